@@ -48,6 +48,11 @@ std::string outFileName = "performance_results_report.csv";
 const testString _query =
     CREATE_STRING("SELECT * FROM ODBCTest.DevOps LIMIT 10000");
 
+// Generated rows of common column types, so the per-cell test needs no table
+const testString _cellQuery = CREATE_STRING(
+    "SELECT x, x * 0.5, CAST(x AS VARCHAR), DATE '2022-01-01' + "
+    "x * INTERVAL '1' DAY FROM UNNEST(SEQUENCE(1, 10000)) AS t(x)");
+
 typedef struct Col {
   SQLLEN data_len;
   SQLCHAR data_dat[BIND_SIZE];
@@ -76,29 +81,35 @@ void prepareOutFile() {
   outFile << "Test Round,test_name,query,loop_count,Average Time (ms),Max Time "
              "(ms),Min Time (ms),"
              "Median Time (ms),90th Percentile (ms),Average Memory Usage "
-             "(KB),Peak Memory Usage (KB)\n";
+             "(KB),Peak Memory Usage (KB),Steady-State Memory Usage (KB)\n";
   outFile.close();
   return;
 }
 
-// Get the average and peak memory usage, assumed to be during a query
-void queryMemUsage(long long& averageMem, long long& peakMem) {
-  long long memSum = 0;
+// Get the average, peak and steady-state memory usage, assumed to be during a
+// query. Steady-state memory usage is the average over the second half of the
+// samples, once the driver buffers have reached their working size.
+void queryMemUsage(long long& averageMem, long long& peakMem,
+                   long long& steadyMem) {
+  std::vector< long long > samples;
   long long memCalc;
-  long long i = 0;
   do {
     memCalc = currentMemUsage();
-    memSum += memCalc;
+    samples.push_back(memCalc);
     if (memCalc > peakMem) {
       peakMem = memCalc;
     }
-    i++;
     // Attempt to limit the number of memory calculations
     boost::this_thread::sleep(boost::posix_time::milliseconds(100));
   } while (!queryFinished);
 
-  if (i > 0) {
-    averageMem = (memSum / i);
+  if (!samples.empty()) {
+    averageMem =
+        std::accumulate(samples.begin(), samples.end(), 0ll) / samples.size();
+
+    size_t half = samples.size() / 2;
+    steadyMem = std::accumulate(samples.begin() + half, samples.end(), 0ll)
+                / (samples.size() - half);
   }
 }
 
@@ -174,14 +185,17 @@ auto RecordBindingFetching = [](SQLHSTMT& hstmt,
     int currentMem = currentMemUsage();                                      \
     long long averageMem = 0;                                                \
     long long peakMem = 0;                                                   \
+    long long steadyMem = 0;                                                 \
     boost::thread queryThread([&] {                                          \
       RecordBindingFetching(_hstmt, times, testString(query), is_wchar);     \
     });                                                                      \
-    boost::thread memThread([&] { queryMemUsage(averageMem, peakMem); });    \
+    boost::thread memThread(                                                 \
+        [&] { queryMemUsage(averageMem, peakMem, steadyMem); });             \
     queryThread.join();                                                      \
     memThread.join();                                                        \
     queryFinished = false;                                                   \
-    Report(#test_name, times, testString(query), averageMem, peakMem);       \
+    Report(#test_name, times, testString(query), averageMem, peakMem,        \
+           steadyMem);                                                       \
   }
 
 class TestPerformance : public testing::Test {
@@ -251,11 +265,13 @@ const std::string sync_median = "%%__MEDIAN__%%";
 const std::string sync_percentile = "%%__90TH_PERCENTILE__%%";
 const std::string sync_average_memory_usage = "%%__AVERAGE_MEMORY_USAGE__%%";
 const std::string sync_peak_memory_usage = "%%__PEAK_MEMORY_USAGE__%%";
+const std::string sync_steady_memory_usage =
+    "%%__STEADY_STATE_MEMORY_USAGE__%%";
 const std::string sync_end = "%%__PARSE__SYNC__END__%%";
 
 // void Report(const std::string& test_case, std::vector< long long > data,
             const testString& query, long long averageMemoryUsage,
-            long long peakMemoryUsage) {
+            long long peakMemoryUsage, long long steadyMemoryUsage) {
   size_t size = data.size();
   ASSERT_EQ(size, (size_t)ITERATION_COUNT);
 
@@ -294,6 +310,8 @@ const std::string sync_end = "%%__PARSE__SYNC__END__%%";
   std::cout << sync_average_memory_usage << averageMemoryUsage << " KB"
             << std::endl;
   std::cout << sync_peak_memory_usage << peakMemoryUsage << " KB" << std::endl;
+  std::cout << sync_steady_memory_usage << steadyMemoryUsage << " KB"
+            << std::endl;
   std::cout << sync_end << std::endl;
 
   std::cout << "Time dump: ";
@@ -316,7 +334,7 @@ const std::string sync_end = "%%__PARSE__SYNC__END__%%";
           << std::to_string(ITERATION_COUNT) << "," << time_mean << ","
           << time_max << "," << time_min << "," << time_median << ","
           << percentile << "," << averageMemoryUsage << "," << peakMemoryUsage
-          << "\n";
+          << "," << steadyMemoryUsage << "\n";
   outFile.close();
 }
 
@@ -332,7 +350,9 @@ TEST_F(TestPerformance, DISABLED_Time_Execute) {
   int currentMem = currentMemUsage();
   long long averageMem = 0;
   long long peakMem = 0;
-  boost::thread memoryThread([&] { queryMemUsage(averageMem, peakMem); });
+  long long steadyMem = 0;
+  boost::thread memoryThread(
+      [&] { queryMemUsage(averageMem, peakMem, steadyMem); });
   boost::thread queryThread = boost::thread([&] {
     SQLRETURN ret = SQLExecDirect(_hstmt, TO_SQLTCHAR(_query.c_str()), SQL_NTS);
     ASSERT_TRUE(SQL_SUCCEEDED(ret));
@@ -353,7 +373,7 @@ TEST_F(TestPerformance, DISABLED_Time_Execute) {
   queryThread.join();
   memoryThread.join();
   queryFinished = false;
-  Report("Execute Query", times, _query, averageMem, peakMem);
+  Report("Execute Query", times, _query, averageMem, peakMem, steadyMem);
 }
 
 TEST_PERF_TEST(DISABLED_Time_BindColumn_FetchSingleRow, _query, true)
@@ -363,7 +383,9 @@ TEST_F(TestPerformance, DISABLED_Time_BindColumn_Fetch5Rows) {
   int currentMem = currentMemUsage();
   long long averageMem = 0;
   long long peakMem = 0;
-  boost::thread memoryThread([&] { queryMemUsage(averageMem, peakMem); });
+  long long steadyMem = 0;
+  boost::thread memoryThread(
+      [&] { queryMemUsage(averageMem, peakMem, steadyMem); });
   boost::thread queryThread = boost::thread([&] {
     SQLROWSETSIZE row_count = 0;
     SQLSMALLINT total_columns = 0;
@@ -406,7 +428,8 @@ TEST_F(TestPerformance, DISABLED_Time_BindColumn_Fetch5Rows) {
   queryThread.join();
   memoryThread.join();
   queryFinished = false;
-  Report("Bind and (5 row) Fetch", times, _query, averageMem, peakMem);
+  Report("Bind and (5 row) Fetch", times, _query, averageMem, peakMem,
+         steadyMem);
 }
 
 TEST_F(TestPerformance, DISABLED_Time_BindColumn_Fetch50Rows) {
@@ -414,7 +437,9 @@ TEST_F(TestPerformance, DISABLED_Time_BindColumn_Fetch50Rows) {
   int currentMem = currentMemUsage();
   long long averageMem = 0;
   long long peakMem = 0;
-  boost::thread memoryThread([&] { queryMemUsage(averageMem, peakMem); });
+  long long steadyMem = 0;
+  boost::thread memoryThread(
+      [&] { queryMemUsage(averageMem, peakMem, steadyMem); });
   boost::thread queryThread = boost::thread([&] {
     SQLROWSETSIZE row_count = 0;
     SQLSMALLINT total_columns = 0;
@@ -458,7 +483,8 @@ TEST_F(TestPerformance, DISABLED_Time_BindColumn_Fetch50Rows) {
   queryThread.join();
   memoryThread.join();
   queryFinished = false;
-  Report("Bind and (50 row) Fetch", times, _query, averageMem, peakMem);
+  Report("Bind and (50 row) Fetch", times, _query, averageMem, peakMem,
+         steadyMem);
 }
 
 TEST_F(TestPerformance, DISABLED_Time_Execute_FetchSingleRow) {
@@ -466,7 +492,9 @@ TEST_F(TestPerformance, DISABLED_Time_Execute_FetchSingleRow) {
   int currentMem = currentMemUsage();
   long long averageMem = 0;
   long long peakMem = 0;
-  boost::thread memoryThread([&] { queryMemUsage(averageMem, peakMem); });
+  long long steadyMem = 0;
+  boost::thread memoryThread(
+      [&] { queryMemUsage(averageMem, peakMem, steadyMem); });
   boost::thread queryThread = boost::thread([&] {
     SQLSMALLINT total_columns = 0;
     int row_count = 0;
@@ -503,7 +531,7 @@ TEST_F(TestPerformance, DISABLED_Time_Execute_FetchSingleRow) {
   memoryThread.join();
   queryFinished = false;
   Report("Execute Query, Bind and (1 row) Fetch", times, _query, averageMem,
-         peakMem);
+         peakMem, steadyMem);
 }
 
 TEST_PERF_TEST(
@@ -1030,6 +1058,61 @@ TEST_PERF_TEST(
     CREATE_STRING("SELECT * FROM perfdb_hcltps.perftable_hcltps LIMIT 1500000"),
     true)
 
+// Cost of reading a cell with SQLFetch and SQLGetData. The query execution is
+// not timed, pages that are not prefetched yet still are. Run it against
+// driver builds to compare them, e.g. with another COMPILED_LOG_LEVEL; the
+// connection string keeps logging off.
+TEST_F(TestPerformance, Time_GetData_PerCell) {
+  std::vector< long long > times;
+  long long averageMem = 0;
+  long long peakMem = 0;
+  long long steadyMem = 0;
+  long long fetchNanos = 0;
+  long long cellCount = 0;
+  boost::thread memoryThread(
+      [&] { queryMemUsage(averageMem, peakMem, steadyMem); });
+  boost::thread queryThread = boost::thread([&] {
+    SQLWCHAR data[BIND_SIZE];
+    SQLLEN dataLen = 0;
+    SQLSMALLINT totalColumns = 0;
+
+    for (size_t iter = 0; iter < ITERATION_COUNT; iter++) {
+      SQLRETURN ret =
+          SQLExecDirect(_hstmt, TO_SQLTCHAR(_cellQuery.c_str()), SQL_NTS);
+      logDiagnostics(SQL_HANDLE_STMT, _hstmt, ret);
+      ASSERT_TRUE(SQL_SUCCEEDED(ret));
+      SQLNumResultCols(_hstmt, &totalColumns);
+
+      auto start = std::chrono::steady_clock::now();
+      while (SQLFetch(_hstmt) == SQL_SUCCESS) {
+        for (SQLUSMALLINT i = 1; i <= totalColumns; i++) {
+          SQLGetData(_hstmt, i, SQL_C_WCHAR, data, sizeof(data), &dataLen);
+          cellCount++;
+        }
+      }
+      auto end = std::chrono::steady_clock::now();
+      ASSERT_TRUE(SQL_SUCCEEDED(SQLCloseCursor(_hstmt)));
+
+      fetchNanos +=
+          std::chrono::duration_cast< std::chrono::nanoseconds >(end - start)
+              .count();
+      times.push_back(
+          std::chrono::duration_cast< std::chrono::milliseconds >(end - start)
+              .count());
+    }
+    queryFinished = true;
+  });
+  queryThread.join();
+  memoryThread.join();
+  queryFinished = false;
+
+  ASSERT_GT(cellCount, 0);
+  std::cout << "Cells read: " << cellCount << ", per cell: "
+            << fetchNanos / cellCount << " ns" << std::endl;
+  Report("GetData per cell", times, _cellQuery, averageMem, peakMem,
+         steadyMem);
+}
+
 int main(int argc, char** argv) {
 #ifdef WIN32
   // Enable CRT for detecting memory leaks
@@ -85,6 +85,8 @@ SQLRETURN SQLExecDirect(SQLHSTMT stmt, SQLWCHAR* query, SQLINTEGER queryLen);
 
 SQLRETURN SQLCancel(SQLHSTMT stmt);
 
+SQLRETURN SQLCancelHandle(SQLSMALLINT handleType, SQLHANDLE handle);
+
 SQLRETURN SQLBindCol(SQLHSTMT stmt, SQLUSMALLINT colNum, SQLSMALLINT targetType,
                      SQLPOINTER targetValue, SQLLEN bufferLength,
                      SQLLEN* strLengthOrIndicator);
@@ -99,6 +101,14 @@ SQLRETURN SQLExtendedFetch(SQLHSTMT stmt, SQLUSMALLINT orientation,
 
 SQLRETURN SQLNumResultCols(SQLHSTMT stmt, SQLSMALLINT* columnNum);
 
+SQLRETURN SQLBindParameter(SQLHSTMT stmt, SQLUSMALLINT paramIdx,
+                           SQLSMALLINT ioType, SQLSMALLINT bufferType,
+                           SQLSMALLINT paramSqlType, SQLULEN columnSize,
+                           SQLSMALLINT decDigits, SQLPOINTER buffer,
+                           SQLLEN bufferLen, SQLLEN* resLen);
+
+SQLRETURN SQLNumParams(SQLHSTMT stmt, SQLSMALLINT* paramCnt);
+
 SQLRETURN SQLTables(SQLHSTMT stmt, SQLWCHAR* catalogName,
                     SQLSMALLINT catalogNameLen, SQLWCHAR* schemaName,
                     SQLSMALLINT schemaNameLen, SQLWCHAR* tableName,
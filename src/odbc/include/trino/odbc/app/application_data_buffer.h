@@ -250,6 +250,16 @@ class ApplicationDataBuffer {
    */
   ConversionResult::Type PutString(const std::string& value, int32_t& written);
 
+  /**
+   * Put in buffer value of type string. Strings are copied to string buffers
+   * from where they are.
+   *
+   * @param value Zero-terminated value.
+   * @param length Length of the value in bytes.
+   * @return Conversion result.
+   */
+  ConversionResult::Type PutString(const char* value, size_t length);
+
   /**
    * Put NULL.
    * @return Conversion result.
@@ -531,13 +541,13 @@ class ApplicationDataBuffer {
   /**
    * Put string to string buffer.
    *
-   * @param value String value.
+   * @param value Zero-terminated string value.
    * @param written Number of characters written.
    * @return Conversion result.
    */
   template < typename OutCharT, typename InCharT >
-  ConversionResult::Type PutStrToStrBuffer(
-      const std::basic_string< InCharT >& value, int32_t& written);
+  ConversionResult::Type PutStrToStrBuffer(const InCharT* value,
+                                           int32_t& written);
 
   /**
    * Put raw data to any buffer.
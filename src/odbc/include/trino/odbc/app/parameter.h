@@ -0,0 +1,187 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _TRINO_ODBC_APP_PARAMETER
+#define _TRINO_ODBC_APP_PARAMETER
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "trino/odbc/app/application_data_buffer.h"
+
+namespace trino {
+namespace odbc {
+namespace app {
+/**
+ * Statement parameter bound with SQLBindParameter.
+ */
+class Parameter {
+ public:
+  /**
+   * Default constructor.
+   */
+  Parameter();
+
+  /**
+   * Constructor.
+   *
+   * @param buffer Underlying data buffer.
+   * @param sqlType SQL type of the parameter.
+   * @param columnSize Column size.
+   * @param decDigits Number of decimal digits.
+   */
+  Parameter(const ApplicationDataBuffer& buffer, int16_t sqlType,
+            size_t columnSize, int16_t decDigits);
+
+  /**
+   * Copy constructor.
+   *
+   * @param other Other instance.
+   */
+  Parameter(const Parameter& other) = default;
+
+  /**
+   * Destructor.
+   */
+  ~Parameter() = default;
+
+  /**
+   * Assignment operator.
+   *
+   * @param other Other instance.
+   * @return This.
+   */
+  Parameter& operator=(const Parameter& other) = default;
+
+  /**
+   * Get the value as a SQL literal of the parameter SQL type, to put in
+   * place of its marker.
+   *
+   * @param literal Literal, set on success.
+   * @param rowIdx Index of the parameter set in a parameter array.
+   * @return @c true on success, @c false if the SQL type is not supported.
+   */
+  bool GetLiteral(std::string& literal, SqlUlen rowIdx = 0) const;
+
+  /**
+   * Check if the value is to be sent at execution time.
+   *
+   * @param rowIdx Index of the parameter set in a parameter array.
+   * @return @c true if the value is sent with SQLPutData.
+   */
+  bool IsDataAtExec(SqlUlen rowIdx = 0) const;
+
+  /**
+   * Get SQL type of the parameter.
+   *
+   * @return SQL type.
+   */
+  int16_t GetSqlType() const {
+    return sqlType;
+  }
+
+  /**
+   * Get underlying data buffer.
+   *
+   * @return Data buffer.
+   */
+  const ApplicationDataBuffer& GetBuffer() const {
+    return buffer;
+  }
+
+  /**
+   * Count the parameter markers of a SQL query. Question marks in string
+   * literals, quoted identifiers and comments are not markers.
+   *
+   * @param sql SQL query.
+   * @return Number of markers.
+   */
+  static uint16_t CountMarkers(const std::string& sql);
+
+  /**
+   * Find the parameter markers of a SQL query.
+   *
+   * @param sql SQL query.
+   * @return Positions of the markers in the query, in ascending order.
+   */
+  static std::vector< size_t > FindMarkers(const std::string& sql);
+
+  /**
+   * Find the row of an INSERT ... VALUES statement inserting a single row,
+   * so more rows can be appended to it.
+   *
+   * @param sql SQL query.
+   * @param rowStart Position of the opening parenthesis of the row, set if
+   *     found. The row ends at the end of the query.
+   * @return @c true if the query is such a statement.
+   */
+  static bool FindValuesRow(const std::string& sql, size_t& rowStart);
+
+  /**
+   * Put literals in place of the parameter markers of a SQL query.
+   *
+   * @param sql SQL query.
+   * @param markers Positions of the markers, as found by FindMarkers().
+   * @param literals Literals, one for every marker.
+   * @param from Position of the query text to start from. Markers must not
+   *     precede it.
+   * @return Query text from @c from with the markers replaced.
+   */
+  static std::string InlineLiterals(const std::string& sql,
+                                    const std::vector< size_t >& markers,
+                                    const std::vector< std::string >& literals,
+                                    size_t from = 0);
+
+  /**
+   * Build an EXECUTE IMMEDIATE statement running a SQL query with the
+   * literals as arguments of its parameter markers, so the query text is
+   * sent unchanged.
+   *
+   * @param sql SQL query.
+   * @param literals Literals, one for every marker.
+   * @return EXECUTE IMMEDIATE statement.
+   */
+  static std::string ExecuteImmediate(
+      const std::string& sql, const std::vector< std::string >& literals);
+
+ private:
+  /** Underlying data buffer. */
+  ApplicationDataBuffer buffer;
+
+  /** SQL type. */
+  int16_t sqlType;
+
+  /** Column size. */
+  size_t columnSize;
+
+  /** Number of decimal digits. */
+  int16_t decDigits;
+};
+
+/** Parameter binding map type alias, keyed by parameter index. */
+typedef std::map< uint16_t, Parameter > ParameterBindingMap;
+}  // namespace app
+}  // namespace odbc
+}  // namespace trino
+
+#endif  //_TRINO_ODBC_APP_PARAMETER
@@ -51,7 +51,10 @@ struct SqlResult {
     AI_NO_DATA,
 
     /** No more data. */
-    AI_NEED_DATA
+    AI_NEED_DATA,
+
+    /** Function is still running asynchronously. */
+    AI_STILL_EXECUTING
   };
 };
 
@@ -81,9 +84,17 @@ struct SqlState {
      */
     S01S02_OPTION_VALUE_CHANGED,
 
+    /**
+     * Attempt to fetch before the result set returned the first rowset.
+     */
+    S01S06_FETCH_BEFORE_FIRST_ROWSET,
+
     /** The numeric or time data returned for a column was truncated. */
     S01S07_FRACTIONAL_TRUNCATION,
 
+    /** Number of bound parameters is less than the number of markers. */
+    S07002_COUNT_FIELD_INCORRECT,
+
     /** Restricted data type attribute violation. */
     S07006_RESTRICTION_VIOLATION,
 
@@ -316,7 +327,13 @@ struct EnvironmentAttribute {
     ODBC_VERSION,
 
     /** Null-termination of strings. */
-    OUTPUT_NTS
+    OUTPUT_NTS,
+
+    /** Bytes held by decoded result pages. */
+    MEMORY_USAGE,
+
+    /** Result memory limit. */
+    MEMORY_LIMIT
   };
 };
 
@@ -46,7 +46,22 @@
 
 #define DEFAULT_AUTH_TYPE AuthType::Type::PASSWORD
 #define DEFAULT_LOG_LEVEL LogLevel::Type::WARNING_LEVEL
+#define DEFAULT_LOG_FILE_SIZE 0
+#define DEFAULT_LOG_DROP_ON_OVERFLOW false
 #define DEFAULT_MAX_ROW_PER_PAGE -1
+#define DEFAULT_RESULT_MEMORY_LIMIT 0
+#define DEFAULT_RESULT_CACHE_TTL 0
+#define DEFAULT_RESULT_CACHE_SIZE 64
+#define DEFAULT_RESULT_CACHE_DIR ""
+#define DEFAULT_QUERY_SHARING false
+#define DEFAULT_METADATA_CACHE_TTL 0
+#define DEFAULT_METADATA_CONCURRENCY 16
+#define DEFAULT_METADATA_SNAPSHOT_DIR ""
+#define DEFAULT_METADATA_PREFETCH false
+#define DEFAULT_QUERY_TRACE_FILE ""
+#define DEFAULT_METRICS_FILE ""
+#define DEFAULT_METRICS_INTERVAL 60
+#define DEFAULT_TRACE_EVENT_FILE ""
 
 using ignite::odbc::config::SettableValue;
 
@@ -96,8 +111,53 @@ class IGNITE_IMPORT_EXPORT Configuration {
     /** Default value for logPath attribute. */
     static const std::string logPath;
 
+    /** Default value for logFileSize attribute. */
+    static const int32_t logFileSize;
+
+    /** Default value for logDropOnOverflow attribute. */
+    static const bool logDropOnOverflow;
+
     /** Default value for maxRowPerPage attribute */
     static const int32_t maxRowPerPage;
+
+    /** Default value for resultMemoryLimit attribute */
+    static const int32_t resultMemoryLimit;
+
+    /** Default value for resultCacheTtl attribute */
+    static const int32_t resultCacheTtl;
+
+    /** Default value for resultCacheSize attribute */
+    static const int32_t resultCacheSize;
+
+    /** Default value for resultCacheDir attribute */
+    static const std::string resultCacheDir;
+
+    /** Default value for querySharing attribute */
+    static const bool querySharing;
+
+    /** Default value for metadataCacheTtl attribute */
+    static const int32_t metadataCacheTtl;
+
+    /** Default value for metadataConcurrency attribute */
+    static const int32_t metadataConcurrency;
+
+    /** Default value for metadataSnapshotDir attribute */
+    static const std::string metadataSnapshotDir;
+
+    /** Default value for metadataPrefetch attribute */
+    static const bool metadataPrefetch;
+
+    /** Default value for queryTraceFile attribute */
+    static const std::string queryTraceFile;
+
+    /** Default value for metricsFile attribute */
+    static const std::string metricsFile;
+
+    /** Default value for metricsInterval attribute */
+    static const int32_t metricsInterval;
+
+    /** Default value for traceEventFile attribute */
+    static const std::string traceEventFile;
   };
 
   /**
@@ -375,6 +435,49 @@ class IGNITE_IMPORT_EXPORT Configuration {
    */
   bool IsLogPathSet() const;
 
+  /**
+   * Get logFileSize.
+   *
+   * @return Size in megabytes the log file is rotated at, 0 for never.
+   */
+  int32_t GetLogFileSize() const;
+
+  /**
+   * Set logFileSize.
+   *
+   * @param size Size in megabytes the log file is rotated at, 0 for never.
+   */
+  void SetLogFileSize(int32_t size);
+
+  /**
+   * Check if the value set.
+   *
+   * @return @true if LogFileSize set.
+   */
+  bool IsLogFileSizeSet() const;
+
+  /**
+   * Get logDropOnOverflow.
+   *
+   * @return @c true if log messages are dropped when the log queue is full.
+   */
+  bool GetLogDropOnOverflow() const;
+
+  /**
+   * Set logDropOnOverflow.
+   *
+   * @param value @c true to drop log messages when the log queue is full,
+   *     @c false to wait for room.
+   */
+  void SetLogDropOnOverflow(bool value);
+
+  /**
+   * Check if the value set.
+   *
+   * @return @true if LogDropOnOverflow set.
+   */
+  bool IsLogDropOnOverflowSet() const;
+
   /**
    * Get maxRowPerPage.
    *
@@ -396,6 +499,289 @@ class IGNITE_IMPORT_EXPORT Configuration {
    */
   bool IsMaxRowPerPageSet() const;
 
+  /**
+   * Get resultMemoryLimit.
+   *
+   * @return Result memory limit in megabytes, zero means no limit.
+   */
+  int32_t GetResultMemoryLimit() const;
+
+  /**
+   * Set resultMemoryLimit.
+   *
+   * @param value Result memory limit in megabytes, zero means no limit.
+   */
+  void SetResultMemoryLimit(int32_t value);
+
+  /**
+   * Check if the value set.
+   *
+   * @return @true if ResultMemoryLimit set.
+   */
+  bool IsResultMemoryLimitSet() const;
+
+  /**
+   * Get resultCacheTtl.
+   *
+   * @return Seconds a cached result stays valid, zero disables the cache.
+   */
+  int32_t GetResultCacheTtl() const;
+
+  /**
+   * Set resultCacheTtl.
+   *
+   * @param value Seconds a cached result stays valid, zero disables the
+   *     cache.
+   */
+  void SetResultCacheTtl(int32_t value);
+
+  /**
+   * Check if the value set.
+   *
+   * @return @true if ResultCacheTtl set.
+   */
+  bool IsResultCacheTtlSet() const;
+
+  /**
+   * Get resultCacheSize.
+   *
+   * @return Result cache size in megabytes.
+   */
+  int32_t GetResultCacheSize() const;
+
+  /**
+   * Set resultCacheSize.
+   *
+   * @param value Result cache size in megabytes.
+   */
+  void SetResultCacheSize(int32_t value);
+
+  /**
+   * Check if the value set.
+   *
+   * @return @true if ResultCacheSize set.
+   */
+  bool IsResultCacheSizeSet() const;
+
+  /**
+   * Get resultCacheDir.
+   *
+   * @return Directory cached results are moved to, empty for none.
+   */
+  const std::string& GetResultCacheDir() const;
+
+  /**
+   * Set resultCacheDir. Ignored unless the directory exists.
+   *
+   * @param dir Directory cached results are moved to.
+   */
+  void SetResultCacheDir(const std::string& dir);
+
+  /**
+   * Check if the value set.
+   *
+   * @return @true if ResultCacheDir set.
+   */
+  bool IsResultCacheDirSet() const;
+
+  /**
+   * Get querySharing.
+   *
+   * @return @c true if identical queries running at the same time are
+   *     executed once.
+   */
+  bool GetQuerySharing() const;
+
+  /**
+   * Set querySharing.
+   *
+   * @param value @c true to execute identical queries running at the same
+   *     time once.
+   */
+  void SetQuerySharing(bool value);
+
+  /**
+   * Check if the value set.
+   *
+   * @return @true if QuerySharing set.
+   */
+  bool IsQuerySharingSet() const;
+
+  /**
+   * Get metadataCacheTtl.
+   *
+   * @return Seconds cached catalog metadata stays valid, zero disables the
+   *     cache.
+   */
+  int32_t GetMetadataCacheTtl() const;
+
+  /**
+   * Set metadataCacheTtl.
+   *
+   * @param value Seconds cached catalog metadata stays valid, zero disables
+   *     the cache.
+   */
+  void SetMetadataCacheTtl(int32_t value);
+
+  /**
+   * Check if the value set.
+   *
+   * @return @true if MetadataCacheTtl set.
+   */
+  bool IsMetadataCacheTtlSet() const;
+
+  /**
+   * Get metadataConcurrency.
+   *
+   * @return Maximum number of catalog queries run at the same time for one
+   *     metadata request.
+   */
+  int32_t GetMetadataConcurrency() const;
+
+  /**
+   * Set metadataConcurrency.
+   *
+   * @param value Maximum number of catalog queries run at the same time for
+   *     one metadata request.
+   */
+  void SetMetadataConcurrency(int32_t value);
+
+  /**
+   * Check if the value set.
+   *
+   * @return @true if MetadataConcurrency set.
+   */
+  bool IsMetadataConcurrencySet() const;
+
+  /**
+   * Get metadataSnapshotDir.
+   *
+   * @return Directory the catalog metadata snapshots are kept in, empty for
+   *     none.
+   */
+  const std::string& GetMetadataSnapshotDir() const;
+
+  /**
+   * Set metadataSnapshotDir. Ignored unless the directory exists.
+   *
+   * @param dir Directory the catalog metadata snapshots are kept in.
+   */
+  void SetMetadataSnapshotDir(const std::string& dir);
+
+  /**
+   * Check if the value set.
+   *
+   * @return @true if MetadataSnapshotDir set.
+   */
+  bool IsMetadataSnapshotDirSet() const;
+
+  /**
+   * Get metadataPrefetch.
+   *
+   * @return @c true if the catalog metadata is read in the background
+   *     right after connecting.
+   */
+  bool GetMetadataPrefetch() const;
+
+  /**
+   * Set metadataPrefetch.
+   *
+   * @param value @c true to read the catalog metadata in the background
+   *     right after connecting.
+   */
+  void SetMetadataPrefetch(bool value);
+
+  /**
+   * Check if the value set.
+   *
+   * @return @true if MetadataPrefetch set.
+   */
+  bool IsMetadataPrefetchSet() const;
+
+  /**
+   * Get queryTraceFile.
+   *
+   * @return File the query timing records are appended to, empty for none.
+   */
+  const std::string& GetQueryTraceFile() const;
+
+  /**
+   * Set queryTraceFile.
+   *
+   * @param path File the query timing records are appended to.
+   */
+  void SetQueryTraceFile(const std::string& path);
+
+  /**
+   * Check if the value set.
+   *
+   * @return @true if QueryTraceFile set.
+   */
+  bool IsQueryTraceFileSet() const;
+
+  /**
+   * Get metricsFile.
+   *
+   * @return File the driver metrics are written to, empty for none.
+   */
+  const std::string& GetMetricsFile() const;
+
+  /**
+   * Set metricsFile.
+   *
+   * @param path File the driver metrics are written to.
+   */
+  void SetMetricsFile(const std::string& path);
+
+  /**
+   * Check if the value set.
+   *
+   * @return @true if MetricsFile set.
+   */
+  bool IsMetricsFileSet() const;
+
+  /**
+   * Get metricsInterval.
+   *
+   * @return Interval between writes of the metrics file in seconds.
+   */
+  int32_t GetMetricsInterval() const;
+
+  /**
+   * Set metricsInterval.
+   *
+   * @param interval Interval between writes of the metrics file in seconds.
+   */
+  void SetMetricsInterval(int32_t interval);
+
+  /**
+   * Check if the value set.
+   *
+   * @return @true if MetricsInterval set.
+   */
+  bool IsMetricsIntervalSet() const;
+
+  /**
+   * Get traceEventFile.
+   *
+   * @return File the trace events are written to, empty for none.
+   */
+  const std::string& GetTraceEventFile() const;
+
+  /**
+   * Set traceEventFile.
+   *
+   * @param path File the trace events are written to.
+   */
+  void SetTraceEventFile(const std::string& path);
+
+  /**
+   * Check if the value set.
+   *
+   * @return @true if TraceEventFile set.
+   */
+  bool IsTraceEventFileSet() const;
+
   /**
    * Get argument map.
    *
@@ -466,8 +852,55 @@ class IGNITE_IMPORT_EXPORT Configuration {
   /** The logging file path. */
   SettableValue< std::string > logPath = DefaultValue::logPath;
 
+  /** The size in megabytes the log file is rotated at. */
+  SettableValue< int32_t > logFileSize = DefaultValue::logFileSize;
+
+  /** Drop log messages when the log queue is full. */
+  SettableValue< bool > logDropOnOverflow = DefaultValue::logDropOnOverflow;
+
   /** The max row number in one page returned from Trino */
   SettableValue< int32_t > maxRowPerPage = DefaultValue::maxRowPerPage;
+
+  /** Memory limit in megabytes for decoded result pages of the connection */
+  SettableValue< int32_t > resultMemoryLimit = DefaultValue::resultMemoryLimit;
+
+  /** Seconds a cached result stays valid, zero disables the cache */
+  SettableValue< int32_t > resultCacheTtl = DefaultValue::resultCacheTtl;
+
+  /** Result cache size in megabytes */
+  SettableValue< int32_t > resultCacheSize = DefaultValue::resultCacheSize;
+
+  /** Directory cached results are moved to when evicted from memory */
+  SettableValue< std::string > resultCacheDir = DefaultValue::resultCacheDir;
+
+  /** Execute identical queries running at the same time once */
+  SettableValue< bool > querySharing = DefaultValue::querySharing;
+
+  /** Seconds cached catalog metadata stays valid, zero disables the cache */
+  SettableValue< int32_t > metadataCacheTtl = DefaultValue::metadataCacheTtl;
+
+  /** Maximum number of catalog queries run at the same time per request */
+  SettableValue< int32_t > metadataConcurrency =
+      DefaultValue::metadataConcurrency;
+
+  /** Directory the catalog metadata snapshots are kept in */
+  SettableValue< std::string > metadataSnapshotDir =
+      DefaultValue::metadataSnapshotDir;
+
+  /** Read the catalog metadata in the background after connecting. */
+  SettableValue< bool > metadataPrefetch = DefaultValue::metadataPrefetch;
+
+  /** File the query timing records are appended to */
+  SettableValue< std::string > queryTraceFile = DefaultValue::queryTraceFile;
+
+  /** File the driver metrics are written to */
+  SettableValue< std::string > metricsFile = DefaultValue::metricsFile;
+
+  /** Interval between writes of the metrics file in seconds */
+  SettableValue< int32_t > metricsInterval = DefaultValue::metricsInterval;
+
+  /** File the trace events are written to */
+  SettableValue< std::string > traceEventFile = DefaultValue::traceEventFile;
 };
 
 template <>
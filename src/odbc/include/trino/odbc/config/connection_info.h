@@ -40,6 +40,11 @@ namespace odbc {
 namespace config {
 /**
  * Connection info.
+ *
+ * The capabilities reported by SQLGetInfo are the same for every
+ * connection, so they are kept in a process-wide table indexed by info
+ * type. Values set for a connection after it is established, such as the
+ * user and data source names, are kept per connection on top of it.
  */
 class ConnectionInfo {
  public:
@@ -87,6 +92,9 @@ class ConnectionInfo {
  private:
   IGNITE_NO_COPY_ASSIGNMENT(ConnectionInfo);
 
+  /** Process-wide info values, indexed by info type. */
+  class InfoTable;
+
   /** Associative array of string parameters. */
   typedef std::map< InfoType, std::string > StringInfoMap;
 
@@ -96,14 +104,30 @@ class ConnectionInfo {
   /** Associative array of unsigned short parameters. */
   typedef std::map< InfoType, unsigned short > UshortInfoMap;
 
-  /** String parameters. */
-  StringInfoMap strParams;
+  /**
+   * Fill the info values.
+   *
+   * @param databaseAsSchema Whether databases are reported as schemas.
+   * @param strParams String parameters.
+   * @param intParams Integer parameters.
+   * @param shortParams Short parameters.
+   */
+  static void FillInfo(bool databaseAsSchema, StringInfoMap& strParams,
+                       UintInfoMap& intParams, UshortInfoMap& shortParams);
 
-  /** Integer parameters. */
-  UintInfoMap intParams;
+  /**
+   * Get the process-wide info values, built on first use.
+   *
+   * @param databaseAsSchema Whether databases are reported as schemas.
+   * @return Info values.
+   */
+  static const InfoTable& GetInfoTable(bool databaseAsSchema);
 
-  /** Short parameters. */
-  UshortInfoMap shortParams;
+  /** Info values shared by the connections. */
+  const InfoTable& table;
+
+  /** String parameters set for the connection. */
+  StringInfoMap strParams;
 
   /** Configuration. */
   const Configuration& config;
@@ -69,8 +69,53 @@ class IGNITE_IMPORT_EXPORT ConnectionStringParser {
     /** Connection attribute keyword for log path. */
     static const std::string logPath;
 
+    /** Connection attribute keyword for log file size. */
+    static const std::string logFileSize;
+
+    /** Connection attribute keyword for log drop on overflow. */
+    static const std::string logDropOnOverflow;
+
     /** Max number of rows in one page returned from TS. */
     static const std::string maxRowPerPage;
+
+    /** Connection attribute keyword for result memory limit. */
+    static const std::string resultMemoryLimit;
+
+    /** Connection attribute keyword for result cache time to live. */
+    static const std::string resultCacheTtl;
+
+    /** Connection attribute keyword for result cache size. */
+    static const std::string resultCacheSize;
+
+    /** Connection attribute keyword for result cache directory. */
+    static const std::string resultCacheDir;
+
+    /** Connection attribute keyword for query sharing. */
+    static const std::string querySharing;
+
+    /** Connection attribute keyword for metadata cache TTL. */
+    static const std::string metadataCacheTtl;
+
+    /** Connection attribute keyword for metadata concurrency. */
+    static const std::string metadataConcurrency;
+
+    /** Connection attribute keyword for metadata snapshot directory. */
+    static const std::string metadataSnapshotDir;
+
+    /** Connection attribute keyword for metadata prefetch. */
+    static const std::string metadataPrefetch;
+
+    /** Connection attribute keyword for query trace file. */
+    static const std::string queryTraceFile;
+
+    /** Connection attribute keyword for metrics file. */
+    static const std::string metricsFile;
+
+    /** Connection attribute keyword for metrics interval. */
+    static const std::string metricsInterval;
+
+    /** Connection attribute keyword for trace event file. */
+    static const std::string traceEventFile;
   };
 
   /**
@@ -132,6 +177,24 @@ class IGNITE_IMPORT_EXPORT ConnectionStringParser {
   void HandleAttributePair(const std::string& key, const std::string& value,
                            diagnostic::DiagnosticRecordStorage* diag);
 
+  /**
+   * Parse non-negative integer attribute value. Reports a diagnostic record
+   * and leaves the result untouched if the value can not be used.
+   *
+   * @param name Attribute name used in diagnostic messages.
+   * @param key Key.
+   * @param value Value.
+   * @param maxValue Maximum allowed value.
+   * @param diag Diagnostics collector.
+   * @param res Parsed value.
+   * @return @c true if the value was parsed.
+   */
+  static bool ParseUnsignedValue(const std::string& name,
+                                 const std::string& key,
+                                 const std::string& value, int64_t maxValue,
+                                 diagnostic::DiagnosticRecordStorage* diag,
+                                 int64_t& res);
+
   /**
    * Convert string to boolean value.
    *
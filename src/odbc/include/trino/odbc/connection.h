@@ -23,6 +23,9 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <future>
+#include <memory>
 #include <vector>
 
 #include "trino/odbc/config/configuration.h"
@@ -33,6 +36,10 @@
 #include "ignite/odbc/odbc_error.h"
 #include "trino/odbc/authentication/saml.h"
 #include "trino/odbc/descriptor.h"
+#include "trino/odbc/memory_governor.h"
+#include "trino/odbc/metadata_cache.h"
+#include "trino/odbc/result_cache.h"
+#include "trino/odbc/shared_query.h"
 
 /*#*/
 #include <aws/core/Aws.h>
@@ -45,6 +52,10 @@ namespace odbc {
 class Environment;
 class Statement;
 
+namespace query {
+class TableMetadataQuery;
+}
+
 /**
  * Statement attributes that could be set by ODBC2 SQLSetConnectOption.
  * These attributes will be passed to statement when a statement is created.
@@ -148,6 +159,55 @@ class IGNITE_IMPORT_EXPORT Connection : public diagnostic::DiagnosableAdapter {
   std::shared_ptr< client::TrinoQuery::TrinoQueryClient > /*#*/
   GetQueryClient() const;
 
+  /**
+   * Get memory governor for result pages of the connection statements.
+   *
+   * @return Memory governor.
+   */
+  const std::shared_ptr< MemoryGovernor >& GetMemoryGovernor() const {
+    return memoryGovernor_;
+  }
+
+  /**
+   * Get cache for results of the connection statements.
+   *
+   * @return Result cache shared with the other connections of the
+   *     environment, or null if the connection does not cache results.
+   */
+  std::shared_ptr< ResultCache > GetResultCache() const;
+
+  /**
+   * Get registry of the running queries identical statements may share.
+   *
+   * @return Registry shared with the other connections of the environment,
+   *     or null if the connection does not share queries.
+   */
+  std::shared_ptr< SharedQueryRegistry > GetSharedQueries() const;
+
+  /**
+   * Get cache for catalog metadata read by the connection statements.
+   *
+   * @return Metadata cache shared with the other connections of the
+   *     environment, or null if the connection does not cache metadata.
+   */
+  std::shared_ptr< MetadataCache > GetMetadataCache() const;
+
+  /**
+   * Get identity the connection runs queries with, which separates the
+   * cached results of different users and servers.
+   *
+   * @return Identity.
+   */
+  std::string GetResultCacheIdentity() const;
+
+  /**
+   * Get path of the catalog metadata snapshot of the data source and
+   * identity of the connection.
+   *
+   * @return Path, empty if the connection keeps no snapshot.
+   */
+  std::string GetMetadataSnapshotPath() const;
+
   /**
    * Create statement associated with the connection.
    *
@@ -226,6 +286,16 @@ class IGNITE_IMPORT_EXPORT Connection : public diagnostic::DiagnosableAdapter {
     return metadataID_;
   }
 
+  /**
+   * Set metadataID_. Used by statements, which must not touch the
+   * connection diagnostic records from their own threads.
+   *
+   * @param metadataID New value.
+   */
+  void SetMetadataID(bool metadataID) {
+    metadataID_ = metadataID;
+  }
+
   /**
    * Get TrinoSAMLCredentialsProvider.
    *
@@ -314,8 +384,10 @@ class IGNITE_IMPORT_EXPORT Connection : public diagnostic::DiagnosableAdapter {
  protected:
   /**
    * Constructor.
+   *
+   * @param env Environment the connection belongs to.
    */
-  Connection();
+  Connection(Environment* env);
 
   /**
    * Create TrinoQueryClient object.
@@ -387,6 +459,12 @@ class IGNITE_IMPORT_EXPORT Connection : public diagnostic::DiagnosableAdapter {
    */
   void Close();
 
+  /**
+   * Start reading the catalog metadata into the metadata cache in the
+   * background, if the connection is configured to.
+   */
+  void StartMetadataPrefetch();
+
   /**
    * Get info of any type.
    * Internal call.
@@ -594,7 +672,7 @@ class IGNITE_IMPORT_EXPORT Connection : public diagnostic::DiagnosableAdapter {
 
   /** Metadata ID flag, indicate if the string arguments of catalog functions
    * are treated as identifiers. */
-  bool metadataID_;
+  std::atomic< bool > metadataID_;
 
   /** Configuration. */
   config::Configuration config_;
@@ -616,6 +694,24 @@ class IGNITE_IMPORT_EXPORT Connection : public diagnostic::DiagnosableAdapter {
 
   /** statement attributes struct */
   StatementAttributes stmtAttr_;
+
+  /** Environment the connection belongs to. */
+  Environment* env_;
+
+  /** Memory governor for result pages of the connection statements. */
+  std::shared_ptr< MemoryGovernor > memoryGovernor_;
+
+  /** Path the metadata snapshot is saved to on close, empty for none. */
+  std::string snapshotPath_;
+
+  /** Metadata prefetch in flight, invalid if there is none. */
+  std::shared_future< void > prefetch_;
+
+  /** Diagnostics of the metadata prefetch. */
+  std::unique_ptr< diagnostic::DiagnosableAdapter > prefetchDiag_;
+
+  /** Query of the metadata prefetch, interrupted on close. */
+  std::unique_ptr< query::TableMetadataQuery > prefetchQuery_;
 };
 }  // namespace odbc
 }  // namespace trino
@@ -21,16 +21,20 @@
 #ifndef _TRINO_ODBC_DIAGNOSTIC_DIAGNOSABLE_ADAPTER
 #define _TRINO_ODBC_DIAGNOSTIC_DIAGNOSABLE_ADAPTER
 
+#include <mutex>
+
 #include "ignite/odbc/diagnostic/diagnosable.h"
 #include "ignite/odbc/odbc_error.h"
 
-#define IGNITE_ODBC_API_CALL(...)         \
-  diagnosticRecords.Reset();              \
-  SqlResult::Type result = (__VA_ARGS__); \
+#define IGNITE_ODBC_API_CALL(...)                                   \
+  std::lock_guard< std::recursive_mutex > handleLock(handleMutex); \
+  diagnosticRecords.Reset();                                        \
+  SqlResult::Type result = (__VA_ARGS__);                           \
   diagnosticRecords.SetHeaderRecord(result)
 
-#define IGNITE_ODBC_API_CALL_ALWAYS_SUCCESS \
-  diagnosticRecords.Reset();                \
+#define IGNITE_ODBC_API_CALL_ALWAYS_SUCCESS                         \
+  std::lock_guard< std::recursive_mutex > handleLock(handleMutex); \
+  diagnosticRecords.Reset();                                        \
   diagnosticRecords.SetHeaderRecord(SqlResult::AI_SUCCESS)
 
 namespace trino {
@@ -52,7 +56,7 @@ class IGNITE_IMPORT_EXPORT DiagnosableAdapter
    *     diagnostic records with connection info.
    */
   DiagnosableAdapter(const Connection* connection = 0)
-      : connection(connection) {
+      : handleMutex(), connection(connection) {
     // No-op.
   }
 
@@ -121,7 +125,8 @@ class IGNITE_IMPORT_EXPORT DiagnosableAdapter
   virtual void AddStatusRecord(const ignite::odbc::OdbcError& err);
 
   /**
-   * Add new status record.
+   * Add new status record. The other overloads add their records through
+   * this one.
    *
    * @param rec Record.
    */
@@ -131,6 +136,13 @@ class IGNITE_IMPORT_EXPORT DiagnosableAdapter
   /** Diagnostic records. */
   DiagnosticRecordStorage diagnosticRecords;
 
+  /**
+   * Handle lock, taken by IGNITE_ODBC_API_CALL. Calls on one handle are
+   * serialized while calls on other handles run in parallel. Recursive, as
+   * API functions call each other.
+   */
+  std::recursive_mutex handleMutex;
+
  private:
   /** Connection. */
   const Connection* connection;
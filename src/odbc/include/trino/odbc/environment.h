@@ -21,9 +21,14 @@
 #ifndef _TRINO_ODBC_ENVIRONMENT
 #define _TRINO_ODBC_ENVIRONMENT
 
+#include <memory>
 #include <set>
 
 #include "trino/odbc/diagnostic/diagnosable_adapter.h"
+#include "trino/odbc/memory_governor.h"
+#include "trino/odbc/metadata_cache.h"
+#include "trino/odbc/result_cache.h"
+#include "trino/odbc/shared_query.h"
 
 namespace trino {
 namespace odbc {
@@ -47,6 +52,13 @@ class IGNITE_IMPORT_EXPORT Environment : public diagnostic::DiagnosableAdapter {
    */
   ~Environment();
 
+  /**
+   * Get number of environments alive in the process.
+   *
+   * @return Number of environments.
+   */
+  static size_t GetCount();
+
   /**
    * Create connection associated with the environment.
    *
@@ -78,6 +90,44 @@ class IGNITE_IMPORT_EXPORT Environment : public diagnostic::DiagnosableAdapter {
    */
   void GetAttribute(int32_t attr, app::ApplicationDataBuffer& buffer);
 
+  /**
+   * Get memory governor shared by all connections of the environment.
+   *
+   * @return Memory governor.
+   */
+  const std::shared_ptr< MemoryGovernor >& GetMemoryGovernor() const {
+    return memoryGovernor_;
+  }
+
+  /**
+   * Get result cache shared by all connections of the environment.
+   *
+   * @return Result cache.
+   */
+  const std::shared_ptr< ResultCache >& GetResultCache() const {
+    return resultCache_;
+  }
+
+  /**
+   * Get registry of the queries running on the connections of the
+   * environment.
+   *
+   * @return Shared query registry.
+   */
+  const std::shared_ptr< SharedQueryRegistry >& GetSharedQueries() const {
+    return sharedQueries_;
+  }
+
+  /**
+   * Get catalog metadata cache shared by all connections of the
+   * environment.
+   *
+   * @return Metadata cache.
+   */
+  const std::shared_ptr< MetadataCache >& GetMetadataCache() const {
+    return metadataCache_;
+  }
+
  protected:
   /**
    * Create connection associated with the environment.
@@ -121,6 +171,18 @@ class IGNITE_IMPORT_EXPORT Environment : public diagnostic::DiagnosableAdapter {
 
   /** ODBC null-termintaion of string behaviour. */
   int32_t odbcNts;
+
+  /** Memory governor for result pages of all connections. */
+  std::shared_ptr< MemoryGovernor > memoryGovernor_;
+
+  /** Results of repeated queries of all connections. */
+  std::shared_ptr< ResultCache > resultCache_;
+
+  /** Queries running on the connections, shared by identical ones. */
+  std::shared_ptr< SharedQueryRegistry > sharedQueries_;
+
+  /** Catalog metadata read by the connections. */
+  std::shared_ptr< MetadataCache > metadataCache_;
 };
 }  // namespace odbc
 }  // namespace trino
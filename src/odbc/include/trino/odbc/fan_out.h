@@ -0,0 +1,78 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _TRINO_ODBC_FAN_OUT
+#define _TRINO_ODBC_FAN_OUT
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "trino/odbc/worker_pool.h"
+
+namespace trino {
+namespace odbc {
+/**
+ * Runs a number of independent tasks with bounded parallelism.
+ *
+ * Used for catalog requests that need one query per database or table.
+ * The calling thread runs tasks as well, next to at most limit - 1 helpers
+ * on the worker pool, so a request makes progress even when all workers
+ * are busy. Each task writes only its own result slot, so results are
+ * consumed in task order no matter which thread ran them, and a failing
+ * task does not stop the others. A task that throws is counted as done
+ * and its error is returned in its slot.
+ */
+class IGNITE_IMPORT_EXPORT FanOut {
+ public:
+  /** Task, called with its index. */
+  typedef std::function< void(size_t) > Task;
+
+  /**
+   * Constructor.
+   *
+   * @param limit Maximum number of tasks running at the same time.
+   * @param pool Pool the helpers run on.
+   */
+  explicit FanOut(size_t limit, WorkerPool& pool = WorkerPool::GetInstance());
+
+  /**
+   * Run tasks and wait for all of them to finish.
+   *
+   * @param count Number of tasks.
+   * @param task Task, called once for every index below count.
+   * @return Error messages of the tasks that threw, by task index, empty
+   *     for the others.
+   */
+  std::vector< std::string > Run(size_t count, const Task& task);
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(FanOut);
+
+  /** Maximum number of tasks running at the same time. */
+  const size_t limit_;
+
+  /** Pool the helpers run on. */
+  WorkerPool& pool_;
+};
+}  // namespace odbc
+}  // namespace trino
+
+#endif  //_TRINO_ODBC_FAN_OUT
@@ -21,8 +21,12 @@
 #ifndef _TRINO_ODBC_LOG
 #define _TRINO_ODBC_LOG
 
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -30,57 +34,59 @@
 #include "ignite/common/common.h"
 #include "ignite/common/include/common/concurrent.h"
 #include "trino/odbc/log_level.h"
+#include "trino/odbc/log_queue.h"
 
 using ignite::odbc::common::concurrent::CriticalSection;
 
 #define DEFAULT_LOG_PATH trino::odbc::Logger::GetDefaultLogPath()
 
+// Most verbose log level compiled in, as a LogLevel::Type value. Messages
+// of more verbose levels are removed at compile time.
+#ifndef TRINO_ODBC_COMPILED_LOG_LEVEL
+#define TRINO_ODBC_COMPILED_LOG_LEVEL 4
+#endif
+
 #define WRITE_LOG_MSG(param, logLevel) \
   WRITE_MSG_TO_STREAM(param, logLevel, (std::ostream*)nullptr)
 
 #define WRITE_MSG_TO_STREAM(param, logLevel, logStream)                       \
   {                                                                           \
-    std::shared_ptr< trino::odbc::Logger > p =                           \
-        trino::odbc::Logger::GetLoggerInstance();                        \
-    if (p->GetLogLevel() >= logLevel && (p->IsEnabled() || p->EnableLog())) { \
-      std::ostream* prevStream = p.get()->GetLogStream();                     \
-      if (logStream != nullptr) {                                             \
-        /* Override the stream temporarily */                                 \
-        p.get()->SetLogStream(logStream);                                     \
-      }                                                                       \
-      std::unique_ptr< trino::odbc::LogStream > lstream(                 \
-          new trino::odbc::LogStream(p.get()));                          \
-      std::string msg_prefix;                                                 \
-      switch (logLevel) {                                                     \
-        case trino::odbc::LogLevel::Type::DEBUG_LEVEL:                   \
-          msg_prefix = "DEBUG MSG: ";                                         \
-          break;                                                              \
-        case trino::odbc::LogLevel::Type::INFO_LEVEL:                    \
-          msg_prefix = "INFO MSG: ";                                          \
-          break;                                                              \
-        case trino::odbc::LogLevel::Type::WARNING_LEVEL:                 \
-          msg_prefix = "WARNING MSG: ";                                       \
-          break;                                                              \
-        case trino::odbc::LogLevel::Type::ERROR_LEVEL:                   \
-          msg_prefix = "ERROR MSG: ";                                         \
-          break;                                                              \
-        default:                                                              \
-          msg_prefix = "";                                                    \
-      }                                                                       \
-      char tStr[1000];                                                        \
-      time_t curTime = time(NULL);                                            \
-      struct tm* locTime = localtime(&curTime);                               \
-      strftime(tStr, 1000, "%T %x ", locTime);                                \
-      /* Write the formatted message to the stream */                         \
-      *lstream << "TID: " << std::this_thread::get_id() << " " << tStr        \
-               << msg_prefix << " "                                           \
-               << trino::odbc::Logger::GetBaseFileName(__FILE__) << ":"  \
-               << __LINE__ << " " << __FUNCTION__ << ": " << param;           \
-      /* This will trigger the write to stream */                             \
-      lstream = nullptr;                                                      \
-      if (logStream != nullptr) {                                             \
-        /* Restore the stream if it was set */                                \
-        p.get()->SetLogStream(prevStream);                                    \
+    /* The level is checked before the logger is touched, so a disabled */    \
+    /* message costs one relaxed load */                                      \
+    if (static_cast< int >(logLevel) <= TRINO_ODBC_COMPILED_LOG_LEVEL         \
+        && trino::odbc::Logger::IsLevelEnabled(logLevel)) {                   \
+      std::shared_ptr< trino::odbc::Logger > p =                              \
+          trino::odbc::Logger::GetLoggerInstance();                           \
+      if (p->IsEnabled() || p->EnableLog()) {                                 \
+        /* The target stream is passed along rather than swapped into the */  \
+        /* logger, so concurrent messages keep going to the log file */       \
+        std::unique_ptr< trino::odbc::LogStream > lstream(                    \
+            new trino::odbc::LogStream(p.get(), logStream));                  \
+        std::string msg_prefix;                                               \
+        switch (logLevel) {                                                   \
+          case trino::odbc::LogLevel::Type::DEBUG_LEVEL:                      \
+            msg_prefix = "DEBUG MSG: ";                                       \
+            break;                                                            \
+          case trino::odbc::LogLevel::Type::INFO_LEVEL:                       \
+            msg_prefix = "INFO MSG: ";                                        \
+            break;                                                            \
+          case trino::odbc::LogLevel::Type::WARNING_LEVEL:                    \
+            msg_prefix = "WARNING MSG: ";                                     \
+            break;                                                            \
+          case trino::odbc::LogLevel::Type::ERROR_LEVEL:                      \
+            msg_prefix = "ERROR MSG: ";                                       \
+            break;                                                            \
+          default:                                                            \
+            msg_prefix = "";                                                  \
+        }                                                                     \
+        /* Write the formatted message to the stream */                       \
+        *lstream << "TID: " << std::this_thread::get_id() << " "              \
+                 << trino::odbc::Logger::FormatLocalTime("%T %x ")            \
+                 << msg_prefix << " "                                         \
+                 << trino::odbc::Logger::GetBaseFileName(__FILE__) << ":"     \
+                 << __LINE__ << " " << __FUNCTION__ << ": " << param;         \
+        /* This will trigger the write to stream */                           \
+        lstream = nullptr;                                                    \
       }                                                                       \
     }                                                                         \
   }
@@ -131,8 +137,10 @@ class IGNITE_IMPORT_EXPORT LogStream : public std::basic_ostream< char > {
   /**
    * Constructor.
    * @param parent pointer to Logger.
+   * @param target Stream to write to instead of the logger stream, may be
+   *     null.
    */
-  LogStream(Logger* parent);
+  LogStream(Logger* parent, std::ostream* target = nullptr);
 
   /**
    * Conversion operator helpful to determine if log is enabled
@@ -153,17 +161,33 @@ class IGNITE_IMPORT_EXPORT LogStream : public std::basic_ostream< char > {
 
   /** Parent logger object */
   Logger* logger;
+
+  /** Target stream, null for the logger stream */
+  std::ostream* target;
 };
 
 /**
  * Logging facility.
+ *
+ * Messages for the log file are queued and written by a background thread
+ * in batches, so logging threads neither wait for the disk nor for each
+ * other. When the queue is full, messages either wait for room or are
+ * dropped and counted, as configured. The log file is rotated once it
+ * reaches the configured size. Messages for other streams are written
+ * right away.
  */
 class Logger {
  public:
+  /** Number of messages the queue holds. */
+  static const size_t QUEUE_CAPACITY = 8192;
+
+  /** Number of rotated log files kept. */
+  static const int ROTATED_FILES = 5;
+
   /**
-   * Destructor.
+   * Destructor. Writes the queued messages.
    */
-  ~Logger() = default;
+  ~Logger();
 
   /**
    * Set the logger's set log level.
@@ -180,6 +204,32 @@ class Logger {
    */
   void SetLogStream(std::ostream* stream);
 
+  /**
+   * Set the size the log file is rotated at.
+   * @param size Size in bytes, 0 to never rotate.
+   */
+  void SetMaxFileSize(uint64_t size);
+
+  /**
+   * Set what happens to messages when the queue is full.
+   * @param drop True to drop them, false to wait for room.
+   */
+  void SetDropOnOverflow(bool drop);
+
+  /**
+   * Get number of messages dropped because the queue was full.
+   * @return Number of messages.
+   */
+  int64_t GetDroppedCount() const {
+    return dropped.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Write the queued messages and stop the writer thread. The thread is
+   * started again by the next message.
+   */
+  void Flush();
+
   /**
    * Gets the current stream to use for logging.
    * Be careful to use this ostream. It is not
@@ -187,7 +237,7 @@ class Logger {
    * be protected by lock.
    */
   std::ostream* GetLogStream() {
-    return stream;
+    return stream.load();
   }
 
   /**
@@ -202,17 +252,38 @@ class Logger {
    * @return Logger instance.
    */
   static std::shared_ptr< Logger > GetLoggerInstance() {
-    if (!logger_) {
+    std::shared_ptr< Logger > logger = std::atomic_load(&logger_);
+    if (!logger) {
       // avoid to be created multiple times for multi-thread execution
       ignite::odbc::common::concurrent::CsLockGuard guard(mutexForCreation);
-      if (!logger_) {
-        logger_ = std::shared_ptr< Logger >(new Logger());
+      logger = std::atomic_load(&logger_);
+      if (!logger) {
+        logger = std::shared_ptr< Logger >(new Logger());
+        std::atomic_store(&logger_, logger);
       }
     }
 
-    return logger_;
+    return logger;
   }
 
+  /**
+   * Check whether messages of a level are logged. Cheap enough to be called
+   * before every message.
+   * @param level Message level.
+   * @return True, if the log level allows the messages.
+   */
+  static bool IsLevelEnabled(LogLevel::Type level) {
+    return static_cast< int >(level)
+           <= logLevel.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Format the current local time. Safe to call from several threads.
+   * @param format Format as accepted by strftime.
+   * @return Formatted time.
+   */
+  static std::string FormatLocalTime(const char* format);
+
   /**
    * Get a file base name without path.
    * @return File base name.
@@ -265,8 +336,10 @@ class Logger {
   /**
    * Outputs the message to log file
    * @param message The message to write
+   * @param target Stream to write to instead of the log file, may be null
    */
-  void WriteMessage(std::string const& message);
+  void WriteMessage(std::string const& message,
+                    std::ostream* target = nullptr);
 
  private:
   static std::shared_ptr< Logger > logger_;  // a singleton instance
@@ -282,6 +355,35 @@ class Logger {
    */
   std::string CreateFileName() const;
 
+  /**
+   * Queue a message for the log file.
+   * @param message The message to write
+   */
+  void Enqueue(std::string message);
+
+  /**
+   * Start the writer thread unless it is running.
+   */
+  void StartWriter();
+
+  /**
+   * Body of the writer thread.
+   */
+  void RunWriter();
+
+  /**
+   * Write a batch of messages to the log stream, rotating the log file if
+   * needed. The write lock must be held.
+   * @param batch Messages, one per line.
+   */
+  void WriteBatch(const std::string& batch);
+
+  /**
+   * Move the log file aside and start a new one. The write lock must be
+   * held.
+   */
+  void RotateFile();
+
   IGNITE_NO_COPY_ASSIGNMENT(Logger);
 
   /** Mutex for writes synchronization. */
@@ -297,19 +399,55 @@ class Logger {
   std::ofstream fileStream;
 
   /** Reference to logging stream */
-  std::ostream* stream = nullptr;
+  std::atomic< std::ostream* > stream{nullptr};
 
   /** Log folder path */
   std::string logPath = DEFAULT_LOG_PATH;
 
-  /** Log Level */
-  LogLevel::Type logLevel = LogLevel::Type::WARNING_LEVEL;
+  /** Log level, kept as an integer so the macros can read it lock-free. */
+  static std::atomic< int > logLevel;
 
   /** Log file name */
   std::string logFileName;
 
   /** Log file path */
   std::string logFilePath;
+
+  /** Size of the log file in bytes. */
+  uint64_t fileSize = 0;
+
+  /** Size the log file is rotated at, 0 for never. */
+  std::atomic< uint64_t > maxFileSize{0};
+
+  /** Drop messages when the queue is full instead of waiting. */
+  std::atomic< bool > dropOnOverflow{false};
+
+  /** Number of dropped messages. */
+  std::atomic< int64_t > dropped{0};
+
+  /** Messages waiting for the writer thread. */
+  LogQueue queue{QUEUE_CAPACITY};
+
+  /** Writer thread. */
+  std::thread writer;
+
+  /** Whether the writer thread is running. */
+  std::atomic< bool > writerRunning{false};
+
+  /** Whether the writer thread waits for messages. */
+  std::atomic< bool > writerSleeping{false};
+
+  /** Whether the writer thread is asked to stop. */
+  bool stopping = false;
+
+  /** Mutex serializing starting and stopping the writer thread. */
+  std::mutex controlMutex;
+
+  /** Mutex guarding the writer thread state. */
+  std::mutex writerMutex;
+
+  /** Signalled when messages are queued or the writer is stopped. */
+  std::condition_variable writerCv;
 };
 
 }  // namespace odbc
@@ -0,0 +1,123 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _TRINO_ODBC_LOG_QUEUE
+#define _TRINO_ODBC_LOG_QUEUE
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include <ignite/common/common.h>
+
+namespace trino {
+namespace odbc {
+/**
+ * Bounded queue of log messages written by many threads and read by one.
+ *
+ * The queue is a ring of cells, each carrying a sequence number that tells
+ * whether the cell is free for the writer claiming its position or holds a
+ * message for the reader. Writers claim positions with a compare-and-swap,
+ * so pushing takes no lock and never waits for the reader. A full queue
+ * rejects the message and leaves the choice to the caller.
+ */
+class IGNITE_IMPORT_EXPORT LogQueue {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param capacity Number of messages held, rounded up to a power of two.
+   */
+  explicit LogQueue(size_t capacity);
+
+  /**
+   * Add a message. Safe to call from several threads.
+   *
+   * @param message Message, moved from on success.
+   * @return @c false if the queue is full.
+   */
+  bool TryPush(std::string& message);
+
+  /**
+   * Take the oldest message. Must only be called by one thread at a time.
+   *
+   * @param message Message, set on success.
+   * @return @c false if there is no message ready.
+   */
+  bool TryPop(std::string& message);
+
+  /**
+   * Get number of positions claimed by writers so far. Messages of claimed
+   * positions may not be ready yet.
+   *
+   * @return Number of positions.
+   */
+  size_t GetPushed() const {
+    return enqueuePos_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Get number of messages taken so far.
+   *
+   * @return Number of messages.
+   */
+  size_t GetPopped() const {
+    return dequeuePos_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Get number of messages held at most.
+   *
+   * @return Capacity.
+   */
+  size_t GetCapacity() const {
+    return mask_ + 1;
+  }
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(LogQueue);
+
+  /** Slot of the ring. */
+  struct Cell {
+    /** Position the cell is free or ready for. */
+    std::atomic< size_t > sequence;
+
+    /** Message. */
+    std::string message;
+  };
+
+  /** Cells. */
+  std::unique_ptr< Cell[] > cells_;
+
+  /** Capacity minus one, the capacity is a power of two. */
+  size_t mask_;
+
+  /** Next position to write. */
+  std::atomic< size_t > enqueuePos_;
+
+  /** Next position to read. */
+  std::atomic< size_t > dequeuePos_;
+};
+}  // namespace odbc
+}  // namespace trino
+
+#endif  //_TRINO_ODBC_LOG_QUEUE
@@ -0,0 +1,177 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _TRINO_ODBC_MEMORY_GOVERNOR
+#define _TRINO_ODBC_MEMORY_GOVERNOR
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <ignite/common/common.h>
+
+namespace trino {
+namespace odbc {
+/**
+ * Memory budget for decoded result pages.
+ *
+ * Governors form a tree: the environment owns the root and every
+ * connection owns a child of it. Bytes reserved on a child are charged to
+ * all of its ancestors, so a child is over budget when it or any ancestor
+ * exceeds its limit. Reserving never blocks; prefetching threads call
+ * WaitForBudget() before requesting the next page, which is how the
+ * budget turns into backpressure.
+ */
+class IGNITE_IMPORT_EXPORT MemoryGovernor {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param limit Limit in bytes, zero means no limit.
+   * @param parent Parent governor, null for the root.
+   */
+  explicit MemoryGovernor(
+      int64_t limit = 0,
+      std::shared_ptr< MemoryGovernor > parent = nullptr);
+
+  /**
+   * Destructor.
+   */
+  ~MemoryGovernor() = default;
+
+  /**
+   * Set limit.
+   *
+   * @param limit Limit in bytes, zero means no limit.
+   */
+  void SetLimit(int64_t limit);
+
+  /**
+   * Get limit.
+   *
+   * @return Limit in bytes, zero means no limit.
+   */
+  int64_t GetLimit() const {
+    return limit_.load();
+  }
+
+  /**
+   * Get number of bytes currently reserved.
+   *
+   * @return Reserved bytes.
+   */
+  int64_t GetUsage() const {
+    return usage_.load();
+  }
+
+  /**
+   * Get the highest number of bytes reserved at once.
+   *
+   * @return Peak reserved bytes.
+   */
+  int64_t GetPeakUsage() const {
+    return peak_.load();
+  }
+
+  /**
+   * Get number of times a prefetching thread had to wait for budget.
+   *
+   * @return Number of waits.
+   */
+  int64_t GetThrottledCount() const {
+    return throttled_.load();
+  }
+
+  /**
+   * Reserve bytes on this governor and all of its ancestors.
+   *
+   * @param bytes Number of bytes.
+   */
+  void Reserve(int64_t bytes);
+
+  /**
+   * Release bytes reserved by Reserve() and wake up waiting threads.
+   *
+   * @param bytes Number of bytes.
+   */
+  void Release(int64_t bytes);
+
+  /**
+   * Check if this governor or any of its ancestors is over its limit.
+   *
+   * @return @c true if over budget.
+   */
+  bool IsOverBudget() const;
+
+  /**
+   * Block the calling thread while the governor is over budget.
+   *
+   * @param proceed Predicate that lets the thread go regardless of the
+   *     budget, e.g. because the statement is closing or its consumer has
+   *     run out of rows. Checked under the governor lock, so the flags it
+   *     reads must be set before Notify() is called.
+   */
+  void WaitForBudget(const std::function< bool() >& proceed);
+
+  /**
+   * Wake up all threads waiting for budget so they re-check their
+   * predicates.
+   */
+  void Notify();
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(MemoryGovernor);
+
+  /**
+   * Get the root of the governor tree, which owns the wait lock.
+   *
+   * @return Root governor.
+   */
+  MemoryGovernor& GetRoot();
+
+  /** Parent governor. */
+  std::shared_ptr< MemoryGovernor > parent_;
+
+  /** Limit in bytes. */
+  std::atomic< int64_t > limit_;
+
+  /** Reserved bytes. */
+  std::atomic< int64_t > usage_;
+
+  /** Peak reserved bytes. */
+  std::atomic< int64_t > peak_;
+
+  /** Number of waits. */
+  std::atomic< int64_t > throttled_;
+
+  /** Wait lock, only used on the root. */
+  std::mutex mutex_;
+
+  /** Wait condition, only used on the root. */
+  std::condition_variable cv_;
+};
+}  // namespace odbc
+}  // namespace trino
+
+#endif  //_TRINO_ODBC_MEMORY_GOVERNOR
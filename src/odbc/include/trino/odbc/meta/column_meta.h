@@ -226,6 +226,17 @@ class IGNITE_IMPORT_EXPORT ColumnMeta {
   void Read(trino::odbc::app::ColumnBindingMap& columnBindings,
             int32_t position);
 
+  /**
+   * Read from the values of a column listing.
+   * @param name the column name.
+   * @param type the data type name.
+   * @param extra the remarks.
+   * @param nullable whether the column is known to be nullable.
+   * @param position the ordinal position of the column.
+   */
+  void Read(const std::string& name, const std::string& type,
+            const std::string& extra, bool nullable, int32_t position);
+
   /**
    * Read using reader.
    * @param trinoVector Vector containing metadata for one row.
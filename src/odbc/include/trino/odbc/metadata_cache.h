@@ -0,0 +1,430 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _TRINO_ODBC_METADATA_CACHE
+#define _TRINO_ODBC_METADATA_CACHE
+
+#include <stdint.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <ignite/common/common.h>
+
+namespace trino {
+namespace odbc {
+/**
+ * Catalog metadata read by SQLTables and SQLColumns, shared by the
+ * connections of an environment so repeated catalog browsing does not go
+ * to the server.
+ *
+ * Database lists, table listings, table columns and column listings are
+ * kept per session identity until the time to live of the connection that
+ * stored them runs out. Empty lists are kept as well, so looking up a
+ * missing object again is answered from the cache too. Least recently used
+ * entries are dropped once there are more than MAX_ENTRIES of them.
+ *
+ * The live entries of an identity can be saved to a snapshot file and
+ * loaded back by a later process, so catalog browsing is answered locally
+ * right after connecting. Entries keep their expiry time across the
+ * snapshot. Snapshots are written to a temporary file that then replaces
+ * the previous one, so concurrent writers and readers never see a partial
+ * file.
+ *
+ * Entries can be marked as being loaded, e.g. by a prefetch. A lookup of
+ * such an entry waits for the load instead of querying the server for the
+ * same metadata again.
+ */
+class IGNITE_IMPORT_EXPORT MetadataCache {
+ public:
+  /** Table of a database. */
+  struct Table {
+    /** Database name. */
+    std::string database;
+
+    /** Table name. */
+    std::string name;
+  };
+
+  /** Column of a table. */
+  struct Column {
+    /** Constructor. */
+    Column() : nullable(false), position(0) {
+      // No-op.
+    }
+
+    /** Database name. */
+    std::string database;
+
+    /** Table name. */
+    std::string table;
+
+    /** Column name. */
+    std::string name;
+
+    /** Data type name. */
+    std::string dataType;
+
+    /** Remarks. */
+    std::string remarks;
+
+    /** Whether the column is known to be nullable. */
+    bool nullable;
+
+    /** Ordinal position of the column in its table, from one. */
+    int32_t position;
+  };
+
+  /** Largest number of entries kept. */
+  static const size_t MAX_ENTRIES = 4096;
+
+  /** Version of the snapshot file format. */
+  static const uint32_t SNAPSHOT_VERSION = 2;
+
+  /** Longest time in seconds a lookup waits for an entry being loaded. */
+  static const int32_t LOAD_WAIT = 60;
+
+  /**
+   * Constructor.
+   */
+  MetadataCache();
+
+  /**
+   * Look up the databases matching a pattern.
+   *
+   * @param identity Identity of the session.
+   * @param pattern Database name pattern.
+   * @param names Database names, set on success.
+   * @return @c true if a live entry is found.
+   */
+  bool GetDatabases(const std::string& identity, const std::string& pattern,
+                    std::vector< std::string >& names);
+
+  /**
+   * Store the databases matching a pattern.
+   *
+   * @param identity Identity of the session.
+   * @param pattern Database name pattern.
+   * @param names Database names, may be empty.
+   * @param ttl Time to live in seconds.
+   */
+  void PutDatabases(const std::string& identity, const std::string& pattern,
+                    const std::vector< std::string >& names, int32_t ttl);
+
+  /**
+   * Look up the tables matching search patterns.
+   *
+   * @param identity Identity of the session.
+   * @param databasePattern Database name pattern.
+   * @param tablePattern Table name pattern.
+   * @param tables Tables ordered by database and name, set on success.
+   * @return @c true if a live entry is found.
+   */
+  bool GetTables(const std::string& identity,
+                 const std::string& databasePattern,
+                 const std::string& tablePattern,
+                 std::vector< Table >& tables);
+
+  /**
+   * Store the tables matching search patterns.
+   *
+   * @param identity Identity of the session.
+   * @param databasePattern Database name pattern.
+   * @param tablePattern Table name pattern.
+   * @param tables Tables ordered by database and name, may be empty.
+   * @param ttl Time to live in seconds.
+   */
+  void PutTables(const std::string& identity,
+                 const std::string& databasePattern,
+                 const std::string& tablePattern,
+                 const std::vector< Table >& tables, int32_t ttl);
+
+  /**
+   * Look up the tables matching case-insensitive identifiers.
+   *
+   * @param identity Identity of the session.
+   * @param database Database identifier.
+   * @param table Table identifier.
+   * @param tables Tables ordered by database and name, set on success.
+   * @return @c true if a live entry is found.
+   */
+  bool GetTablesByName(const std::string& identity,
+                       const std::string& database, const std::string& table,
+                       std::vector< Table >& tables);
+
+  /**
+   * Store the tables matching case-insensitive identifiers.
+   *
+   * @param identity Identity of the session.
+   * @param database Database identifier.
+   * @param table Table identifier.
+   * @param tables Tables ordered by database and name, may be empty.
+   * @param ttl Time to live in seconds.
+   */
+  void PutTablesByName(const std::string& identity,
+                       const std::string& database, const std::string& table,
+                       const std::vector< Table >& tables, int32_t ttl);
+
+  /**
+   * Look up the columns of a table.
+   *
+   * @param identity Identity of the session.
+   * @param database Database name.
+   * @param table Table name.
+   * @param columns Columns in table order, set on success.
+   * @return @c true if a live entry is found.
+   */
+  bool GetColumns(const std::string& identity, const std::string& database,
+                  const std::string& table, std::vector< Column >& columns);
+
+  /**
+   * Store the columns of a table.
+   *
+   * @param identity Identity of the session.
+   * @param database Database name.
+   * @param table Table name.
+   * @param columns Columns in table order, may be empty.
+   * @param ttl Time to live in seconds.
+   */
+  void PutColumns(const std::string& identity, const std::string& database,
+                  const std::string& table,
+                  const std::vector< Column >& columns, int32_t ttl);
+
+  /**
+   * Look up the columns matching search patterns.
+   *
+   * @param identity Identity of the session.
+   * @param databasePattern Database name pattern.
+   * @param tablePattern Table name pattern.
+   * @param columnPattern Column name pattern.
+   * @param columns Columns ordered by database, table and position, set on
+   *     success.
+   * @return @c true if a live entry is found.
+   */
+  bool GetColumnListing(const std::string& identity,
+                        const std::string& databasePattern,
+                        const std::string& tablePattern,
+                        const std::string& columnPattern,
+                        std::vector< Column >& columns);
+
+  /**
+   * Store the columns matching search patterns.
+   *
+   * @param identity Identity of the session.
+   * @param databasePattern Database name pattern.
+   * @param tablePattern Table name pattern.
+   * @param columnPattern Column name pattern.
+   * @param columns Columns ordered by database, table and position, may be
+   *     empty.
+   * @param ttl Time to live in seconds.
+   */
+  void PutColumnListing(const std::string& identity,
+                        const std::string& databasePattern,
+                        const std::string& tablePattern,
+                        const std::string& columnPattern,
+                        const std::vector< Column >& columns, int32_t ttl);
+
+  /**
+   * Mark the databases matching a pattern as being loaded.
+   *
+   * @param identity Identity of the session.
+   * @param pattern Database name pattern.
+   */
+  void BeginDatabasesLoad(const std::string& identity,
+                          const std::string& pattern);
+
+  /**
+   * Mark the tables matching search patterns as being loaded.
+   *
+   * @param identity Identity of the session.
+   * @param databasePattern Database name pattern.
+   * @param tablePattern Table name pattern.
+   */
+  void BeginTablesLoad(const std::string& identity,
+                       const std::string& databasePattern,
+                       const std::string& tablePattern);
+
+  /**
+   * End the loads of a session identity. Lookups waiting for entries that
+   * were not stored give up and miss.
+   *
+   * @param identity Identity of the session.
+   */
+  void EndLoads(const std::string& identity);
+
+  /**
+   * Save the live entries of a session identity to a snapshot file.
+   *
+   * @param identity Identity of the session.
+   * @param path Path of the snapshot file, replaced if it exists.
+   * @return @c true on success.
+   */
+  bool Save(const std::string& identity, const std::string& path) const;
+
+  /**
+   * Load the entries of a snapshot file for a session identity. Entries
+   * that expired in the meantime and entries already in the cache are
+   * skipped.
+   *
+   * @param identity Identity of the session.
+   * @param path Path of the snapshot file.
+   * @return Number of loaded entries.
+   */
+  size_t Load(const std::string& identity, const std::string& path);
+
+  /**
+   * Make the file name of the snapshot of a data source and identity.
+   *
+   * @param dsn Data source name.
+   * @param identity Identity of the session.
+   * @return File name.
+   */
+  static std::string MakeSnapshotName(const std::string& dsn,
+                                      const std::string& identity);
+
+  /**
+   * Drop all entries of a session identity.
+   *
+   * @param identity Identity of the session.
+   */
+  void Invalidate(const std::string& identity);
+
+  /**
+   * Drop all entries.
+   */
+  void Clear();
+
+  /**
+   * Get number of entries.
+   *
+   * @return Number of entries.
+   */
+  size_t GetSize() const;
+
+  /**
+   * Get number of lookups that found an entry.
+   *
+   * @return Number of hits.
+   */
+  int64_t GetHitCount() const;
+
+  /**
+   * Get number of lookups that did not find an entry.
+   *
+   * @return Number of misses.
+   */
+  int64_t GetMissCount() const;
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(MetadataCache);
+
+  /** Stored entry. */
+  struct Slot {
+    /** Key. */
+    std::string key;
+
+    /** Values, row by row. */
+    std::vector< std::string > values;
+
+    /** Time the entry expires. */
+    std::chrono::steady_clock::time_point expiry;
+  };
+
+  /**
+   * Make the key of an entry.
+   *
+   * @param identity Identity of the session.
+   * @param kind Kind of the entry.
+   * @param first First name of the entry.
+   * @param second Second name of the entry.
+   * @return Key.
+   */
+  static std::string MakeKey(const std::string& identity, char kind,
+                             const std::string& first,
+                             const std::string& second);
+
+  /**
+   * Mark an entry as being loaded.
+   *
+   * @param key Key.
+   */
+  void BeginLoad(const std::string& key);
+
+  /**
+   * Look up an entry and mark it as most recently used. Waits for the entry
+   * if it is being loaded.
+   *
+   * @param key Key.
+   * @param values Values, set on success.
+   * @return @c true if a live entry is found.
+   */
+  bool Get(const std::string& key, std::vector< std::string >& values);
+
+  /**
+   * Store an entry.
+   *
+   * @param key Key.
+   * @param values Values.
+   * @param ttl Time to live in seconds.
+   */
+  void Put(const std::string& key, std::vector< std::string > values,
+           int32_t ttl);
+
+  /**
+   * Store an entry, the lock must be held.
+   *
+   * @param key Key.
+   * @param values Values.
+   * @param expiry Time the entry expires.
+   */
+  void Insert(const std::string& key, std::vector< std::string > values,
+              std::chrono::steady_clock::time_point expiry);
+
+  /** Number of hits. */
+  int64_t hits_;
+
+  /** Number of misses. */
+  int64_t misses_;
+
+  /** Entries, most recently used first. */
+  std::list< Slot > slots_;
+
+  /** Position of every entry in the list, keyed by key. */
+  std::unordered_map< std::string, std::list< Slot >::iterator > index_;
+
+  /** Keys of the entries being loaded. */
+  std::unordered_set< std::string > loading_;
+
+  /** Lock guarding all of the above. */
+  mutable std::mutex mutex_;
+
+  /** Signalled when a load ends. */
+  std::condition_variable loaded_;
+};
+}  // namespace odbc
+}  // namespace trino
+
+#endif  //_TRINO_ODBC_METADATA_CACHE
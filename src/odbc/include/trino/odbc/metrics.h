@@ -0,0 +1,306 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _TRINO_ODBC_METRICS
+#define _TRINO_ODBC_METRICS
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+
+#include <ignite/common/common.h>
+
+#include "trino/odbc/app/application_data_buffer.h"
+
+namespace trino {
+namespace odbc {
+/**
+ * Process-wide registry of driver metrics.
+ *
+ * Every metric is a set of atomics updated with relaxed operations, so
+ * recording takes no lock. The registry is read as Prometheus text, through
+ * a driver-specific connection attribute or from a file the registry
+ * rewrites periodically for the node exporter textfile collector.
+ */
+class IGNITE_IMPORT_EXPORT Metrics {
+ public:
+  /** Monotonic counter. */
+  class Counter {
+   public:
+    /**
+     * Constructor.
+     */
+    Counter() : value_(0) {
+      // No-op.
+    }
+
+    /**
+     * Add to the counter.
+     *
+     * @param n Amount.
+     */
+    void Add(uint64_t n = 1) {
+      value_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the value.
+     *
+     * @return Value.
+     */
+    uint64_t Get() const {
+      return value_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    IGNITE_NO_COPY_ASSIGNMENT(Counter);
+
+    /** Value. */
+    std::atomic< uint64_t > value_;
+  };
+
+  /** Value that goes up and down. */
+  class Gauge {
+   public:
+    /**
+     * Constructor.
+     */
+    Gauge() : value_(0) {
+      // No-op.
+    }
+
+    /**
+     * Add to the gauge.
+     *
+     * @param n Amount, may be negative.
+     */
+    void Add(int64_t n) {
+      value_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the value.
+     *
+     * @return Value.
+     */
+    int64_t Get() const {
+      return value_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    IGNITE_NO_COPY_ASSIGNMENT(Gauge);
+
+    /** Value. */
+    std::atomic< int64_t > value_;
+  };
+
+  /**
+   * Latency histogram with logarithmic buckets. Bucket i counts durations
+   * of at most 2^i microseconds, so the relative error of any quantile
+   * read from it is below a factor of two over the whole range.
+   */
+  class Histogram {
+   public:
+    /** Number of buckets with an upper bound, from 1 us to about 67 s. */
+    static const size_t BUCKET_COUNT = 27;
+
+    /**
+     * Constructor.
+     */
+    Histogram();
+
+    /**
+     * Record a duration.
+     *
+     * @param duration Duration.
+     */
+    void Record(std::chrono::steady_clock::duration duration);
+
+    /**
+     * Get number of recorded durations of a bucket, not cumulative.
+     *
+     * @param idx Bucket index, BUCKET_COUNT for the durations above the
+     *     last bound.
+     * @return Number of durations.
+     */
+    uint64_t GetBucket(size_t idx) const {
+      return buckets_[idx].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get number of recorded durations.
+     *
+     * @return Number of durations.
+     */
+    uint64_t GetCount() const {
+      return count_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get sum of recorded durations.
+     *
+     * @return Sum in microseconds.
+     */
+    uint64_t GetSumMicros() const {
+      return sum_.load(std::memory_order_relaxed);
+    }
+
+   private:
+    IGNITE_NO_COPY_ASSIGNMENT(Histogram);
+
+    /** Durations per bucket, the last one is unbounded. */
+    std::atomic< uint64_t > buckets_[BUCKET_COUNT + 1];
+
+    /** Number of durations. */
+    std::atomic< uint64_t > count_;
+
+    /** Sum of durations in microseconds. */
+    std::atomic< uint64_t > sum_;
+  };
+
+  /** Number of conversion result types. */
+  static const size_t CONVERSION_RESULT_COUNT =
+      static_cast< size_t >(app::ConversionResult::Type::AI_FAILURE) + 1;
+
+  /**
+   * Get the driver-wide instance.
+   *
+   * @return Metrics.
+   */
+  static Metrics& GetInstance();
+
+  /**
+   * Constructor.
+   */
+  Metrics();
+
+  /**
+   * Format all metrics in the Prometheus text exposition format.
+   *
+   * @return Metrics text.
+   */
+  std::string ToPrometheusText() const;
+
+  /**
+   * Write the metrics to a file, replacing it at once.
+   *
+   * @param path File path.
+   * @return @c true on success.
+   */
+  bool WriteFile(const std::string& path) const;
+
+  /**
+   * Rewrite a metrics file periodically. A later call replaces the file
+   * and the interval of an earlier one.
+   *
+   * @param path File path.
+   * @param interval Interval between writes.
+   */
+  void StartExport(const std::string& path, std::chrono::seconds interval);
+
+  /**
+   * Record a result page received from the server.
+   *
+   * @param fetch Time the request for the page took.
+   * @param bytes Decoded size of the page.
+   */
+  void RecordPage(std::chrono::steady_clock::duration fetch, size_t bytes) {
+    pagesFetched.Add();
+    bytesReceived.Add(bytes);
+    pageFetchLatency.Record(fetch);
+  }
+
+  /** Data queries started. */
+  Counter queriesStarted;
+
+  /** Data queries that failed or timed out. */
+  Counter queriesFailed;
+
+  /** Result pages fetched from the server. */
+  Counter pagesFetched;
+
+  /** Decoded bytes of the fetched pages. */
+  Counter bytesReceived;
+
+  /** Rows read into bound application buffers. */
+  Counter rowsConverted;
+
+  /** Conversions by result type, only the unsuccessful ones are counted. */
+  Counter conversionErrors[CONVERSION_RESULT_COUNT];
+
+  /** Worker threads started. */
+  Gauge workerThreads;
+
+  /** Worker threads running a task. */
+  Gauge workersBusy;
+
+  /** Page arenas allocated. */
+  Counter arenasCreated;
+
+  /** Page arenas taken from a pool. */
+  Counter arenasReused;
+
+  /** Queries answered by a result cache. */
+  Counter resultCacheHits;
+
+  /** Cacheable queries not found in a result cache. */
+  Counter resultCacheMisses;
+
+  /** Lookups answered by a metadata cache. */
+  Counter metadataCacheHits;
+
+  /** Lookups not found in a metadata cache. */
+  Counter metadataCacheMisses;
+
+  /** Time from the start of a query until its first page was read. */
+  Histogram executeLatency;
+
+  /** Time requests for result pages took. */
+  Histogram pageFetchLatency;
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(Metrics);
+
+  /**
+   * Write the export file and schedule the next write.
+   *
+   * @param generation Export generation the write belongs to.
+   */
+  void Export(uint64_t generation);
+
+  /** Lock guarding the export settings. */
+  mutable std::mutex exportMutex_;
+
+  /** Export file path. */
+  std::string exportPath_;
+
+  /** Interval between writes of the export file. */
+  std::chrono::seconds exportInterval_;
+
+  /** Export settings generation, bumped to drop scheduled writes. */
+  uint64_t exportGeneration_;
+};
+}  // namespace odbc
+}  // namespace trino
+
+#endif  //_TRINO_ODBC_METRICS
@@ -0,0 +1,376 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _TRINO_ODBC_PAGE_ARENA
+#define _TRINO_ODBC_PAGE_ARENA
+
+#include <stdint.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "trino/odbc/memory_governor.h"
+#include "trino/odbc/meta/column_meta.h"
+
+/*#*/
+#include <aws/core/utils/memory/stl/AWSVector.h>
+#include <aws/trino-query/model/Row.h>
+
+/** Default number of idle arenas kept by a statement. */
+#define DEFAULT_PAGE_ARENA_POOL_SIZE 2
+
+namespace trino {
+namespace odbc {
+/**
+ * Decoded value of one result set cell.
+ */
+struct PageCell {
+  /** Kind of the decoded value. */
+  struct Kind {
+    enum Type {
+      /** Datum holds a null value. */
+      NULL_VALUE,
+
+      /** Datum holds a scalar value, stored as received. */
+      SCALAR,
+
+      /** Datum holds a nested value, stored rendered to text. */
+      TEXT,
+
+      /** Datum holds a row value without data. */
+      NO_DATA,
+
+      /** Datum holds no value the driver knows about. */
+      UNSUPPORTED
+    };
+  };
+
+  /** Kind of the value. */
+  Kind::Type kind;
+
+  /** Offset of the value in the arena data buffer. */
+  uint32_t offset;
+
+  /** Length of the value in bytes, not including terminating zero. */
+  uint32_t length;
+};
+
+/**
+ * Reusable storage for one decoded result page.
+ *
+ * All values of a page are copied into a single character buffer and
+ * addressed through a flat cell table, so a page costs two allocations
+ * no matter how many rows and columns it has. Reset() drops the content
+ * but keeps the capacity, so a recycled arena decodes the next page of a
+ * similar size without touching the heap.
+ */
+class IGNITE_IMPORT_EXPORT PageArena {
+ public:
+  /**
+   * Constructor.
+   */
+  PageArena();
+
+  /**
+   * Destructor.
+   */
+  ~PageArena() = default;
+
+  /**
+   * Decode rows of a result page into the arena. Previous content is
+   * dropped.
+   *
+   * @param rows Rows of the page.
+   * @param columnMetadataVec Column metadata of the result set.
+   */
+  void Decode(const Aws::Vector< client::TrinoQuery::Model::Row >& rows, /*#*/
+              const meta::ColumnMetaVector& columnMetadataVec);
+
+  /**
+   * Drop the content of the arena, keeping the allocated capacity.
+   */
+  void Reset();
+
+  /**
+   * Start a new row. Used by Decode() and by tests.
+   */
+  void BeginRow();
+
+  /**
+   * Append a cell to the current row.
+   *
+   * @param kind Kind of the value.
+   * @param value Value data.
+   * @param length Value length.
+   */
+  void AddCell(PageCell::Kind::Type kind, const char* value, size_t length);
+
+  /**
+   * Get number of rows in the arena.
+   *
+   * @return Number of rows.
+   */
+  size_t GetRowCount() const {
+    return rowCount_;
+  }
+
+  /**
+   * Get number of columns in the arena.
+   *
+   * @return Number of columns.
+   */
+  size_t GetColumnCount() const {
+    return columnCount_;
+  }
+
+  /**
+   * Get a cell.
+   *
+   * @param rowIdx Row index, starts at 0.
+   * @param columnIdx Column index, starts at 0.
+   * @return Pointer to the cell or nullptr if it is out of range.
+   */
+  const PageCell* GetCell(size_t rowIdx, size_t columnIdx) const;
+
+  /**
+   * Get value data of a cell.
+   *
+   * @param cell Cell.
+   * @return Zero-terminated value data.
+   */
+  const char* GetValue(const PageCell& cell) const {
+    return data_.data() + cell.offset;
+  }
+
+  /**
+   * Get number of bytes used by the current content.
+   *
+   * @return Used bytes.
+   */
+  size_t GetUsedBytes() const;
+
+  /**
+   * Get number of bytes allocated by the arena.
+   *
+   * @return Reserved bytes.
+   */
+  size_t GetReservedBytes() const;
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(PageArena);
+
+  /** Value data of all cells, each value is zero-terminated. */
+  std::vector< char > data_;
+
+  /** Cells, row by row. */
+  std::vector< PageCell > cells_;
+
+  /** Offsets of the first cell of each row in cells_. */
+  std::vector< uint32_t > rowOffsets_;
+
+  /** Number of rows. */
+  size_t rowCount_;
+
+  /** Number of columns. */
+  size_t columnCount_;
+};
+
+class ResultPage;
+
+/**
+ * Small pool of page arenas owned by one statement.
+ *
+ * The pool is held through a shared pointer, so pages that outlive the
+ * statement can still find out whether their arena has a home to return to.
+ * Decoded pages are charged to the memory governor of the pool for as long
+ * as they are alive.
+ */
+class IGNITE_IMPORT_EXPORT PageArenaPool
+    : public std::enable_shared_from_this< PageArenaPool > {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param governor Memory governor to charge decoded pages to, may be null.
+   * @param maxIdle Maximum number of idle arenas kept for reuse.
+   */
+  explicit PageArenaPool(
+      std::shared_ptr< MemoryGovernor > governor = nullptr,
+      size_t maxIdle = DEFAULT_PAGE_ARENA_POOL_SIZE);
+
+  /**
+   * Destructor.
+   */
+  ~PageArenaPool() = default;
+
+  /**
+   * Take an arena from the pool, creating one if there is none idle.
+   *
+   * @return Empty arena.
+   */
+  std::unique_ptr< PageArena > Acquire();
+
+  /**
+   * Return an arena to the pool. The arena is reset and kept for reuse,
+   * or freed if the pool already holds enough idle arenas.
+   *
+   * @param arena Arena.
+   */
+  void Release(std::unique_ptr< PageArena > arena);
+
+  /**
+   * Decode rows into a pooled arena and wrap it into an immutable page.
+   * The arena returns to the pool when the last reference to the page is
+   * dropped.
+   *
+   * @param rows Rows of the page.
+   * @param columnMetadataVec Column metadata of the result set.
+   * @param nextToken Token of the next page, empty for the last page.
+   * @return Decoded page.
+   */
+  std::shared_ptr< const ResultPage > DecodePage(
+      const Aws::Vector< client::TrinoQuery::Model::Row >& rows, /*#*/
+      const meta::ColumnMetaVector& columnMetadataVec,
+      const std::string& nextToken);
+
+  /**
+   * Get memory governor decoded pages are charged to.
+   *
+   * @return Memory governor, may be null.
+   */
+  const std::shared_ptr< MemoryGovernor >& GetMemoryGovernor() const {
+    return governor_;
+  }
+
+  /**
+   * Get number of arenas created by the pool so far.
+   *
+   * @return Number of created arenas.
+   */
+  size_t GetCreatedCount() const;
+
+  /**
+   * Get number of page decodes served by a recycled arena.
+   *
+   * @return Number of reuses.
+   */
+  size_t GetReusedCount() const;
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(PageArenaPool);
+
+  /** Memory governor. */
+  std::shared_ptr< MemoryGovernor > governor_;
+
+  /** Mutex guarding the pool. */
+  mutable std::mutex mutex_;
+
+  /** Idle arenas. */
+  std::vector< std::unique_ptr< PageArena > > idle_;
+
+  /** Maximum number of idle arenas. */
+  size_t maxIdle_;
+
+  /** Number of created arenas. */
+  size_t created_;
+
+  /** Number of reused arenas. */
+  size_t reused_;
+};
+
+/**
+ * Immutable decoded result page.
+ *
+ * Pages are handed from the fetching thread to the cursor through
+ * std::shared_ptr< const ResultPage >, so ownership moves without copying
+ * rows and readers only ever borrow them.
+ */
+class IGNITE_IMPORT_EXPORT ResultPage {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param arena Arena holding the decoded rows.
+   * @param pool Pool to return the arena to on destruction.
+   * @param nextToken Token of the next page, empty for the last page.
+   * @param governor Memory governor the page is charged to, may be null.
+   */
+  ResultPage(std::unique_ptr< PageArena > arena,
+             std::weak_ptr< PageArenaPool > pool,
+             const std::string& nextToken,
+             std::shared_ptr< MemoryGovernor > governor = nullptr);
+
+  /**
+   * Destructor. Returns the arena to its pool and releases the memory
+   * charged for it.
+   */
+  ~ResultPage();
+
+  /**
+   * Get decoded rows.
+   *
+   * @return Arena holding the decoded rows.
+   */
+  const PageArena& GetArena() const {
+    return *arena_;
+  }
+
+  /**
+   * Get number of rows in the page.
+   *
+   * @return Number of rows.
+   */
+  size_t GetRowCount() const {
+    return arena_->GetRowCount();
+  }
+
+  /**
+   * Get token of the next page.
+   *
+   * @return Next token, empty for the last page.
+   */
+  const std::string& GetNextToken() const {
+    return nextToken_;
+  }
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(ResultPage);
+
+  /** Arena holding the decoded rows. */
+  std::unique_ptr< PageArena > arena_;
+
+  /** Pool the arena came from. */
+  std::weak_ptr< PageArenaPool > pool_;
+
+  /** Token of the next page. */
+  std::string nextToken_;
+
+  /** Memory governor the page is charged to. */
+  std::shared_ptr< MemoryGovernor > governor_;
+
+  /** Number of bytes charged to the governor. */
+  int64_t charged_;
+};
+}  // namespace odbc
+}  // namespace trino
+
+#endif  //_TRINO_ODBC_PAGE_ARENA
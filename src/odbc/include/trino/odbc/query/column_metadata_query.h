@@ -165,6 +165,46 @@ class ColumnMetadataQuery : public trino::odbc::query::Query {
   SqlResult::Type MakeRequestGetColumnsMetaPerTable(
       const std::string& databaseName, const std::string& tableName);
 
+  /**
+   * Make one request for the columns of all tables matching the search
+   * patterns and use response to set internal state.
+   *
+   * @param databasePattern Database name search pattern
+   *
+   * @return Operation result.
+   */
+  SqlResult::Type MakeRequestGetColumnsMetaWithPattern(
+      const std::string& databasePattern);
+
+  /**
+   * Get the columns matching the search patterns with one SHOW COLUMNS per
+   * matching table, for catalogs without a usable
+   * information_schema.columns. The queries run in parallel up to the
+   * MetadataConcurrency limit, a failed one is reported as a warning.
+   *
+   * @param columnPattern Column name search pattern
+   * @param columns Vector to store columns ordered by database, table and
+   *     position
+   *
+   * @return Operation result, AI_SUCCESS_WITH_INFO if some columns are
+   *     missing.
+   */
+  SqlResult::Type GetColumnsPerTable(
+      const std::string& columnPattern,
+      std::vector< MetadataCache::Column >& columns);
+
+  /**
+   * Read the rows of an executed DESCRIBE or SHOW COLUMNS query.
+   *
+   * @param query Executed query
+   * @param databaseName Database name
+   * @param tableName Table name
+   * @param columns Vector to store columns
+   */
+  static void ReadColumns(DataQuery& query, const std::string& databaseName,
+                          const std::string& tableName,
+                          std::vector< MetadataCache::Column >& columns);
+
   /** Connection associated with the statement. */
   Connection& connection;
 
@@ -197,9 +237,6 @@ class ColumnMetadataQuery : public trino::odbc::query::Query {
 
   /** DataQuery pointer for "describe" command to run **/
   std::shared_ptr< DataQuery > dataQuery_;
-
-  /** TableMetadataQuery pointer for fetching table **/
-  std::shared_ptr< TableMetadataQuery > tableMetadataQuery_;
 };
 }  // namespace query
 }  // namespace odbc
@@ -21,6 +21,12 @@
 #ifndef _TRINO_ODBC_QUERY_DATA_QUERY
 #define _TRINO_ODBC_QUERY_DATA_QUERY
 
+#include "trino/odbc/page_arena.h"
+#include "trino/odbc/query_trace.h"
+#include "trino/odbc/result_cache.h"
+#include "trino/odbc/shared_query.h"
+#include "trino/odbc/spill_store.h"
+#include "trino/odbc/timer_service.h"
 #include "trino/odbc/trino_cursor.h"
 #include "trino/odbc/query/query.h"
 #include "trino/odbc/connection.h"
@@ -30,6 +36,9 @@
 #include <aws/trino-query/model/QueryResult.h>
 #include <aws/trino-query/model/ColumnInfo.h>
 
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <queue>
 #include <mutex>
 #include <condition_variable>
@@ -44,12 +53,56 @@ namespace odbc {
 class Connection;
 
 namespace query {
+/**
+ * Outcome of fetching one result page.
+ */
+struct PageOutcome {
+  /** Decoded page, null if the request failed. */
+  std::shared_ptr< const ResultPage > page;
+
+  /** Error description if the request failed. */
+  std::string error;
+
+  /** Time the request took. */
+  QueryTrace::Clock::duration fetch = QueryTrace::Clock::duration::zero();
+
+  /** Time decoding the page took. */
+  QueryTrace::Clock::duration decode = QueryTrace::Clock::duration::zero();
+};
+
+/**
+ * Reason an execution of a data query failed.
+ */
+struct FailureKind {
+  enum Type {
+    /** The execution did not fail. */
+    NONE,
+
+    /** The server rejected the statement, so it did not run. */
+    REJECTED,
+
+    /** The query timeout expired or the query was interrupted. */
+    STOPPED,
+
+    /** Any other failure, e.g. the server could not be reached. */
+    OTHER
+  };
+};
+
 /**
  * Context for asynchronous fetching data query result.
+ *
+ * Shared between the query and its fetching thread. A closed query starts
+ * over with a new context, so a thread still waiting for the server never
+ * touches the state of the next execution.
  */
 class IGNITE_IMPORT_EXPORT DataQueryContext {
  public:
-  DataQueryContext() : isClosing_(false) {
+  DataQueryContext()
+      : isClosing_(false),
+        consumerWaiting_(false),
+        timedOut_(false),
+        interrupted_(false) {
   }
 
   ~DataQueryContext() = default;
@@ -60,11 +113,32 @@ class IGNITE_IMPORT_EXPORT DataQueryContext {
   /** condition variable to synchronize threads */
   std::condition_variable cv_;
 
-  /** queue to save query execution outcome objects. */
-  std::queue< client::TrinoQuery::Model::QueryOutcome > queue_; /*#*/
+  /** queue to save fetched pages. */
+  std::queue< PageOutcome > queue_;
 
   /** Flag to indicate if the main thread is exiting or not. */
-  bool isClosing_;
+  std::atomic< bool > isClosing_;
+
+  /**
+   * Flag to indicate that the main thread ran out of rows and waits for the
+   * next page, which lets the fetching thread ignore the memory budget.
+   */
+  std::atomic< bool > consumerWaiting_;
+
+  /** Column metadata the fetched pages are decoded with. */
+  meta::ColumnMetaVector columnMeta_;
+
+  /** Flag to indicate that the query timeout has expired. */
+  std::atomic< bool > timedOut_;
+
+  /** Flag to indicate that the query was interrupted, set with timedOut_. */
+  std::atomic< bool > interrupted_;
+
+  /** ID of the executed query, guarded by the mutex. */
+  std::string queryId_;
+
+  /** Query shared with identical statements, guarded by the mutex. */
+  std::shared_ptr< SharedQuery > sharedQuery_;
 };
 
 /**
@@ -78,9 +152,15 @@ class IGNITE_IMPORT_EXPORT DataQuery : public trino::odbc::query::Query {
    * @param diag Diagnostics collector.
    * @param connection Associated connection.
    * @param sql SQL query string.
+   * @param scrollable Keep fetched rows in a spill store so the result can be
+   *     scrolled in any direction.
+   * @param maxRows Maximum number of rows to return, zero means no limit.
+   * @param queryTimeout Seconds the query may run until its result set is
+   *     fetched, zero means no limit.
    */
   DataQuery(diagnostic::DiagnosableAdapter& diag, Connection& connection,
-            const std::string& sql);
+            const std::string& sql, bool scrollable = false,
+            int64_t maxRows = 0, int32_t queryTimeout = 0);
 
   /**
    * Destructor.
@@ -101,6 +181,13 @@ class IGNITE_IMPORT_EXPORT DataQuery : public trino::odbc::query::Query {
    */
   virtual SqlResult::Type Cancel();
 
+  /**
+   * Interrupt the query from another thread. Ends the waits for result
+   * pages the way an expired query timeout does and cancels the query on
+   * the server.
+   */
+  virtual void Interrupt();
+
   /**
    * Get column metadata.
    *
@@ -162,6 +249,26 @@ class IGNITE_IMPORT_EXPORT DataQuery : public trino::odbc::query::Query {
    */
   virtual SqlResult::Type NextResultSet();
 
+  /**
+   * Check if the query result can be scrolled in any direction.
+   *
+   * @return True if the query keeps fetched rows in a spill store.
+   */
+  virtual bool IsScrollable() const {
+    return scrollable_;
+  }
+
+  /**
+   * Position the cursor right before the first row of the requested rowset.
+   *
+   * @param orientation Fetch orientation as defined by SQLFetchScroll.
+   * @param offset Fetch offset as defined by SQLFetchScroll.
+   * @param rowsetSize Number of rows in the rowset.
+   * @return Operation result.
+   */
+  virtual SqlResult::Type MoveToRowset(int16_t orientation, int64_t offset,
+                                       SqlUlen rowsetSize);
+
   /**
    * Get SQL query string.
    *
@@ -171,6 +278,16 @@ class IGNITE_IMPORT_EXPORT DataQuery : public trino::odbc::query::Query {
     return sql_;
   }
 
+  /**
+   * Get the reason the last execution failed. Only a rejected statement is
+   * known not to have run on the server.
+   *
+   * @return Failure kind, NONE if the execution did not fail.
+   */
+  FailureKind::Type GetFailure() const {
+    return failure_;
+  }
+
  private:
   IGNITE_NO_COPY_ASSIGNMENT(DataQuery);
 
@@ -191,11 +308,46 @@ class IGNITE_IMPORT_EXPORT DataQuery : public trino::odbc::query::Query {
   SqlResult::Type MakeRequestExecute();
 
   /**
-   * Make data fetch request and use response to set internal state.
+   * Serve the result found in the result cache instead of executing the
+   * query on the server.
+   *
+   * @return Result.
+   */
+  SqlResult::Type ExecuteCached();
+
+  /**
+   * Decode the next page of the cached result.
+   *
+   * @param page Decoded page.
+   * @return Result. AI_NO_DATA if there are no more rows.
+   */
+  SqlResult::Type TakeCachedPage(std::shared_ptr< const ResultPage >& page);
+
+  /**
+   * Store the result collected so far in the result cache, once the result
+   * set is complete.
+   */
+  void StoreResult();
+
+  /**
+   * Read the result of an identical query started by another statement.
    *
    * @return Result.
    */
-  SqlResult::Type MakeRequestFetch();
+  SqlResult::Type ExecuteShared();
+
+  /**
+   * Wait for the next page of the shared query.
+   *
+   * @param page Page.
+   * @return Result. AI_NO_DATA if there are no more rows.
+   */
+  SqlResult::Type TakeSharedPage(std::shared_ptr< const ResultPage >& page);
+
+  /**
+   * Detach from the shared query, if any.
+   */
+  void LeaveSharedQuery();
 
   /**
    * Make result set metadata request.
@@ -252,14 +404,115 @@ class IGNITE_IMPORT_EXPORT DataQuery : public trino::odbc::query::Query {
   SqlResult::Type SwitchCursor();
 
   /**
-   * Record the thread so they could be waited before the main thread ends.
-   * @param thread Thread to be saved.
+   * Wait for the page fetched by the asynchronous thread and start fetching
+   * the one after it.
    *
-   * @return void.
+   * @param page Fetched page.
+   * @return Result. AI_NO_DATA if there are no more rows.
    */
-  void addThreads(std::thread& thread) {
-    threads_.push(std::move(thread));
-  }
+  SqlResult::Type TakeNextPage(std::shared_ptr< const ResultPage >& page);
+
+  /**
+   * Make the page rows available to the cursor, either by pointing the
+   * cursor to the page or by appending the page to the spill store.
+   *
+   * @param page Page.
+   * @return Result.
+   */
+  SqlResult::Type AcceptPage(std::shared_ptr< const ResultPage > page);
+
+  /**
+   * Fetch pages into the spill store until it holds the given number of rows
+   * or the result set is exhausted.
+   *
+   * @param rowCount Number of rows.
+   * @return Result.
+   */
+  SqlResult::Type SpillUntil(size_t rowCount);
+
+  /**
+   * Read the current row to application buffers.
+   *
+   * @param columnBindings Application buffers to put data to.
+   * @return Operation result.
+   */
+  SqlResult::Type ReadRow(app::ColumnBindingMap& columnBindings);
+
+  /**
+   * Start fetching the next page on the request worker pool.
+   *
+   * @param nextToken Token of the page to fetch.
+   */
+  void StartAsyncFetch(const std::string& nextToken);
+
+  /**
+   * Account a received page and either start fetching the page after it or
+   * stop fetching if the result set or the row limit is exhausted.
+   *
+   * @param page Received page.
+   */
+  void ContinueFetch(const ResultPage& page);
+
+  /**
+   * Ask the server for no more rows than the row limit still allows.
+   */
+  void LimitPageSize();
+
+  /**
+   * Stop fetching once the row limit is reached and cancel the query on
+   * the server.
+   */
+  void StopAtMaxRows();
+
+  /**
+   * Arm the query timeout timer.
+   */
+  void ArmTimeout();
+
+  /**
+   * Wake up everything waiting for result pages of the query and cancel it
+   * on the server. Used by the timeout timer and Interrupt(), so it only
+   * touches shared state.
+   *
+   * @param context Shared query context.
+   * @param client Query client.
+   * @param governor Memory governor the fetching thread may wait on.
+   */
+  static void Expire(
+      const std::shared_ptr< DataQueryContext >& context,
+      const std::shared_ptr< client::TrinoQuery::TrinoQueryClient >& client, /*#*/
+      const std::shared_ptr< MemoryGovernor >& governor);
+
+  /**
+   * Cancel a query on the server in the background, so the caller is not
+   * held up for a server round-trip.
+   *
+   * @param client Query client.
+   * @param queryId Query ID.
+   */
+  static void SubmitCancel(
+      const std::shared_ptr< client::TrinoQuery::TrinoQueryClient >& client, /*#*/
+      const std::string& queryId);
+
+  /**
+   * Disarm the query timeout timer.
+   */
+  void DisarmTimeout();
+
+  /**
+   * Report an expired query timeout.
+   *
+   * @return Result.
+   */
+  SqlResult::Type TimeoutExpired();
+
+  /**
+   * Cancel the executed query on the server.
+   *
+   * @param message Outcome description.
+   * @return @c false if the query could not be cancelled.
+   */
+  bool CancelServerQuery(std::string& message);
 
   /** Connection associated with the statement. */
   Connection& connection_;
@@ -276,26 +529,95 @@ class IGNITE_IMPORT_EXPORT DataQuery : public trino::odbc::query::Query {
   /** Current Trino Query Request. */
   QueryRequest request_;
 
-  /** Current Trino Query Result. */
-  std::shared_ptr< QueryResult > result_;
+  /** ID of the executed query, empty if the query is not executed. */
+  std::string queryId_;
 
   /** Cursor. */
   std::unique_ptr< TrinoCursor > cursor_;
 
+  /** Arenas the result pages are decoded into. */
+  std::shared_ptr< PageArenaPool > arenaPool_;
+
   /** Trino query client. */
   std::shared_ptr< client::TrinoQuery::TrinoQueryClient > queryClient_; /*#*/
 
-  /** Context for asynchornous result fetching. */
-  DataQueryContext context_;
+  /**
+   * Context for asynchornous result fetching. Replaced on close with
+   * std::atomic_store, as Interrupt() reads it from another thread.
+   */
+  std::shared_ptr< DataQueryContext > context_;
 
-  /** Queue for threads. */
-  std::queue< std::thread > threads_;
+  /** Page fetch in flight, invalid if there is none. */
+  std::shared_future< void > fetch_;
 
   /** Flag indicating asynchronous fetch is started. */
   bool hasAsyncFetch;
 
   /** Row counter for how many rows has been fetched */
   int rowCounter;
+
+  /** Flag indicating the result is kept for scrolling. */
+  bool scrollable_;
+
+  /** Rows fetched so far, only used by scrollable queries. */
+  std::shared_ptr< SpillStore > spill_;
+
+  /**
+   * First row of the current rowset, starts at 1. 0 means before the first
+   * row, a value past the last row means after the end.
+   */
+  size_t rowsetStart_;
+
+  /** Size of the current rowset. */
+  size_t rowsetSize_;
+
+  /** Maximum number of rows to return, zero means no limit. */
+  int64_t maxRows_;
+
+  /** Number of rows received from the server. */
+  int64_t rowsReceived_;
+
+  /** Number of bytes of decoded rows received from the server. */
+  uint64_t bytesReceived_;
+
+  /** Time the query was sent to the server. */
+  std::chrono::steady_clock::time_point executeStart_;
+
+  /** Query timeout in seconds, zero means no limit. */
+  int32_t queryTimeout_;
+
+  /** Result cache of the connection, null if results are not cached. */
+  std::shared_ptr< ResultCache > resultCache_;
+
+  /** Result cache key of the query, empty if the query is not cacheable. */
+  std::string cacheKey_;
+
+  /** Cached result being served, null if the query runs on the server. */
+  std::shared_ptr< const ResultCache::Entry > cachedResult_;
+
+  /** Index of the next page of the cached result. */
+  size_t cachedPage_;
+
+  /** Result being collected for the cache, null once abandoned. */
+  std::shared_ptr< ResultCache::Entry > cacheEntry_;
+
+  /** Query shared with identical statements, null if not shared. */
+  std::shared_ptr< SharedQuery > sharedQuery_;
+
+  /** Reader ID of the statement in the shared query. */
+  size_t sharedReader_;
+
+  /** Index of the next page of the shared query. */
+  size_t sharedPage_;
+
+  /** Timing record of the execution, null unless tracing is enabled. */
+  std::unique_ptr< QueryTrace > trace_;
+
+  /** Armed query timeout timer, zero if none. */
+  TimerService::TimerId timer_;
+
+  /** Reason the last execution failed. */
+  FailureKind::Type failure_;
 };
 }  // namespace query
 }  // namespace odbc
@@ -171,6 +171,47 @@ class Query {
    */
   virtual SqlResult::Type NextResultSet() = 0;
 
+  /**
+   * Check if the query result can be scrolled in any direction.
+   *
+   * @return True if the query supports MoveToRowset().
+   */
+  virtual bool IsScrollable() const {
+    return false;
+  }
+
+  /**
+   * Interrupt the query from another thread, e.g. while it is executed or
+   * fetched asynchronously. The interrupted call fails as soon as possible.
+   * Safe to call concurrently with the other methods.
+   */
+  virtual void Interrupt() {
+    // No-op.
+  }
+
+  /**
+   * Position the cursor right before the first row of the requested rowset,
+   * so the following FetchNextRow() calls return the rows of the rowset.
+   *
+   * @param orientation Fetch orientation as defined by SQLFetchScroll.
+   * @param offset Fetch offset as defined by SQLFetchScroll.
+   * @param rowsetSize Number of rows in the rowset.
+   * @return Operation result. AI_NO_DATA if the cursor is positioned before
+   *     the start or after the end of the result set.
+   */
+  virtual SqlResult::Type MoveToRowset(int16_t orientation, int64_t offset,
+                                       SqlUlen rowsetSize) {
+    IGNITE_UNUSED(orientation);
+    IGNITE_UNUSED(offset);
+    IGNITE_UNUSED(rowsetSize);
+
+    diag.AddStatusRecord(
+        SqlState::SHYC00_OPTIONAL_FEATURE_NOT_IMPLEMENTED,
+        "Only SQL_FETCH_NEXT FetchOrientation type is supported");
+
+    return SqlResult::AI_ERROR;
+  }
+
   /**
    * Get query type.
    *
@@ -21,7 +21,12 @@
 #ifndef _TRINO_ODBC_QUERY_TABLE_METADATA_QUERY
 #define _TRINO_ODBC_QUERY_TABLE_METADATA_QUERY
 
+#include <atomic>
+#include <mutex>
+#include <set>
+
 #include "trino/odbc/meta/table_meta.h"
+#include "trino/odbc/metadata_cache.h"
 #include "trino/odbc/query/query.h"
 #include "trino/odbc/query/data_query.h"
 #include "trino/odbc/statement.h"
@@ -85,6 +90,14 @@ class TableMetadataQuery : public trino::odbc::query::Query {
    */
   virtual SqlResult::Type Execute();
 
+  /**
+   * Read the database list and the tables of all databases into the
+   * metadata cache. Entries already in the cache are read again.
+   *
+   * @return Operation result.
+   */
+  SqlResult::Type Prefetch();
+
   /**
    * Cancel query.
    *
@@ -92,6 +105,12 @@ class TableMetadataQuery : public trino::odbc::query::Query {
    */
   virtual SqlResult::Type Cancel();
 
+  /**
+   * Interrupt the query from another thread. The running server queries are
+   * interrupted and no new ones are started, so Prefetch() returns soon.
+   */
+  virtual void Interrupt();
+
   /**
    * Get column metadata.
    *
@@ -209,16 +228,59 @@ class TableMetadataQuery : public trino::odbc::query::Query {
       std::vector< std::string >& databaseNames);
 
   /**
-   *  Get the table names that match table pattern from specified database
+   * Get the tables that match a condition on information_schema.tables
    *
-   * @param databaseName Database name
-   * @param tablePattern Table name search pattern
-   * @param tablePattern Vector to store table names
+   * @param condition Condition on table_schema and table_name
+   * @param tables Vector to store tables ordered by database and name
+   * @param queryDiag Diagnostics the errors of the query are added to
    * @return Operation result
    */
-  SqlResult::Type getMatchedTables(const std::string& databaseName,
-                                   const std::string& tablePattern,
-                                   std::vector< std::string >& c);
+  SqlResult::Type getMatchedTables(
+      const std::string& condition, std::vector< MetadataCache::Table >& tables,
+      diagnostic::DiagnosableAdapter& queryDiag);
+
+  /**
+   * Get the tables that match the search patterns with one SHOW TABLES per
+   * matching database, for catalogs without a usable
+   * information_schema.tables. The queries run in parallel up to the
+   * MetadataConcurrency limit, a failed one is reported as a warning.
+   *
+   * @param databasePattern Database name search pattern
+   * @param tablePattern Table name search pattern
+   * @param tables Vector to store tables ordered by database and name
+   * @return Operation result, AI_SUCCESS_WITH_INFO if some tables are missing
+   */
+  SqlResult::Type getTablesPerDatabase(
+      const std::string& databasePattern, const std::string& tablePattern,
+      std::vector< MetadataCache::Table >& tables);
+
+  /**
+   * Add tables to the fetched metadata
+   *
+   * @param tables Tables
+   */
+  void addTables(const std::vector< MetadataCache::Table >& tables);
+
+  /**
+   * Register a server query before it is executed, so Interrupt() reaches
+   * it.
+   *
+   * @param query Server query.
+   * @param queryDiag Diagnostics the interruption is reported to.
+   * @return False if the query is interrupted and must not be executed.
+   */
+  bool beginDataQuery(DataQuery& query,
+                      diagnostic::DiagnosableAdapter& queryDiag);
+
+  /**
+   * Unregister a server query registered with beginDataQuery().
+   *
+   * @param query Server query.
+   * @param queryDiag Diagnostics the interruption is reported to.
+   * @return False if the query was interrupted, its results are partial.
+   */
+  bool endDataQuery(DataQuery& query,
+                    diagnostic::DiagnosableAdapter& queryDiag);
 
   /**
    * Remove outer matching quotes from a string. They can be either single (')
@@ -259,6 +321,9 @@ class TableMetadataQuery : public trino::odbc::query::Query {
   /** Return a list of supported table types flag. */
   bool all_table_types;
 
+  /** Prefetching flag, the metadata cache is not looked up. */
+  bool prefetching;
+
   /** Fetched metadata. */
   meta::TableMetaVector meta;
 
@@ -270,6 +335,15 @@ class TableMetadataQuery : public trino::odbc::query::Query {
 
   /** DataQuery pointer for "show" command to run **/
   std::shared_ptr< DataQuery > dataQuery_;
+
+  /** Interrupted flag, no server query is started once it is set. */
+  std::atomic< bool > interrupted_;
+
+  /** Guards runningQueries_. */
+  std::mutex runningMutex_;
+
+  /** Server queries being executed or fetched. */
+  std::set< DataQuery* > runningQueries_;
 };
 }  // namespace query
 }  // namespace odbc
@@ -0,0 +1,259 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _TRINO_ODBC_QUERY_TRACE
+#define _TRINO_ODBC_QUERY_TRACE
+
+#include <stdint.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <ignite/common/common.h>
+
+namespace trino {
+namespace odbc {
+/**
+ * Timing record of one query execution.
+ *
+ * The statement fills the record while it runs the query and appends it to
+ * the trace file as one JSON object when the query is closed. Page timings
+ * are measured by the thread that fetched the page and handed over with it,
+ * so the record itself is only touched by the statement.
+ */
+class IGNITE_IMPORT_EXPORT QueryTrace {
+ public:
+  /** Clock the timings are taken with. */
+  typedef std::chrono::steady_clock Clock;
+
+  /** Largest number of pages listed one by one in the record. */
+  static const size_t MAX_LISTED_PAGES;
+
+  /**
+   * Adds the time spent in its scope to the driver time of a fetch call.
+   */
+  class CallTimer {
+   public:
+    /**
+     * Constructor.
+     *
+     * @param trace Trace to add to, may be null.
+     */
+    explicit CallTimer(QueryTrace* trace)
+        : trace_(trace), start_(trace ? Clock::now() : Clock::time_point()) {
+      // No-op.
+    }
+
+    /**
+     * Destructor.
+     */
+    ~CallTimer() {
+      if (trace_) {
+        trace_->AddFetchCall(Clock::now() - start_);
+      }
+    }
+
+   private:
+    IGNITE_NO_COPY_ASSIGNMENT(CallTimer);
+
+    /** Trace. */
+    QueryTrace* trace_;
+
+    /** Start of the call. */
+    Clock::time_point start_;
+  };
+
+  /**
+   * Constructor. Starts the clock of the query.
+   *
+   * @param sql SQL query string.
+   */
+  explicit QueryTrace(const std::string& sql);
+
+  /**
+   * Set the Trino query ID.
+   *
+   * @param queryId Query ID.
+   */
+  void SetQueryId(const std::string& queryId);
+
+  /**
+   * Set where the result comes from.
+   *
+   * @param source "server", "cache" or "shared".
+   */
+  void SetSource(const std::string& source);
+
+  /**
+   * Record that the first response of the server arrived.
+   */
+  void FirstResponse();
+
+  /**
+   * Record that the execution returned to the application.
+   */
+  void Executed();
+
+  /**
+   * Record a received page.
+   *
+   * @param rows Number of rows.
+   * @param bytes Decoded size in bytes.
+   * @param fetch Time the request for the page took.
+   * @param decode Time decoding the page took.
+   */
+  void AddPage(size_t rows, uint64_t bytes, Clock::duration fetch,
+               Clock::duration decode);
+
+  /**
+   * Record time a fetch call waited for the next page.
+   *
+   * @param wait Wait time.
+   */
+  void AddWait(Clock::duration wait);
+
+  /**
+   * Record time spent converting a value to the application buffer.
+   *
+   * @param columnIdx Column index, starts at 1.
+   * @param time Conversion time.
+   */
+  void AddConversion(uint16_t columnIdx, Clock::duration time);
+
+  /**
+   * Record a fetch call of the application.
+   *
+   * @param time Time spent in the driver.
+   */
+  void AddFetchCall(Clock::duration time);
+
+  /**
+   * Record that the query failed.
+   *
+   * @param error Error description.
+   */
+  void SetError(const std::string& error);
+
+  /**
+   * Record that the query is closed. Stops the clock of the query.
+   *
+   * @param complete @c true if the whole result was fetched.
+   * @param close Time closing the query took.
+   */
+  void Finish(bool complete, Clock::duration close);
+
+  /**
+   * Format the record as one line of JSON, without the line break.
+   *
+   * @return Record.
+   */
+  std::string ToJson() const;
+
+  /**
+   * Append the record to a trace file.
+   *
+   * @param path File path.
+   * @return @c true on success.
+   */
+  bool Write(const std::string& path) const;
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(QueryTrace);
+
+  /** Timing of one page. */
+  struct Page {
+    /** Number of rows. */
+    size_t rows;
+
+    /** Time the request took. */
+    Clock::duration fetch;
+
+    /** Time decoding took. */
+    Clock::duration decode;
+  };
+
+  /** SQL query string. */
+  std::string sql_;
+
+  /** Trino query ID. */
+  std::string queryId_;
+
+  /** Source of the result. */
+  std::string source_;
+
+  /** Error description, empty if the query did not fail. */
+  std::string error_;
+
+  /** Wall clock time the query started at. */
+  std::chrono::system_clock::time_point started_;
+
+  /** Start of the query. */
+  Clock::time_point start_;
+
+  /** Time until the first response. */
+  Clock::duration firstResponse_;
+
+  /** Time until the execution returned. */
+  Clock::duration execute_;
+
+  /** Time from the start until the query was closed. */
+  Clock::duration total_;
+
+  /** Time closing the query took. */
+  Clock::duration close_;
+
+  /** Pages listed one by one. */
+  std::vector< Page > pages_;
+
+  /** Number of pages. */
+  size_t pageCount_;
+
+  /** Number of rows received. */
+  uint64_t rows_;
+
+  /** Number of bytes received. */
+  uint64_t bytes_;
+
+  /** Time all page requests took. */
+  Clock::duration fetch_;
+
+  /** Time decoding all pages took. */
+  Clock::duration decode_;
+
+  /** Time fetch calls waited for pages. */
+  Clock::duration wait_;
+
+  /** Conversion time by column index minus one. */
+  std::vector< Clock::duration > conversion_;
+
+  /** Number of fetch calls. */
+  uint64_t fetchCalls_;
+
+  /** Time spent in the driver by fetch calls. */
+  Clock::duration fetchCallTime_;
+
+  /** Whether the whole result was fetched. */
+  bool complete_;
+};
+}  // namespace odbc
+}  // namespace trino
+
+#endif  //_TRINO_ODBC_QUERY_TRACE
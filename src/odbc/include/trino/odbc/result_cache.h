@@ -0,0 +1,355 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _TRINO_ODBC_RESULT_CACHE
+#define _TRINO_ODBC_RESULT_CACHE
+
+#include <stdint.h>
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "trino/odbc/meta/column_meta.h"
+#include "trino/odbc/page_arena.h"
+
+namespace trino {
+namespace odbc {
+/**
+ * Results of recently executed read queries, shared by the connections of
+ * an environment so repeated dashboard queries are answered without a
+ * round-trip to the server.
+ *
+ * An entry holds the column metadata and the pages of one complete result
+ * set, every page encoded as a column-major chunk of the SpillStore format.
+ * Entries expire after the time to live of the connection that stored them
+ * and are evicted in least recently used order once the memory limit is
+ * exceeded. If a cache directory is set, evicted entries move to a file in
+ * that directory instead, where the same limit applies again.
+ */
+class IGNITE_IMPORT_EXPORT ResultCache {
+ public:
+  /**
+   * Cached result set. Immutable once stored, so readers share it without
+   * locking.
+   */
+  class IGNITE_IMPORT_EXPORT Entry {
+   public:
+    /**
+     * Constructor.
+     *
+     * @param meta Column metadata of the result set.
+     */
+    explicit Entry(const meta::ColumnMetaVector& meta);
+
+    /**
+     * Destructor. Removes the backing file, if any.
+     */
+    ~Entry();
+
+    /**
+     * Append a page.
+     *
+     * @param arena Arena holding the decoded page.
+     */
+    void AddPage(const PageArena& arena);
+
+    /**
+     * Get column metadata.
+     *
+     * @return Column metadata.
+     */
+    const meta::ColumnMetaVector& GetMeta() const {
+      return meta_;
+    }
+
+    /**
+     * Get number of pages.
+     *
+     * @return Number of pages.
+     */
+    size_t GetPageCount() const {
+      return pages_.size();
+    }
+
+    /**
+     * Get size of the encoded pages.
+     *
+     * @return Size in bytes.
+     */
+    uint64_t GetSize() const {
+      return size_;
+    }
+
+    /**
+     * Check if the pages are kept in a file rather than in memory.
+     *
+     * @return @c true if the entry is on disk.
+     */
+    bool IsOnDisk() const {
+      return !path_.empty();
+    }
+
+    /**
+     * Decode a page.
+     *
+     * @param pageIdx Page index, starts at 0.
+     * @param arena Arena to decode the page into.
+     * @return @c true on success.
+     */
+    bool ReadPage(size_t pageIdx, PageArena& arena) const;
+
+   private:
+    IGNITE_NO_COPY_ASSIGNMENT(Entry);
+
+    friend class ResultCache;
+
+    /** Location of one page in the data. */
+    struct Page {
+      /** Offset of the chunk. */
+      uint64_t offset;
+
+      /** Size of the chunk in bytes. */
+      uint64_t size;
+    };
+
+    /**
+     * Write the pages to a new file in the directory.
+     *
+     * @param dir Directory.
+     * @return Entry backed by the file, or null on failure.
+     */
+    std::shared_ptr< const Entry > Spill(const std::string& dir) const;
+
+    /** Column metadata. */
+    meta::ColumnMetaVector meta_;
+
+    /** Page index. */
+    std::vector< Page > pages_;
+
+    /** Encoded pages, empty if the entry is on disk. */
+    std::vector< char > data_;
+
+    /** Size of the encoded pages. */
+    uint64_t size_;
+
+    /** Backing file, empty if the entry is in memory. */
+    std::string path_;
+  };
+
+  /** Default memory limit in megabytes. */
+  static const int32_t DEFAULT_SIZE_MB = 64;
+
+  /**
+   * Constructor. The cache stores nothing until Reserve() is called.
+   */
+  ResultCache();
+
+  /**
+   * Destructor. Removes the files of the entries on disk.
+   */
+  ~ResultCache();
+
+  /**
+   * Make room for the results of a connection. The limit only grows, and
+   * the directory is set by the first connection that asks for one.
+   *
+   * @param limit Limit of the memory, and of the directory, in bytes.
+   * @param dir Directory evicted entries are moved to, may be empty.
+   */
+  void Reserve(uint64_t limit, const std::string& dir);
+
+  /**
+   * Get the largest size of an entry worth keeping.
+   *
+   * @return Size in bytes, zero if the cache is not reserved yet.
+   */
+  uint64_t GetEntryLimit() const;
+
+  /**
+   * Look up a result and mark it as most recently used.
+   *
+   * @param key Key made by MakeKey().
+   * @return Entry or null if there is no live one.
+   */
+  std::shared_ptr< const Entry > Get(const std::string& key);
+
+  /**
+   * Store a complete result. Results larger than GetEntryLimit() are
+   * dropped.
+   *
+   * @param key Key made by MakeKey().
+   * @param entry Entry.
+   * @param ttl Time to live in seconds.
+   */
+  void Put(const std::string& key, std::shared_ptr< const Entry > entry,
+           int32_t ttl);
+
+  /**
+   * Drop all entries.
+   */
+  void Clear();
+
+  /**
+   * Get number of entries.
+   *
+   * @return Number of entries.
+   */
+  size_t GetSize() const;
+
+  /**
+   * Get size of the entries kept in memory.
+   *
+   * @return Size in bytes.
+   */
+  uint64_t GetMemoryUsage() const;
+
+  /**
+   * Get size of the entries kept on disk.
+   *
+   * @return Size in bytes.
+   */
+  uint64_t GetDiskUsage() const;
+
+  /**
+   * Get number of lookups that found a result.
+   *
+   * @return Number of hits.
+   */
+  int64_t GetHitCount() const;
+
+  /**
+   * Get number of lookups that did not find a result.
+   *
+   * @return Number of misses.
+   */
+  int64_t GetMissCount() const;
+
+  /**
+   * Get number of stored results.
+   *
+   * @return Number of stores.
+   */
+  int64_t GetStoreCount() const;
+
+  /**
+   * Get number of results dropped to stay within the limits.
+   *
+   * @return Number of evictions.
+   */
+  int64_t GetEvictionCount() const;
+
+  /**
+   * Normalize query text: comments are removed and whitespace outside of
+   * quotes is collapsed, so formatting does not split the cache.
+   *
+   * @param sql SQL text.
+   * @return Normalized text.
+   */
+  static std::string NormalizeSql(const std::string& sql);
+
+  /**
+   * Check if the result of a query may be cached, which is the case for
+   * queries that only read data.
+   *
+   * @param sql Normalized SQL text.
+   * @return @c true if the query is cacheable.
+   */
+  static bool IsCacheable(const std::string& sql);
+
+  /**
+   * Make the key of a query.
+   *
+   * @param sql Normalized SQL text.
+   * @param identity Identity of the session the query runs in.
+   * @return Key.
+   */
+  static std::string MakeKey(const std::string& sql,
+                             const std::string& identity);
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(ResultCache);
+
+  /** Stored result. */
+  struct Slot {
+    /** Key. */
+    std::string key;
+
+    /** Entry. */
+    std::shared_ptr< const Entry > entry;
+
+    /** Time the entry expires. */
+    std::chrono::steady_clock::time_point expiry;
+  };
+
+  /**
+   * Drop a slot. The lock must be held.
+   *
+   * @param slot Slot.
+   */
+  void EraseLocked(std::list< Slot >::iterator slot);
+
+  /**
+   * Move or drop least recently used entries until the limits are met. The
+   * lock must be held.
+   */
+  void EvictLocked();
+
+  /** Limit of the memory and of the directory in bytes. */
+  uint64_t limit_;
+
+  /** Directory evicted entries are moved to, empty for none. */
+  std::string dir_;
+
+  /** Size of the entries in memory. */
+  uint64_t memoryUsage_;
+
+  /** Size of the entries on disk. */
+  uint64_t diskUsage_;
+
+  /** Number of hits. */
+  int64_t hits_;
+
+  /** Number of misses. */
+  int64_t misses_;
+
+  /** Number of stores. */
+  int64_t stores_;
+
+  /** Number of evictions. */
+  int64_t evictions_;
+
+  /** Entries, most recently used first. */
+  std::list< Slot > slots_;
+
+  /** Position of every entry in the list, keyed by key. */
+  std::unordered_map< std::string, std::list< Slot >::iterator > index_;
+
+  /** Lock guarding all of the above. */
+  mutable std::mutex mutex_;
+};
+}  // namespace odbc
+}  // namespace trino
+
+#endif  //_TRINO_ODBC_RESULT_CACHE
@@ -0,0 +1,305 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _TRINO_ODBC_SHARED_QUERY
+#define _TRINO_ODBC_SHARED_QUERY
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "trino/odbc/meta/column_meta.h"
+#include "trino/odbc/page_arena.h"
+
+/*#*/
+#include <aws/trino-query/TrinoQueryClient.h>
+#include <aws/trino-query/model/QueryRequest.h>
+
+namespace trino {
+namespace odbc {
+/**
+ * One execution of a query read by several statements at once.
+ *
+ * The statement that registers the query first executes it and hands the
+ * first page over with Start(). From then on the shared query fetches the
+ * pages itself, one page ahead of the fastest reader, and every attached
+ * statement reads them at its own pace. Pages are immutable and shared, so
+ * each one is held in memory once no matter how many statements read it,
+ * and it is dropped once every reader has moved past it.
+ *
+ * Statements may attach as long as the first page is still held, which is
+ * the case until more than MAX_RETAINED_PAGES pages are fetched. The query
+ * is cancelled on the server once the last reader detaches before the
+ * result set is exhausted.
+ */
+class IGNITE_IMPORT_EXPORT SharedQuery
+    : public std::enable_shared_from_this< SharedQuery > {
+ public:
+  /** Outcome of waiting for a page. */
+  struct Outcome {
+    enum Type {
+      /** The page is available. */
+      PAGE,
+
+      /** The result set has no more pages. */
+      END,
+
+      /** The query failed on the server. */
+      FAILED,
+
+      /**
+       * The query was never started by its first reader, so the others have
+       * to execute it on their own.
+       */
+      ABANDONED,
+
+      /** The reader stopped waiting. */
+      STOPPED
+    };
+  };
+
+  /** Number of leading pages kept for statements that attach late. */
+  static const size_t MAX_RETAINED_PAGES = 16;
+
+  /**
+   * Constructor.
+   *
+   * @param client Query client used to fetch pages and cancel the query.
+   */
+  explicit SharedQuery(
+      std::shared_ptr< client::TrinoQuery::TrinoQueryClient > client); /*#*/
+
+  /**
+   * Destructor.
+   */
+  ~SharedQuery() = default;
+
+  /**
+   * Attach a reader.
+   *
+   * @param reader Reader ID, set on success. The first reader gets ID 0
+   *     and is the one expected to call Start().
+   * @return @c false if the query can not be joined any more.
+   */
+  bool Attach(size_t& reader);
+
+  /**
+   * Detach a reader. If the first reader detaches before calling Start(),
+   * the query is abandoned.
+   *
+   * @param reader Reader ID.
+   */
+  void Detach(size_t reader);
+
+  /**
+   * Start sharing the query executed by the first reader, which already
+   * holds the first page.
+   *
+   * @param request Request the query was executed with.
+   * @param meta Column metadata of the result set.
+   * @param first First page.
+   * @param queryId ID of the query on the server.
+   * @param pool Pool to decode the following pages with.
+   */
+  void Start(const client::TrinoQuery::Model::QueryRequest& request, /*#*/
+             const meta::ColumnMetaVector& meta,
+             std::shared_ptr< const ResultPage > first,
+             const std::string& queryId,
+             std::shared_ptr< PageArenaPool > pool);
+
+  /**
+   * Wait until the first reader started the query.
+   *
+   * @param stop Predicate telling the reader to stop waiting.
+   * @return PAGE once the query is started, ABANDONED or STOPPED otherwise.
+   */
+  Outcome::Type WaitStarted(const std::function< bool() >& stop);
+
+  /**
+   * Get column metadata. Only valid once the query is started.
+   *
+   * @return Column metadata.
+   */
+  const meta::ColumnMetaVector& GetMeta() const {
+    return meta_;
+  }
+
+  /**
+   * Wait for a page and mark everything before it as read by the reader.
+   *
+   * @param reader Reader ID.
+   * @param pageIdx Page index, starts at 0.
+   * @param page Page, set if the outcome is PAGE.
+   * @param error Error description, set if the outcome is FAILED.
+   * @param stop Predicate telling the reader to stop waiting.
+   * @return Outcome.
+   */
+  Outcome::Type GetPage(size_t reader, size_t pageIdx,
+                        std::shared_ptr< const ResultPage >& page,
+                        std::string& error,
+                        const std::function< bool() >& stop);
+
+  /**
+   * Wake up readers waiting for pages so they check their stop predicate.
+   */
+  void Wake();
+
+  /**
+   * Get number of attached readers.
+   *
+   * @return Number of readers.
+   */
+  size_t GetReaderCount() const;
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(SharedQuery);
+
+  /**
+   * Start fetching the next page. The lock must be held.
+   */
+  void FetchLocked();
+
+  /**
+   * Fetch pages until one with rows or the end of the result set is
+   * received. Runs on the request worker pool.
+   *
+   * @param request Request of the page.
+   */
+  void Fetch(client::TrinoQuery::Model::QueryRequest request); /*#*/
+
+  /**
+   * Drop pages every reader has moved past. The lock must be held.
+   */
+  void TrimLocked();
+
+  /** Query client. */
+  std::shared_ptr< client::TrinoQuery::TrinoQueryClient > client_; /*#*/
+
+  /** Request of the next page. */
+  client::TrinoQuery::Model::QueryRequest request_; /*#*/
+
+  /** Pool the pages are decoded with. */
+  std::shared_ptr< PageArenaPool > pool_;
+
+  /** Column metadata. */
+  meta::ColumnMetaVector meta_;
+
+  /** ID of the query on the server. */
+  std::string queryId_;
+
+  /** Token of the next page, empty once the result set is exhausted. */
+  std::string nextToken_;
+
+  /** Fetched pages, null once every reader has moved past them. */
+  std::vector< std::shared_ptr< const ResultPage > > pages_;
+
+  /** Index of the next page of every reader, keyed by reader ID. */
+  std::map< size_t, size_t > readers_;
+
+  /** ID of the next reader, the first reader gets 0. */
+  size_t nextReader_;
+
+  /** Flag indicating the first reader started the query. */
+  bool started_;
+
+  /** Flag indicating the query is abandoned before it started. */
+  bool abandoned_;
+
+  /** Flag indicating no more pages are going to be fetched. */
+  bool finished_;
+
+  /** Flag indicating a page is being fetched. */
+  bool fetching_;
+
+  /** Flag indicating late readers may still attach. */
+  bool joinable_;
+
+  /** Error description if the query failed. */
+  std::string error_;
+
+  /** Lock guarding all of the above. */
+  mutable std::mutex mutex_;
+
+  /** Condition variable signalled on every change of the state. */
+  std::condition_variable cv_;
+};
+
+/**
+ * Queries currently executed by the statements of an environment, so an
+ * identical query submitted meanwhile reads the running one instead of
+ * executing again.
+ */
+class IGNITE_IMPORT_EXPORT SharedQueryRegistry {
+ public:
+  /**
+   * Constructor.
+   */
+  SharedQueryRegistry();
+
+  /**
+   * Destructor.
+   */
+  ~SharedQueryRegistry() = default;
+
+  /**
+   * Attach to the running query with the key, or register a new one the
+   * caller has to execute and Start().
+   *
+   * @param key Query key, as made by ResultCache::MakeKey().
+   * @param client Query client of the caller.
+   * @param reader Reader ID of the caller.
+   * @param leader Set if the caller registered the query.
+   * @return Shared query.
+   */
+  std::shared_ptr< SharedQuery > Join(
+      const std::string& key,
+      std::shared_ptr< client::TrinoQuery::TrinoQueryClient > client, /*#*/
+      size_t& reader, bool& leader);
+
+  /**
+   * Get number of statements that read a query executed by another one.
+   *
+   * @return Number of merged statements.
+   */
+  int64_t GetMergedCount() const;
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(SharedQueryRegistry);
+
+  /** Running queries, keyed by query key. */
+  std::unordered_map< std::string, std::weak_ptr< SharedQuery > > queries_;
+
+  /** Number of merged statements. */
+  int64_t merged_;
+
+  /** Lock guarding all of the above. */
+  mutable std::mutex mutex_;
+};
+}  // namespace odbc
+}  // namespace trino
+
+#endif  //_TRINO_ODBC_SHARED_QUERY
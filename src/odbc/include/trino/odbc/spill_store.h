@@ -0,0 +1,188 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _TRINO_ODBC_SPILL_STORE
+#define _TRINO_ODBC_SPILL_STORE
+
+#include <stdint.h>
+
+#include <cstdio>
+#include <vector>
+
+#include "trino/odbc/page_arena.h"
+
+namespace trino {
+namespace odbc {
+/**
+ * Append-only store of decoded result pages backing scrollable cursors.
+ *
+ * Every page is appended to an anonymous temporary file as one chunk laid
+ * out column by column: a small header, the cell table of each column and
+ * then the values of each column. The file is memory-mapped for reading, so
+ * any row can be read without keeping decoded pages on the heap; only a
+ * small index entry per chunk stays in memory.
+ */
+class IGNITE_IMPORT_EXPORT SpillStore {
+ public:
+  /**
+   * Constructor.
+   */
+  SpillStore();
+
+  /**
+   * Destructor. Closes the store.
+   */
+  ~SpillStore();
+
+  /**
+   * Create the backing file.
+   *
+   * @return @c true on success.
+   */
+  bool Open();
+
+  /**
+   * Unmap and remove the backing file.
+   */
+  void Close();
+
+  /**
+   * Append rows of a page.
+   *
+   * @param arena Arena holding the decoded page.
+   * @param rowLimit Maximum number of leading rows of the page to append.
+   * @return @c true on success.
+   */
+  bool Append(const PageArena& arena, size_t rowLimit = SIZE_MAX);
+
+  /**
+   * Get number of stored rows.
+   *
+   * @return Number of rows.
+   */
+  size_t GetRowCount() const {
+    return rowCount_;
+  }
+
+  /**
+   * Get size of the backing file.
+   *
+   * @return Size in bytes.
+   */
+  uint64_t GetFileSize() const {
+    return fileSize_;
+  }
+
+  /**
+   * Read a cell.
+   *
+   * @param rowIdx Row index, starts at 0.
+   * @param columnIdx Column index, starts at 0.
+   * @param cell Cell.
+   * @param value Zero-terminated value data. Stays valid until the next call.
+   * @return @c true if the cell exists.
+   */
+  bool GetCell(size_t rowIdx, size_t columnIdx, PageCell& cell,
+               const char*& value);
+
+  /**
+   * Encode rows of a page as one chunk of the store format.
+   *
+   * @param arena Arena holding the decoded page.
+   * @param rowLimit Maximum number of leading rows of the page to encode.
+   * @param chunk Buffer the chunk is written to, including the padding.
+   * @return Number of encoded rows.
+   */
+  static size_t EncodeChunk(const PageArena& arena, size_t rowLimit,
+                            std::vector< char >& chunk);
+
+  /**
+   * Decode a chunk written by EncodeChunk() back into an arena. Previous
+   * content of the arena is dropped.
+   *
+   * @param data Chunk data.
+   * @param size Chunk size in bytes.
+   * @param arena Arena to decode the rows into.
+   * @return @c true on success, @c false if the chunk is malformed.
+   */
+  static bool DecodeChunk(const char* data, size_t size, PageArena& arena);
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(SpillStore);
+
+  /** Location of one appended page in the backing file. */
+  struct Chunk {
+    /** Index of the first row of the chunk. */
+    size_t firstRow;
+
+    /** Number of rows. */
+    uint32_t rowCount;
+
+    /** Number of columns. */
+    uint32_t columnCount;
+
+    /** Offset of the chunk in the file. */
+    uint64_t offset;
+
+    /** Size of the chunk in bytes. */
+    uint64_t size;
+  };
+
+  /**
+   * Make sure the mapping covers the given number of bytes of the file.
+   *
+   * @param size Number of bytes.
+   * @return @c true on success.
+   */
+  bool EnsureMapped(uint64_t size);
+
+  /**
+   * Drop the current mapping.
+   */
+  void Unmap();
+
+  /** Backing file. */
+  std::FILE* file_;
+
+  /** File mapping handle, only used on Windows. */
+  void* mapping_;
+
+  /** Mapped file data. */
+  char* mapped_;
+
+  /** Number of mapped bytes. */
+  uint64_t mappedSize_;
+
+  /** Number of bytes written to the file. */
+  uint64_t fileSize_;
+
+  /** Number of stored rows. */
+  size_t rowCount_;
+
+  /** Chunk index, ordered by first row. */
+  std::vector< Chunk > chunks_;
+
+  /** Chunk being appended. */
+  std::vector< char > chunkBuffer_;
+};
+}  // namespace odbc
+}  // namespace trino
+
+#endif  //_TRINO_ODBC_SPILL_STORE
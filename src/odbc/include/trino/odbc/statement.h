@@ -23,10 +23,18 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "trino/odbc/app/application_data_buffer.h"
+#include "trino/odbc/app/parameter.h"
 #include "trino/odbc/common_types.h"
 #include "trino/odbc/diagnostic/diagnosable_adapter.h"
 #include "trino/odbc/meta/column_meta.h"
@@ -40,14 +48,42 @@ namespace odbc {
 struct StatementAttributes;
 class Connection;
 
+/**
+ * Driver manager callback notifying about completion of an asynchronous
+ * function, see SQL_ATTR_ASYNC_STMT_PCALLBACK.
+ */
+typedef SQLRETURN(SQL_API* AsyncNotificationCallback)(SQLPOINTER context,
+                                                       int last);
+
 /**
  * SQL-statement abstraction. Holds SQL query user buffers data and
  * call result.
+ *
+ * With SQL_ATTR_ASYNC_ENABLE on, executing and fetching run on the driver
+ * worker pool and return SQL_STILL_EXECUTING until the application calls
+ * the same function again after the work is done. While a function runs
+ * asynchronously the worker owns the statement; the driver manager only
+ * lets the application poll it or cancel it.
+ *
+ * Statements of one connection can execute and fetch on different threads
+ * at the same time. Every call takes the lock of its own handle only, so
+ * calls on one statement are serialized while other statements proceed;
+ * SQLCancel from another thread interrupts the running call instead of
+ * waiting for it.
  */
 class IGNITE_IMPORT_EXPORT Statement : public diagnostic::DiagnosableAdapter {
   friend class Connection;
 
  public:
+  /** Maximum number of parameter sets inserted by one batch statement. */
+  static const size_t MAX_BATCH_ROWS = 1000;
+
+  /**
+   * Length of a batch statement after which no more parameter sets are
+   * added, well below the default query length limit of Trino.
+   */
+  static const size_t MAX_BATCH_QUERY_LENGTH = 512 * 1024;
+
   /**
    * Destructor.
    */
@@ -65,6 +101,33 @@ class IGNITE_IMPORT_EXPORT Statement : public diagnostic::DiagnosableAdapter {
   void BindColumn(uint16_t columnIdx, int16_t targetType, void* targetValue,
                   SqlLen bufferLength, SqlLen* strLengthOrIndicator);
 
+  /**
+   * Bind parameter.
+   *
+   * @param paramIdx Parameter index.
+   * @param ioType Type of the parameter (input/output).
+   * @param bufferType The data type of the parameter.
+   * @param paramSqlType The SQL data type of the parameter.
+   * @param columnSize  The size of the column or expression of the
+   *     corresponding parameter marker.
+   * @param decDigits  The decimal digits of the column or expression of the
+   *     corresponding parameter marker.
+   * @param buffer A pointer to a buffer for the parameter's data.
+   * @param bufferLen Length of the ParameterValuePtr buffer in bytes.
+   * @param resLen A pointer to a buffer for the parameter's length.
+   */
+  void BindParameter(uint16_t paramIdx, int16_t ioType, int16_t bufferType,
+                     int16_t paramSqlType, SqlUlen columnSize,
+                     int16_t decDigits, void* buffer, SqlLen bufferLen,
+                     SqlLen* resLen);
+
+  /**
+   * Get number of parameter markers of the prepared query.
+   *
+   * @param paramNum Number of parameters.
+   */
+  void GetParametersNumber(uint16_t& paramNum);
+
   /**
    * Set column binding offset pointer.
    *
@@ -153,6 +216,15 @@ class IGNITE_IMPORT_EXPORT Statement : public diagnostic::DiagnosableAdapter {
    */
   void CancelSqlQuery();
 
+  /**
+   * Interrupt the execution or fetch another thread is running on the
+   * statement. Does not wait for the function, which fails with HY008.
+   *
+   * @return @c true if a query was executed or fetched, @c false if
+   *     CancelSqlQuery() should be called instead.
+   */
+  bool InterruptSqlQuery();
+
   /**
    * Get columns metadata.
    *
@@ -367,6 +439,17 @@ class IGNITE_IMPORT_EXPORT Statement : public diagnostic::DiagnosableAdapter {
    */
   void RestoreDescriptor(DescType type);
 
+  using diagnostic::DiagnosableAdapter::AddStatusRecord;
+
+  /**
+   * Add new status record. The records of a function running
+   * asynchronously are kept with the function until it is polled, as the
+   * application may read the records of the statement meanwhile.
+   *
+   * @param rec Record.
+   */
+  virtual void AddStatusRecord(const diagnostic::DiagnosticRecord& rec);
+
  protected:
   /**
    * Constructor.
@@ -459,9 +542,92 @@ class IGNITE_IMPORT_EXPORT Statement : public diagnostic::DiagnosableAdapter {
    * Get number parameters required by the prepared statement.
    *
    * @param paramNum Number of parameters.
+   * @return Operation result.
    */
   SqlResult::Type InternalGetParametersNumber(uint16_t& paramNum);
 
+  /**
+   * Bind parameter.
+   * Internal call.
+   *
+   * @param paramIdx Parameter index.
+   * @param ioType Type of the parameter (input/output).
+   * @param bufferType The data type of the parameter.
+   * @param paramSqlType The SQL data type of the parameter.
+   * @param columnSize  The size of the column or expression of the
+   *     corresponding parameter marker.
+   * @param decDigits  The decimal digits of the column or expression of the
+   *     corresponding parameter marker.
+   * @param buffer A pointer to a buffer for the parameter's data.
+   * @param bufferLen Length of the ParameterValuePtr buffer in bytes.
+   * @param resLen A pointer to a buffer for the parameter's length.
+   * @return Operation result.
+   */
+  SqlResult::Type InternalBindParameter(uint16_t paramIdx, int16_t ioType,
+                                        int16_t bufferType,
+                                        int16_t paramSqlType,
+                                        SqlUlen columnSize, int16_t decDigits,
+                                        void* buffer, SqlLen bufferLen,
+                                        SqlLen* resLen);
+
+  /**
+   * Execute the prepared query with EXECUTE IMMEDIATE, passing the bound
+   * parameter values as literal arguments.
+   *
+   * @param paramNum Number of parameter markers.
+   * @return Operation result.
+   */
+  SqlResult::Type InternalExecuteWithParameters(uint16_t paramNum);
+
+  /**
+   * Execute the prepared query once for every parameter set of the bound
+   * parameter arrays. Rows for a single row INSERT ... VALUES statement are
+   * sent in batches of multi-row statements with the values inlined, other
+   * statements are executed for each set with EXECUTE IMMEDIATE.
+   *
+   * @param paramNum Number of parameter markers.
+   * @return Operation result.
+   */
+  SqlResult::Type InternalExecuteParameterArray(uint16_t paramNum);
+
+  /**
+   * Get the bound values of a parameter set as SQL literals.
+   *
+   * @param rowIdx Index of the parameter set.
+   * @param paramNum Number of parameter markers.
+   * @param literals Literals, one for every marker.
+   * @return Operation result.
+   */
+  SqlResult::Type GetParameterLiterals(SqlUlen rowIdx, uint16_t paramNum,
+                                       std::vector< std::string >& literals);
+
+  /**
+   * Run a query of a parameter array as the underlying query, so SQLCancel
+   * can interrupt it.
+   *
+   * @param query SQL query carrying the values.
+   * @param deadline End of the query timeout of the whole parameter array.
+   * @param rejected Set to @c true if the server rejected the query, so it
+   *     is known not to have run.
+   * @param stopped Set to @c true if the query was interrupted or timed out,
+   *     so the rest of the parameter array must not run.
+   * @return Operation result.
+   */
+  SqlResult::Type RunParameterArrayQuery(
+      const std::string& query,
+      const std::chrono::steady_clock::time_point& deadline, bool& rejected,
+      bool& stopped);
+
+  /**
+   * Check whether a parameter array must stop before its next query, and
+   * add the status record if it must.
+   *
+   * @param deadline End of the query timeout of the whole parameter array.
+   * @return @c true if the statement was interrupted or the timeout expired.
+   */
+  bool IsParameterArrayStopped(
+      const std::chrono::steady_clock::time_point& deadline);
+
   /**
    * Get value of the column in the result set.
    *
@@ -540,6 +706,54 @@ class IGNITE_IMPORT_EXPORT Statement : public diagnostic::DiagnosableAdapter {
    */
   SqlResult::Type InternalFetchRow();
 
+  /**
+   * Fetch rows of the rowset starting at the current cursor position.
+   *
+   * @return Operation result.
+   */
+  SqlResult::Type FetchRowset();
+
+  /**
+   * Run a function that may be executed asynchronously and set the
+   * diagnostic header. Replaces IGNITE_ODBC_API_CALL for such functions.
+   *
+   * Starts the function on the worker pool if asynchronous execution is
+   * enabled, polls it if it is already running and runs it on the calling
+   * thread otherwise.
+   *
+   * @param function ODBC function identifier, one of the SQL_API_* values.
+   * @param operation Function body.
+   */
+  void AsyncApiCall(uint16_t function,
+                    const std::function< SqlResult::Type() >& operation);
+
+  /**
+   * Check the state of the function running asynchronously. Once it is
+   * done, the operation is reset and its result is returned.
+   *
+   * @param function ODBC function identifier of the calling function.
+   * @return Operation result.
+   */
+  SqlResult::Type PollAsyncOperation(uint16_t function);
+
+  /**
+   * Block until the function running asynchronously is done.
+   */
+  void WaitAsyncOperation();
+
+  /**
+   * Close the underlying query and replace it.
+   *
+   * @param query New query, the statement takes ownership.
+   * @param sql SQL text of the query if it is a prepared data query.
+   */
+  void SetCurrentQuery(Query* query, const std::string& sql = std::string());
+
+  /**
+   * Interrupt the underlying query, if any.
+   */
+  void InterruptCurrentQuery();
+
   /**
    * Get number of columns in the result set.
    *
@@ -687,15 +901,63 @@ class IGNITE_IMPORT_EXPORT Statement : public diagnostic::DiagnosableAdapter {
    */
   uint16_t SqlResultToRowResult(SqlResult::Type value);
 
+  /** Function running asynchronously. */
+  struct AsyncOperation {
+    /** ODBC function identifier, one of the SQL_API_* values. */
+    uint16_t function;
+
+    /** Result, valid once the function is done. */
+    SqlResult::Type result;
+
+    /** Set once the function is done. */
+    bool done;
+
+    /** Set when the application cancels the function. */
+    bool cancelled;
+
+    /**
+     * Diagnostic records of the function, moved to the statement when the
+     * function is polled after it is done.
+     */
+    diagnostic::DiagnosticRecordStorage records;
+
+    /** Time the function was started. */
+    std::chrono::steady_clock::time_point start;
+
+    /** Lock guarding the flags. */
+    std::mutex mutex;
+
+    /** Condition signalled when the function is done. */
+    std::condition_variable cv;
+  };
+
   /** Connection associated with the statement. */
   Connection& connection;
 
   /** Column bindings. */
   app::ColumnBindingMap columnBindings;
 
+  /** Parameter bindings. */
+  app::ParameterBindingMap paramBindings;
+
+  /** SQL text of the prepared query, markers included. */
+  std::string preparedSql;
+
   /** Underlying query. */
   std::unique_ptr< Query > currentQuery;
 
+  /**
+   * Lock guarding replacement of the underlying query, which SQLCancel
+   * interrupts while a function runs on another thread.
+   */
+  std::mutex queryMutex;
+
+  /**
+   * Set when the underlying query is interrupted, so a parameter array does
+   * not start its next query. Guarded by queryMutex.
+   */
+  bool interrupted;
+
   /** Buffer to store number of rows fetched by the last fetch. */
   SQLULEN* rowsFetched;
 
@@ -708,6 +970,42 @@ class IGNITE_IMPORT_EXPORT Statement : public diagnostic::DiagnosableAdapter {
   /** Row array size. */
   SqlUlen rowArraySize;
 
+  /** Number of parameter sets in the bound parameter arrays. */
+  SqlUlen paramSetSize;
+
+  /** Buffer to store number of parameter sets processed. */
+  SQLULEN* paramsProcessed;
+
+  /** Array to store statuses of parameter sets. */
+  SQLUSMALLINT* paramStatuses;
+
+  /** Cursor type used for the next query. */
+  SqlUlen cursorType;
+
+  /** Maximum number of rows to return, zero means no limit. */
+  SqlUlen maxRows;
+
+  /** Query timeout in seconds, zero means no limit. */
+  SqlUlen queryTimeout;
+
+  /** Asynchronous execution mode. */
+  SqlUlen asyncEnable;
+
+  /** Function running asynchronously, null if there is none. */
+  std::shared_ptr< AsyncOperation > asyncOperation;
+
+  /** Driver manager completion callback, null in polling mode. */
+  AsyncNotificationCallback asyncCallback;
+
+  /** Context passed to the completion callback. */
+  SQLPOINTER asyncCallbackContext;
+
+  /**
+   * Set while a function executes or fetches synchronously, which
+   * SQLCancel from another thread interrupts.
+   */
+  std::atomic< bool > executing;
+
   /** implicitly allocated ARD */
   std::unique_ptr< Descriptor > ardi;
 
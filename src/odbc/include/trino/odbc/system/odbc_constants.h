@@ -51,6 +51,30 @@
 // Internal SQL connection attribute to set log level
 #define SQL_ATTR_TRINOLOG_DEBUG 65536
 
+// Internal SQL environment and connection attribute to get the number of bytes
+// held by decoded result pages
+#define SQL_ATTR_TRINO_MEMORY_USAGE 65537
+
+// Internal SQL environment attribute to set the result memory limit in bytes
+// for all connections of the environment
+#define SQL_ATTR_TRINO_MEMORY_LIMIT 65538
+
+// Internal SQL connection attribute to get the number of queries answered by
+// the result cache
+#define SQL_ATTR_TRINO_RESULT_CACHE_HITS 65539
+
+// Internal SQL connection attribute to get the number of cacheable queries
+// that were not found in the result cache
+#define SQL_ATTR_TRINO_RESULT_CACHE_MISSES 65540
+
+// Internal SQL connection attribute to drop the catalog metadata cached for
+// the endpoint and user of the connection
+#define SQL_ATTR_TRINO_METADATA_CACHE_INVALIDATE 65541
+
+// Internal SQL connection attribute to get the driver metrics in the
+// Prometheus text format, as a wide character string
+#define SQL_ATTR_TRINO_METRICS 65542
+
 // Internal flag to use database as catalog or schema
 // true if databases are reported as catalog, false if databases are reported as
 // schema
@@ -0,0 +1,154 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#ifndef _TRINO_ODBC_TIMER_SERVICE
+#define _TRINO_ODBC_TIMER_SERVICE
+
+#include <stdint.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <ignite/common/common.h>
+
+namespace trino {
+namespace odbc {
+/**
+ * Driver-wide timer service.
+ *
+ * Timers are kept in a hashed timing wheel served by a single thread, so
+ * arming and cancelling a timer are constant time operations and idle
+ * statements cost no thread. The thread is started with the first timer and
+ * sleeps while no timer is pending. Callbacks run on the timer thread and
+ * must be short; they must not refer to objects that can be destroyed
+ * before the timer is cancelled.
+ */
+class IGNITE_IMPORT_EXPORT TimerService {
+ public:
+  /** Timer identifier, zero is never used. */
+  typedef uint64_t TimerId;
+
+  /** Callback run when a timer expires. */
+  typedef std::function< void() > Callback;
+
+  /**
+   * Get the driver-wide instance.
+   *
+   * @return Timer service.
+   */
+  static TimerService& GetInstance();
+
+  /**
+   * Constructor.
+   *
+   * @param tick Wheel resolution. Timers expire up to one tick late.
+   * @param slotCount Number of wheel slots.
+   */
+  explicit TimerService(
+      std::chrono::milliseconds tick = std::chrono::milliseconds(100),
+      size_t slotCount = 512);
+
+  /**
+   * Destructor. Stops the timer thread, pending timers do not fire.
+   */
+  ~TimerService();
+
+  /**
+   * Arm a timer.
+   *
+   * @param delay Time until the timer expires.
+   * @param callback Callback to run on expiry.
+   * @return Timer identifier.
+   */
+  TimerId Schedule(std::chrono::milliseconds delay, Callback callback);
+
+  /**
+   * Disarm a timer.
+   *
+   * @param id Timer identifier.
+   * @return @c true if the timer was pending, @c false if it has already
+   *     expired or was cancelled.
+   */
+  bool Cancel(TimerId id);
+
+  /**
+   * Get number of pending timers.
+   *
+   * @return Number of timers.
+   */
+  size_t GetPendingCount() const;
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(TimerService);
+
+  /** Armed timer. */
+  struct Timer {
+    /** Tick the timer expires at. */
+    uint64_t expiry;
+
+    /** Callback. */
+    Callback callback;
+  };
+
+  /**
+   * Timer thread body.
+   */
+  void Run();
+
+  /** Wheel resolution. */
+  const std::chrono::milliseconds tick_;
+
+  /** Wheel slots, each maps timer identifiers to timers. */
+  std::vector< std::unordered_map< TimerId, Timer > > slots_;
+
+  /** Slot of every pending timer. */
+  std::unordered_map< TimerId, size_t > index_;
+
+  /** Time of tick zero. */
+  std::chrono::steady_clock::time_point start_;
+
+  /** Last processed tick. */
+  uint64_t currentTick_;
+
+  /** Last assigned timer identifier. */
+  TimerId lastId_;
+
+  /** Flag asking the timer thread to exit. */
+  bool stopping_;
+
+  /** Lock guarding the wheel. */
+  mutable std::mutex mutex_;
+
+  /** Condition the timer thread sleeps on. */
+  std::condition_variable cv_;
+
+  /** Timer thread, started with the first timer. */
+  std::thread thread_;
+};
+}  // namespace odbc
+}  // namespace trino
+
+#endif  //_TRINO_ODBC_TIMER_SERVICE
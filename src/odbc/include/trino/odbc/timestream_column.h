@@ -24,6 +24,7 @@
 #include <stdint.h>
 #include <trino/odbc/app/application_data_buffer.h>
 #include "trino/odbc/meta/column_meta.h"
+#include "trino/odbc/page_arena.h"
 /*#*/
 #include <aws/trino-query/model/Row.h>
 
@@ -78,56 +79,88 @@ class TrinoColumn {
   ConversionResult::Type ReadToBuffer(const Datum& datum,
                                       ApplicationDataBuffer& dataBuf) const;
 
+  /**
+   * Read decoded column data and store it in application data buffer.
+   *
+   * @param kind Kind of the decoded value.
+   * @param value Decoded value, as produced by DecodeDatum(). Must be
+   *     zero-terminated.
+   * @param length Length of the value in bytes.
+   * @param dataBuf Application data buffer.
+   * @return Operation result.
+   */
+  ConversionResult::Type ReadToBuffer(PageCell::Kind::Type kind,
+                                      const char* value, size_t length,
+                                      ApplicationDataBuffer& dataBuf) const;
+
+  /**
+   * Decode datum into its storable form. Scalar values are kept as
+   * received, nested values are rendered to text.
+   *
+   * @param datum datum which contains the result data.
+   * @param value Decoded value.
+   * @return Kind of the decoded value.
+   */
+  PageCell::Kind::Type DecodeDatum(const Datum& datum,
+                                   std::string& value) const;
+
  private:
   /**
-   * Parse Datum data and save result to dataBuf
+   * Put decoded value to dataBuf.
    *
-   * @param datum datum which contains the result data
+   * @param kind Kind of the decoded value.
+   * @param value Zero-terminated decoded value.
+   * @param length Length of the value in bytes.
    * @param dataBuf Application data buffer.
    * @return Operation result.
    */
-  ConversionResult::Type ParseDatum(const Datum& datum,
-                                    ApplicationDataBuffer& dataBuf) const;
+  ConversionResult::Type PutValue(PageCell::Kind::Type kind, const char* value,
+                                  size_t length,
+                                  ApplicationDataBuffer& dataBuf) const;
 
   /**
-   * Parse scalar data type in datum and save result to dataBuf.
+   * Render nested datum element to text.
    *
-   * @param datum datum which contains the result data
+   * @param datum datum which contains the element data.
+   * @param result String to append the rendered element to.
+   */
+  void AppendElement(const Datum& datum, std::string& result) const;
+
+  /**
+   * Parse scalar value and save result to dataBuf.
+   *
+   * @param value Zero-terminated scalar value.
+   * @param length Length of the value in bytes.
    * @param dataBuf Application data buffer.
    * @return Operation result.
    */
-  ConversionResult::Type ParseScalarType(const Datum& datum,
+  ConversionResult::Type ParseScalarType(const char* value, size_t length,
                                          ApplicationDataBuffer& dataBuf) const;
 
   /**
-   * Parse TimeSeries data type in datum and save result to dataBuf.
+   * Render TimeSeries data type in datum to text.
    *
    * @param datum datum which contains the result data
-   * @param dataBuf Application data buffer.
-   * @return Operation result.
+   * @param result Rendered value.
    */
-  ConversionResult::Type ParseTimeSeriesType(
-      const Datum& datum, ApplicationDataBuffer& dataBuf) const;
+  void FormatTimeSeriesType(const Datum& datum, std::string& result) const;
 
   /**
-   * Parse Array data type in datum and save result to dataBuf.
+   * Render Array data type in datum to text.
    *
    * @param datum datum which contains the result data
-   * @param dataBuf Application data buffer.
-   * @return Operation result.
+   * @param result Rendered value.
    */
-  ConversionResult::Type ParseArrayType(const Datum& datum,
-                                        ApplicationDataBuffer& dataBuf) const;
+  void FormatArrayType(const Datum& datum, std::string& result) const;
 
   /**
-   * Parse Row data type in datum and save result to dataBuf.
+   * Render Row data type in datum to text.
    *
    * @param datum datum which contains the result data
-   * @param dataBuf Application data buffer.
-   * @return Operation result.
+   * @param result Rendered value.
+   * @return False if the row has no data.
    */
-  ConversionResult::Type ParseRowType(const Datum& datum,
-                                      ApplicationDataBuffer& dataBuf) const;
+  bool FormatRowType(const Datum& datum, std::string& result) const;
 
   /** The column index */
   uint32_t columnIdx_;
@@ -29,12 +29,8 @@
 #include "trino/odbc/common_types.h"
 #include "trino/odbc/trino_column.h"
 #include "trino/odbc/meta/column_meta.h"
-
-/*#*/
-#include <aws/core/utils/memory/stl/AWSVector.h>
-#include <aws/trino-query/model/Row.h>
-
-using client::TrinoQuery::Model::Row; /*#*/
+#include "trino/odbc/page_arena.h"
+#include "trino/odbc/spill_store.h"
 
 namespace trino {
 namespace odbc {
@@ -45,10 +41,20 @@ class TrinoCursor {
  public:
   /**
    * Constructor.
-   * @param rowVec Row vector.
+   * @param page Decoded page. The cursor borrows its rows.
+   * @param columnMetadataVec Column metadata vector.
+   */
+  TrinoCursor(std::shared_ptr< const ResultPage > page,
+              const meta::ColumnMetaVector& columnMetadataVec);
+
+  /**
+   * Constructor for a scrollable cursor.
+   * @param spill Spill store holding all rows fetched so far. Rows appended
+   *     later become visible to the cursor.
    * @param columnMetadataVec Column metadata vector.
    */
-  TrinoCursor(const Aws::Vector< Row > rowVec, const meta::ColumnMetaVector& columnMetadataVec); /*@*/
+  TrinoCursor(std::shared_ptr< SpillStore > spill,
+              const meta::ColumnMetaVector& columnMetadataVec);
 
   /**
    * Destructor.
@@ -69,6 +75,24 @@ class TrinoCursor {
    */
   bool HasData() const;
 
+  /**
+   * Get current row position.
+   *
+   * @return Row position, starts at 1. 0 means before the first row.
+   */
+  size_t GetPosition() const {
+    return curPos_;
+  }
+
+  /**
+   * Set current row position. Only supported by scrollable cursors.
+   *
+   * @param pos Row position, starts at 1. 0 means before the first row.
+   */
+  void SetPosition(size_t pos) {
+    curPos_ = pos;
+  }
+
   /**
    * Get column number in a row.
    *
@@ -116,11 +140,11 @@ class TrinoCursor {
    */
   bool EnsureColumnDiscovered(uint32_t columnIdx);
 
-  /** Resultset rows */
-  const Aws::Vector< Row > rowVec_; /*#*/
+  /** Decoded resultset page */
+  std::shared_ptr< const ResultPage > page_;
 
-  /** The iterator to beginning of cursor */
-  Aws::Vector< Row >::const_iterator iterator_; /*#*/
+  /** Spill store, only set for scrollable cursors */
+  std::shared_ptr< SpillStore > spill_;
 
   /** The column metadata vector*/
   const meta::ColumnMetaVector& columnMetadataVec_;
@@ -128,8 +152,8 @@ class TrinoCursor {
   /** Columns. */
   std::vector< TrinoColumn > columns_;
 
-  /* current iterator position, start from 1 when used */
-  int curPos_;
+  /* current row position, start from 1 when used */
+  size_t curPos_;
 };
 }  // namespace odbc
 }  // namespace trino
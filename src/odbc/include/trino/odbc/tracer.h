@@ -0,0 +1,232 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _TRINO_ODBC_TRACER
+#define _TRINO_ODBC_TRACER
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <ignite/common/common.h>
+
+#include "trino/odbc/log_queue.h"
+
+namespace trino {
+namespace odbc {
+/**
+ * Driver-wide tracer writing Chrome trace events.
+ *
+ * Every span becomes one complete event of the JSON array format, carrying
+ * the process and thread it ran on, so the file opens in chrome://tracing
+ * and in Perfetto. Events are pushed to a lock-free queue and written by a
+ * background thread; when the writer falls behind, events are dropped
+ * instead of slowing the driver down. The closing bracket of the array is
+ * never written, which the format allows, so the file stays valid however
+ * the process ends.
+ */
+class IGNITE_IMPORT_EXPORT Tracer {
+ public:
+  /** Clock of the event timestamps. */
+  typedef std::chrono::steady_clock Clock;
+
+  /** Number of events the queue holds. */
+  static const size_t QUEUE_CAPACITY = 65536;
+
+  /**
+   * Scoped span, recorded as an event when it ends. Costs one atomic load
+   * while tracing is off.
+   */
+  class Span {
+   public:
+    /**
+     * Constructor. Starts the span.
+     *
+     * @param name Span name, a string literal without characters that need
+     *     escaping in JSON.
+     * @param category Span category, same rules as for the name.
+     */
+    explicit Span(const char* name, const char* category = "odbc")
+        : name_(name), category_(category), start_() {
+      if (Tracer::IsEnabled()) {
+        start_ = Clock::now();
+      }
+    }
+
+    /**
+     * Destructor. Ends the span.
+     */
+    ~Span() {
+      if (start_ != Clock::time_point() && Tracer::IsEnabled()) {
+        Tracer::GetInstance().Complete(name_, category_, start_,
+                                       Clock::now());
+      }
+    }
+
+   private:
+    IGNITE_NO_COPY_ASSIGNMENT(Span);
+
+    /** Span name. */
+    const char* name_;
+
+    /** Span category. */
+    const char* category_;
+
+    /** Start time, the epoch if tracing was off when the span started. */
+    Clock::time_point start_;
+  };
+
+  /**
+   * Get the driver-wide instance.
+   *
+   * @return Tracer.
+   */
+  static Tracer& GetInstance();
+
+  /**
+   * Check if tracing is on.
+   *
+   * @return @c true if spans are recorded.
+   */
+  static bool IsEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Constructor.
+   */
+  Tracer();
+
+  /**
+   * Destructor. Stops tracing.
+   */
+  ~Tracer();
+
+  /**
+   * Start writing events to a file, which is truncated. Does nothing if
+   * events are already written to a file.
+   *
+   * @param path File path.
+   * @return @c true if events are written to the file.
+   */
+  bool Start(const std::string& path);
+
+  /**
+   * Stop recording spans, write the pending events and close the file.
+   */
+  void Stop();
+
+  /**
+   * Record a complete event.
+   *
+   * @param name Event name, see Span.
+   * @param category Event category, see Span.
+   * @param start Start time.
+   * @param end End time.
+   */
+  void Complete(const char* name, const char* category, Clock::time_point start,
+                Clock::time_point end);
+
+  /**
+   * Write the pending events and stop the writer thread. The thread is
+   * started again by the next event.
+   */
+  void Flush();
+
+  /**
+   * Get number of events dropped because the queue was full.
+   *
+   * @return Number of events.
+   */
+  int64_t GetDroppedCount() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(Tracer);
+
+  /**
+   * Start the writer thread unless it runs.
+   */
+  void StartWriter();
+
+  /**
+   * Drain the queue and stop the writer thread. The control lock must be
+   * held.
+   */
+  void StopWriter();
+
+  /**
+   * Writer thread routine.
+   */
+  void RunWriter();
+
+  /** Whether spans are recorded. */
+  static std::atomic< bool > enabled;
+
+  /** Events not written yet. */
+  LogQueue queue_;
+
+  /** Trace file. */
+  std::FILE* file_;
+
+  /** Trace file path. */
+  std::string path_;
+
+  /** Timestamps are relative to this time. */
+  Clock::time_point origin_;
+
+  /** Process identifier written with every event. */
+  uint64_t pid_;
+
+  /** Whether no event has been written to the file yet. */
+  bool first_;
+
+  /** Number of events dropped because the queue was full. */
+  std::atomic< int64_t > dropped_;
+
+  /** Lock serializing starting and stopping the writer and the file. */
+  std::mutex controlMutex_;
+
+  /** Lock guarding the stop flag of the writer. */
+  std::mutex writerMutex_;
+
+  /** Wakes the writer up when it has to stop. */
+  std::condition_variable writerCv_;
+
+  /** Writer thread. */
+  std::thread writer_;
+
+  /** Whether the writer thread runs. */
+  std::atomic< bool > writerRunning_;
+
+  /** Whether the writer has to drain the queue and exit. */
+  bool stopping_;
+};
+}  // namespace odbc
+}  // namespace trino
+
+#endif  //_TRINO_ODBC_TRACER
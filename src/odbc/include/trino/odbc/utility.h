@@ -227,6 +227,14 @@ IGNITE_IMPORT_EXPORT std::string Rtrim(const std::string& s);
  */
 IGNITE_IMPORT_EXPORT std::string Trim(const std::string& s);
 
+/**
+ * Quote a string as a SQL string literal.
+ * @param value String to be quoted
+ *
+ * @return the literal, with quotes inside the string doubled.
+ */
+IGNITE_IMPORT_EXPORT std::string QuoteSqlString(const std::string& value);
+
 /**
  * Converts a string with search patterns to regular expression string.
  * @param pattern Pattern to be converted
@@ -0,0 +1,148 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _TRINO_ODBC_WORKER_POOL
+#define _TRINO_ODBC_WORKER_POOL
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ignite/common/common.h>
+
+namespace trino {
+namespace odbc {
+/**
+ * Driver-wide pool of worker threads.
+ *
+ * Runs work the driver does on behalf of the application in the
+ * background, such as asynchronously executed statement functions. Tasks
+ * are run in submission order. Threads are started on demand, when no
+ * thread is idle, up to the thread limit; further tasks wait in the queue.
+ * Started threads stay for the lifetime of the pool.
+ *
+ * The driver-wide pools are drained when the last environment is freed, so
+ * no task outlives the driver.
+ */
+class IGNITE_IMPORT_EXPORT WorkerPool {
+ public:
+  /** Task run by a worker. */
+  typedef std::function< void() > Task;
+
+  /**
+   * Get the driver-wide instance.
+   *
+   * @return Worker pool.
+   */
+  static WorkerPool& GetInstance();
+
+  /**
+   * Get the driver-wide pool for server requests made in the background,
+   * such as result page fetches and query cancels. Its tasks wait for the
+   * server and for the application reading the pages, so the pool has no
+   * thread limit and can not be filled up by the tasks the others wait for.
+   *
+   * @return Worker pool.
+   */
+  static WorkerPool& GetRequestInstance();
+
+  /**
+   * Constructor.
+   *
+   * @param maxThreads Maximum number of threads.
+   */
+  explicit WorkerPool(size_t maxThreads);
+
+  /**
+   * Destructor. Runs the queued tasks and joins the threads.
+   */
+  ~WorkerPool();
+
+  /**
+   * Queue a task.
+   *
+   * @param task Task. Exceptions it throws are logged and dropped.
+   */
+  void Submit(Task task);
+
+  /**
+   * Get number of started threads.
+   *
+   * @return Number of threads.
+   */
+  size_t GetThreadCount() const;
+
+  /**
+   * Get number of tasks waiting for a thread.
+   *
+   * @return Number of tasks.
+   */
+  size_t GetQueuedCount() const;
+
+  /**
+   * Wait until no task is queued or running. Tasks submitted meanwhile are
+   * waited for as well.
+   */
+  void Drain();
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(WorkerPool);
+
+  /**
+   * Worker thread body.
+   */
+  void Run();
+
+  /** Maximum number of threads. */
+  const size_t maxThreads_;
+
+  /** Queued tasks. */
+  std::deque< Task > tasks_;
+
+  /** Number of threads waiting for a task. */
+  size_t idle_;
+
+  /** Number of tasks being run. */
+  size_t running_;
+
+  /** Flag asking the threads to exit once the queue is empty. */
+  bool stopping_;
+
+  /** Lock guarding the queue. */
+  mutable std::mutex mutex_;
+
+  /** Condition the idle threads wait on. */
+  std::condition_variable cv_;
+
+  /** Condition Drain() waits on. */
+  std::condition_variable drained_;
+
+  /** Started threads. */
+  std::vector< std::thread > threads_;
+};
+}  // namespace odbc
+}  // namespace trino
+
+#endif  //_TRINO_ODBC_WORKER_POOL
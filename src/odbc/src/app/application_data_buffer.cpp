@@ -226,7 +226,7 @@ ConversionResult::Type ApplicationDataBuffer::PutValToStrBuffer(
   std::stringstream converter;
   converter << value;
   int32_t written = 0;
-  return PutStrToStrBuffer< CharT >(converter.str(), written);
+  return PutStrToStrBuffer< CharT >(converter.str().c_str(), written);
 }
 
 template < typename CharT >
@@ -237,12 +237,12 @@ ConversionResult::Type ApplicationDataBuffer::PutValToStrBuffer(
   // NOTE: Need to cast to larger integer - or will mistake it for a character.
   converter << static_cast< int32_t >(value);
   int32_t written = 0;
-  return PutStrToStrBuffer< CharT >(converter.str(), written);
+  return PutStrToStrBuffer< CharT >(converter.str().c_str(), written);
 }
 
 template < typename OutCharT, typename InCharT >
 ConversionResult::Type ApplicationDataBuffer::PutStrToStrBuffer(
-    const std::basic_string< InCharT >& value, int32_t& written) {
+    const InCharT* value, int32_t& written) {
   LOG_DEBUG_MSG("PutStrToStrBuffer is called with value " << value);
   written = 0;
 
@@ -265,11 +265,11 @@ ConversionResult::Type ApplicationDataBuffer::PutStrToStrBuffer(
   if (inCharSize == 1) {
     if (outCharSize == 2 || outCharSize == 4) {
       lenWrittenOrRequired = utility::CopyUtf8StringToSqlWcharString(
-          reinterpret_cast< const char* >(value.c_str()),
+          reinterpret_cast< const char* >(value),
           reinterpret_cast< SQLWCHAR* >(dataPtr), buflen, isTruncated);
     } else if (sizeof(OutCharT) == 1) {
       lenWrittenOrRequired = utility::CopyUtf8StringToSqlCharString(
-          reinterpret_cast< const char* >(value.c_str()),
+          reinterpret_cast< const char* >(value),
           reinterpret_cast< SQLCHAR* >(dataPtr), buflen, isTruncated);
     } else {
       LOG_ERROR_MSG("Unexpected conversion from UTF8 string.");
@@ -459,11 +459,11 @@ ConversionResult::Type ApplicationDataBuffer::PutString(
     case OdbcNativeType::AI_CHAR:
     case OdbcNativeType::AI_BINARY:
     case OdbcNativeType::AI_DEFAULT: {
-      return PutStrToStrBuffer< char >(value, written);
+      return PutStrToStrBuffer< char >(value.c_str(), written);
     }
 
     case OdbcNativeType::AI_WCHAR: {
-      return PutStrToStrBuffer< SQLWCHAR >(value, written);
+      return PutStrToStrBuffer< SQLWCHAR >(value.c_str(), written);
     }
 
     default:
@@ -473,6 +473,28 @@ ConversionResult::Type ApplicationDataBuffer::PutString(
   return ConversionResult::Type::AI_UNSUPPORTED_CONVERSION;
 }
 
+ConversionResult::Type ApplicationDataBuffer::PutString(const char* value,
+                                                        size_t length) {
+  using namespace type_traits;
+  int32_t written = 0;
+
+  switch (type) {
+    case OdbcNativeType::AI_CHAR:
+    case OdbcNativeType::AI_BINARY:
+    case OdbcNativeType::AI_DEFAULT: {
+      return PutStrToStrBuffer< char >(value, written);
+    }
+
+    case OdbcNativeType::AI_WCHAR: {
+      return PutStrToStrBuffer< SQLWCHAR >(value, written);
+    }
+
+    default:
+      // the value is parsed into a number
+      return PutString(std::string(value, length), written);
+  }
+}
+
 ConversionResult::Type ApplicationDataBuffer::PutNull() {
   LOG_DEBUG_MSG("PutNull is called. No data put into buffer");
 
@@ -1328,14 +1350,13 @@ T ApplicationDataBuffer::GetNum() const {
     }
 
     case OdbcNativeType::AI_SIGNED_LONG: {
-      res =
-          static_cast< T >(*reinterpret_cast< const signed long* >(GetData()));
+      res = static_cast< T >(*reinterpret_cast< const SQLINTEGER* >(GetData()));
       break;
     }
 
     case OdbcNativeType::AI_UNSIGNED_LONG: {
-      res = static_cast< T >(
-          *reinterpret_cast< const unsigned long* >(GetData()));
+      res =
+          static_cast< T >(*reinterpret_cast< const SQLUINTEGER* >(GetData()));
       break;
     }
 
@@ -0,0 +1,380 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "trino/odbc/app/parameter.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "trino/odbc/log.h"
+#include "trino/odbc/system/odbc_constants.h"
+#include "trino/odbc/utility.h"
+#include "trino/odbc/utils.h"
+
+namespace {
+/**
+ * Format the date and time parts of a struct tm.
+ *
+ * @param format Format as accepted by strftime.
+ * @param ctime Time.
+ * @return Formatted time.
+ */
+std::string FormatTm(const char* format, const tm& ctime) {
+  char buf[64];
+  size_t len = strftime(buf, sizeof(buf), format, &ctime);
+
+  return std::string(buf, len);
+}
+
+/**
+ * Format fraction of a second.
+ *
+ * @param ns Fraction in nanoseconds.
+ * @return Fraction with a leading dot, empty for zero.
+ */
+std::string FormatFraction(int32_t ns) {
+  if (ns <= 0)
+    return "";
+
+  char buf[16];
+  snprintf(buf, sizeof(buf), ".%09d", ns);
+
+  return buf;
+}
+
+/**
+ * Skip a quoted literal, quoted identifier or comment.
+ *
+ * @param sql SQL query.
+ * @param pos Position in the query.
+ * @return Position after the skipped part, @c pos if nothing starts there.
+ */
+size_t SkipQuotedOrComment(const std::string& sql, size_t pos) {
+  char c = sql[pos];
+
+  if (c == '\'' || c == '"') {
+    // doubled quotes inside are read as two adjacent literals
+    size_t end = sql.find(c, pos + 1);
+    return end == std::string::npos ? sql.size() : end + 1;
+  }
+
+  if (c == '-' && pos + 1 < sql.size() && sql[pos + 1] == '-') {
+    size_t end = sql.find('\n', pos + 2);
+    return end == std::string::npos ? sql.size() : end + 1;
+  }
+
+  if (c == '/' && pos + 1 < sql.size() && sql[pos + 1] == '*') {
+    size_t end = sql.find("*/", pos + 2);
+    return end == std::string::npos ? sql.size() : end + 2;
+  }
+
+  return pos;
+}
+
+/**
+ * Skip white space and comments.
+ *
+ * @param sql SQL query.
+ * @param pos Position in the query.
+ * @return Position of the next character that is neither.
+ */
+size_t SkipBlank(const std::string& sql, size_t pos) {
+  while (pos < sql.size()) {
+    if (std::isspace(static_cast< unsigned char >(sql[pos]))) {
+      ++pos;
+    } else if (sql[pos] == '-' || sql[pos] == '/') {
+      size_t next = SkipQuotedOrComment(sql, pos);
+      if (next == pos)
+        break;
+      pos = next;
+    } else {
+      break;
+    }
+  }
+
+  return pos;
+}
+
+/**
+ * Check if a keyword starts at the position, ignoring case.
+ *
+ * @param sql SQL query.
+ * @param pos Position in the query.
+ * @param keyword Keyword in upper case.
+ * @return @c true if the keyword is there as a whole word.
+ */
+bool IsKeyword(const std::string& sql, size_t pos, const char* keyword) {
+  size_t len = strlen(keyword);
+  if (pos + len > sql.size())
+    return false;
+
+  if (pos > 0
+      && (std::isalnum(static_cast< unsigned char >(sql[pos - 1]))
+          || sql[pos - 1] == '_'))
+    return false;
+
+  for (size_t i = 0; i < len; ++i) {
+    if (std::toupper(static_cast< unsigned char >(sql[pos + i])) != keyword[i])
+      return false;
+  }
+
+  size_t end = pos + len;
+  return end == sql.size()
+         || !(std::isalnum(static_cast< unsigned char >(sql[end]))
+              || sql[end] == '_');
+}
+}  // namespace
+
+namespace trino {
+namespace odbc {
+namespace app {
+Parameter::Parameter() : buffer(), sqlType(), columnSize(), decDigits() {
+  // No-op.
+}
+
+Parameter::Parameter(const ApplicationDataBuffer& buffer, int16_t sqlType,
+                     size_t columnSize, int16_t decDigits)
+    : buffer(buffer),
+      sqlType(sqlType),
+      columnSize(columnSize),
+      decDigits(decDigits) {
+  // No-op.
+}
+
+bool Parameter::GetLiteral(std::string& literal, SqlUlen rowIdx) const {
+  ApplicationDataBuffer value(buffer);
+  value.SetElementOffset(rowIdx);
+
+  const SqlLen* resLen = value.GetResLen();
+  if ((resLen && *resLen == SQL_NULL_DATA) || !value.GetData()) {
+    literal = "NULL";
+    return true;
+  }
+
+  switch (sqlType) {
+    case SQL_CHAR:
+    case SQL_VARCHAR:
+    case SQL_LONGVARCHAR:
+    case SQL_WCHAR:
+    case SQL_WVARCHAR:
+    case SQL_WLONGVARCHAR: {
+      literal = utility::QuoteSqlString(
+          value.GetString(std::numeric_limits< size_t >::max()));
+      return true;
+    }
+
+    case SQL_BIT: {
+      literal = value.GetInt8() != 0 ? "true" : "false";
+      return true;
+    }
+
+    case SQL_TINYINT:
+    case SQL_SMALLINT:
+    case SQL_INTEGER:
+    case SQL_BIGINT: {
+      literal = std::to_string(value.GetInt64());
+      return true;
+    }
+
+    case SQL_REAL:
+    case SQL_FLOAT:
+    case SQL_DOUBLE: {
+      double number = value.GetDouble();
+      if (std::isnan(number)) {
+        literal = "nan()";
+      } else if (std::isinf(number)) {
+        literal = number > 0 ? "infinity()" : "-infinity()";
+      } else {
+        // the exponent makes it a DOUBLE rather than a DECIMAL literal
+        std::ostringstream converter;
+        converter << std::scientific
+                  << std::setprecision(std::numeric_limits< double >::digits10
+                                       + 2)
+                  << number;
+        literal = converter.str();
+      }
+      return true;
+    }
+
+    case SQL_DECIMAL:
+    case SQL_NUMERIC: {
+      Decimal number;
+      value.GetDecimal(number);
+
+      std::ostringstream converter;
+      converter << number;
+      literal = "DECIMAL " + utility::QuoteSqlString(converter.str());
+      return true;
+    }
+
+    case SQL_DATE:
+    case SQL_TYPE_DATE: {
+      tm ctime;
+      common::DateToCTm(value.GetDate(), ctime);
+      literal =
+          "DATE " + utility::QuoteSqlString(FormatTm("%Y-%m-%d", ctime));
+      return true;
+    }
+
+    case SQL_TIME:
+    case SQL_TYPE_TIME: {
+      Time time = value.GetTime();
+      tm ctime;
+      common::TimeToCTm(time, ctime);
+      literal = "TIME "
+                + utility::QuoteSqlString(
+                    FormatTm("%H:%M:%S", ctime)
+                    + FormatFraction(time.GetSecondFraction()));
+      return true;
+    }
+
+    case SQL_TIMESTAMP:
+    case SQL_TYPE_TIMESTAMP: {
+      Timestamp timestamp = value.GetTimestamp();
+      tm ctime;
+      common::TimestampToCTm(timestamp, ctime);
+      literal = "TIMESTAMP "
+                + utility::QuoteSqlString(
+                    FormatTm("%Y-%m-%d %H:%M:%S", ctime)
+                    + FormatFraction(timestamp.GetSecondFraction()));
+      return true;
+    }
+
+    default:
+      LOG_ERROR_MSG("Parameter SQL type " << sqlType << " is not supported");
+      return false;
+  }
+}
+
+bool Parameter::IsDataAtExec(SqlUlen rowIdx) const {
+  ApplicationDataBuffer value(buffer);
+  value.SetElementOffset(rowIdx);
+
+  return value.IsDataAtExec();
+}
+
+uint16_t Parameter::CountMarkers(const std::string& sql) {
+  return static_cast< uint16_t >(FindMarkers(sql).size());
+}
+
+std::vector< size_t > Parameter::FindMarkers(const std::string& sql) {
+  std::vector< size_t > markers;
+  size_t i = 0;
+
+  while (i < sql.size()) {
+    size_t next = SkipQuotedOrComment(sql, i);
+    if (next != i) {
+      i = next;
+    } else {
+      if (sql[i] == '?')
+        markers.push_back(i);
+      ++i;
+    }
+  }
+
+  return markers;
+}
+
+bool Parameter::FindValuesRow(const std::string& sql, size_t& rowStart) {
+  size_t i = SkipBlank(sql, 0);
+  if (!IsKeyword(sql, i, "INSERT"))
+    return false;
+
+  int depth = 0;
+  size_t valuesEnd = std::string::npos;
+  size_t open = std::string::npos;
+  size_t lastOpen = std::string::npos;
+  size_t lastClose = std::string::npos;
+
+  while (i < sql.size()) {
+    size_t next = SkipQuotedOrComment(sql, i);
+    if (next != i) {
+      i = next;
+      continue;
+    }
+
+    char c = sql[i];
+    if (c == '(') {
+      if (depth++ == 0)
+        open = i;
+    } else if (c == ')') {
+      if (--depth < 0)
+        return false;
+      if (depth == 0) {
+        lastOpen = open;
+        lastClose = i;
+      }
+    } else if (depth == 0 && IsKeyword(sql, i, "VALUES")) {
+      valuesEnd = i + 6;
+    }
+    ++i;
+  }
+
+  // the row is the last top-level parenthesized list, it directly follows
+  // VALUES and nothing but blanks follows it
+  if (depth != 0 || valuesEnd == std::string::npos
+      || lastOpen == std::string::npos || lastOpen < valuesEnd
+      || SkipBlank(sql, valuesEnd) != lastOpen
+      || SkipBlank(sql, lastClose + 1) != sql.size())
+    return false;
+
+  rowStart = lastOpen;
+  return true;
+}
+
+std::string Parameter::InlineLiterals(
+    const std::string& sql, const std::vector< size_t >& markers,
+    const std::vector< std::string >& literals, size_t from) {
+  std::string query;
+  size_t pos = from;
+
+  for (size_t i = 0; i < markers.size(); ++i) {
+    query.append(sql, pos, markers[i] - pos);
+    query += literals[i];
+    pos = markers[i] + 1;
+  }
+  query.append(sql, pos, std::string::npos);
+
+  return query;
+}
+
+std::string Parameter::ExecuteImmediate(
+    const std::string& sql, const std::vector< std::string >& literals) {
+  std::string query = "EXECUTE IMMEDIATE '";
+  for (char c : sql) {
+    if (c == '\'')
+      query += '\'';
+    query += c;
+  }
+  query += '\'';
+
+  for (size_t i = 0; i < literals.size(); ++i)
+    query += (i == 0 ? " USING " : ", ") + literals[i];
+
+  return query;
+}
+}  // namespace app
+}  // namespace odbc
+}  // namespace trino
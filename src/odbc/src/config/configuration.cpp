@@ -57,8 +57,33 @@ const AuthType::Type Configuration::DefaultValue::authType = DEFAULT_AUTH_TYPE;
 // Logging Configuration Options
 const LogLevel::Type Configuration::DefaultValue::logLevel = DEFAULT_LOG_LEVEL;
 const std::string Configuration::DefaultValue::logPath = DEFAULT_LOG_PATH;
+const int32_t Configuration::DefaultValue::logFileSize = DEFAULT_LOG_FILE_SIZE;
+const bool Configuration::DefaultValue::logDropOnOverflow =
+    DEFAULT_LOG_DROP_ON_OVERFLOW;
 const int32_t Configuration::DefaultValue::maxRowPerPage = DEFAULT_MAX_ROW_PER_PAGE;
 
+// Result Set Options
+const int32_t Configuration::DefaultValue::resultMemoryLimit = DEFAULT_RESULT_MEMORY_LIMIT;
+const int32_t Configuration::DefaultValue::resultCacheTtl = DEFAULT_RESULT_CACHE_TTL;
+const int32_t Configuration::DefaultValue::resultCacheSize = DEFAULT_RESULT_CACHE_SIZE;
+const std::string Configuration::DefaultValue::resultCacheDir = DEFAULT_RESULT_CACHE_DIR;
+const bool Configuration::DefaultValue::querySharing = DEFAULT_QUERY_SHARING;
+const int32_t Configuration::DefaultValue::metadataCacheTtl = DEFAULT_METADATA_CACHE_TTL;
+const int32_t Configuration::DefaultValue::metadataConcurrency =
+    DEFAULT_METADATA_CONCURRENCY;
+const std::string Configuration::DefaultValue::metadataSnapshotDir =
+    DEFAULT_METADATA_SNAPSHOT_DIR;
+const bool Configuration::DefaultValue::metadataPrefetch =
+    DEFAULT_METADATA_PREFETCH;
+const std::string Configuration::DefaultValue::queryTraceFile =
+    DEFAULT_QUERY_TRACE_FILE;
+const std::string Configuration::DefaultValue::metricsFile =
+    DEFAULT_METRICS_FILE;
+const int32_t Configuration::DefaultValue::metricsInterval =
+    DEFAULT_METRICS_INTERVAL;
+const std::string Configuration::DefaultValue::traceEventFile =
+    DEFAULT_TRACE_EVENT_FILE;
+
 std::string Configuration::ToConnectString() const {
   LOG_DEBUG_MSG("ToConnectString is called");
   ArgumentMap arguments;
@@ -247,6 +272,33 @@ bool Configuration::IsLogPathSet() const {
   return logPath.IsSet();
 }
 
+int32_t Configuration::GetLogFileSize() const {
+  return logFileSize.GetValue();
+}
+
+void Configuration::SetLogFileSize(int32_t size) {
+  this->logFileSize.SetValue(size);
+  Logger::GetLoggerInstance()->SetMaxFileSize(static_cast< uint64_t >(size)
+                                              * 1024 * 1024);
+}
+
+bool Configuration::IsLogFileSizeSet() const {
+  return logFileSize.IsSet();
+}
+
+bool Configuration::GetLogDropOnOverflow() const {
+  return logDropOnOverflow.GetValue();
+}
+
+void Configuration::SetLogDropOnOverflow(bool value) {
+  this->logDropOnOverflow.SetValue(value);
+  Logger::GetLoggerInstance()->SetDropOnOverflow(value);
+}
+
+bool Configuration::IsLogDropOnOverflowSet() const {
+  return logDropOnOverflow.IsSet();
+}
+
 int32_t Configuration::GetMaxRowPerPage() const {
   return maxRowPerPage.GetValue();
 }
@@ -259,6 +311,166 @@ bool Configuration::IsMaxRowPerPageSet() const {
   return maxRowPerPage.IsSet();
 }
 
+int32_t Configuration::GetResultMemoryLimit() const {
+  return resultMemoryLimit.GetValue();
+}
+
+void Configuration::SetResultMemoryLimit(int32_t value) {
+  this->resultMemoryLimit.SetValue(value);
+}
+
+bool Configuration::IsResultMemoryLimitSet() const {
+  return resultMemoryLimit.IsSet();
+}
+
+int32_t Configuration::GetResultCacheTtl() const {
+  return resultCacheTtl.GetValue();
+}
+
+void Configuration::SetResultCacheTtl(int32_t value) {
+  this->resultCacheTtl.SetValue(value);
+}
+
+bool Configuration::IsResultCacheTtlSet() const {
+  return resultCacheTtl.IsSet();
+}
+
+int32_t Configuration::GetResultCacheSize() const {
+  return resultCacheSize.GetValue();
+}
+
+void Configuration::SetResultCacheSize(int32_t value) {
+  this->resultCacheSize.SetValue(value);
+}
+
+bool Configuration::IsResultCacheSizeSet() const {
+  return resultCacheSize.IsSet();
+}
+
+const std::string& Configuration::GetResultCacheDir() const {
+  return resultCacheDir.GetValue();
+}
+
+void Configuration::SetResultCacheDir(const std::string& dir) {
+  if (ignite::odbc::common::IsValidDirectory(dir)) {
+    this->resultCacheDir.SetValue(dir);
+  }
+}
+
+bool Configuration::IsResultCacheDirSet() const {
+  return resultCacheDir.IsSet();
+}
+
+bool Configuration::GetQuerySharing() const {
+  return querySharing.GetValue();
+}
+
+void Configuration::SetQuerySharing(bool value) {
+  this->querySharing.SetValue(value);
+}
+
+bool Configuration::IsQuerySharingSet() const {
+  return querySharing.IsSet();
+}
+
+int32_t Configuration::GetMetadataCacheTtl() const {
+  return metadataCacheTtl.GetValue();
+}
+
+void Configuration::SetMetadataCacheTtl(int32_t value) {
+  this->metadataCacheTtl.SetValue(value);
+}
+
+bool Configuration::IsMetadataCacheTtlSet() const {
+  return metadataCacheTtl.IsSet();
+}
+
+int32_t Configuration::GetMetadataConcurrency() const {
+  return metadataConcurrency.GetValue();
+}
+
+void Configuration::SetMetadataConcurrency(int32_t value) {
+  this->metadataConcurrency.SetValue(value);
+}
+
+bool Configuration::IsMetadataConcurrencySet() const {
+  return metadataConcurrency.IsSet();
+}
+
+const std::string& Configuration::GetMetadataSnapshotDir() const {
+  return metadataSnapshotDir.GetValue();
+}
+
+void Configuration::SetMetadataSnapshotDir(const std::string& dir) {
+  if (ignite::odbc::common::IsValidDirectory(dir)) {
+    this->metadataSnapshotDir.SetValue(dir);
+  }
+}
+
+bool Configuration::IsMetadataSnapshotDirSet() const {
+  return metadataSnapshotDir.IsSet();
+}
+
+bool Configuration::GetMetadataPrefetch() const {
+  return metadataPrefetch.GetValue();
+}
+
+void Configuration::SetMetadataPrefetch(bool value) {
+  this->metadataPrefetch.SetValue(value);
+}
+
+bool Configuration::IsMetadataPrefetchSet() const {
+  return metadataPrefetch.IsSet();
+}
+
+const std::string& Configuration::GetQueryTraceFile() const {
+  return queryTraceFile.GetValue();
+}
+
+void Configuration::SetQueryTraceFile(const std::string& path) {
+  this->queryTraceFile.SetValue(path);
+}
+
+bool Configuration::IsQueryTraceFileSet() const {
+  return queryTraceFile.IsSet();
+}
+
+const std::string& Configuration::GetMetricsFile() const {
+  return metricsFile.GetValue();
+}
+
+void Configuration::SetMetricsFile(const std::string& path) {
+  this->metricsFile.SetValue(path);
+}
+
+bool Configuration::IsMetricsFileSet() const {
+  return metricsFile.IsSet();
+}
+
+int32_t Configuration::GetMetricsInterval() const {
+  return metricsInterval.GetValue();
+}
+
+void Configuration::SetMetricsInterval(int32_t interval) {
+  this->metricsInterval.SetValue(interval);
+}
+
+bool Configuration::IsMetricsIntervalSet() const {
+  return metricsInterval.IsSet();
+}
+
+const std::string& Configuration::GetTraceEventFile() const {
+  return traceEventFile.GetValue();
+}
+
+void Configuration::SetTraceEventFile(const std::string& path) {
+  this->traceEventFile.SetValue(path);
+}
+
+bool Configuration::IsTraceEventFileSet() const {
+  return traceEventFile.IsSet();
+}
+
 void Configuration::ToMap(ArgumentMap& res) const {
   AddToMap(res, ConnectionStringParser::Key::dsn, dsn);
   AddToMap(res, ConnectionStringParser::Key::driver, driver);
@@ -271,7 +483,27 @@ void Configuration::ToMap(ArgumentMap& res) const {
   AddToMap(res, ConnectionStringParser::Key::authType, authType);
   AddToMap(res, ConnectionStringParser::Key::logLevel, logLevel);
   AddToMap(res, ConnectionStringParser::Key::logPath, logPath);
+  AddToMap(res, ConnectionStringParser::Key::logFileSize, logFileSize);
+  AddToMap(res, ConnectionStringParser::Key::logDropOnOverflow,
+           logDropOnOverflow);
   AddToMap(res, ConnectionStringParser::Key::maxRowPerPage, maxRowPerPage);
+  AddToMap(res, ConnectionStringParser::Key::resultMemoryLimit, resultMemoryLimit);
+  AddToMap(res, ConnectionStringParser::Key::resultCacheTtl, resultCacheTtl);
+  AddToMap(res, ConnectionStringParser::Key::resultCacheSize, resultCacheSize);
+  AddToMap(res, ConnectionStringParser::Key::resultCacheDir, resultCacheDir);
+  AddToMap(res, ConnectionStringParser::Key::querySharing, querySharing);
+  AddToMap(res, ConnectionStringParser::Key::metadataCacheTtl,
+           metadataCacheTtl);
+  AddToMap(res, ConnectionStringParser::Key::metadataConcurrency,
+           metadataConcurrency);
+  AddToMap(res, ConnectionStringParser::Key::metadataSnapshotDir,
+           metadataSnapshotDir);
+  AddToMap(res, ConnectionStringParser::Key::metadataPrefetch,
+           metadataPrefetch);
+  AddToMap(res, ConnectionStringParser::Key::queryTraceFile, queryTraceFile);
+  AddToMap(res, ConnectionStringParser::Key::metricsFile, metricsFile);
+  AddToMap(res, ConnectionStringParser::Key::metricsInterval, metricsInterval);
+  AddToMap(res, ConnectionStringParser::Key::traceEventFile, traceEventFile);
 }
 
 void Configuration::Validate() const {
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <vector>
 
 #include "trino/odbc/system/odbc_constants.h"
 #include "trino/odbc/log.h"
@@ -593,8 +594,10 @@ const char* ConnectionInfo::InfoTypeToString(InfoType type) {
 
 #undef DBG_STR_CASE
 
-ConnectionInfo::ConnectionInfo(const Configuration& config)
-    : strParams(), intParams(), shortParams(), config(config) {
+void ConnectionInfo::FillInfo(bool databaseAsSchema,
+                              StringInfoMap& strParams,
+                              UintInfoMap& intParams,
+                              UshortInfoMap& shortParams) {
   //
   //======================= String Params =======================
   //
@@ -664,7 +667,7 @@ ConnectionInfo::ConnectionInfo(const Configuration& config)
   // example, "database" or "directory". This string can be in upper, lower, or
   // mixed case. This InfoType has been renamed for ODBC 3.0 from the ODBC 2.0
   // InfoType SQL_QUALIFIER_TERM.
-  if (DATABASE_AS_SCHEMA)
+  if (databaseAsSchema)
     strParams[SQL_CATALOG_TERM] = "";
   else
     strParams[SQL_CATALOG_TERM] = "database";
@@ -680,7 +683,7 @@ ConnectionInfo::ConnectionInfo(const Configuration& config)
   // A character string with the data source vendor's name for a schema; for
   // example, "owner", "Authorization ID", or "Schema". This InfoType has been
   // renamed for ODBC 3.0 from the ODBC 2.0 InfoType SQL_OWNER_TERM.
-  if (DATABASE_AS_SCHEMA)
+  if (databaseAsSchema)
     strParams[SQL_SCHEMA_TERM] = "schema";
   else
     strParams[SQL_SCHEMA_TERM] = "";
@@ -710,7 +713,7 @@ ConnectionInfo::ConnectionInfo(const Configuration& config)
 #ifdef SQL_CATALOG_NAME
   // A character string: "Y" if the server supports catalog names, or "N" if it
   // does not. An SQL - 92 Full level-conformant driver will always return "Y".
-  if (DATABASE_AS_SCHEMA)
+  if (databaseAsSchema)
     strParams[SQL_CATALOG_NAME] = "N";
   else
     strParams[SQL_CATALOG_NAME] = "Y";
@@ -857,7 +860,7 @@ ConnectionInfo::ConnectionInfo(const Configuration& config)
   // This InfoType is limited to catalog functions. For a description of the use
   // of the escape character in search pattern strings, see Pattern Value
   // Arguments.
-  strParams[SQL_SEARCH_PATTERN_ESCAPE] = "";
+  strParams[SQL_SEARCH_PATTERN_ESCAPE] = "\\";
 #endif  // SQL_SEARCH_PATTERN_ESCAPE
 
 #ifdef SQL_SERVER_NAME
@@ -900,7 +903,7 @@ ConnectionInfo::ConnectionInfo(const Configuration& config)
   //    associated with a connection handle can be in asynchronous mode, while
   //    other statement handles on the same connection are in synchronous mode.
   // SQL_AM_NONE = Asynchronous mode is not supported.
-  intParams[SQL_ASYNC_MODE] = SQL_AM_NONE;
+  intParams[SQL_ASYNC_MODE] = SQL_AM_STATEMENT;
 #endif  // SQL_ASYNC_MODE
 
 #ifdef SQL_ASYNC_NOTIFICATION
@@ -914,7 +917,11 @@ ConnectionInfo::ConnectionInfo(const Configuration& config)
   // asynchronous operations and statement level asynchronous operations. If a
   // driver returns SQL_ASYNC_NOTIFICATION_CAPABLE, it must support notification
   // for all APIs that it can execute asynchronously.
+#ifdef SQL_ATTR_ASYNC_STMT_PCALLBACK
+  intParams[SQL_ASYNC_NOTIFICATION] = SQL_ASYNC_NOTIFICATION_CAPABLE;
+#else
   intParams[SQL_ASYNC_NOTIFICATION] = SQL_ASYNC_NOTIFICATION_NOT_CAPABLE;
+#endif  // SQL_ATTR_ASYNC_STMT_PCALLBACK
 #endif  // SQL_ASYNC_NOTIFICATION
 
 #ifdef SQL_BATCH_ROW_COUNT
@@ -983,7 +990,7 @@ ConnectionInfo::ConnectionInfo(const Configuration& config)
   // value of 0 is returned if catalogs are not supported by the data source.
   // This InfoType has been renamed for ODBC 3.0 from the ODBC 2.0 InfoType
   // SQL_QUALIFIER_LOCATION.
-  if (DATABASE_AS_SCHEMA)
+  if (databaseAsSchema)
     intParams[SQL_CATALOG_LOCATION] = 0;  // I.e., not supported
   else
     intParams[SQL_CATALOG_LOCATION] = SQL_CL_START;
@@ -1048,7 +1055,7 @@ ConnectionInfo::ConnectionInfo(const Configuration& config)
   // level-conformant driver will always return a bitmask with all of these bits
   // set. This InfoType has been renamed for ODBC 3.0 from the ODBC 2.0 InfoType
   // SQL_QUALIFIER_USAGE.
-  if (DATABASE_AS_SCHEMA)
+  if (databaseAsSchema)
     intParams[SQL_CATALOG_USAGE] = 0;  // I.e., not supported
   else
     intParams[SQL_CATALOG_USAGE] = SQL_CU_DML_STATEMENTS;
@@ -1058,7 +1065,7 @@ ConnectionInfo::ConnectionInfo(const Configuration& config)
   // Bitmask enumerating the statements in which schemas can be used.
   // This InfoType has been renamed for ODBC 3.0 from the ODBC 2.0 InfoType
   // SQL_OWNER_USAGE.
-  if (DATABASE_AS_SCHEMA) {
+  if (databaseAsSchema) {
     intParams[SQL_SCHEMA_USAGE] =
         SQL_SU_DML_STATEMENTS | SQL_SU_TABLE_DEFINITION
         | SQL_SU_PRIVILEGE_DEFINITION | SQL_SU_INDEX_DEFINITION;
@@ -1204,8 +1211,7 @@ ConnectionInfo::ConnectionInfo(const Configuration& config)
   // by the driver. This bitmask contains the first subset of attributes; for
   // the second subset, see SQL_STATIC_CURSOR_ATTRIBUTES2.
   intParams[SQL_STATIC_CURSOR_ATTRIBUTES1] =
-      SQL_CA1_NEXT | SQL_CA1_ABSOLUTE | SQL_CA1_RELATIVE | SQL_CA1_BOOKMARK
-      | SQL_CA1_LOCK_NO_CHANGE | SQL_CA1_POS_POSITION | SQL_CA1_POS_REFRESH;
+      SQL_CA1_NEXT | SQL_CA1_ABSOLUTE | SQL_CA1_RELATIVE;
 #endif  // SQL_STATIC_CURSOR_ATTRIBUTES1
 
 #ifdef SQL_STATIC_CURSOR_ATTRIBUTES2
@@ -1213,7 +1219,8 @@ ConnectionInfo::ConnectionInfo(const Configuration& config)
   // by the driver. This bitmask contains the second subset of attributes; for
   // the first subset, see SQL_STATIC_CURSOR_ATTRIBUTES1.
   intParams[SQL_STATIC_CURSOR_ATTRIBUTES2] =
-      SQL_CA2_READ_ONLY_CONCURRENCY | SQL_CA2_CRC_EXACT;
+      SQL_CA2_READ_ONLY_CONCURRENCY | SQL_CA2_MAX_ROWS_SELECT
+      | SQL_CA2_CRC_EXACT;
 #endif  // SQL_STATIC_CURSOR_ATTRIBUTES2
 
 #ifdef SQL_CONVERT_BIGINT
@@ -2046,7 +2053,8 @@ ConnectionInfo::ConnectionInfo(const Configuration& config)
   // For descriptions of these bitmasks, see SQL_DYNAMIC_CURSOR_ATTRIBUTES2 (and
   // substitute "forward-only cursor" for "dynamic cursor" in the descriptions).
   intParams[SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES2] =
-      SQL_CA2_READ_ONLY_CONCURRENCY | SQL_CA2_CRC_EXACT;
+      SQL_CA2_READ_ONLY_CONCURRENCY | SQL_CA2_MAX_ROWS_SELECT
+      | SQL_CA2_CRC_EXACT;
 #endif  // SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES2
 
 #ifdef SQL_INDEX_KEYWORDS
@@ -2422,8 +2430,7 @@ ConnectionInfo::ConnectionInfo(const Configuration& config)
   // SQL_FD_FETCH_BOOKMARK (ODBC 2.0)
   intParams[SQL_FETCH_DIRECTION] =
       SQL_FD_FETCH_NEXT | SQL_FD_FETCH_FIRST | SQL_FD_FETCH_LAST
-      | SQL_FD_FETCH_PRIOR | SQL_FD_FETCH_ABSOLUTE | SQL_FD_FETCH_RELATIVE
-      | SQL_FD_FETCH_BOOKMARK;
+      | SQL_FD_FETCH_PRIOR | SQL_FD_FETCH_ABSOLUTE | SQL_FD_FETCH_RELATIVE;
 #endif  // SQL_FETCH_DIRECTION
 
 #ifdef SQL_LOCK_TYPES
@@ -2801,27 +2808,149 @@ ConnectionInfo::ConnectionInfo(const Configuration& config)
 #endif  // SQL_NULL_COLLATION
 }
 
+class ConnectionInfo::InfoTable {
+ public:
+  /** Info value. */
+  struct Value {
+    /** Value kinds. */
+    enum class Kind { NONE, STRING, UINT, USHORT };
+
+    /** Constructor. */
+    Value() : kind(Kind::NONE), number(0), str() {
+      // No-op.
+    }
+
+    /** Kind of the value. */
+    Kind kind;
+
+    /** Integer or short value. */
+    unsigned int number;
+
+    /** String value. */
+    std::string str;
+  };
+
+  /**
+   * Constructor.
+   *
+   * @param databaseAsSchema Whether databases are reported as schemas.
+   */
+  explicit InfoTable(bool databaseAsSchema) : slots(), values(1) {
+    StringInfoMap strParams;
+    UintInfoMap intParams;
+    UshortInfoMap shortParams;
+    FillInfo(databaseAsSchema, strParams, intParams, shortParams);
+
+    InfoType last = 0;
+    if (!strParams.empty())
+      last = std::max(last, strParams.rbegin()->first);
+    if (!intParams.empty())
+      last = std::max(last, intParams.rbegin()->first);
+    if (!shortParams.empty())
+      last = std::max(last, shortParams.rbegin()->first);
+    slots.assign(static_cast< size_t >(last) + 1, 0);
+
+    // strings are added last, so they win like they did in the lookup order
+    for (const auto& param : shortParams) {
+      Value& value = Add(param.first);
+      value.kind = Value::Kind::USHORT;
+      value.number = param.second;
+    }
+
+    for (const auto& param : intParams) {
+      Value& value = Add(param.first);
+      value.kind = Value::Kind::UINT;
+      value.number = param.second;
+    }
+
+    for (const auto& param : strParams) {
+      Value& value = Add(param.first);
+      value.kind = Value::Kind::STRING;
+      value.str = param.second;
+    }
+  }
+
+  /**
+   * Find the value of an info type.
+   *
+   * @param type Info type.
+   * @return Value, null if the type is not supported.
+   */
+  const Value* Find(InfoType type) const {
+    if (type >= slots.size() || slots[type] == 0)
+      return nullptr;
+
+    return &values[slots[type]];
+  }
+
+ private:
+  IGNITE_NO_COPY_ASSIGNMENT(InfoTable);
+
+  /**
+   * Get the value of an info type, adding it if needed.
+   *
+   * @param type Info type.
+   * @return Value.
+   */
+  Value& Add(InfoType type) {
+    if (slots[type] == 0) {
+      slots[type] = static_cast< uint16_t >(values.size());
+      values.emplace_back();
+    }
+
+    return values[slots[type]];
+  }
+
+  /** Position of the value of every info type, 0 for none. */
+  std::vector< uint16_t > slots;
+
+  /** Values, the first one is unused. */
+  std::vector< Value > values;
+};
+
+const ConnectionInfo::InfoTable& ConnectionInfo::GetInfoTable(
+    bool databaseAsSchema) {
+  // static locals are initialized once even with concurrent callers
+  if (databaseAsSchema) {
+    static const InfoTable schemaTable(true);
+    return schemaTable;
+  }
+
+  static const InfoTable catalogTable(false);
+  return catalogTable;
+}
+
+ConnectionInfo::ConnectionInfo(const Configuration& config)
+    : table(GetInfoTable(DATABASE_AS_SCHEMA)), strParams(), config(config) {
+  // No-op.
+}
+
 ConnectionInfo::~ConnectionInfo() {
   // No-op.
 }
 
 SqlResult::Type ConnectionInfo::GetInfo(InfoType type, void* buf, short buflen,
                                         short* reslen) const {
-  StringInfoMap::const_iterator itStr = strParams.find(type);
+  const InfoTable::Value* value = table.Find(type);
+  if (!value)
+    return SqlResult::AI_ERROR;
 
-  if (itStr != strParams.end()) {
+  if (value->kind == InfoTable::Value::Kind::STRING) {
     if (buf && !buflen)
       return SqlResult::AI_ERROR;
 
+    StringInfoMap::const_iterator itStr = strParams.find(type);
+    const std::string& str =
+        itStr != strParams.end() ? itStr->second : value->str;
+
     bool isTruncated = false;
     // Length is given in bytes, implicitly handles if buf is NULL.
     unsigned short strlen = static_cast< short >(utility::CopyStringToBuffer(
-        itStr->second, reinterpret_cast< SQLWCHAR* >(buf), buflen, isTruncated,
-        true));
+        str, reinterpret_cast< SQLWCHAR* >(buf), buflen, isTruncated, true));
 
     if (type != SQL_USER_NAME) {
-      LOG_INFO_MSG(type << " (" << ConnectionInfo::InfoTypeToString(type)
-                        << ") string result: \"" << itStr->second << "\"");
+      LOG_DEBUG_MSG(type << " (" << ConnectionInfo::InfoTypeToString(type)
+                         << ") string result: \"" << str << "\"");
     }
 
     if (reslen)
@@ -2834,39 +2963,31 @@ SqlResult::Type ConnectionInfo::GetInfo(InfoType type, void* buf, short buflen,
   if (!buf)
     return SqlResult::AI_ERROR;
 
-  UintInfoMap::const_iterator itInt = intParams.find(type);
-
-  if (itInt != intParams.end()) {
+  if (value->kind == InfoTable::Value::Kind::UINT) {
     unsigned int* res = reinterpret_cast< unsigned int* >(buf);
 
-    *res = itInt->second;
+    *res = value->number;
 
-    LOG_INFO_MSG(type << " (" << ConnectionInfo::InfoTypeToString(type)
-                      << ") int result: " << itInt->second);
+    LOG_DEBUG_MSG(type << " (" << ConnectionInfo::InfoTypeToString(type)
+                       << ") int result: " << value->number);
 
     return SqlResult::AI_SUCCESS;
   }
 
-  UshortInfoMap::const_iterator itShort = shortParams.find(type);
-
-  if (itShort != shortParams.end()) {
-    unsigned short* res = reinterpret_cast< unsigned short* >(buf);
+  unsigned short* res = reinterpret_cast< unsigned short* >(buf);
 
-    *res = itShort->second;
+  *res = static_cast< unsigned short >(value->number);
 
-    LOG_INFO_MSG(type << " (" << ConnectionInfo::InfoTypeToString(type)
-                      << ") short result: " << itShort->second);
+  LOG_DEBUG_MSG(type << " (" << ConnectionInfo::InfoTypeToString(type)
+                     << ") short result: " << value->number);
 
-    return SqlResult::AI_SUCCESS;
-  }
-
-  return SqlResult::AI_ERROR;
+  return SqlResult::AI_SUCCESS;
 }
 
 SqlResult::Type ConnectionInfo::SetInfo(InfoType type, std::string value) {
-  StringInfoMap::const_iterator itStr = strParams.find(type);
+  const InfoTable::Value* current = table.Find(type);
 
-  if (itStr != strParams.end()) {
+  if (current && current->kind == InfoTable::Value::Kind::STRING) {
     strParams[type] = value;
     return SqlResult::AI_SUCCESS;
   }
@@ -43,7 +43,30 @@ const std::string ConnectionStringParser::Key::endpoint = "endpointoverride";
 const std::string ConnectionStringParser::Key::authType = "auth";
 const std::string ConnectionStringParser::Key::logLevel = "loglevel";
 const std::string ConnectionStringParser::Key::logPath = "logoutput";
+const std::string ConnectionStringParser::Key::logFileSize = "logfilesize";
+const std::string ConnectionStringParser::Key::logDropOnOverflow =
+    "logdroponoverflow";
 const std::string ConnectionStringParser::Key::maxRowPerPage = "maxrowperpage";
+const std::string ConnectionStringParser::Key::resultMemoryLimit = "resultmemorylimit";
+const std::string ConnectionStringParser::Key::resultCacheTtl = "resultcachettl";
+const std::string ConnectionStringParser::Key::resultCacheSize = "resultcachesize";
+const std::string ConnectionStringParser::Key::resultCacheDir = "resultcachedir";
+const std::string ConnectionStringParser::Key::querySharing = "querysharing";
+const std::string ConnectionStringParser::Key::metadataCacheTtl =
+    "metadatacachettl";
+const std::string ConnectionStringParser::Key::metadataConcurrency =
+    "metadataconcurrency";
+const std::string ConnectionStringParser::Key::metadataSnapshotDir =
+    "metadatasnapshotdir";
+const std::string ConnectionStringParser::Key::metadataPrefetch =
+    "metadataprefetch";
+const std::string ConnectionStringParser::Key::queryTraceFile =
+    "querytracefile";
+const std::string ConnectionStringParser::Key::metricsFile = "metricsfile";
+const std::string ConnectionStringParser::Key::metricsInterval =
+    "metricsinterval";
+const std::string ConnectionStringParser::Key::traceEventFile =
+    "traceeventfile";
 
 ConnectionStringParser::ConnectionStringParser(Configuration& cfg) : cfg(cfg) {
   // No-op.
@@ -272,6 +295,27 @@ void ConnectionStringParser::HandleAttributePair(
     cfg.SetLogLevel(level);
   } else if (lKey == Key::logPath) {
     cfg.SetLogPath(value);
+  } else if (lKey == Key::logFileSize) {
+    int64_t numValue = 0;
+    if (ParseUnsignedValue("Log File Size", key, value, INT32_MAX, diag,
+                           numValue)) {
+      cfg.SetLogFileSize(static_cast< int32_t >(numValue));
+    }
+  } else if (lKey == Key::logDropOnOverflow) {
+    BoolParseResult::Type res = StringToBool(value);
+
+    if (res == BoolParseResult::Type::AI_UNRECOGNIZED) {
+      if (diag) {
+        diag->AddStatusRecord(
+            SqlState::S01S02_OPTION_VALUE_CHANGED,
+            MakeErrorMessage("Log Drop On Overflow attribute value is not a "
+                             "boolean. Using default value.",
+                             key, value));
+      }
+      return;
+    }
+
+    cfg.SetLogDropOnOverflow(res == BoolParseResult::Type::AI_TRUE);
   } else if (lKey == Key::driver) {
     cfg.SetDriver(value);
   } else if (lKey == Key::uid) {
@@ -344,6 +388,82 @@ void ConnectionStringParser::HandleAttributePair(
     }
 
     cfg.SetMaxRowPerPage(static_cast< uint32_t >(numValue));
+  } else if (lKey == Key::resultMemoryLimit) {
+    int64_t numValue = 0;
+    if (ParseUnsignedValue("Result Memory Limit", key, value, INT32_MAX, diag,
+                           numValue)) {
+      cfg.SetResultMemoryLimit(static_cast< int32_t >(numValue));
+    }
+  } else if (lKey == Key::resultCacheTtl) {
+    int64_t numValue = 0;
+    if (ParseUnsignedValue("Result Cache TTL", key, value, INT32_MAX, diag,
+                           numValue)) {
+      cfg.SetResultCacheTtl(static_cast< int32_t >(numValue));
+    }
+  } else if (lKey == Key::resultCacheSize) {
+    int64_t numValue = 0;
+    if (ParseUnsignedValue("Result Cache Size", key, value, INT32_MAX, diag,
+                           numValue)) {
+      cfg.SetResultCacheSize(static_cast< int32_t >(numValue));
+    }
+  } else if (lKey == Key::resultCacheDir) {
+    cfg.SetResultCacheDir(value);
+  } else if (lKey == Key::querySharing) {
+    BoolParseResult::Type res = StringToBool(value);
+
+    if (res == BoolParseResult::Type::AI_UNRECOGNIZED) {
+      if (diag) {
+        diag->AddStatusRecord(
+            SqlState::S01S02_OPTION_VALUE_CHANGED,
+            MakeErrorMessage("Query Sharing attribute value is not a boolean. "
+                             "Using default value.",
+                             key, value));
+      }
+      return;
+    }
+
+    cfg.SetQuerySharing(res == BoolParseResult::Type::AI_TRUE);
+  } else if (lKey == Key::metadataCacheTtl) {
+    int64_t numValue = 0;
+    if (ParseUnsignedValue("Metadata Cache TTL", key, value, INT32_MAX, diag,
+                           numValue)) {
+      cfg.SetMetadataCacheTtl(static_cast< int32_t >(numValue));
+    }
+  } else if (lKey == Key::metadataConcurrency) {
+    int64_t numValue = 0;
+    if (ParseUnsignedValue("Metadata Concurrency", key, value, INT32_MAX, diag,
+                           numValue)) {
+      cfg.SetMetadataConcurrency(static_cast< int32_t >(numValue));
+    }
+  } else if (lKey == Key::metadataSnapshotDir) {
+    cfg.SetMetadataSnapshotDir(value);
+  } else if (lKey == Key::metadataPrefetch) {
+    BoolParseResult::Type res = StringToBool(value);
+
+    if (res == BoolParseResult::Type::AI_UNRECOGNIZED) {
+      if (diag) {
+        diag->AddStatusRecord(
+            SqlState::S01S02_OPTION_VALUE_CHANGED,
+            MakeErrorMessage("Metadata Prefetch attribute value is not a "
+                             "boolean. Using default value.",
+                             key, value));
+      }
+      return;
+    }
+
+    cfg.SetMetadataPrefetch(res == BoolParseResult::Type::AI_TRUE);
+  } else if (lKey == Key::queryTraceFile) {
+    cfg.SetQueryTraceFile(value);
+  } else if (lKey == Key::metricsFile) {
+    cfg.SetMetricsFile(value);
+  } else if (lKey == Key::metricsInterval) {
+    int64_t numValue = 0;
+    if (ParseUnsignedValue("Metrics Interval", key, value, INT32_MAX, diag,
+                           numValue)) {
+      cfg.SetMetricsInterval(static_cast< int32_t >(numValue));
+    }
+  } else if (lKey == Key::traceEventFile) {
+    cfg.SetTraceEventFile(value);
   } else if (diag) {
     std::stringstream stream;
 
@@ -366,6 +486,43 @@ ConnectionStringParser::StringToBool(const std::string& value) {
   return BoolParseResult::Type::AI_UNRECOGNIZED;
 }
 
+bool ConnectionStringParser::ParseUnsignedValue(
+    const std::string& name, const std::string& key, const std::string& value,
+    int64_t maxValue, diagnostic::DiagnosticRecordStorage* diag,
+    int64_t& res) {
+  std::string problem;
+  if (value.empty()) {
+    problem = "is empty";
+  } else if (!trino::odbc::common::AllDigits(value)) {
+    problem = "contains unexpected characters";
+  } else if (value.size() >= sizeof(std::to_string(UINT32_MAX))) {
+    problem = "is too large";
+  } else {
+    int64_t numValue = 0;
+    std::stringstream conv;
+
+    conv << value;
+    conv >> numValue;
+
+    if (numValue > maxValue) {
+      problem = "is out of range";
+    } else {
+      res = numValue;
+      return true;
+    }
+  }
+
+  if (diag) {
+    diag->AddStatusRecord(
+        SqlState::S01S02_OPTION_VALUE_CHANGED,
+        MakeErrorMessage(
+            name + " attribute value " + problem + ". Using default value.",
+            key, value));
+  }
+
+  return false;
+}
+
 std::string ConnectionStringParser::MakeErrorMessage(const std::string& msg,
                                                      const std::string& key,
                                                      const std::string& value) {
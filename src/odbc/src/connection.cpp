@@ -33,9 +33,13 @@
 #include "trino/odbc/dsn_config.h"
 #include "trino/odbc/environment.h"
 #include "trino/odbc/log.h"
+#include "trino/odbc/metrics.h"
+#include "trino/odbc/query/table_metadata_query.h"
 #include "trino/odbc/statement.h"
 #include "trino/odbc/system/system_dsn.h"
+#include "trino/odbc/tracer.h"
 #include "trino/odbc/utility.h"
+#include "trino/odbc/worker_pool.h"
 
 #include <trino/auth.h>
 #include <trino/client.h>
@@ -54,8 +58,14 @@ using trino::odbc::IgniteError;
 namespace trino {
 namespace odbc {
 
-Connection::Connection()
-    : info_(config_), metadataID_(false) {
+Connection::Connection(Environment* env)
+    : metadataID_(false),
+      info_(config_),
+      env_(env),
+      memoryGovernor_(
+          std::make_shared< MemoryGovernor >(0, env->GetMemoryGovernor())),
+      snapshotPath_(),
+      prefetch_() {
   LOG_DEBUG_MSG("Connection is called");
 }
 
@@ -69,11 +79,12 @@ const config::ConnectionInfo& Connection::GetInfo() const {
 
 void Connection::GetInfo(config::ConnectionInfo::InfoType type, void* buf,
                          short buflen, short* reslen) {
-  LOG_INFO_MSG("SQLGetInfo called: "
-               << type << " (" << config::ConnectionInfo::InfoTypeToString(type)
-               << "), " << std::hex << reinterpret_cast< size_t >(buf) << ", "
-               << buflen << ", " << std::hex
-               << reinterpret_cast< size_t >(reslen) << std::dec);
+  LOG_DEBUG_MSG("SQLGetInfo called: "
+                << type << " ("
+                << config::ConnectionInfo::InfoTypeToString(type) << "), "
+                << std::hex << reinterpret_cast< size_t >(buf) << ", "
+                << buflen << ", " << std::hex
+                << reinterpret_cast< size_t >(reslen) << std::dec);
 
   IGNITE_ODBC_API_CALL(InternalGetInfo(type, buf, buflen, reslen));
 }
@@ -152,6 +163,39 @@ SqlResult::Type Connection::InternalEstablish(
     return SqlResult::AI_ERROR;
   }
 
+  // the limit is configured in megabytes
+  memoryGovernor_->SetLimit(
+      static_cast< int64_t >(config_.GetResultMemoryLimit()) * 1024 * 1024);
+
+  // the cache is shared by the environment, so it is sized by the largest
+  // request of the connections using it
+  if (config_.GetResultCacheTtl() > 0) {
+    env_->GetResultCache()->Reserve(
+        static_cast< uint64_t >(config_.GetResultCacheSize()) * 1024 * 1024,
+        config_.GetResultCacheDir());
+  }
+
+  // catalog browsing of a new session starts from the snapshot the
+  // previous one left
+  snapshotPath_ = GetMetadataSnapshotPath();
+  if (!snapshotPath_.empty()) {
+    env_->GetMetadataCache()->Load(GetResultCacheIdentity(), snapshotPath_);
+  }
+
+  // the metrics cover the whole process, the last connection naming a
+  // file decides where they are written
+  if (!config_.GetMetricsFile().empty()) {
+    Metrics::GetInstance().StartExport(
+        config_.GetMetricsFile(),
+        std::chrono::seconds(config_.GetMetricsInterval()));
+  }
+
+  if (!config_.GetTraceEventFile().empty()) {
+    Tracer::GetInstance().Start(config_.GetTraceEventFile());
+  }
+
+  StartMetadataPrefetch();
+
   bool errors = GetDiagnosticRecords().GetStatusRecordsNumber() > 0;
 
   LOG_DEBUG_MSG("errors is " << errors);
@@ -167,9 +211,53 @@ void Connection::Deregister() {
   env_->DeregisterConnection(this);
 }
 
+std::shared_ptr< ResultCache > Connection::GetResultCache() const {
+  if (config_.GetResultCacheTtl() <= 0) {
+    return nullptr;
+  }
+
+  return env_->GetResultCache();
+}
+
+std::shared_ptr< SharedQueryRegistry > Connection::GetSharedQueries() const {
+  if (!config_.GetQuerySharing()) {
+    return nullptr;
+  }
+
+  return env_->GetSharedQueries();
+}
+
+std::shared_ptr< MetadataCache > Connection::GetMetadataCache() const {
+  if (config_.GetMetadataCacheTtl() <= 0) {
+    return nullptr;
+  }
+
+  return env_->GetMetadataCache();
+}
+
+std::string Connection::GetResultCacheIdentity() const {
+  // the driver keeps no session catalog or schema, queries name them, so
+  // the server and the credentials are what tells sessions apart
+  return config_.GetEndpoint() + '\n'
+         + AuthType::ToString(config_.GetAuthType()) + '\n' + config_.GetUid()
+         + '\n' + config_.GetProfileName();
+}
+
+std::string Connection::GetMetadataSnapshotPath() const {
+  if (config_.GetMetadataCacheTtl() <= 0
+      || config_.GetMetadataSnapshotDir().empty()) {
+    return std::string();
+  }
+
+  return config_.GetMetadataSnapshotDir() + '/'
+         + MetadataCache::MakeSnapshotName(config_.GetDsn(),
+                                           GetResultCacheIdentity());
+}
+
 std::shared_ptr< client::TrinoQuery::TrinoQueryClient > /*@*/
 Connection::GetQueryClient() const {
-  return queryClient_;
+  // statements pick the client up on their own threads
+  return std::atomic_load(&queryClient_);
 }
 
 SqlResult::Type Connection::InternalRelease() {
@@ -192,10 +280,65 @@ SqlResult::Type Connection::InternalRelease() {
 }
 
 void Connection::Close() {
+  // the prefetch runs queries with the client, it is stopped first
+  if (prefetch_.valid()) {
+    prefetchQuery_->Interrupt();
+    prefetch_.wait();
+    prefetch_ = std::shared_future< void >();
+    prefetchQuery_.reset();
+    prefetchDiag_.reset();
+  }
+
   if (queryClient_) {
-    queryClient_.reset();
+    std::atomic_store(
+        &queryClient_,
+        std::shared_ptr< client::TrinoQuery::TrinoQueryClient >()); /*#*/
   }
 
+  // the snapshot is written off the disconnecting thread, the cache is kept
+  // alive by the task
+  if (!snapshotPath_.empty()) {
+    std::shared_ptr< MetadataCache > cache = env_->GetMetadataCache();
+    std::string identity = GetResultCacheIdentity();
+    std::string path = snapshotPath_;
+    WorkerPool::GetInstance().Submit(
+        [cache, identity, path]() { cache->Save(identity, path); });
+    snapshotPath_.clear();
+  }
+}
+
+void Connection::StartMetadataPrefetch() {
+  std::shared_ptr< MetadataCache > cache = GetMetadataCache();
+  if (!cache || !config_.GetMetadataPrefetch()) {
+    return;
+  }
+
+  // lookups of the prefetched entries wait for the prefetch from now on,
+  // instead of sending the same queries
+  std::string identity = GetResultCacheIdentity();
+  cache->BeginDatabasesLoad(identity, "%");
+  cache->BeginTablesLoad(identity, "%", "%");
+
+  std::shared_ptr< std::promise< void > > done =
+      std::make_shared< std::promise< void > >();
+  prefetch_ = done->get_future().share();
+
+  // the query is owned by the connection, so Close() can interrupt it, and
+  // outlives the task as Close() waits for it
+  prefetchDiag_.reset(new diagnostic::DiagnosableAdapter(this));
+  prefetchQuery_.reset(new query::TableMetadataQuery(
+      *prefetchDiag_, *this, boost::none, boost::none, std::string("%"),
+      boost::none));
+  query::TableMetadataQuery* query = prefetchQuery_.get();
+
+  LOG_DEBUG_MSG("Starting metadata prefetch");
+  WorkerPool::GetInstance().Submit([query, cache, identity, done]() {
+    SqlResult::Type result = query->Prefetch();
+    LOG_DEBUG_MSG("Metadata prefetch is finished with result " << result);
+
+    cache->EndLoads(identity);
+    done->set_value();
+  });
 }
 
 Statement* Connection::CreateStatement() {
@@ -253,7 +396,7 @@ void Connection::GetAttribute(int attr, void* buf, SQLINTEGER bufLen,
 }
 
 SqlResult::Type Connection::InternalGetAttribute(int attr, void* buf,
-                                                 SQLINTEGER,
+                                                 SQLINTEGER bufLen,
                                                  SQLINTEGER* valueLen) {
   LOG_DEBUG_MSG("InternalGetAttribute is called, attr is " << attr);
   if (!buf) {
@@ -322,7 +465,7 @@ SqlResult::Type Connection::InternalGetAttribute(int attr, void* buf,
     case SQL_ATTR_ASYNC_ENABLE: {
       SQLUINTEGER* val = reinterpret_cast< SQLUINTEGER* >(buf);
 
-      // Asynchronous execution is not supported
+      // Asynchronous execution is enabled per statement only
       *val = SQL_ASYNC_ENABLE_OFF;
 
       if (valueLen)
@@ -343,6 +486,63 @@ SqlResult::Type Connection::InternalGetAttribute(int attr, void* buf,
       break;
     }
 
+    case SQL_ATTR_TRINO_MEMORY_USAGE: {
+      SQLULEN* val = reinterpret_cast< SQLULEN* >(buf);
+
+      *val = static_cast< SQLULEN >(memoryGovernor_->GetUsage());
+
+      if (valueLen)
+        *valueLen = SQL_IS_UINTEGER;
+
+      break;
+    }
+
+    case SQL_ATTR_TRINO_RESULT_CACHE_HITS: {
+      SQLULEN* val = reinterpret_cast< SQLULEN* >(buf);
+
+      *val = static_cast< SQLULEN >(env_->GetResultCache()->GetHitCount());
+
+      if (valueLen)
+        *valueLen = SQL_IS_UINTEGER;
+
+      break;
+    }
+
+    case SQL_ATTR_TRINO_RESULT_CACHE_MISSES: {
+      SQLULEN* val = reinterpret_cast< SQLULEN* >(buf);
+
+      *val = static_cast< SQLULEN >(env_->GetResultCache()->GetMissCount());
+
+      if (valueLen)
+        *valueLen = SQL_IS_UINTEGER;
+
+      break;
+    }
+
+    case SQL_ATTR_TRINO_METRICS: {
+      std::string text = Metrics::GetInstance().ToPrometheusText();
+
+      // Length is given in bytes
+      bool isTruncated = false;
+      utility::CopyStringToBuffer(text, reinterpret_cast< SQLWCHAR* >(buf),
+                                  static_cast< size_t >(std::max(bufLen, 0)),
+                                  isTruncated, true);
+
+      if (valueLen)
+        *valueLen = static_cast< SQLINTEGER >(text.size() * sizeof(SQLWCHAR));
+
+      if (isTruncated) {
+        AddStatusRecord(SqlState::S01004_DATA_TRUNCATED,
+                        "Buffer is too small for the metrics. Truncated from "
+                        "the right.",
+                        trino::odbc::LogLevel::Type::WARNING_LEVEL);
+
+        return SqlResult::AI_SUCCESS_WITH_INFO;
+      }
+
+      return SqlResult::AI_SUCCESS;
+    }
+
     default: {
       AddStatusRecord(SqlState::SHYC00_OPTIONAL_FEATURE_NOT_IMPLEMENTED,
                       "Specified attribute is not supported.",
@@ -425,6 +625,23 @@ SqlResult::Type Connection::InternalSetAttribute(int attr, void* value,
       LOG_INFO_MSG("log level is set to " << static_cast< int >(type));
       break;
     }
+
+    case SQL_ATTR_TRINO_METADATA_CACHE_INVALIDATE: {
+      // the value is ignored, any set drops the entries of the connection
+      env_->GetMetadataCache()->Invalidate(GetResultCacheIdentity());
+      LOG_INFO_MSG("Metadata cache is invalidated");
+      break;
+    }
+
+    case SQL_ATTR_TRINO_MEMORY_USAGE:
+    case SQL_ATTR_TRINO_RESULT_CACHE_HITS:
+    case SQL_ATTR_TRINO_RESULT_CACHE_MISSES:
+    case SQL_ATTR_TRINO_METRICS: {
+      AddStatusRecord(SqlState::SHY092_OPTION_TYPE_OUT_OF_RANGE,
+                      "Attribute is read only.");
+
+      return SqlResult::AI_ERROR;
+    }
     default: {
       AddStatusRecord(SqlState::SHYC00_OPTIONAL_FEATURE_NOT_IMPLEMENTED,
                       "Specified attribute is not supported.");
@@ -695,6 +912,12 @@ SqlResult::Type Connection::InternalGetFunctions(SQLUSMALLINT funcId, SQLUSMALLI
       *valueBuf = true;
       break;
     }
+#ifdef SQL_API_SQLCANCELHANDLE
+    case SQL_API_SQLCANCELHANDLE: {
+      *valueBuf = true;
+      break;
+    }
+#endif  // SQL_API_SQLCANCELHANDLE
     case SQL_API_SQLGETDIAGFIELD: {
       *valueBuf = true;
       break;
@@ -1062,6 +1285,9 @@ void Connection::SetODBC3FunctionsValue(SQLUSMALLINT* valueBuf) {
   SQL_FUNC_SET(valueBuf, SQL_API_SQLBINDCOL);
   SQL_FUNC_SET(valueBuf, SQL_API_SQLGETDESCREC);
   SQL_FUNC_SET(valueBuf, SQL_API_SQLCANCEL);
+#ifdef SQL_API_SQLCANCELHANDLE
+  SQL_FUNC_SET(valueBuf, SQL_API_SQLCANCELHANDLE);
+#endif  // SQL_API_SQLCANCELHANDLE
   SQL_FUNC_SET(valueBuf, SQL_API_SQLGETDIAGFIELD);
   SQL_FUNC_SET(valueBuf, SQL_API_SQLCLOSECURSOR);
   SQL_FUNC_SET(valueBuf, SQL_API_SQLGETDIAGREC);
@@ -1206,9 +1432,9 @@ SqlResult::Type Connection::InternalSetStmtAttribute(SQLUSMALLINT option, SQLULE
       break;
     }
     case SQL_CURSOR_TYPE: {
-      if (value != SQL_CURSOR_FORWARD_ONLY) {
+      if (value != SQL_CURSOR_FORWARD_ONLY && value != SQL_CURSOR_STATIC) {
         AddStatusRecord(SqlState::SHYC00_OPTIONAL_FEATURE_NOT_IMPLEMENTED,
-                        "Only forward cursors are currently supported");
+                        "Only forward and static cursors are supported");
 
         return SqlResult::AI_ERROR;
       }
@@ -36,10 +36,10 @@ void DiagnosableAdapter::AddStatusRecord(
                 logLevel);
 
   if (connection) {
-    diagnosticRecords.AddStatusRecord(
+    AddStatusRecord(
         connection->CreateStatusRecord(sqlState, message, rowNum, columnNum));
   } else {
-    diagnosticRecords.AddStatusRecord(
+    AddStatusRecord(
         DiagnosticRecord(sqlState, message, "", "", rowNum, columnNum));
   }
 }
@@ -48,9 +48,15 @@ const std::string STATE_01S01 = "01S01";
 /** SQL state 01S02 constant. */
 const std::string STATE_01S02 = "01S02";
 
+/** SQL state 01S06 constant. */
+const std::string STATE_01S06 = "01S06";
+
 /** SQL state 01S07 constant. */
 const std::string STATE_01S07 = "01S07";
 
+/** SQL state 07002 constant. */
+const std::string STATE_07002 = "07002";
+
 /** SQL state 07009 constant. */
 const std::string STATE_07009 = "07009";
 
@@ -305,9 +311,15 @@ const std::string& DiagnosticRecord::GetSqlState() const {
     case SqlState::S01S02_OPTION_VALUE_CHANGED:
       return STATE_01S02;
 
+    case SqlState::S01S06_FETCH_BEFORE_FIRST_ROWSET:
+      return STATE_01S06;
+
     case SqlState::S01S07_FRACTIONAL_TRUNCATION:
       return STATE_01S07;
 
+    case SqlState::S07002_COUNT_FIELD_INCORRECT:
+      return STATE_07002;
+
     case SqlState::S07006_RESTRICTION_VIOLATION:
       return STATE_07006;
 
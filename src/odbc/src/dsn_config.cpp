@@ -198,11 +198,101 @@ void ReadDsnConfiguration(const char* dsn, Configuration& config,
   if (logPath.IsSet() && !config.IsLogPathSet())
     config.SetLogPath(logPath.GetValue());
 
+  SettableValue< int32_t > logFileSize =
+      ReadDsnInt(dsn, ConnectionStringParser::Key::logFileSize);
+
+  if (logFileSize.IsSet() && !config.IsLogFileSizeSet())
+    config.SetLogFileSize(logFileSize.GetValue());
+
+  SettableValue< bool > logDropOnOverflow =
+      ReadDsnBool(dsn, ConnectionStringParser::Key::logDropOnOverflow);
+
+  if (logDropOnOverflow.IsSet() && !config.IsLogDropOnOverflowSet())
+    config.SetLogDropOnOverflow(logDropOnOverflow.GetValue());
+
   SettableValue< int32_t > maxRowPerPage =
       ReadDsnInt(dsn, ConnectionStringParser::Key::maxRowPerPage);
 
   if (maxRowPerPage.IsSet() && !config.IsMaxRowPerPageSet())
     config.SetMaxRowPerPage(maxRowPerPage.GetValue());
+
+  SettableValue< int32_t > resultMemoryLimit =
+      ReadDsnInt(dsn, ConnectionStringParser::Key::resultMemoryLimit);
+
+  if (resultMemoryLimit.IsSet() && !config.IsResultMemoryLimitSet())
+    config.SetResultMemoryLimit(resultMemoryLimit.GetValue());
+
+  SettableValue< int32_t > resultCacheTtl =
+      ReadDsnInt(dsn, ConnectionStringParser::Key::resultCacheTtl);
+
+  if (resultCacheTtl.IsSet() && !config.IsResultCacheTtlSet())
+    config.SetResultCacheTtl(resultCacheTtl.GetValue());
+
+  SettableValue< int32_t > resultCacheSize =
+      ReadDsnInt(dsn, ConnectionStringParser::Key::resultCacheSize);
+
+  if (resultCacheSize.IsSet() && !config.IsResultCacheSizeSet())
+    config.SetResultCacheSize(resultCacheSize.GetValue());
+
+  SettableValue< std::string > resultCacheDir =
+      ReadDsnString(dsn, ConnectionStringParser::Key::resultCacheDir);
+
+  if (resultCacheDir.IsSet() && !config.IsResultCacheDirSet())
+    config.SetResultCacheDir(resultCacheDir.GetValue());
+
+  SettableValue< bool > querySharing =
+      ReadDsnBool(dsn, ConnectionStringParser::Key::querySharing);
+
+  if (querySharing.IsSet() && !config.IsQuerySharingSet())
+    config.SetQuerySharing(querySharing.GetValue());
+
+  SettableValue< int32_t > metadataCacheTtl =
+      ReadDsnInt(dsn, ConnectionStringParser::Key::metadataCacheTtl);
+
+  if (metadataCacheTtl.IsSet() && !config.IsMetadataCacheTtlSet())
+    config.SetMetadataCacheTtl(metadataCacheTtl.GetValue());
+
+  SettableValue< int32_t > metadataConcurrency =
+      ReadDsnInt(dsn, ConnectionStringParser::Key::metadataConcurrency);
+
+  if (metadataConcurrency.IsSet() && !config.IsMetadataConcurrencySet())
+    config.SetMetadataConcurrency(metadataConcurrency.GetValue());
+
+  SettableValue< std::string > metadataSnapshotDir =
+      ReadDsnString(dsn, ConnectionStringParser::Key::metadataSnapshotDir);
+
+  if (metadataSnapshotDir.IsSet() && !config.IsMetadataSnapshotDirSet())
+    config.SetMetadataSnapshotDir(metadataSnapshotDir.GetValue());
+
+  SettableValue< bool > metadataPrefetch =
+      ReadDsnBool(dsn, ConnectionStringParser::Key::metadataPrefetch);
+
+  if (metadataPrefetch.IsSet() && !config.IsMetadataPrefetchSet())
+    config.SetMetadataPrefetch(metadataPrefetch.GetValue());
+
+  SettableValue< std::string > queryTraceFile =
+      ReadDsnString(dsn, ConnectionStringParser::Key::queryTraceFile);
+
+  if (queryTraceFile.IsSet() && !config.IsQueryTraceFileSet())
+    config.SetQueryTraceFile(queryTraceFile.GetValue());
+
+  SettableValue< std::string > metricsFile =
+      ReadDsnString(dsn, ConnectionStringParser::Key::metricsFile);
+
+  if (metricsFile.IsSet() && !config.IsMetricsFileSet())
+    config.SetMetricsFile(metricsFile.GetValue());
+
+  SettableValue< int32_t > metricsInterval =
+      ReadDsnInt(dsn, ConnectionStringParser::Key::metricsInterval);
+
+  if (metricsInterval.IsSet() && !config.IsMetricsIntervalSet())
+    config.SetMetricsInterval(metricsInterval.GetValue());
+
+  SettableValue< std::string > traceEventFile =
+      ReadDsnString(dsn, ConnectionStringParser::Key::traceEventFile);
+
+  if (traceEventFile.IsSet() && !config.IsTraceEventFileSet())
+    config.SetTraceEventFile(traceEventFile.GetValue());
 }
 
 bool WriteDsnConfiguration(const config::Configuration& config,
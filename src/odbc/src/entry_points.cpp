@@ -144,6 +144,10 @@ SQLRETURN SQL_API SQLCancel(SQLHSTMT stmt) {
   return trino::SQLCancel(stmt);
 }
 
+SQLRETURN SQL_API SQLCancelHandle(SQLSMALLINT handleType, SQLHANDLE handle) {
+  return trino::SQLCancelHandle(handleType, handle);
+}
+
 SQLRETURN SQL_API SQLBindCol(SQLHSTMT stmt, SQLUSMALLINT colNum,
                              SQLSMALLINT targetType, SQLPOINTER targetValue,
                              SQLLEN bufferLength,
@@ -587,20 +591,9 @@ SQLRETURN SQL_API SQLBindParameter(SQLHSTMT stmt, SQLUSMALLINT paramIdx,
                                    SQLSMALLINT paramSqlType, SQLULEN columnSize,
                                    SQLSMALLINT decDigits, SQLPOINTER buffer,
                                    SQLLEN bufferLen, SQLLEN* resLen) {
-  IGNITE_UNUSED(paramIdx);
-  IGNITE_UNUSED(ioType);
-  IGNITE_UNUSED(bufferType);
-  IGNITE_UNUSED(paramSqlType);
-  IGNITE_UNUSED(columnSize);
-  IGNITE_UNUSED(decDigits);
-  IGNITE_UNUSED(buffer);
-  IGNITE_UNUSED(bufferLen);
-  IGNITE_UNUSED(resLen);
-
-  LOG_DEBUG_MSG("unsupported function SQLBindParameter called");
-
-  STMT_UNSUPPORTED_FUNC(stmt, "SQLBindParameter is not supported.");
-  return SQL_ERROR;
+  return trino::SQLBindParameter(stmt, paramIdx, ioType, bufferType,
+                                 paramSqlType, columnSize, decDigits, buffer,
+                                 bufferLen, resLen);
 }
 
 SQLRETURN SQL_API SQLDescribeParam(SQLHSTMT stmt, SQLUSMALLINT paramNum,
@@ -641,12 +634,7 @@ SQLRETURN SQL_API SQLParamOptions(SQLHSTMT stmt, SQLULEN paramSetSize,
 }
 
 SQLRETURN SQL_API SQLNumParams(SQLHSTMT stmt, SQLSMALLINT* paramCnt) {
-  IGNITE_UNUSED(paramCnt);
-
-  LOG_DEBUG_MSG("unsupported function SQLNumParams called");
-
-  STMT_UNSUPPORTED_FUNC(stmt, "SQLNumParams is not supported.");
-  return SQL_ERROR;
+  return trino::SQLNumParams(stmt, paramCnt);
 }
 
 SQLRETURN SQL_API SQLPutData(SQLHSTMT stmt, SQLPOINTER data,
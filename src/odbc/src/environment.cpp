@@ -20,19 +20,36 @@
 
 #include "trino/odbc/environment.h"
 
+#include <atomic>
 #include <cstdlib>
 
 #include "trino/odbc/connection.h"
 #include "trino/odbc/system/odbc_constants.h"
 
+namespace {
+/** Number of environments alive in the process. */
+std::atomic< size_t > environmentCount(0);
+}  // namespace
+
 namespace trino {
 namespace odbc {
 Environment::Environment()
-    : connections(), odbcVersion(SQL_OV_ODBC3), odbcNts(SQL_TRUE) {
+    : connections(),
+      odbcVersion(SQL_OV_ODBC3),
+      odbcNts(SQL_TRUE),
+      memoryGovernor_(std::make_shared< MemoryGovernor >()),
+      resultCache_(std::make_shared< ResultCache >()),
+      sharedQueries_(std::make_shared< SharedQueryRegistry >()),
+      metadataCache_(std::make_shared< MetadataCache >()) {
+  ++environmentCount;
 }
 
 Environment::~Environment() {
-  // No-op.
+  --environmentCount;
+}
+
+size_t Environment::GetCount() {
+  return environmentCount;
 }
 
 Connection* Environment::CreateConnection() {
@@ -110,6 +127,31 @@ SqlResult::Type Environment::InternalSetAttribute(int32_t attr, void* value,
       return SqlResult::AI_SUCCESS;
     }
 
+    case EnvironmentAttribute::MEMORY_USAGE: {
+      AddStatusRecord(SqlState::SHY092_OPTION_TYPE_OUT_OF_RANGE,
+                      "Attribute is read only.");
+
+      return SqlResult::AI_ERROR;
+    }
+
+    case EnvironmentAttribute::MEMORY_LIMIT: {
+      int64_t limit =
+          static_cast< int64_t >(reinterpret_cast< intptr_t >(value));
+
+      if (limit < 0) {
+        AddStatusRecord(SqlState::SHY024_INVALID_ATTRIBUTE_VALUE,
+                        "Result memory limit must be non-negative.");
+
+        return SqlResult::AI_ERROR;
+      }
+
+      memoryGovernor_->SetLimit(limit);
+      LOG_INFO_MSG("Result memory limit has been set to " << limit
+                                                          << " bytes");
+
+      return SqlResult::AI_SUCCESS;
+    }
+
     case EnvironmentAttribute::UNKNOWN:
     default:
       break;
@@ -144,6 +186,18 @@ SqlResult::Type Environment::InternalGetAttribute(
       return SqlResult::AI_SUCCESS;
     }
 
+    case EnvironmentAttribute::MEMORY_USAGE: {
+      buffer.PutInt64(memoryGovernor_->GetUsage());
+
+      return SqlResult::AI_SUCCESS;
+    }
+
+    case EnvironmentAttribute::MEMORY_LIMIT: {
+      buffer.PutInt64(memoryGovernor_->GetLimit());
+
+      return SqlResult::AI_SUCCESS;
+    }
+
     case EnvironmentAttribute::UNKNOWN:
     default:
       break;
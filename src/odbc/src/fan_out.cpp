@@ -0,0 +1,147 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "trino/odbc/fan_out.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+#include "trino/odbc/log.h"
+
+namespace {
+/** State of one run, shared with the helpers that may outlive it. */
+struct FanOutState {
+  /**
+   * Constructor.
+   *
+   * @param count Number of tasks.
+   * @param task Task.
+   */
+  FanOutState(size_t count, const trino::odbc::FanOut::Task& task)
+      : count(count), task(task), errors(count), next(0), done(0) {
+    // No-op.
+  }
+
+  /** Number of tasks. */
+  const size_t count;
+
+  /** Task. */
+  const trino::odbc::FanOut::Task task;
+
+  /** Error messages by task index, written by the thread that ran it. */
+  std::vector< std::string > errors;
+
+  /** Index of the next task to claim. */
+  std::atomic< size_t > next;
+
+  /** Number of finished tasks. */
+  size_t done;
+
+  /** Lock guarding the number of finished tasks. */
+  std::mutex mutex;
+
+  /** Condition the caller waits on. */
+  std::condition_variable cv;
+};
+
+/**
+ * Run a task. An exception must not unwind the caller, as helpers still
+ * use the state and the task, nor leave a worker thread.
+ *
+ * @param task Task.
+ * @param idx Task index.
+ * @param error Set to the error message if the task throws.
+ */
+void RunTask(const trino::odbc::FanOut::Task& task, size_t idx,
+             std::string& error) {
+  try {
+    task(idx);
+  } catch (const std::exception& e) {
+    error = e.what();
+  } catch (...) {
+    error = "Unknown error";
+  }
+
+  if (!error.empty()) {
+    LOG_ERROR_MSG("Task " << idx << " failed: " << error);
+  }
+}
+
+/**
+ * Run unclaimed tasks until there are none left.
+ *
+ * @param state State of the run.
+ */
+void Drain(FanOutState& state) {
+  size_t ran = 0;
+  for (size_t idx = state.next++; idx < state.count; idx = state.next++) {
+    RunTask(state.task, idx, state.errors[idx]);
+    ++ran;
+  }
+
+  if (ran > 0) {
+    std::lock_guard< std::mutex > lock(state.mutex);
+    state.done += ran;
+    if (state.done == state.count) {
+      state.cv.notify_all();
+    }
+  }
+}
+}  // namespace
+
+namespace trino {
+namespace odbc {
+FanOut::FanOut(size_t limit, WorkerPool& pool)
+    : limit_(limit > 0 ? limit : 1), pool_(pool) {
+  // No-op.
+}
+
+std::vector< std::string > FanOut::Run(size_t count, const Task& task) {
+  size_t helpers = std::min(limit_, count);
+  if (helpers <= 1) {
+    std::vector< std::string > errors(count);
+    for (size_t idx = 0; idx < count; ++idx) {
+      RunTask(task, idx, errors[idx]);
+    }
+    return errors;
+  }
+
+  LOG_DEBUG_MSG("Running " << count << " tasks on up to " << helpers
+                           << " threads");
+  // helpers starting after all tasks are claimed find nothing to do, the
+  // state stays alive for them
+  std::shared_ptr< FanOutState > state =
+      std::make_shared< FanOutState >(count, task);
+  for (size_t i = 1; i < helpers; ++i) {
+    pool_.Submit([state]() { Drain(*state); });
+  }
+
+  Drain(*state);
+
+  std::unique_lock< std::mutex > lock(state->mutex);
+  state->cv.wait(lock, [&]() { return state->done == state->count; });
+  return state->errors;
+}
+}  // namespace odbc
+}  // namespace trino
@@ -28,6 +28,8 @@
 #include <unistd.h>
 #endif
 
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
 
 #include "trino/odbc/config/configuration.h"
@@ -41,11 +43,40 @@ using trino::odbc::config::Configuration;
 // logger_ pointer will  initialized in first call to GetLoggerInstance
 std::shared_ptr< Logger > Logger::logger_;
 CriticalSection Logger::mutexForCreation;
+std::atomic< int > Logger::logLevel(
+    static_cast< int >(LogLevel::Type::WARNING_LEVEL));
+const size_t Logger::QUEUE_CAPACITY;
+const int Logger::ROTATED_FILES;
+
+namespace {
+/** Largest number of messages written at once. */
+const size_t BATCH_SIZE = 256;
+
+/** Longest time the writer sleeps before looking for messages again. */
+const std::chrono::milliseconds WRITER_IDLE(100);
+
+/**
+ * Get size of a file.
+ * @param path Path of the file.
+ * @return Size in bytes, 0 if the file does not exist.
+ */
+uint64_t GetFileSize(const std::string& path) {
+  std::ifstream file(path, std::ios_base::binary | std::ios_base::ate);
+  if (!file) {
+    return 0;
+  }
+
+  return static_cast< uint64_t >(file.tellg());
+}
+}  // namespace
 
 namespace trino {
 namespace odbc {
-LogStream::LogStream(Logger* parent)
-    : std::basic_ostream< char >(0), strbuf(), logger(parent) {
+LogStream::LogStream(Logger* parent, std::ostream* target)
+    : std::basic_ostream< char >(0),
+      strbuf(),
+      logger(parent),
+      target(target) {
   init(&strbuf);
 }
 
@@ -55,10 +86,14 @@ bool LogStream::operator()() const {
 
 LogStream::~LogStream() {
   if (logger) {
-    logger->WriteMessage(strbuf.str());
+    logger->WriteMessage(strbuf.str(), target);
   }
 }
 
+Logger::~Logger() {
+  Flush();
+}
+
 std::string Logger::GetDefaultLogPath() {
   std::string defPath;
 #if defined(PREDEF_PLATFORM_UNIX_OR_APPLE)
@@ -89,12 +124,22 @@ std::string Logger::GetDefaultLogPath() {
   return defPath;
 }
 
-std::string Logger::CreateFileName() const {
+std::string Logger::FormatLocalTime(const char* format) {
   char tStr[1000];
   time_t curTime = time(nullptr);
-  struct tm* locTime = localtime(&curTime);
-  strftime(tStr, 1000, "%Y%m%d", locTime);
-  std::string dateTime(tStr, std::find(tStr, tStr + 1000, '\0'));
+  struct tm locTime;
+  // localtime() returns a shared buffer, messages are logged from many threads
+#ifdef _WIN32
+  localtime_s(&locTime, &curTime);
+#else
+  localtime_r(&curTime, &locTime);
+#endif
+  size_t len = strftime(tStr, sizeof(tStr), format, &locTime);
+  return std::string(tStr, len);
+}
+
+std::string Logger::CreateFileName() const {
+  std::string dateTime = FormatLocalTime("%Y%m%d");
   std::string fileName("trino_odbc_" + dateTime + ".log");
   return fileName;
 }
@@ -116,10 +161,13 @@ void Logger::SetLogPath(const std::string& path) {
   }
   std::string oldLogFilePath = logFilePath;
   logPath = path;
-  if (IsEnabled() && logLevel != LogLevel::Type::OFF) {
+  if (IsEnabled() && GetLogLevel() != LogLevel::Type::OFF) {
     LOG_INFO_MSG("Reset log path: Log path is changed to " + logPath
                  + ". Log file is in format trino_odbc_YYYYMMDD.log");
 
+    // the queued messages belong to the previous file
+    Flush();
+
     {
       // close file stream and erase log file name to allow new log file path
       CsLockGuard guard(mutex);
@@ -134,11 +182,40 @@ void Logger::SetLogPath(const std::string& path) {
 }
 
 void Logger::SetLogStream(std::ostream* logStream) {
+  // the queued messages belong to the current stream
+  if (stream != logStream) {
+    Flush();
+  }
   stream = logStream;
 }
 
+void Logger::SetMaxFileSize(uint64_t size) {
+  maxFileSize = size;
+}
+
+void Logger::SetDropOnOverflow(bool drop) {
+  dropOnOverflow = drop;
+}
+
+void Logger::Flush() {
+  std::lock_guard< std::mutex > control(controlMutex);
+  if (!writer.joinable()) {
+    return;
+  }
+
+  {
+    std::lock_guard< std::mutex > lock(writerMutex);
+    stopping = true;
+  }
+  writerCv.notify_all();
+
+  // the writer drains the queue before it exits
+  writer.join();
+  writerRunning = false;
+}
+
 void Logger::SetLogLevel(LogLevel::Type level) {
-  logLevel = level;
+  logLevel.store(static_cast< int >(level), std::memory_order_relaxed);
 }
 
 bool Logger::IsFileStreamOpen() const {
@@ -151,13 +228,19 @@ bool Logger::IsEnabled() const {
 
 bool Logger::EnableLog() {
   // if stream is not set, set the stream as filestream
-  if (stream == nullptr)
-    SetLogStream(&fileStream);
+  std::ostream* expected = nullptr;
+  stream.compare_exchange_strong(expected, &fileStream);
 
-  if (!IsEnabled() && logLevel != LogLevel::Type::OFF
+  if (!IsEnabled() && GetLogLevel() != LogLevel::Type::OFF
       && stream == &fileStream) {
     // The filename creation and stream open is not multi-thread safe
     CsLockGuard guard(mutex);
+
+    // another thread may have opened the file while this one waited
+    if (IsEnabled()) {
+      return true;
+    }
+
     if (logFileName.empty()) {
       logFileName = CreateFileName();
       std::stringstream tmpStream;
@@ -172,19 +255,149 @@ bool Logger::EnableLog() {
     }
 
     fileStream.open(logFilePath, std::ios_base::app);
+    fileSize = GetFileSize(logFilePath);
   }
   return IsEnabled();
 }
 
-void Logger::WriteMessage(std::string const& message) {
-  if (IsEnabled()) {
+void Logger::WriteMessage(std::string const& message, std::ostream* target) {
+  if (target) {
     CsLockGuard guard(mutex);
-    *stream << message << std::endl;
+    *target << message << std::endl;
+  } else if (IsEnabled()) {
+    if (stream == &fileStream) {
+      Enqueue(message);
+    } else {
+      CsLockGuard guard(mutex);
+      *stream.load() << message << std::endl;
+    }
+  }
+}
+
+void Logger::Enqueue(std::string message) {
+  if (!writerRunning.load(std::memory_order_acquire)) {
+    StartWriter();
+  }
+
+  while (!queue.TryPush(message)) {
+    if (dropOnOverflow.load(std::memory_order_relaxed)) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    // wait for the writer to make room
+    if (!writerRunning.load(std::memory_order_acquire)) {
+      StartWriter();
+    }
+    std::this_thread::yield();
+  }
+
+  if (writerSleeping.load(std::memory_order_acquire)) {
+    // taking the lock makes sure the writer is waiting, not about to wait
+    { std::lock_guard< std::mutex > lock(writerMutex); }
+    writerCv.notify_one();
+  }
+}
+
+void Logger::StartWriter() {
+  std::lock_guard< std::mutex > control(controlMutex);
+  if (writer.joinable()) {
+    return;
+  }
+
+  stopping = false;
+  writer = std::thread(&Logger::RunWriter, this);
+  writerRunning = true;
+}
+
+void Logger::RunWriter() {
+  std::string batch;
+  std::string message;
+  int64_t reportedDrops = dropped.load(std::memory_order_relaxed);
+
+  for (;;) {
+    batch.clear();
+    for (size_t count = 0; count < BATCH_SIZE && queue.TryPop(message);
+         ++count) {
+      batch.append(message).append(1, '\n');
+    }
+
+    int64_t drops = dropped.load(std::memory_order_relaxed);
+    if (drops != reportedDrops) {
+      batch.append("WARNING MSG: ")
+          .append(std::to_string(drops - reportedDrops))
+          .append(" log messages were dropped, the log queue was full\n");
+      reportedDrops = drops;
+    }
+
+    if (!batch.empty()) {
+      CsLockGuard guard(mutex);
+      WriteBatch(batch);
+      continue;
+    }
+
+    if (queue.GetPopped() != queue.GetPushed()) {
+      // a writer claimed a position but has not stored the message yet
+      std::this_thread::yield();
+      continue;
+    }
+
+    std::unique_lock< std::mutex > lock(writerMutex);
+    if (stopping) {
+      break;
+    }
+
+    writerSleeping = true;
+    writerCv.wait_for(lock, WRITER_IDLE, [this]() {
+      return stopping || queue.GetPopped() != queue.GetPushed();
+    });
+    writerSleeping = false;
   }
 }
 
+void Logger::WriteBatch(const std::string& batch) {
+  std::ostream* out = stream.load();
+  if (out == &fileStream) {
+    if (!fileStream.is_open()) {
+      return;
+    }
+
+    uint64_t limit = maxFileSize.load(std::memory_order_relaxed);
+    if (limit > 0 && fileSize > 0 && fileSize + batch.size() > limit) {
+      RotateFile();
+    }
+    fileSize += batch.size();
+  } else if (!out) {
+    return;
+  }
+
+  // one flush per batch instead of one per line
+  out->write(batch.data(), static_cast< std::streamsize >(batch.size()));
+  out->flush();
+}
+
+void Logger::RotateFile() {
+  fileStream.close();
+
+  // rename does not replace an existing file on Windows
+  for (int i = ROTATED_FILES - 1; i > 0; --i) {
+    std::string from = logFilePath + '.' + std::to_string(i);
+    std::string to = logFilePath + '.' + std::to_string(i + 1);
+    std::remove(to.c_str());
+    std::rename(from.c_str(), to.c_str());
+  }
+
+  std::string rotated = logFilePath + ".1";
+  std::remove(rotated.c_str());
+  std::rename(logFilePath.c_str(), rotated.c_str());
+
+  fileStream.open(logFilePath, std::ios_base::app);
+  fileSize = 0;
+}
+
 LogLevel::Type Logger::GetLogLevel() const {
-  return logLevel;
+  return static_cast< LogLevel::Type >(
+      logLevel.load(std::memory_order_relaxed));
 }
 
 std::string& Logger::GetLogPath() {
@@ -0,0 +1,80 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "trino/odbc/log_queue.h"
+
+namespace trino {
+namespace odbc {
+LogQueue::LogQueue(size_t capacity)
+    : cells_(), mask_(0), enqueuePos_(0), dequeuePos_(0) {
+  size_t size = 2;
+  while (size < capacity) {
+    size <<= 1;
+  }
+
+  cells_.reset(new Cell[size]);
+  for (size_t i = 0; i < size; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  mask_ = size - 1;
+}
+
+bool LogQueue::TryPush(std::string& message) {
+  size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+  for (;;) {
+    Cell& cell = cells_[pos & mask_];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    intptr_t diff = static_cast< intptr_t >(sequence)
+                    - static_cast< intptr_t >(pos);
+
+    if (diff == 0) {
+      // the cell is free for this position, claim it
+      if (enqueuePos_.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+        cell.message.swap(message);
+        cell.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // the cell still holds the message of the previous round
+      return false;
+    } else {
+      pos = enqueuePos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool LogQueue::TryPop(std::string& message) {
+  size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+  Cell& cell = cells_[pos & mask_];
+  size_t sequence = cell.sequence.load(std::memory_order_acquire);
+  if (sequence != pos + 1) {
+    return false;
+  }
+
+  message.swap(cell.message);
+  cell.message.clear();
+  cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+  dequeuePos_.store(pos + 1, std::memory_order_release);
+
+  return true;
+}
+}  // namespace odbc
+}  // namespace trino
@@ -0,0 +1,108 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "trino/odbc/memory_governor.h"
+
+#include "trino/odbc/log.h"
+
+namespace trino {
+namespace odbc {
+MemoryGovernor::MemoryGovernor(int64_t limit,
+                               std::shared_ptr< MemoryGovernor > parent)
+    : parent_(std::move(parent)),
+      limit_(limit),
+      usage_(0),
+      peak_(0),
+      throttled_(0) {
+  // No-op.
+}
+
+void MemoryGovernor::SetLimit(int64_t limit) {
+  LOG_DEBUG_MSG("SetLimit is called with limit " << limit);
+  limit_.store(limit);
+
+  // a raised limit may let waiting threads go
+  Notify();
+}
+
+void MemoryGovernor::Reserve(int64_t bytes) {
+  for (MemoryGovernor* governor = this; governor;
+       governor = governor->parent_.get()) {
+    int64_t usage = governor->usage_.fetch_add(bytes) + bytes;
+
+    int64_t peak = governor->peak_.load();
+    while (usage > peak && !governor->peak_.compare_exchange_weak(peak, usage))
+      ;
+  }
+}
+
+void MemoryGovernor::Release(int64_t bytes) {
+  for (MemoryGovernor* governor = this; governor;
+       governor = governor->parent_.get()) {
+    governor->usage_.fetch_sub(bytes);
+  }
+
+  Notify();
+}
+
+bool MemoryGovernor::IsOverBudget() const {
+  for (const MemoryGovernor* governor = this; governor;
+       governor = governor->parent_.get()) {
+    int64_t limit = governor->limit_.load();
+    if (limit > 0 && governor->usage_.load() >= limit) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void MemoryGovernor::WaitForBudget(const std::function< bool() >& proceed) {
+  MemoryGovernor& root = GetRoot();
+
+  std::unique_lock< std::mutex > lock(root.mutex_);
+  if (IsOverBudget() && !proceed()) {
+    ++throttled_;
+    LOG_DEBUG_MSG("Result memory budget is exhausted, usage is "
+                  << usage_.load() << " bytes, waiting");
+
+    root.cv_.wait(lock, [&]() { return !IsOverBudget() || proceed(); });
+  }
+}
+
+void MemoryGovernor::Notify() {
+  MemoryGovernor& root = GetRoot();
+
+  // taking the lock orders the notification after the state change the
+  // waiters are about to check
+  std::lock_guard< std::mutex > lock(root.mutex_);
+  root.cv_.notify_all();
+}
+
+MemoryGovernor& MemoryGovernor::GetRoot() {
+  MemoryGovernor* governor = this;
+  while (governor->parent_) {
+    governor = governor->parent_.get();
+  }
+
+  return *governor;
+}
+}  // namespace odbc
+}  // namespace trino
@@ -156,18 +156,27 @@ void ColumnMeta::Read(app::ColumnBindingMap& columnBindings, int32_t position) {
     LOG_ERROR_MSG("Could not find the second column");
     return;
   }
-
-  dataType = static_cast< int16_t >(
-      GetScalarDataType(itr->second.GetString(STRING_BUFFER_SIZE)));
+  std::string type = itr->second.GetString(STRING_BUFFER_SIZE);
 
   itr = columnBindings.find(3);
   if (itr == columnBindings.end()) {
     LOG_ERROR_MSG("Could not find the third column");
     return;
   }
-  remarks = itr->second.GetString(STRING_BUFFER_SIZE);
-  if (remarks.value() == "MEASURE_VALUE" || remarks.value() == "MULTI") {
-    // These are measure values which could be nullable.
+
+  Read(columnName.value(), type, itr->second.GetString(STRING_BUFFER_SIZE),
+       false, position);
+}
+
+void ColumnMeta::Read(const std::string& name, const std::string& type,
+                      const std::string& extra, bool nullable,
+                      int32_t position) {
+  columnName = name;
+  dataType = static_cast< int16_t >(GetScalarDataType(type));
+  remarks = extra;
+  if (nullable || remarks.value() == "MEASURE_VALUE"
+      || remarks.value() == "MULTI") {
+    // Listed as nullable, or measure values which could be nullable.
     nullability = Nullability::NULLABLE;
   } else {
     nullability = Nullability::NO_NULL;
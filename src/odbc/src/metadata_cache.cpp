@@ -0,0 +1,691 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "trino/odbc/metadata_cache.h"
+
+#ifdef _WIN32
+#include "trino/odbc/system/odbc_constants.h"
+#else
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+
+#include "trino/odbc/log.h"
+#include "trino/odbc/metrics.h"
+
+namespace {
+/** Kinds of the entries. */
+const char DATABASES = 'D';
+const char TABLES = 'T';
+const char TABLES_BY_NAME = 'N';
+const char COLUMNS = 'C';
+const char COLUMN_LISTING = 'L';
+
+/** Leading bytes of a snapshot file. */
+const char SNAPSHOT_MAGIC[4] = {'T', 'M', 'C', 'S'};
+
+/**
+ * Append a number to a snapshot buffer.
+ *
+ * @param buffer Buffer.
+ * @param value Value.
+ */
+template < typename T >
+void WriteNumber(std::string& buffer, T value) {
+  buffer.append(reinterpret_cast< const char* >(&value), sizeof(value));
+}
+
+/**
+ * Append a string to a snapshot buffer.
+ *
+ * @param buffer Buffer.
+ * @param value Value.
+ */
+void WriteString(std::string& buffer, const std::string& value) {
+  WriteNumber(buffer, static_cast< uint32_t >(value.size()));
+  buffer.append(value);
+}
+
+/** Reader of a snapshot buffer. */
+struct SnapshotReader {
+  /**
+   * Constructor.
+   *
+   * @param data Snapshot data.
+   */
+  explicit SnapshotReader(const std::vector< char >& data)
+      : data(data), pos(0) {
+    // No-op.
+  }
+
+  /**
+   * Read a number.
+   *
+   * @param value Value, set on success.
+   * @return @c false if the buffer is too short.
+   */
+  template < typename T >
+  bool ReadNumber(T& value) {
+    if (data.size() - pos < sizeof(value)) {
+      return false;
+    }
+
+    std::memcpy(&value, data.data() + pos, sizeof(value));
+    pos += sizeof(value);
+    return true;
+  }
+
+  /**
+   * Read a string.
+   *
+   * @param value Value, set on success.
+   * @return @c false if the buffer is too short.
+   */
+  bool ReadString(std::string& value) {
+    uint32_t size = 0;
+    if (!ReadNumber(size) || data.size() - pos < size) {
+      return false;
+    }
+
+    value.assign(data.data() + pos, size);
+    pos += size;
+    return true;
+  }
+
+  /** Snapshot data. */
+  const std::vector< char >& data;
+
+  /** Read position. */
+  size_t pos;
+};
+
+/**
+ * Replace a file with another one in the same directory.
+ *
+ * @param from Path of the new file.
+ * @param to Path of the replaced file.
+ * @return @c true on success.
+ */
+bool ReplaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+  return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+/**
+ * Create a temporary file next to a path.
+ *
+ * @param path Path the file is for.
+ * @param tmpPath Path of the created file.
+ * @return Open file or nullptr on failure.
+ */
+std::FILE* CreateSnapshotFile(const std::string& path, std::string& tmpPath) {
+#ifdef _WIN32
+  tmpPath = path + "." + std::to_string(GetCurrentProcessId()) + "."
+            + std::to_string(GetCurrentThreadId()) + ".tmp";
+  return std::fopen(tmpPath.c_str(), "wb");
+#else
+  std::string pattern = path + ".XXXXXX";
+  std::vector< char > name(pattern.begin(), pattern.end());
+  name.push_back('\0');
+
+  int fd = mkstemp(name.data());
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  tmpPath = name.data();
+  std::FILE* file = fdopen(fd, "wb");
+  if (!file) {
+    close(fd);
+    std::remove(tmpPath.c_str());
+  }
+  return file;
+#endif
+}
+
+/** Number of values of one table. */
+const size_t TABLE_VALUES = 2;
+
+/**
+ * Flatten tables into entry values.
+ *
+ * @param tables Tables.
+ * @return Values.
+ */
+std::vector< std::string > EncodeTables(
+    const std::vector< trino::odbc::MetadataCache::Table >& tables) {
+  std::vector< std::string > values;
+  values.reserve(tables.size() * TABLE_VALUES);
+  for (const trino::odbc::MetadataCache::Table& table : tables) {
+    values.push_back(table.database);
+    values.push_back(table.name);
+  }
+
+  return values;
+}
+
+/**
+ * Rebuild tables from entry values.
+ *
+ * @param values Values.
+ * @param tables Tables.
+ */
+void DecodeTables(const std::vector< std::string >& values,
+                  std::vector< trino::odbc::MetadataCache::Table >& tables) {
+  tables.clear();
+  for (size_t i = 0; i + TABLE_VALUES <= values.size(); i += TABLE_VALUES) {
+    trino::odbc::MetadataCache::Table table;
+    table.database = values[i];
+    table.name = values[i + 1];
+    tables.push_back(std::move(table));
+  }
+}
+
+/** Number of values of one column. */
+const size_t COLUMN_VALUES = 7;
+
+/**
+ * Flatten columns into entry values.
+ *
+ * @param columns Columns.
+ * @return Values.
+ */
+std::vector< std::string > EncodeColumns(
+    const std::vector< trino::odbc::MetadataCache::Column >& columns) {
+  std::vector< std::string > values;
+  values.reserve(columns.size() * COLUMN_VALUES);
+  for (const trino::odbc::MetadataCache::Column& column : columns) {
+    values.push_back(column.database);
+    values.push_back(column.table);
+    values.push_back(column.name);
+    values.push_back(column.dataType);
+    values.push_back(column.remarks);
+    values.push_back(column.nullable ? "1" : "0");
+    values.push_back(std::to_string(column.position));
+  }
+
+  return values;
+}
+
+/**
+ * Rebuild columns from entry values.
+ *
+ * @param values Values.
+ * @param columns Columns.
+ */
+void DecodeColumns(const std::vector< std::string >& values,
+                   std::vector< trino::odbc::MetadataCache::Column >& columns) {
+  columns.clear();
+  for (size_t i = 0; i + COLUMN_VALUES <= values.size(); i += COLUMN_VALUES) {
+    trino::odbc::MetadataCache::Column column;
+    column.database = values[i];
+    column.table = values[i + 1];
+    column.name = values[i + 2];
+    column.dataType = values[i + 3];
+    column.remarks = values[i + 4];
+    column.nullable = values[i + 5] == "1";
+    column.position = std::atoi(values[i + 6].c_str());
+    columns.push_back(std::move(column));
+  }
+}
+}  // namespace
+
+namespace trino {
+namespace odbc {
+const size_t MetadataCache::MAX_ENTRIES;
+const uint32_t MetadataCache::SNAPSHOT_VERSION;
+const int32_t MetadataCache::LOAD_WAIT;
+
+MetadataCache::MetadataCache()
+    : hits_(0),
+      misses_(0),
+      slots_(),
+      index_(),
+      loading_(),
+      mutex_(),
+      loaded_() {
+  // No-op.
+}
+
+bool MetadataCache::GetDatabases(const std::string& identity,
+                                 const std::string& pattern,
+                                 std::vector< std::string >& names) {
+  return Get(MakeKey(identity, DATABASES, pattern, ""), names);
+}
+
+void MetadataCache::PutDatabases(const std::string& identity,
+                                 const std::string& pattern,
+                                 const std::vector< std::string >& names,
+                                 int32_t ttl) {
+  Put(MakeKey(identity, DATABASES, pattern, ""), names, ttl);
+}
+
+bool MetadataCache::GetTables(const std::string& identity,
+                              const std::string& databasePattern,
+                              const std::string& tablePattern,
+                              std::vector< Table >& tables) {
+  std::vector< std::string > values;
+  if (!Get(MakeKey(identity, TABLES, databasePattern, tablePattern), values)) {
+    return false;
+  }
+
+  DecodeTables(values, tables);
+  return true;
+}
+
+void MetadataCache::PutTables(const std::string& identity,
+                              const std::string& databasePattern,
+                              const std::string& tablePattern,
+                              const std::vector< Table >& tables,
+                              int32_t ttl) {
+  Put(MakeKey(identity, TABLES, databasePattern, tablePattern),
+      EncodeTables(tables), ttl);
+}
+
+bool MetadataCache::GetTablesByName(const std::string& identity,
+                                    const std::string& database,
+                                    const std::string& table,
+                                    std::vector< Table >& tables) {
+  std::vector< std::string > values;
+  if (!Get(MakeKey(identity, TABLES_BY_NAME, database, table), values)) {
+    return false;
+  }
+
+  DecodeTables(values, tables);
+  return true;
+}
+
+void MetadataCache::PutTablesByName(const std::string& identity,
+                                    const std::string& database,
+                                    const std::string& table,
+                                    const std::vector< Table >& tables,
+                                    int32_t ttl) {
+  Put(MakeKey(identity, TABLES_BY_NAME, database, table),
+      EncodeTables(tables), ttl);
+}
+
+bool MetadataCache::GetColumns(const std::string& identity,
+                               const std::string& database,
+                               const std::string& table,
+                               std::vector< Column >& columns) {
+  std::vector< std::string > values;
+  if (!Get(MakeKey(identity, COLUMNS, database, table), values)) {
+    return false;
+  }
+
+  DecodeColumns(values, columns);
+  return true;
+}
+
+void MetadataCache::PutColumns(const std::string& identity,
+                               const std::string& database,
+                               const std::string& table,
+                               const std::vector< Column >& columns,
+                               int32_t ttl) {
+  Put(MakeKey(identity, COLUMNS, database, table), EncodeColumns(columns),
+      ttl);
+}
+
+bool MetadataCache::GetColumnListing(const std::string& identity,
+                                     const std::string& databasePattern,
+                                     const std::string& tablePattern,
+                                     const std::string& columnPattern,
+                                     std::vector< Column >& columns) {
+  std::vector< std::string > values;
+  if (!Get(MakeKey(identity, COLUMN_LISTING, databasePattern,
+                   tablePattern + '\0' + columnPattern),
+           values)) {
+    return false;
+  }
+
+  DecodeColumns(values, columns);
+  return true;
+}
+
+void MetadataCache::PutColumnListing(const std::string& identity,
+                                     const std::string& databasePattern,
+                                     const std::string& tablePattern,
+                                     const std::string& columnPattern,
+                                     const std::vector< Column >& columns,
+                                     int32_t ttl) {
+  Put(MakeKey(identity, COLUMN_LISTING, databasePattern,
+              tablePattern + '\0' + columnPattern),
+      EncodeColumns(columns), ttl);
+}
+
+bool MetadataCache::Save(const std::string& identity,
+                         const std::string& path) const {
+  std::string prefix = identity + '\0';
+  std::string buffer(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+  WriteNumber(buffer, SNAPSHOT_VERSION);
+
+  uint32_t count = 0;
+  size_t countPos = buffer.size();
+  WriteNumber(buffer, count);
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    // expiry times are stored as wall clock time, the steady clock does not
+    // survive the process
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    std::chrono::system_clock::time_point wallNow =
+        std::chrono::system_clock::now();
+
+    // least recently used first, so loading keeps the order
+    for (auto it = slots_.rbegin(); it != slots_.rend(); ++it) {
+      if (it->expiry <= now
+          || it->key.compare(0, prefix.size(), prefix) != 0) {
+        continue;
+      }
+
+      int64_t expiry =
+          std::chrono::duration_cast< std::chrono::seconds >(
+              (wallNow + (it->expiry - now)).time_since_epoch())
+              .count();
+      WriteString(buffer, it->key.substr(prefix.size()));
+      WriteNumber(buffer, expiry);
+      WriteNumber(buffer, static_cast< uint32_t >(it->values.size()));
+      for (const std::string& value : it->values) {
+        WriteString(buffer, value);
+      }
+      ++count;
+    }
+  }
+  std::memcpy(&buffer[countPos], &count, sizeof(count));
+
+  std::string tmpPath;
+  std::FILE* file = CreateSnapshotFile(path, tmpPath);
+  if (!file) {
+    LOG_ERROR_MSG("Failed to create metadata snapshot file for " << path);
+    return false;
+  }
+
+  bool written =
+      std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+  if (std::fclose(file) != 0 || !written || !ReplaceFile(tmpPath, path)) {
+    LOG_ERROR_MSG("Failed to write metadata snapshot file " << path);
+    std::remove(tmpPath.c_str());
+    return false;
+  }
+
+  LOG_DEBUG_MSG("Saved " << count << " metadata cache entries to " << path);
+  return true;
+}
+
+void MetadataCache::BeginDatabasesLoad(const std::string& identity,
+                                       const std::string& pattern) {
+  BeginLoad(MakeKey(identity, DATABASES, pattern, ""));
+}
+
+void MetadataCache::BeginTablesLoad(const std::string& identity,
+                                    const std::string& databasePattern,
+                                    const std::string& tablePattern) {
+  BeginLoad(MakeKey(identity, TABLES, databasePattern, tablePattern));
+}
+
+void MetadataCache::EndLoads(const std::string& identity) {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  std::string prefix = identity + '\0';
+  for (auto it = loading_.begin(); it != loading_.end();) {
+    if (it->compare(0, prefix.size(), prefix) == 0) {
+      it = loading_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  loaded_.notify_all();
+}
+
+size_t MetadataCache::Load(const std::string& identity,
+                           const std::string& path) {
+  std::FILE* file = std::fopen(path.c_str(), "rb");
+  if (!file) {
+    LOG_DEBUG_MSG("No metadata snapshot file " << path);
+    return 0;
+  }
+
+  std::vector< char > data;
+  char chunk[4096];
+  size_t read;
+  while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+    data.insert(data.end(), chunk, chunk + read);
+  }
+  std::fclose(file);
+
+  SnapshotReader reader(data);
+  char magic[sizeof(SNAPSHOT_MAGIC)] = {};
+  uint32_t version = 0;
+  uint32_t count = 0;
+  for (char& c : magic) {
+    if (!reader.ReadNumber(c)) {
+      break;
+    }
+  }
+  if (std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0
+      || !reader.ReadNumber(version) || version != SNAPSHOT_VERSION
+      || !reader.ReadNumber(count)) {
+    LOG_WARNING_MSG("Metadata snapshot file " << path
+                                              << " has an unknown format");
+    return 0;
+  }
+
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  int64_t wallNow = std::chrono::duration_cast< std::chrono::seconds >(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count();
+
+  size_t loaded = 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    std::string suffix;
+    int64_t expiry = 0;
+    uint32_t valueCount = 0;
+    // every value takes at least its length, a larger count is corrupt
+    if (!reader.ReadString(suffix) || !reader.ReadNumber(expiry)
+        || !reader.ReadNumber(valueCount)
+        || valueCount > (data.size() - reader.pos) / sizeof(uint32_t)) {
+      LOG_WARNING_MSG("Metadata snapshot file " << path << " is truncated");
+      break;
+    }
+
+    std::vector< std::string > values(valueCount);
+    bool complete = true;
+    for (std::string& value : values) {
+      complete = complete && reader.ReadString(value);
+    }
+    if (!complete) {
+      LOG_WARNING_MSG("Metadata snapshot file " << path << " is truncated");
+      break;
+    }
+
+    std::string key = identity + '\0' + suffix;
+    if (expiry <= wallNow || index_.count(key) > 0) {
+      continue;
+    }
+
+    Insert(key, std::move(values),
+           now + std::chrono::seconds(expiry - wallNow));
+    ++loaded;
+  }
+
+  LOG_DEBUG_MSG("Loaded " << loaded << " metadata cache entries from "
+                          << path);
+  return loaded;
+}
+
+std::string MetadataCache::MakeSnapshotName(const std::string& dsn,
+                                            const std::string& identity) {
+  // FNV-1a, the name must stay the same across processes and builds
+  uint64_t hash = 14695981039346656037ULL;
+  std::string source = dsn + '\0' + identity;
+  for (char c : source) {
+    hash ^= static_cast< unsigned char >(c);
+    hash *= 1099511628211ULL;
+  }
+
+  char name[64];
+  std::snprintf(name, sizeof(name), "trino-odbc-metadata-%016llx.bin",
+                static_cast< unsigned long long >(hash));
+  return name;
+}
+
+void MetadataCache::Invalidate(const std::string& identity) {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  std::string prefix = identity + '\0';
+  for (auto it = slots_.begin(); it != slots_.end();) {
+    if (it->key.compare(0, prefix.size(), prefix) == 0) {
+      index_.erase(it->key);
+      it = slots_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  LOG_DEBUG_MSG("Metadata cache is invalidated, " << slots_.size()
+                                                  << " entries left");
+}
+
+void MetadataCache::Clear() {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  index_.clear();
+  slots_.clear();
+}
+
+size_t MetadataCache::GetSize() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  return slots_.size();
+}
+
+int64_t MetadataCache::GetHitCount() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  return hits_;
+}
+
+int64_t MetadataCache::GetMissCount() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  return misses_;
+}
+
+std::string MetadataCache::MakeKey(const std::string& identity, char kind,
+                                   const std::string& first,
+                                   const std::string& second) {
+  std::string key;
+  key.reserve(identity.size() + first.size() + second.size() + 4);
+  key.append(identity).append(1, '\0');
+  key.append(1, kind).append(1, '\0');
+  key.append(first).append(1, '\0');
+  key.append(second);
+
+  return key;
+}
+
+void MetadataCache::BeginLoad(const std::string& key) {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  loading_.insert(key);
+}
+
+bool MetadataCache::Get(const std::string& key,
+                        std::vector< std::string >& values) {
+  std::unique_lock< std::mutex > lock(mutex_);
+
+  auto it = index_.find(key);
+  if (it == index_.end() && loading_.count(key) > 0) {
+    // attach to the load in flight instead of issuing the same query
+    LOG_DEBUG_MSG("Waiting for metadata being loaded");
+    loaded_.wait_for(lock, std::chrono::seconds(LOAD_WAIT),
+                     [&]() { return loading_.count(key) == 0; });
+    it = index_.find(key);
+  }
+
+  if (it == index_.end()) {
+    ++misses_;
+    Metrics::GetInstance().metadataCacheMisses.Add();
+    return false;
+  }
+
+  if (it->second->expiry <= std::chrono::steady_clock::now()) {
+    LOG_DEBUG_MSG("Cached metadata is expired");
+    slots_.erase(it->second);
+    index_.erase(it);
+    ++misses_;
+    Metrics::GetInstance().metadataCacheMisses.Add();
+    return false;
+  }
+
+  ++hits_;
+  Metrics::GetInstance().metadataCacheHits.Add();
+  slots_.splice(slots_.begin(), slots_, it->second);
+  values = slots_.front().values;
+
+  return true;
+}
+
+void MetadataCache::Put(const std::string& key,
+                        std::vector< std::string > values, int32_t ttl) {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  Insert(key, std::move(values),
+         std::chrono::steady_clock::now() + std::chrono::seconds(ttl));
+}
+
+void MetadataCache::Insert(const std::string& key,
+                           std::vector< std::string > values,
+                           std::chrono::steady_clock::time_point expiry) {
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    slots_.erase(it->second);
+    index_.erase(it);
+  }
+
+  Slot slot;
+  slot.key = key;
+  slot.values = std::move(values);
+  slot.expiry = expiry;
+
+  slots_.push_front(std::move(slot));
+  index_[key] = slots_.begin();
+
+  if (loading_.erase(key) > 0) {
+    loaded_.notify_all();
+  }
+
+  while (slots_.size() > MAX_ENTRIES) {
+    index_.erase(slots_.back().key);
+    slots_.pop_back();
+  }
+}
+}  // namespace odbc
+}  // namespace trino
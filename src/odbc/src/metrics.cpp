@@ -0,0 +1,329 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "trino/odbc/metrics.h"
+
+#ifdef _WIN32
+#include "trino/odbc/system/odbc_constants.h"
+#else
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <sstream>
+#include <vector>
+
+#include "trino/odbc/log.h"
+#include "trino/odbc/timer_service.h"
+#include "trino/odbc/worker_pool.h"
+
+namespace {
+/** Prefix of the metric names. */
+const char METRIC_PREFIX[] = "trino_odbc_";
+
+/** Label values of the conversion result types. */
+const char* const CONVERSION_RESULT_NAMES[] = {"success",
+                                                "fractional_truncated",
+                                                "varlen_data_truncated",
+                                                "unsupported_conversion",
+                                                "indicator_needed",
+                                                "no_data",
+                                                "failure"};
+
+/**
+ * Replace a file with another one.
+ *
+ * @param from Path of the new file.
+ * @param to Path of the file to replace.
+ * @return @c true on success.
+ */
+bool ReplaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+  return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+/**
+ * Create a temporary file next to a path.
+ *
+ * @param path Path the file is for.
+ * @param tmpPath Path of the created file.
+ * @return Open file or nullptr on failure.
+ */
+std::FILE* CreateTempFile(const std::string& path, std::string& tmpPath) {
+#ifdef _WIN32
+  tmpPath = path + "." + std::to_string(GetCurrentProcessId()) + ".tmp";
+  return std::fopen(tmpPath.c_str(), "wb");
+#else
+  std::string pattern = path + ".XXXXXX";
+  std::vector< char > name(pattern.begin(), pattern.end());
+  name.push_back('\0');
+
+  int fd = mkstemp(name.data());
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  tmpPath = name.data();
+  std::FILE* file = fdopen(fd, "wb");
+  if (!file) {
+    close(fd);
+    std::remove(tmpPath.c_str());
+  }
+  return file;
+#endif
+}
+
+/**
+ * Write the help and type lines of a metric.
+ *
+ * @param out Output stream.
+ * @param name Metric name without the prefix.
+ * @param type Metric type.
+ * @param help Help text.
+ */
+void WriteHeader(std::ostream& out, const char* name, const char* type,
+                 const char* help) {
+  out << "# HELP " << METRIC_PREFIX << name << ' ' << help << '\n'
+      << "# TYPE " << METRIC_PREFIX << name << ' ' << type << '\n';
+}
+
+/**
+ * Write a counter.
+ *
+ * @param out Output stream.
+ * @param name Metric name without the prefix, ending in "_total".
+ * @param help Help text.
+ * @param counter Counter.
+ */
+void WriteCounter(std::ostream& out, const char* name, const char* help,
+                  const trino::odbc::Metrics::Counter& counter) {
+  WriteHeader(out, name, "counter", help);
+  out << METRIC_PREFIX << name << ' ' << counter.Get() << '\n';
+}
+
+/**
+ * Write a gauge.
+ *
+ * @param out Output stream.
+ * @param name Metric name without the prefix.
+ * @param help Help text.
+ * @param gauge Gauge.
+ */
+void WriteGauge(std::ostream& out, const char* name, const char* help,
+                const trino::odbc::Metrics::Gauge& gauge) {
+  WriteHeader(out, name, "gauge", help);
+  out << METRIC_PREFIX << name << ' ' << gauge.Get() << '\n';
+}
+
+/**
+ * Write a histogram, in seconds as Prometheus expects.
+ *
+ * @param out Output stream.
+ * @param name Metric name without the prefix, ending in "_seconds".
+ * @param help Help text.
+ * @param histogram Histogram.
+ */
+void WriteHistogram(std::ostream& out, const char* name, const char* help,
+                    const trino::odbc::Metrics::Histogram& histogram) {
+  typedef trino::odbc::Metrics::Histogram Histogram;
+
+  WriteHeader(out, name, "histogram", help);
+
+  // the buckets are read one by one while other threads record, so the
+  // total is taken from them to keep the cumulative counts consistent
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < Histogram::BUCKET_COUNT; ++i) {
+    cumulative += histogram.GetBucket(i);
+    out << METRIC_PREFIX << name << "_bucket{le=\""
+        << static_cast< double >(uint64_t(1) << i) / 1e6 << "\"} "
+        << cumulative << '\n';
+  }
+  cumulative += histogram.GetBucket(Histogram::BUCKET_COUNT);
+
+  out << METRIC_PREFIX << name << "_bucket{le=\"+Inf\"} " << cumulative << '\n'
+      << METRIC_PREFIX << name << "_sum "
+      << static_cast< double >(histogram.GetSumMicros()) / 1e6 << '\n'
+      << METRIC_PREFIX << name << "_count " << cumulative << '\n';
+}
+}  // namespace
+
+namespace trino {
+namespace odbc {
+Metrics::Histogram::Histogram() : count_(0), sum_(0) {
+  for (size_t i = 0; i <= BUCKET_COUNT; ++i) {
+    buckets_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void Metrics::Histogram::Record(std::chrono::steady_clock::duration duration) {
+  int64_t micros =
+      std::chrono::duration_cast< std::chrono::microseconds >(duration)
+          .count();
+  uint64_t value = micros > 0 ? static_cast< uint64_t >(micros) : 0;
+
+  // index of the smallest power of two not below the value
+  size_t idx = 0;
+  while (idx < BUCKET_COUNT && (uint64_t(1) << idx) < value) {
+    ++idx;
+  }
+
+  buckets_[idx].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+}
+
+Metrics& Metrics::GetInstance() {
+  // never destroyed, the timer and worker threads may still record metrics
+  // while the process exits
+  static Metrics* instance = new Metrics();
+  return *instance;
+}
+
+Metrics::Metrics()
+    : exportMutex_(),
+      exportPath_(),
+      exportInterval_(0),
+      exportGeneration_(0) {
+  // No-op.
+}
+
+std::string Metrics::ToPrometheusText() const {
+  std::ostringstream out;
+
+  WriteCounter(out, "queries_started_total", "Data queries started.",
+               queriesStarted);
+  WriteCounter(out, "queries_failed_total",
+               "Data queries that failed or timed out.", queriesFailed);
+  WriteCounter(out, "pages_fetched_total",
+               "Result pages fetched from the server.", pagesFetched);
+  WriteCounter(out, "received_bytes_total",
+               "Decoded bytes of the fetched result pages.", bytesReceived);
+  WriteCounter(out, "rows_converted_total",
+               "Rows read into bound application buffers.", rowsConverted);
+
+  WriteHeader(out, "conversion_errors_total", "counter",
+              "Column conversions that did not fully succeed, by result.");
+  for (size_t i = 0; i < CONVERSION_RESULT_COUNT; ++i) {
+    if (conversionErrors[i].Get() > 0) {
+      out << METRIC_PREFIX << "conversion_errors_total{result=\""
+          << CONVERSION_RESULT_NAMES[i] << "\"} " << conversionErrors[i].Get()
+          << '\n';
+    }
+  }
+
+  WriteGauge(out, "worker_threads", "Worker threads started.",
+             workerThreads);
+  WriteGauge(out, "worker_threads_busy", "Worker threads running a task.",
+             workersBusy);
+  WriteCounter(out, "page_arenas_created_total", "Page arenas allocated.",
+               arenasCreated);
+  WriteCounter(out, "page_arenas_reused_total",
+               "Page arenas taken from a pool.", arenasReused);
+  WriteCounter(out, "result_cache_hits_total",
+               "Queries answered by a result cache.", resultCacheHits);
+  WriteCounter(out, "result_cache_misses_total",
+               "Cacheable queries not found in a result cache.",
+               resultCacheMisses);
+  WriteCounter(out, "metadata_cache_hits_total",
+               "Lookups answered by a metadata cache.", metadataCacheHits);
+  WriteCounter(out, "metadata_cache_misses_total",
+               "Lookups not found in a metadata cache.", metadataCacheMisses);
+
+  WriteHistogram(out, "query_execute_seconds",
+                 "Time from the start of a query until its first page was "
+                 "read.",
+                 executeLatency);
+  WriteHistogram(out, "page_fetch_seconds",
+                 "Time requests for result pages took.", pageFetchLatency);
+
+  return out.str();
+}
+
+bool Metrics::WriteFile(const std::string& path) const {
+  std::string text = ToPrometheusText();
+
+  // the textfile collector must never see a partially written file
+  std::string tmpPath;
+  std::FILE* file = CreateTempFile(path, tmpPath);
+  if (!file) {
+    LOG_ERROR_MSG("Failed to create metrics file for " << path);
+    return false;
+  }
+
+  bool written = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+  if (std::fclose(file) != 0 || !written || !ReplaceFile(tmpPath, path)) {
+    LOG_ERROR_MSG("Failed to write metrics file " << path);
+    std::remove(tmpPath.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+void Metrics::StartExport(const std::string& path,
+                          std::chrono::seconds interval) {
+  uint64_t generation;
+  {
+    std::lock_guard< std::mutex > lock(exportMutex_);
+    if (path == exportPath_ && interval == exportInterval_) {
+      return;
+    }
+
+    exportPath_ = path;
+    exportInterval_ = interval;
+    generation = ++exportGeneration_;
+  }
+
+  LOG_INFO_MSG("Writing metrics to " << path << " every " << interval.count()
+                                     << " seconds");
+  Export(generation);
+}
+
+void Metrics::Export(uint64_t generation) {
+  std::string path;
+  std::chrono::seconds interval;
+  {
+    std::lock_guard< std::mutex > lock(exportMutex_);
+    if (generation != exportGeneration_) {
+      return;
+    }
+
+    path = exportPath_;
+    interval = exportInterval_;
+  }
+
+  WriteFile(path);
+  if (interval.count() <= 0) {
+    return;
+  }
+
+  // the timer thread only hands the write over to a worker, so a slow disk
+  // never delays the query timeouts
+  TimerService::GetInstance().Schedule(interval, [this, generation]() {
+    WorkerPool::GetInstance().Submit(
+        [this, generation]() { Export(generation); });
+  });
+}
+}  // namespace odbc
+}  // namespace trino
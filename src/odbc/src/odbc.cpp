@@ -34,8 +34,10 @@
 #include "trino/odbc/statement.h"
 #include "trino/odbc/system/odbc_constants.h"
 #include "trino/odbc/system/system_dsn.h"
+#include "trino/odbc/tracer.h"
 #include "trino/odbc/type_traits.h"
 #include "trino/odbc/utility.h"
+#include "trino/odbc/worker_pool.h"
 
 using ignite::odbc::diagnostic::Diagnosable;
 /**
@@ -67,6 +69,8 @@ SQLRETURN SQLGetInfo(SQLHDBC conn, SQLUSMALLINT infoType, SQLPOINTER infoValue,
   using odbc::Connection;
   using odbc::config::ConnectionInfo;
 
+  odbc::Tracer::Span span("SQLGetInfo");
+
   LOG_DEBUG_MSG("SQLGetInfo called: "
                 << infoType << " ("
                 << ConnectionInfo::InfoTypeToString(infoType) << "), "
@@ -86,6 +90,8 @@ SQLRETURN SQLGetInfo(SQLHDBC conn, SQLUSMALLINT infoType, SQLPOINTER infoValue,
 
 SQLRETURN SQLAllocHandle(SQLSMALLINT type, SQLHANDLE parent,
                          SQLHANDLE* result) {
+  odbc::Tracer::Span span("SQLAllocHandle");
+
   LOG_DEBUG_MSG("SQLAllocHandle called with type " << type);
   switch (type) {
     case SQL_HANDLE_ENV:
@@ -112,6 +118,8 @@ SQLRETURN SQLAllocHandle(SQLSMALLINT type, SQLHANDLE parent,
 SQLRETURN SQLAllocEnv(SQLHENV* env) {
   using odbc::Environment;
 
+  odbc::Tracer::Span span("SQLAllocEnv");
+
   LOG_DEBUG_MSG("SQLAllocEnv called");
 
   *env = reinterpret_cast< SQLHENV >(new Environment());
@@ -123,6 +131,8 @@ SQLRETURN SQLAllocConnect(SQLHENV env, SQLHDBC* conn) {
   using odbc::Connection;
   using odbc::Environment;
 
+  odbc::Tracer::Span span("SQLAllocConnect");
+
   LOG_DEBUG_MSG("SQLAllocConnect called");
 
   *conn = SQL_NULL_HDBC;
@@ -149,6 +159,8 @@ SQLRETURN SQLAllocConnect(SQLHENV env, SQLHDBC* conn) {
 SQLRETURN SQLAllocStmt(SQLHDBC conn, SQLHSTMT* stmt) {
   using odbc::Connection;
 
+  odbc::Tracer::Span span("SQLAllocStmt");
+
   LOG_DEBUG_MSG("SQLAllocStmt called");
 
   *stmt = SQL_NULL_HDBC;
@@ -170,6 +182,8 @@ SQLRETURN SQLAllocStmt(SQLHDBC conn, SQLHSTMT* stmt) {
 SQLRETURN SQLAllocDesc(SQLHDBC conn, SQLHDESC* desc) {
   using odbc::Connection;
 
+  odbc::Tracer::Span span("SQLAllocDesc");
+
   Connection* connection = reinterpret_cast< Connection* >(conn);
 
   if (!connection) {
@@ -185,6 +199,8 @@ SQLRETURN SQLAllocDesc(SQLHDBC conn, SQLHDESC* desc) {
 }
 
 SQLRETURN SQLFreeHandle(SQLSMALLINT type, SQLHANDLE handle) {
+  // no span here, the tracer is flushed when the environment is freed and
+  // the functions called below record their own spans
   LOG_DEBUG_MSG("SQLFreeHandle called with type " << type);
 
   switch (type) {
@@ -219,7 +235,20 @@ SQLRETURN SQLFreeEnv(SQLHENV env) {
     return SQL_INVALID_HANDLE;
   }
 
-  delete environment;
+  {
+    odbc::Tracer::Span span("SQLFreeEnv");
+    delete environment;
+  }
+
+  // the application may unload the driver once the environment is freed,
+  // so the background work of the driver ends before this returns
+  if (Environment::GetCount() == 0) {
+    // the tasks of the general pool may still start server requests
+    odbc::WorkerPool::GetInstance().Drain();
+    odbc::WorkerPool::GetRequestInstance().Drain();
+  }
+  odbc::Tracer::GetInstance().Flush();
+  Logger::GetLoggerInstance()->Flush();
 
   return SQL_SUCCESS;
 }
@@ -227,6 +256,8 @@ SQLRETURN SQLFreeEnv(SQLHENV env) {
 SQLRETURN SQLFreeConnect(SQLHDBC conn) {
   using odbc::Connection;
 
+  odbc::Tracer::Span span("SQLFreeConnect");
+
   LOG_DEBUG_MSG("SQLFreeConnect called");
 
   Connection* connection = reinterpret_cast< Connection* >(conn);
@@ -244,6 +275,8 @@ SQLRETURN SQLFreeConnect(SQLHDBC conn) {
 }
 
 SQLRETURN SQLFreeStmt(SQLHSTMT stmt, SQLUSMALLINT option) {
+  odbc::Tracer::Span span("SQLFreeStmt");
+
   LOG_DEBUG_MSG("SQLFreeStmt called [option=" << option << ']');
 
   Statement* statement = reinterpret_cast< Statement* >(stmt);
@@ -269,6 +302,8 @@ SQLRETURN SQLFreeStmt(SQLHSTMT stmt, SQLUSMALLINT option) {
 SQLRETURN SQLFreeDescriptor(SQLHDESC desc) {
   using odbc::Statement;
 
+  odbc::Tracer::Span span("SQLFreeDescriptor");
+
   LOG_DEBUG_MSG("SQLFreeDescriptor called");
 
   Descriptor* descriptor = reinterpret_cast< Descriptor* >(desc);
@@ -287,6 +322,8 @@ SQLRETURN SQLFreeDescriptor(SQLHDESC desc) {
 }
 
 SQLRETURN SQLCloseCursor(SQLHSTMT stmt) {
+  odbc::Tracer::Span span("SQLCloseCursor");
+
   LOG_DEBUG_MSG("SQLCloseCursor called");
 
   Statement* statement = reinterpret_cast< Statement* >(stmt);
@@ -303,6 +340,8 @@ SQLRETURN SQLDriverConnect(SQLHDBC conn, SQLHWND windowHandle,
                            SQLSMALLINT outConnectionStringBufferLen,
                            SQLSMALLINT* outConnectionStringLen,
                            SQLUSMALLINT driverCompletion) {
+  odbc::Tracer::Span span("SQLDriverConnect");
+
   IGNITE_UNUSED(driverCompletion);
 
   using odbc::Connection;
@@ -348,6 +387,8 @@ SQLRETURN SQLConnect(SQLHDBC conn, SQLWCHAR* serverName,
   using odbc::Connection;
   using odbc::config::Configuration;
 
+  odbc::Tracer::Span span("SQLConnect");
+
   LOG_DEBUG_MSG("SQLConnect called\n");
 
   Connection* connection = reinterpret_cast< Connection* >(conn);
@@ -382,6 +423,8 @@ SQLRETURN SQLConnect(SQLHDBC conn, SQLWCHAR* serverName,
 SQLRETURN SQLDisconnect(SQLHDBC conn) {
   using odbc::Connection;
 
+  odbc::Tracer::Span span("SQLDisconnect");
+
   LOG_DEBUG_MSG("SQLDisconnect called");
 
   Connection* connection = reinterpret_cast< Connection* >(conn);
@@ -397,6 +440,8 @@ SQLRETURN SQLDisconnect(SQLHDBC conn) {
 }
 
 SQLRETURN SQLPrepare(SQLHSTMT stmt, SQLWCHAR* query, SQLINTEGER queryLen) {
+  odbc::Tracer::Span span("SQLPrepare");
+
   LOG_DEBUG_MSG("SQLPrepare called");
 
   Statement* statement = reinterpret_cast< Statement* >(stmt);
@@ -416,6 +461,8 @@ SQLRETURN SQLPrepare(SQLHSTMT stmt, SQLWCHAR* query, SQLINTEGER queryLen) {
 }
 
 SQLRETURN SQLExecute(SQLHSTMT stmt) {
+  odbc::Tracer::Span span("SQLExecute");
+
   LOG_DEBUG_MSG("SQLExecute called");
 
   Statement* statement = reinterpret_cast< Statement* >(stmt);
@@ -431,6 +478,8 @@ SQLRETURN SQLExecute(SQLHSTMT stmt) {
 }
 
 SQLRETURN SQLExecDirect(SQLHSTMT stmt, SQLWCHAR* query, SQLINTEGER queryLen) {
+  odbc::Tracer::Span span("SQLExecDirect");
+
   LOG_DEBUG_MSG("SQLExecDirect called");
 
   Statement* statement = reinterpret_cast< Statement* >(stmt);
@@ -450,6 +499,8 @@ SQLRETURN SQLExecDirect(SQLHSTMT stmt, SQLWCHAR* query, SQLINTEGER queryLen) {
 }
 
 SQLRETURN SQLCancel(SQLHSTMT stmt) {
+  odbc::Tracer::Span span("SQLCancel");
+
   LOG_DEBUG_MSG("SQLCancel called");
 
   Statement* statement = reinterpret_cast< Statement* >(stmt);
@@ -459,17 +510,49 @@ SQLRETURN SQLCancel(SQLHSTMT stmt) {
     return SQL_INVALID_HANDLE;
   }
 
+  // the diagnostic records belong to the function running on another
+  // thread, which reports the cancellation itself
+  if (statement->InterruptSqlQuery())
+    return SQL_SUCCESS;
+
   statement->CancelSqlQuery();
 
   return statement->GetDiagnosticRecords().GetReturnCode();
 }
 
+SQLRETURN SQLCancelHandle(SQLSMALLINT handleType, SQLHANDLE handle) {
+  odbc::Tracer::Span span("SQLCancelHandle");
+
+  LOG_DEBUG_MSG("SQLCancelHandle called with handleType " << handleType);
+
+  switch (handleType) {
+    case SQL_HANDLE_STMT:
+      return SQLCancel(handle);
+
+    case SQL_HANDLE_DBC: {
+      // connection functions never run asynchronously, so there is nothing
+      // to cancel
+      if (!handle) {
+        LOG_ERROR_MSG("connection is nullptr");
+        return SQL_INVALID_HANDLE;
+      }
+
+      return SQL_SUCCESS;
+    }
+
+    default:
+      return SQL_INVALID_HANDLE;
+  }
+}
+
 SQLRETURN SQLBindCol(SQLHSTMT stmt, SQLUSMALLINT colNum, SQLSMALLINT targetType,
                      SQLPOINTER targetValue, SQLLEN bufferLength,
                      SQLLEN* strLengthOrIndicator) {
   using namespace odbc::type_traits;
   using odbc::app::ApplicationDataBuffer;
 
+  odbc::Tracer::Span span("SQLBindCol");
+
   LOG_DEBUG_MSG("SQLBindCol called: index="
                 << colNum << ", type=" << targetType
                 << ", targetValue=" << reinterpret_cast< size_t >(targetValue)
@@ -490,6 +573,8 @@ SQLRETURN SQLBindCol(SQLHSTMT stmt, SQLUSMALLINT colNum, SQLSMALLINT targetType,
 }
 
 SQLRETURN SQLFetch(SQLHSTMT stmt) {
+  odbc::Tracer::Span span("SQLFetch");
+
   LOG_DEBUG_MSG("SQLFetch called");
 
   Statement* statement = reinterpret_cast< Statement* >(stmt);
@@ -506,6 +591,8 @@ SQLRETURN SQLFetch(SQLHSTMT stmt) {
 
 SQLRETURN SQLFetchScroll(SQLHSTMT stmt, SQLSMALLINT orientation,
                          SQLLEN offset) {
+  odbc::Tracer::Span span("SQLFetchScroll");
+
   LOG_DEBUG_MSG("SQLFetchScroll called with Orientation "
                 << orientation << " Offset " << offset);
 
@@ -524,6 +611,8 @@ SQLRETURN SQLFetchScroll(SQLHSTMT stmt, SQLSMALLINT orientation,
 SQLRETURN SQLExtendedFetch(SQLHSTMT stmt, SQLUSMALLINT orientation,
                            SQLLEN offset, SQLULEN* rowCount,
                            SQLUSMALLINT* rowStatusArray) {
+  odbc::Tracer::Span span("SQLExtendedFetch");
+
   LOG_DEBUG_MSG("SQLExtendedFetch called");
 
   SQLRETURN res = SQLFetchScroll(stmt, orientation, offset);
@@ -553,6 +642,8 @@ SQLRETURN SQLExtendedFetch(SQLHSTMT stmt, SQLUSMALLINT orientation,
 SQLRETURN SQLNumResultCols(SQLHSTMT stmt, SQLSMALLINT* columnNum) {
   using odbc::meta::ColumnMetaVector;
 
+  odbc::Tracer::Span span("SQLNumResultCols");
+
   LOG_DEBUG_MSG("SQLNumResultCols called");
 
   Statement* statement = reinterpret_cast< Statement* >(stmt);
@@ -572,11 +663,64 @@ SQLRETURN SQLNumResultCols(SQLHSTMT stmt, SQLSMALLINT* columnNum) {
   return statement->GetDiagnosticRecords().GetReturnCode();
 }
 
+SQLRETURN SQLBindParameter(SQLHSTMT stmt, SQLUSMALLINT paramIdx,
+                           SQLSMALLINT ioType, SQLSMALLINT bufferType,
+                           SQLSMALLINT paramSqlType, SQLULEN columnSize,
+                           SQLSMALLINT decDigits, SQLPOINTER buffer,
+                           SQLLEN bufferLen, SQLLEN* resLen) {
+  odbc::Tracer::Span span("SQLBindParameter");
+
+  LOG_DEBUG_MSG("SQLBindParameter called: index="
+                << paramIdx << ", ioType=" << ioType
+                << ", bufferType=" << bufferType
+                << ", paramSqlType=" << paramSqlType
+                << ", columnSize=" << columnSize
+                << ", decDigits=" << decDigits
+                << ", bufferLen=" << bufferLen);
+
+  Statement* statement = reinterpret_cast< Statement* >(stmt);
+
+  if (!statement) {
+    LOG_ERROR_MSG("statement is nullptr");
+    return SQL_INVALID_HANDLE;
+  }
+
+  statement->BindParameter(paramIdx, ioType, bufferType, paramSqlType,
+                           columnSize, decDigits, buffer, bufferLen, resLen);
+
+  return statement->GetDiagnosticRecords().GetReturnCode();
+}
+
+SQLRETURN SQLNumParams(SQLHSTMT stmt, SQLSMALLINT* paramCnt) {
+  odbc::Tracer::Span span("SQLNumParams");
+
+  LOG_DEBUG_MSG("SQLNumParams called");
+
+  Statement* statement = reinterpret_cast< Statement* >(stmt);
+
+  if (!statement) {
+    LOG_ERROR_MSG("statement is nullptr");
+    return SQL_INVALID_HANDLE;
+  }
+
+  uint16_t paramNum = 0;
+  statement->GetParametersNumber(paramNum);
+
+  if (paramCnt) {
+    *paramCnt = static_cast< SQLSMALLINT >(paramNum);
+    LOG_DEBUG_MSG("paramCnt: " << *paramCnt);
+  }
+
+  return statement->GetDiagnosticRecords().GetReturnCode();
+}
+
 SQLRETURN SQLColumns(SQLHSTMT stmt, SQLWCHAR* catalogName,
                      SQLSMALLINT catalogNameLen, SQLWCHAR* schemaName,
                      SQLSMALLINT schemaNameLen, SQLWCHAR* tableName,
                      SQLSMALLINT tableNameLen, SQLWCHAR* columnName,
                      SQLSMALLINT columnNameLen) {
+  odbc::Tracer::Span span("SQLColumns");
+
   LOG_DEBUG_MSG("SQLColumns called");
 
   Statement* statement = reinterpret_cast< Statement* >(stmt);
@@ -615,6 +759,8 @@ SQLRETURN SQLColumnPrivileges(SQLHSTMT stmt, SQLWCHAR* catalogName,
                               SQLSMALLINT schemaNameLen, SQLWCHAR* tableName,
                               SQLSMALLINT tableNameLen, SQLWCHAR* columnName,
                               SQLSMALLINT columnNameLen) {
+  odbc::Tracer::Span span("SQLColumnPrivileges");
+
   LOG_DEBUG_MSG("SQLColumnPrivileges called");
 
   IGNITE_UNUSED(catalogName);
@@ -645,6 +791,8 @@ SQLRETURN SQLTables(SQLHSTMT stmt, SQLWCHAR* catalogName,
                     SQLSMALLINT schemaNameLen, SQLWCHAR* tableName,
                     SQLSMALLINT tableNameLen, SQLWCHAR* tableType,
                     SQLSMALLINT tableTypeLen) {
+  odbc::Tracer::Span span("SQLTables");
+
   LOG_DEBUG_MSG("SQLTables called");
 
   Statement* statement = reinterpret_cast< Statement* >(stmt);
@@ -675,6 +823,8 @@ SQLRETURN SQLTablePrivileges(SQLHSTMT stmt, SQLWCHAR* catalogName,
                              SQLSMALLINT catalogNameLen, SQLWCHAR* schemaName,
                              SQLSMALLINT schemaNameLen, SQLWCHAR* tableName,
                              SQLSMALLINT tableNameLen) {
+  odbc::Tracer::Span span("SQLTablePrivileges");
+
   LOG_DEBUG_MSG("SQLTablePrivileges called");
 
   IGNITE_UNUSED(catalogName);
@@ -699,6 +849,8 @@ SQLRETURN SQLTablePrivileges(SQLHSTMT stmt, SQLWCHAR* catalogName,
 }
 
 SQLRETURN SQLMoreResults(SQLHSTMT stmt) {
+  odbc::Tracer::Span span("SQLMoreResults");
+
   LOG_DEBUG_MSG("SQLMoreResults called");
 
   Statement* statement = reinterpret_cast< Statement* >(stmt);
@@ -718,6 +870,8 @@ SQLRETURN SQLNativeSql(SQLHDBC conn, SQLWCHAR* inQuery, SQLINTEGER inQueryLen,
                        SQLINTEGER* outQueryLen) {
   using namespace odbc;
 
+  odbc::Tracer::Span span("SQLNativeSql");
+
   LOG_DEBUG_MSG("SQLNativeSql called");
 
   Connection* connection = reinterpret_cast< Connection* >(conn);
@@ -745,6 +899,8 @@ SQLRETURN SQLColAttribute(SQLHSTMT stmt, SQLUSMALLINT columnNum,
   using odbc::meta::ColumnMeta;
   using odbc::meta::ColumnMetaVector;
 
+  odbc::Tracer::Span span("SQLColAttribute");
+
   LOG_DEBUG_MSG("SQLColAttribute called: "
                 << fieldId << " (" << ColumnMeta::AttrIdToString(fieldId)
                 << ")");
@@ -782,6 +938,8 @@ SQLRETURN SQLDescribeCol(SQLHSTMT stmt, SQLUSMALLINT columnNum,
                          SQLSMALLINT* nullable) {
   using odbc::SqlLen;
 
+  odbc::Tracer::Span span("SQLDescribeCol");
+
   LOG_DEBUG_MSG("SQLDescribeCol called with columnNum "
                 << columnNum << ", columnNameBuf " << columnNameBuf
                 << ", columnNameBufLen" << columnNameBufLen
@@ -874,6 +1032,8 @@ SQLRETURN SQLDescribeCol(SQLHSTMT stmt, SQLUSMALLINT columnNum,
 }
 
 SQLRETURN SQLRowCount(SQLHSTMT stmt, SQLLEN* rowCnt) {
+  odbc::Tracer::Span span("SQLRowCount");
+
   LOG_DEBUG_MSG("SQLRowCount called");
 
   Statement* statement = reinterpret_cast< Statement* >(stmt);
@@ -901,6 +1061,8 @@ SQLRETURN SQLForeignKeys(
     SQLSMALLINT foreignCatalogNameLen, SQLWCHAR* foreignSchemaName,
     SQLSMALLINT foreignSchemaNameLen, SQLWCHAR* foreignTableName,
     SQLSMALLINT foreignTableNameLen) {
+  odbc::Tracer::Span span("SQLForeignKeys");
+
   LOG_DEBUG_MSG("SQLForeignKeys called");
 
   IGNITE_UNUSED(primaryCatalogName);
@@ -932,6 +1094,8 @@ SQLRETURN SQLForeignKeys(
 
 SQLRETURN SQLGetStmtAttr(SQLHSTMT stmt, SQLINTEGER attr, SQLPOINTER valueBuf,
                          SQLINTEGER valueBufLen, SQLINTEGER* valueResLen) {
+  odbc::Tracer::Span span("SQLGetStmtAttr");
+
   LOG_DEBUG_MSG("SQLGetStmtAttr called");
 
 #ifdef _DEBUG
@@ -955,6 +1119,8 @@ SQLRETURN SQLGetStmtAttr(SQLHSTMT stmt, SQLINTEGER attr, SQLPOINTER valueBuf,
 
 SQLRETURN SQLSetStmtAttr(SQLHSTMT stmt, SQLINTEGER attr, SQLPOINTER value,
                          SQLINTEGER valueLen) {
+  odbc::Tracer::Span span("SQLSetStmtAttr");
+
   LOG_DEBUG_MSG("SQLSetStmtAttr called: " << attr);
 
 #ifdef _DEBUG
@@ -978,6 +1144,8 @@ SQLRETURN SQLPrimaryKeys(SQLHSTMT stmt, SQLWCHAR* catalogName,
                          SQLSMALLINT catalogNameLen, SQLWCHAR* schemaName,
                          SQLSMALLINT schemaNameLen, SQLWCHAR* tableName,
                          SQLSMALLINT tableNameLen) {
+  odbc::Tracer::Span span("SQLPrimaryKeys");
+
   LOG_DEBUG_MSG("SQLPrimaryKeys called");
 
   IGNITE_UNUSED(catalogName);
@@ -1011,6 +1179,8 @@ SQLRETURN SQLGetDiagField(SQLSMALLINT handleType, SQLHANDLE handle,
 
   using odbc::app::ApplicationDataBuffer;
 
+  odbc::Tracer::Span span("SQLGetDiagField");
+
   LOG_DEBUG_MSG("SQLGetDiagField called with handleType "
                 << handleType << ", recNum " << recNum << ", diagId "
                 << diagId);
@@ -1057,6 +1227,8 @@ SQLRETURN SQLGetDiagRec(SQLSMALLINT handleType, SQLHANDLE handle,
 
   using odbc::app::ApplicationDataBuffer;
 
+  odbc::Tracer::Span span("SQLGetDiagRec");
+
   LOG_DEBUG_MSG("SQLGetDiagRec called with handleType "
                 << handleType << ", handle " << handle << ", recNum " << recNum
                 << ", sqlState " << sqlState << ", nativeError " << nativeError
@@ -1146,6 +1318,8 @@ SQLRETURN SQLGetDiagRec(SQLSMALLINT handleType, SQLHANDLE handle,
 }
 
 SQLRETURN SQLGetTypeInfo(SQLHSTMT stmt, SQLSMALLINT type) {
+  odbc::Tracer::Span span("SQLGetTypeInfo");
+
   LOG_DEBUG_MSG("SQLGetTypeInfo called: [type=" << type << ']');
 
   Statement* statement = reinterpret_cast< Statement* >(stmt);
@@ -1167,6 +1341,8 @@ SQLRETURN SQLGetData(SQLHSTMT stmt, SQLUSMALLINT colNum, SQLSMALLINT targetType,
 
   using odbc::app::ApplicationDataBuffer;
 
+  odbc::Tracer::Span span("SQLGetData");
+
   LOG_DEBUG_MSG("SQLGetData called with colNum " << colNum << ", targetType "
                                                  << targetType);
 
@@ -1191,6 +1367,8 @@ SQLRETURN SQLSetEnvAttr(SQLHENV env, SQLINTEGER attr, SQLPOINTER value,
                         SQLINTEGER valueLen) {
   using odbc::Environment;
 
+  odbc::Tracer::Span span("SQLSetEnvAttr");
+
   LOG_DEBUG_MSG("SQLSetEnvAttr called with Attribute " << attr << ", Value "
                                                        << (size_t)value);
 
@@ -1213,6 +1391,8 @@ SQLRETURN SQLGetEnvAttr(SQLHENV env, SQLINTEGER attr, SQLPOINTER valueBuf,
 
   using app::ApplicationDataBuffer;
 
+  odbc::Tracer::Span span("SQLGetEnvAttr");
+
   LOG_DEBUG_MSG("SQLGetEnvAttr called with attr " << attr);
 
   Environment* environment = reinterpret_cast< Environment* >(env);
@@ -1238,6 +1418,8 @@ SQLRETURN SQLSpecialColumns(SQLHSTMT stmt, SQLSMALLINT idType,
                             SQLWCHAR* schemaName, SQLSMALLINT schemaNameLen,
                             SQLWCHAR* tableName, SQLSMALLINT tableNameLen,
                             SQLSMALLINT scope, SQLSMALLINT nullable) {
+  odbc::Tracer::Span span("SQLSpecialColumns");
+
   LOG_DEBUG_MSG("SQLSpecialColumns called");
 
   IGNITE_UNUSED(idType);
@@ -1269,6 +1451,8 @@ SQLRETURN SQLStatistics(SQLHSTMT stmt, SQLWCHAR* catalogName,
                         SQLSMALLINT schemaNameLen, SQLWCHAR* tableName,
                         SQLSMALLINT tableNameLen, SQLUSMALLINT unique,
                         SQLUSMALLINT reserved) {
+  odbc::Tracer::Span span("SQLStatistics");
+
   LOG_DEBUG_MSG("SQLStatistics called");
 
   IGNITE_UNUSED(catalogName);
@@ -1299,6 +1483,8 @@ SQLRETURN SQLProcedureColumns(SQLHSTMT stmt, SQLWCHAR* catalogName,
                               SQLSMALLINT schemaNameLen, SQLWCHAR* procName,
                               SQLSMALLINT procNameLen, SQLWCHAR* columnName,
                               SQLSMALLINT columnNameLen) {
+  odbc::Tracer::Span span("SQLProcedureColumns");
+
   LOG_DEBUG_MSG("SQLProcedureColumns called");
 
   IGNITE_UNUSED(catalogName);
@@ -1328,6 +1514,8 @@ SQLRETURN SQLProcedures(SQLHSTMT stmt, SQLWCHAR* catalogName,
                         SQLSMALLINT catalogNameLen, SQLWCHAR* schemaName,
                         SQLSMALLINT schemaNameLen, SQLWCHAR* tableName,
                         SQLSMALLINT tableNameLen) {
+  odbc::Tracer::Span span("SQLProcedures");
+
   LOG_DEBUG_MSG("SQLProcedures called");
 
   IGNITE_UNUSED(catalogName);
@@ -1361,6 +1549,8 @@ SQLRETURN SQLError(SQLHENV env, SQLHDBC conn, SQLHSTMT stmt, SQLWCHAR* state,
 
   using trino::odbc::app::ApplicationDataBuffer;
 
+  odbc::Tracer::Span span("SQLError");
+
   LOG_DEBUG_MSG("SQLError is called with env "
                 << env << ", conn " << conn << ", stmt " << stmt << ", state "
                 << state << ", error " << error << ", msgBuf " << msgBuf
@@ -1420,6 +1610,8 @@ SQLRETURN SQLGetConnectAttr(SQLHDBC conn, SQLINTEGER attr, SQLPOINTER valueBuf,
 
   using app::ApplicationDataBuffer;
 
+  odbc::Tracer::Span span("SQLGetConnectAttr");
+
   LOG_DEBUG_MSG("SQLGetConnectAttr called with attr " << attr);
 
   Connection* connection = reinterpret_cast< Connection* >(conn);
@@ -1438,6 +1630,8 @@ SQLRETURN SQLSetConnectAttr(SQLHDBC conn, SQLINTEGER attr, SQLPOINTER value,
                             SQLINTEGER valueLen) {
   using odbc::Connection;
 
+  odbc::Tracer::Span span("SQLSetConnectAttr");
+
   LOG_DEBUG_MSG("SQLSetConnectAttr called(" << attr << ", " << value << ")");
 
   Connection* connection = reinterpret_cast< Connection* >(conn);
@@ -1454,6 +1648,8 @@ SQLRETURN SQLSetConnectAttr(SQLHDBC conn, SQLINTEGER attr, SQLPOINTER value,
 
 SQLRETURN SQLGetCursorName(SQLHSTMT stmt, SQLWCHAR* nameBuf,
                            SQLSMALLINT nameBufLen, SQLSMALLINT* nameResLen) {
+  odbc::Tracer::Span span("SQLGetCursorName");
+
   LOG_DEBUG_MSG("SQLGetCursorName called with nameBufLen " << nameBufLen);
 
   Statement* statement = reinterpret_cast< Statement* >(stmt);
@@ -1468,6 +1664,8 @@ SQLRETURN SQLGetCursorName(SQLHSTMT stmt, SQLWCHAR* nameBuf,
 }
 
 SQLRETURN SQLSetCursorName(SQLHSTMT stmt, SQLWCHAR* name, SQLSMALLINT nameLen) {
+  odbc::Tracer::Span span("SQLSetCursorName");
+
   LOG_DEBUG_MSG("SQLSetCursorName called with name " << name << ", nameLen "
                                                      << nameLen);
 
@@ -1485,6 +1683,8 @@ SQLRETURN SQLSetCursorName(SQLHSTMT stmt, SQLWCHAR* name, SQLSMALLINT nameLen) {
 SQLRETURN SQLSetDescField(SQLHDESC descr, SQLSMALLINT recNum,
                           SQLSMALLINT fieldId, SQLPOINTER buffer,
                           SQLINTEGER bufferLen) {
+  odbc::Tracer::Span span("SQLSetDescField");
+
   LOG_DEBUG_MSG("SQLSetDescField called with recNum " << recNum << ", fieldId "
                                                       << fieldId);
 
@@ -1503,6 +1703,8 @@ SQLRETURN SQLSetDescField(SQLHDESC descr, SQLSMALLINT recNum,
 SQLRETURN SQLGetDescField(SQLHDESC descr, SQLSMALLINT recNum,
                           SQLSMALLINT fieldId, SQLPOINTER buffer,
                           SQLINTEGER bufferLen, SQLINTEGER* resLen) {
+  odbc::Tracer::Span span("SQLGetDescField");
+
   LOG_DEBUG_MSG("SQLGetDescField called with recNum " << recNum << ", fieldId "
                                                       << fieldId);
   Descriptor* descriptor = reinterpret_cast< Descriptor* >(descr);
@@ -1518,6 +1720,8 @@ SQLRETURN SQLGetDescField(SQLHDESC descr, SQLSMALLINT recNum,
 }
 
 SQLRETURN SQLCopyDesc(SQLHDESC src, SQLHDESC dst) {
+  odbc::Tracer::Span span("SQLCopyDesc");
+
   LOG_DEBUG_MSG("SQLCopyDesc called");
 
   Descriptor* srcDesc = reinterpret_cast< Descriptor* >(src);
@@ -1563,6 +1767,8 @@ SQLRETURN SQLSetConnectOption(SQLHDBC conn, SQLUSMALLINT option,
                               SQLULEN value) {
   using odbc::Connection;
 
+  odbc::Tracer::Span span("SQLSetConnectOption");
+
   LOG_DEBUG_MSG("SQLSetConnectOption called(" << option << ", " << value
                                               << ")");
 
@@ -1581,6 +1787,8 @@ SQLRETURN SQLGetConnectOption(SQLHDBC conn, SQLUSMALLINT option,
                               SQLPOINTER value) {
   using odbc::Connection;
 
+  odbc::Tracer::Span span("SQLGetConnectOption");
+
   LOG_DEBUG_MSG("SQLGetConnectOption called(" << option << ")");
 
   Connection* connection = reinterpret_cast< Connection* >(conn);
@@ -1596,6 +1804,8 @@ SQLRETURN SQLGetConnectOption(SQLHDBC conn, SQLUSMALLINT option,
 
 SQLRETURN SQLGetStmtOption(SQLHSTMT stmt, SQLUSMALLINT option,
                            SQLPOINTER value) {
+  odbc::Tracer::Span span("SQLGetStmtOption");
+
   LOG_DEBUG_MSG("SQLGetStmtOption called with option " << option);
 
   Statement* statement = reinterpret_cast< Statement* >(stmt);
@@ -1614,6 +1824,8 @@ SQLRETURN SQLColAttributes(SQLHSTMT stmt, SQLUSMALLINT colNum,
                            SQLUSMALLINT fieldId, SQLPOINTER strAttrBuf,
                            SQLSMALLINT strAttrBufLen,
                            SQLSMALLINT* strAttrResLen, SQLLEN* numAttrBuf) {
+  odbc::Tracer::Span span("SQLColAttributes");
+
   LOG_DEBUG_MSG("SQLColAttributes called: "
                 << fieldId << " ("
                 << odbc::meta::ColumnMeta::AttrIdToString(fieldId) << ")");
@@ -0,0 +1,217 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "trino/odbc/page_arena.h"
+
+#include "trino/odbc/log.h"
+#include "trino/odbc/metrics.h"
+#include "trino/odbc/tracer.h"
+#include "trino/odbc/trino_column.h"
+
+using client::TrinoQuery::Model::Datum; /*#*/
+using client::TrinoQuery::Model::Row; /*#*/
+
+namespace trino {
+namespace odbc {
+PageArena::PageArena()
+    : data_(), cells_(), rowOffsets_(), rowCount_(0), columnCount_(0) {
+  // No-op.
+}
+
+void PageArena::Decode(const Aws::Vector< Row >& rows, /*#*/
+                       const meta::ColumnMetaVector& columnMetadataVec) {
+  LOG_DEBUG_MSG("Decode is called with " << rows.size() << " rows");
+
+  Reset();
+  columnCount_ = columnMetadataVec.size();
+
+  std::vector< TrinoColumn > columns;
+  columns.reserve(columnCount_);
+  for (size_t i = 0; i < columnCount_; ++i) {
+    columns.emplace_back(static_cast< uint32_t >(i), columnMetadataVec[i]);
+  }
+
+  rowOffsets_.reserve(rows.size());
+  cells_.reserve(rows.size() * columnCount_);
+
+  std::string value;
+  for (const Row& row : rows) {
+    BeginRow();
+
+    const Aws::Vector< Datum >& data = row.GetData(); /*#*/
+    for (size_t i = 0; i < columnCount_; ++i) {
+      if (i < data.size()) {
+        PageCell::Kind::Type kind = columns[i].DecodeDatum(data[i], value);
+        AddCell(kind, value.data(), value.size());
+      } else {
+        AddCell(PageCell::Kind::NULL_VALUE, nullptr, 0);
+      }
+    }
+  }
+}
+
+void PageArena::Reset() {
+  data_.clear();
+  cells_.clear();
+  rowOffsets_.clear();
+  rowCount_ = 0;
+  columnCount_ = 0;
+}
+
+void PageArena::BeginRow() {
+  rowOffsets_.push_back(static_cast< uint32_t >(cells_.size()));
+  ++rowCount_;
+}
+
+void PageArena::AddCell(PageCell::Kind::Type kind, const char* value,
+                        size_t length) {
+  PageCell cell;
+  cell.kind = kind;
+  cell.offset = static_cast< uint32_t >(data_.size());
+  cell.length = static_cast< uint32_t >(length);
+
+  if (length > 0) {
+    data_.insert(data_.end(), value, value + length);
+  }
+  data_.push_back('\0');
+
+  cells_.push_back(cell);
+
+  size_t rowWidth = cells_.size() - rowOffsets_.back();
+  if (rowWidth > columnCount_) {
+    columnCount_ = rowWidth;
+  }
+}
+
+const PageCell* PageArena::GetCell(size_t rowIdx, size_t columnIdx) const {
+  if (rowIdx >= rowCount_) {
+    return nullptr;
+  }
+
+  size_t begin = rowOffsets_[rowIdx];
+  size_t end =
+      rowIdx + 1 < rowCount_ ? rowOffsets_[rowIdx + 1] : cells_.size();
+  if (begin + columnIdx >= end) {
+    return nullptr;
+  }
+
+  return &cells_[begin + columnIdx];
+}
+
+size_t PageArena::GetUsedBytes() const {
+  return data_.size() + cells_.size() * sizeof(PageCell)
+         + rowOffsets_.size() * sizeof(uint32_t);
+}
+
+size_t PageArena::GetReservedBytes() const {
+  return data_.capacity() + cells_.capacity() * sizeof(PageCell)
+         + rowOffsets_.capacity() * sizeof(uint32_t);
+}
+
+PageArenaPool::PageArenaPool(std::shared_ptr< MemoryGovernor > governor,
+                             size_t maxIdle)
+    : governor_(std::move(governor)),
+      idle_(),
+      maxIdle_(maxIdle),
+      created_(0),
+      reused_(0) {
+  // No-op.
+}
+
+std::unique_ptr< PageArena > PageArenaPool::Acquire() {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  if (idle_.empty()) {
+    ++created_;
+    Metrics::GetInstance().arenasCreated.Add();
+    LOG_DEBUG_MSG("Creating page arena, " << created_ << " created so far");
+    return std::unique_ptr< PageArena >(new PageArena());
+  }
+
+  std::unique_ptr< PageArena > arena = std::move(idle_.back());
+  idle_.pop_back();
+  ++reused_;
+  Metrics::GetInstance().arenasReused.Add();
+
+  return arena;
+}
+
+void PageArenaPool::Release(std::unique_ptr< PageArena > arena) {
+  if (!arena) {
+    return;
+  }
+
+  arena->Reset();
+
+  std::lock_guard< std::mutex > lock(mutex_);
+  if (idle_.size() < maxIdle_) {
+    idle_.push_back(std::move(arena));
+  }
+}
+
+std::shared_ptr< const ResultPage > PageArenaPool::DecodePage(
+    const Aws::Vector< Row >& rows, /*#*/
+    const meta::ColumnMetaVector& columnMetadataVec,
+    const std::string& nextToken) {
+  Tracer::Span span("decode page", "fetch");
+  std::unique_ptr< PageArena > arena = Acquire();
+  arena->Decode(rows, columnMetadataVec);
+
+  return std::make_shared< ResultPage >(std::move(arena), shared_from_this(),
+                                       nextToken, governor_);
+}
+
+size_t PageArenaPool::GetCreatedCount() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+  return created_;
+}
+
+size_t PageArenaPool::GetReusedCount() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+  return reused_;
+}
+
+ResultPage::ResultPage(std::unique_ptr< PageArena > arena,
+                       std::weak_ptr< PageArenaPool > pool,
+                       const std::string& nextToken,
+                       std::shared_ptr< MemoryGovernor > governor)
+    : arena_(std::move(arena)),
+      pool_(std::move(pool)),
+      nextToken_(nextToken),
+      governor_(std::move(governor)),
+      charged_(0) {
+  if (governor_) {
+    charged_ = static_cast< int64_t >(arena_->GetReservedBytes());
+    governor_->Reserve(charged_);
+  }
+}
+
+ResultPage::~ResultPage() {
+  if (governor_) {
+    governor_->Release(charged_);
+  }
+
+  std::shared_ptr< PageArenaPool > pool = pool_.lock();
+  if (pool) {
+    pool->Release(std::move(arena_));
+  }
+}
+}  // namespace odbc
+}  // namespace trino
@@ -20,9 +20,12 @@
 
 #include "trino/odbc/query/column_metadata_query.h"
 
+#include <algorithm>
+#include <regex>
 #include <vector>
 
 #include "trino/odbc/connection.h"
+#include "trino/odbc/fan_out.h"
 #include "trino/odbc/ignite_error.h"
 #include "trino/odbc/system/odbc_constants.h"
 #include "trino/odbc/log.h"
@@ -158,9 +161,6 @@ ColumnMetadataQuery::ColumnMetadataQuery(
                                    ScalarType::INTEGER, Nullability::NO_NULL));
   columnsMeta.push_back(ColumnMeta(sch, tbl, "IS_NULLABLE", ScalarType::VARCHAR,
                                    Nullability::NULLABLE));
-
-  tableMetadataQuery_ = std::make_shared< TableMetadataQuery >(
-      diag, connection, catalog, schema, table, boost::none);
 }
 
 ColumnMetadataQuery::~ColumnMetadataQuery() {
@@ -480,49 +480,8 @@ SqlResult::Type ColumnMetadataQuery::GetColumnsWithDatabaseSearchPattern(
       << databasePattern.get_value_or(""));
   if (!connection.GetMetadataID()) {
     // database name and table name are treated as search patterns
-    SqlResult::Type result = tableMetadataQuery_->Execute();
-    if (result != SqlResult::AI_SUCCESS) {
-      std::string warnMsg = "Failed to get table metadata for "
-                            + databasePattern.get_value_or("") + "."
-                            + table.get_value_or("");
-      diag.AddStatusRecord(SqlState::S01000_GENERAL_WARNING, warnMsg,
-                           LogLevel::Type::WARNING_LEVEL);
-      return SqlResult::AI_SUCCESS_WITH_INFO;
-    }
-
-    app::ColumnBindingMap columnBindings;
-    SqlLen buflen = STRING_BUFFER_SIZE;
-    // According to Trino, database name could only contain
-    // letters, digits, dashes, periods or underscores. It could
-    // not be a unicode string.
-    char databaseName[STRING_BUFFER_SIZE]{};
-    ApplicationDataBuffer buf1(
-        trino::odbc::type_traits::OdbcNativeType::Type::AI_CHAR,
-        databaseName, buflen, nullptr);
-    columnBindings[databaseType] = buf1;
-
-    // According to Trino, table name could only contain
-    // letters, digits, dashes, periods or underscores. It could
-    // not be a unicode string.
-    char tableName[STRING_BUFFER_SIZE]{};
-    ApplicationDataBuffer buf2(
-        trino::odbc::type_traits::OdbcNativeType::Type::AI_CHAR,
-        &tableName, buflen, nullptr);
-    columnBindings[TableMetadataQuery::ResultColumn::TABLE_NAME] = buf2;
-
-    LOG_ERROR_MSG("table is " << databaseName << "." << tableName);
-    while (tableMetadataQuery_->FetchNextRow(columnBindings)
-           == SqlResult::AI_SUCCESS) {
-      result = MakeRequestGetColumnsMetaPerTable(std::string(databaseName),
-                                                 std::string(tableName));
-      if (result != SqlResult::AI_SUCCESS
-          && result != SqlResult::AI_SUCCESS_WITH_INFO) {
-        LOG_ERROR_MSG("Failed to get columns for " << databaseName << "."
-                                                   << tableName);
-        break;
-      }
-    }
-    return result;
+    return MakeRequestGetColumnsMetaWithPattern(
+        databasePattern.get_value_or("%"));
   } else {
     // database name and table name are treated as case insensitive identifiers
     return MakeRequestGetColumnsMetaPerTable(databasePattern.get_value_or(""),
@@ -552,19 +511,68 @@ SqlResult::Type ColumnMetadataQuery::MakeRequestGetColumnsMetaPerTable(
   LOG_DEBUG_MSG(
       "MakeRequestGetColumnsMetaPerTable is called with databaseName: "
       << databaseName << ", tableName: " << tableName);
-  std::string sql = "describe \"";
-  sql += databaseName;
-  sql += "\".\"";
-  sql += tableName + "\"";
-  LOG_DEBUG_MSG("sql is " << sql);
-
-  dataQuery_ = std::make_shared< DataQuery >(diag, connection, sql);
-  SqlResult::Type result = dataQuery_->Execute();
-  if (result != SqlResult::AI_SUCCESS) {
+  std::shared_ptr< MetadataCache > cache = connection.GetMetadataCache();
+  std::string identity;
+  std::vector< MetadataCache::Column > columns;
+  if (cache) {
+    identity = connection.GetResultCacheIdentity();
+  }
+
+  SqlResult::Type result = SqlResult::AI_SUCCESS;
+  if (cache && cache->GetColumns(identity, databaseName, tableName, columns)) {
+    LOG_DEBUG_MSG("Columns are found in the metadata cache");
+  } else {
+    std::string sql = "describe \"";
+    sql += databaseName;
+    sql += "\".\"";
+    sql += tableName + "\"";
+    LOG_DEBUG_MSG("sql is " << sql);
+
+    dataQuery_ = std::make_shared< DataQuery >(diag, connection, sql);
+    result = dataQuery_->Execute();
+    if (result == SqlResult::AI_SUCCESS) {
+      ReadColumns(*dataQuery_, databaseName, tableName, columns);
+    }
+
+    // an empty description is cached as well, failures are not as they
+    // may be transient
+    if (cache && result != SqlResult::AI_ERROR) {
+      cache->PutColumns(identity, databaseName, tableName, columns,
+                        connection.GetConfiguration().GetMetadataCacheTtl());
+    }
+  }
+
+  if (result != SqlResult::AI_SUCCESS || columns.empty()) {
     LOG_DEBUG_MSG("Sql execution result is " << result);
     return SqlResult::AI_NO_DATA;
   }
 
+  for (const MetadataCache::Column& found : columns) {
+    if (column.get_value_or("") == "%"
+        || column.get_value_or("") == found.name) {
+      meta.emplace_back(meta::ColumnMeta(databaseName, tableName));
+      meta.back().Read(found.name, found.dataType, found.remarks,
+                       found.nullable, found.position);
+    }
+  }
+
+  LOG_DEBUG_MSG("meta size is " << meta.size());
+
+  if (meta.empty()) {
+    diag.AddStatusRecord(
+        SqlState::S01000_GENERAL_WARNING,
+        "No columns with name \'" + column.get_value_or("") + "\' found",
+        LogLevel::Type::WARNING_LEVEL);
+    result = SqlResult::AI_SUCCESS_WITH_INFO;
+  }
+
+  return result;
+}
+
+void ColumnMetadataQuery::ReadColumns(
+    DataQuery& query, const std::string& databaseName,
+    const std::string& tableName,
+    std::vector< MetadataCache::Column >& columns) {
   app::ColumnBindingMap columnBindings;
   SqlLen buflen = STRING_BUFFER_SIZE;
   // column name could be a unicode string
@@ -574,39 +582,284 @@ SqlResult::Type ColumnMetadataQuery::MakeRequestGetColumnsMetaPerTable(
       buflen, nullptr);
   columnBindings[1] = buf1;
 
-  char dataType[64];
+  char dataType[STRING_BUFFER_SIZE]{};
   ApplicationDataBuffer buf2(
-      trino::odbc::type_traits::OdbcNativeType::Type::AI_CHAR, &dataType,
-      buflen, nullptr);
+      trino::odbc::type_traits::OdbcNativeType::Type::AI_CHAR, dataType, buflen,
+      nullptr);
   columnBindings[2] = buf2;
 
-  char remarks[64];
+  char remarks[STRING_BUFFER_SIZE]{};
   ApplicationDataBuffer buf3(
-      trino::odbc::type_traits::OdbcNativeType::Type::AI_CHAR, &remarks,
-      buflen, nullptr);
+      trino::odbc::type_traits::OdbcNativeType::Type::AI_CHAR, remarks, buflen,
+      nullptr);
   columnBindings[3] = buf3;
 
-  LOG_DEBUG_MSG("column is " << columnName << ", dataType is " << dataType
-                             << ", remarks is " << remarks);
+  // all columns of the table are listed in table order
+  int32_t position = 0;
+  while (query.FetchNextRow(columnBindings) == SqlResult::AI_SUCCESS) {
+    MetadataCache::Column found;
+    found.database = databaseName;
+    found.table = tableName;
+    found.name = utility::SqlWcharToString(columnName, STRING_BUFFER_SIZE);
+    found.dataType = dataType;
+    found.remarks = remarks;
+    found.position = ++position;
+    LOG_DEBUG_MSG("column is " << found.name << ", dataType is "
+                               << found.dataType << ", remarks is "
+                               << found.remarks);
+    columns.push_back(std::move(found));
+  }
+}
 
-  int32_t prevPosition = 0;
-  while (dataQuery_->FetchNextRow(columnBindings) == SqlResult::AI_SUCCESS) {
-    if (column.get_value_or("") == "%"
-        || column.get_value_or("")
-               == utility::SqlWcharToString(columnName, STRING_BUFFER_SIZE)) {
-      meta.emplace_back(meta::ColumnMeta(databaseName, tableName));
-      meta.back().Read(columnBindings, ++prevPosition);
+SqlResult::Type ColumnMetadataQuery::GetColumnsPerTable(
+    const std::string& columnPattern,
+    std::vector< MetadataCache::Column >& columns) {
+  LOG_DEBUG_MSG("GetColumnsPerTable is called");
+  TableMetadataQuery tableQuery(diag, connection, catalog, schema, table,
+                                boost::none);
+  SqlResult::Type result = tableQuery.Execute();
+  if (result != SqlResult::AI_SUCCESS
+      && result != SqlResult::AI_SUCCESS_WITH_INFO) {
+    return result;
+  }
+
+  app::ColumnBindingMap columnBindings;
+  SqlLen buflen = STRING_BUFFER_SIZE;
+  // According to Trino, database and table names could only contain
+  // letters, digits, dashes, periods or underscores. They could
+  // not be unicode strings.
+  char databaseName[STRING_BUFFER_SIZE]{};
+  ApplicationDataBuffer buf1(
+      trino::odbc::type_traits::OdbcNativeType::Type::AI_CHAR, databaseName,
+      buflen, nullptr);
+  TableMetadataQuery::ResultColumn::Type databaseType =
+      DATABASE_AS_SCHEMA ? TableMetadataQuery::ResultColumn::TABLE_SCHEM
+                         : TableMetadataQuery::ResultColumn::TABLE_CAT;
+  columnBindings[databaseType] = buf1;
+
+  char tableName[STRING_BUFFER_SIZE]{};
+  ApplicationDataBuffer buf2(
+      trino::odbc::type_traits::OdbcNativeType::Type::AI_CHAR, tableName,
+      buflen, nullptr);
+  columnBindings[TableMetadataQuery::ResultColumn::TABLE_NAME] = buf2;
+
+  std::vector< MetadataCache::Table > tables;
+  while (tableQuery.FetchNextRow(columnBindings) == SqlResult::AI_SUCCESS) {
+    MetadataCache::Table found;
+    found.database = databaseName;
+    found.name = tableName;
+    tables.push_back(std::move(found));
+  }
+
+  /** Outcome of the query of one table. */
+  struct TableColumns {
+    /** Columns in table order. */
+    std::vector< MetadataCache::Column > columns;
+
+    /** Error message, empty on success. */
+    std::string error;
+  };
+
+  std::vector< TableColumns > found(tables.size());
+  // the positions count all columns of a table, so every column is listed
+  // and the pattern is matched here
+  std::regex columnRegex(utility::ConvertPatternToRegex(columnPattern));
+  FanOut fanOut(connection.GetConfiguration().GetMetadataConcurrency());
+  std::vector< std::string > failures;
+  failures = fanOut.Run(tables.size(), [&](size_t idx) {
+    // every query has its own diagnostics, they are merged in table order
+    diagnostic::DiagnosableAdapter queryDiag(&connection);
+    std::string sql = "SHOW COLUMNS FROM \"" + tables[idx].database + "\".\""
+                      + tables[idx].name + "\"";
+    LOG_DEBUG_MSG("sql is " << sql);
+
+    DataQuery query(queryDiag, connection, sql);
+    SqlResult::Type queryResult = query.Execute();
+    if (queryResult == SqlResult::AI_SUCCESS) {
+      std::vector< MetadataCache::Column >& columns = found[idx].columns;
+      ReadColumns(query, tables[idx].database, tables[idx].name, columns);
+      if (columnPattern != "%") {
+        columns.erase(
+            std::remove_if(columns.begin(), columns.end(),
+                           [&](const MetadataCache::Column& column) {
+                             return !std::regex_match(column.name,
+                                                      columnRegex);
+                           }),
+            columns.end());
+      }
+    } else if (queryResult != SqlResult::AI_NO_DATA) {
+      const diagnostic::DiagnosticRecordStorage& records =
+          queryDiag.GetDiagnosticRecords();
+      found[idx].error = records.GetStatusRecordsNumber() > 0
+                             ? records.GetStatusRecord(1).GetMessageText()
+                             : "Failed to execute sql: " + sql;
+    }
+  });
+
+  // the partial outcome of a failed task is dropped
+  for (size_t i = 0; i < failures.size(); ++i) {
+    if (!failures[i].empty()) {
+      found[i].error = failures[i];
     }
   }
 
+  result = SqlResult::AI_SUCCESS;
+  for (size_t i = 0; i < tables.size(); ++i) {
+    if (!found[i].error.empty()) {
+      // the columns of the other tables are still returned
+      std::string warnMsg = "Failed to get the columns of table ("
+                            + tables[i].database + "." + tables[i].name
+                            + "): " + found[i].error;
+      diag.AddStatusRecord(SqlState::S01000_GENERAL_WARNING, warnMsg,
+                           LogLevel::Type::WARNING_LEVEL);
+      result = SqlResult::AI_SUCCESS_WITH_INFO;
+      continue;
+    }
+
+    columns.insert(columns.end(), found[i].columns.begin(),
+                   found[i].columns.end());
+  }
+
+  LOG_DEBUG_MSG("columns size is " << columns.size());
+  return result;
+}
+
+SqlResult::Type ColumnMetadataQuery::MakeRequestGetColumnsMetaWithPattern(
+    const std::string& databasePattern) {
+  std::string tablePattern = table.get_value_or("%");
+  std::string columnPattern = column.get_value_or("%");
+  LOG_DEBUG_MSG("MakeRequestGetColumnsMetaWithPattern is called with "
+                << databasePattern << "." << tablePattern << "."
+                << columnPattern);
+
+  std::shared_ptr< MetadataCache > cache = connection.GetMetadataCache();
+  std::string identity;
+  std::vector< MetadataCache::Column > columns;
+  if (cache) {
+    identity = connection.GetResultCacheIdentity();
+  }
+
+  SqlResult::Type result = SqlResult::AI_SUCCESS;
+  if (cache
+      && cache->GetColumnListing(identity, databasePattern, tablePattern,
+                                 columnPattern, columns)) {
+    LOG_DEBUG_MSG("Columns are found in the metadata cache");
+  } else {
+    // the patterns are matched by the server, so all columns arrive in one
+    // result set instead of one DESCRIBE per table
+    std::string sql =
+        "SELECT table_schema, table_name, column_name, data_type, "
+        "coalesce(comment, ''), is_nullable, ordinal_position "
+        "FROM information_schema.columns WHERE table_schema LIKE "
+        + utility::QuoteSqlString(databasePattern)
+        + " ESCAPE '\\' AND table_name LIKE "
+        + utility::QuoteSqlString(tablePattern)
+        + " ESCAPE '\\' AND column_name LIKE "
+        + utility::QuoteSqlString(columnPattern)
+        + " ESCAPE '\\' ORDER BY table_schema, table_name, ordinal_position";
+    LOG_DEBUG_MSG("sql is " << sql);
+
+    diagnostic::DiagnosableAdapter catalogDiag(&connection);
+    dataQuery_ = std::make_shared< DataQuery >(catalogDiag, connection, sql);
+    result = dataQuery_->Execute();
+    if (result == SqlResult::AI_SUCCESS) {
+      app::ColumnBindingMap columnBindings;
+      SqlLen buflen = STRING_BUFFER_SIZE;
+      // According to Trino, database and table names could only contain
+      // letters, digits, dashes, periods or underscores. They could
+      // not be unicode strings.
+      char databaseName[STRING_BUFFER_SIZE]{};
+      ApplicationDataBuffer buf1(
+          trino::odbc::type_traits::OdbcNativeType::Type::AI_CHAR,
+          databaseName, buflen, nullptr);
+      columnBindings[1] = buf1;
+
+      char tableName[STRING_BUFFER_SIZE]{};
+      ApplicationDataBuffer buf2(
+          trino::odbc::type_traits::OdbcNativeType::Type::AI_CHAR, tableName,
+          buflen, nullptr);
+      columnBindings[2] = buf2;
+
+      // column name could be a unicode string
+      SQLWCHAR columnName[STRING_BUFFER_SIZE];
+      ApplicationDataBuffer buf3(
+          trino::odbc::type_traits::OdbcNativeType::Type::AI_WCHAR, columnName,
+          buflen, nullptr);
+      columnBindings[3] = buf3;
+
+      char dataType[STRING_BUFFER_SIZE]{};
+      ApplicationDataBuffer buf4(
+          trino::odbc::type_traits::OdbcNativeType::Type::AI_CHAR, dataType,
+          buflen, nullptr);
+      columnBindings[4] = buf4;
+
+      char remarks[STRING_BUFFER_SIZE]{};
+      ApplicationDataBuffer buf5(
+          trino::odbc::type_traits::OdbcNativeType::Type::AI_CHAR, remarks,
+          buflen, nullptr);
+      columnBindings[5] = buf5;
+
+      char isNullable[STRING_BUFFER_SIZE]{};
+      ApplicationDataBuffer buf6(
+          trino::odbc::type_traits::OdbcNativeType::Type::AI_CHAR, isNullable,
+          buflen, nullptr);
+      columnBindings[6] = buf6;
+
+      int32_t position = 0;
+      ApplicationDataBuffer buf7(
+          trino::odbc::type_traits::OdbcNativeType::Type::AI_SIGNED_LONG,
+          &position, sizeof(position), nullptr);
+      columnBindings[7] = buf7;
+
+      while (dataQuery_->FetchNextRow(columnBindings)
+             == SqlResult::AI_SUCCESS) {
+        MetadataCache::Column found;
+        found.database = databaseName;
+        found.table = tableName;
+        found.name = utility::SqlWcharToString(columnName, STRING_BUFFER_SIZE);
+        found.dataType = dataType;
+        found.remarks = remarks;
+        found.nullable = std::string(isNullable) == "YES";
+        found.position = position;
+        columns.push_back(std::move(found));
+      }
+    } else if (result == SqlResult::AI_NO_DATA) {
+      result = SqlResult::AI_SUCCESS;
+    } else {
+      LOG_WARNING_MSG(
+          "information_schema.columns could not be read, falling back to "
+          "SHOW COLUMNS per table");
+      columns.clear();
+      result = GetColumnsPerTable(columnPattern, columns);
+      if (result != SqlResult::AI_SUCCESS
+          && result != SqlResult::AI_SUCCESS_WITH_INFO) {
+        return result;
+      }
+    }
+
+    // partial results are not cached
+    if (cache && result != SqlResult::AI_SUCCESS_WITH_INFO) {
+      cache->PutColumnListing(
+          identity, databasePattern, tablePattern, columnPattern, columns,
+          connection.GetConfiguration().GetMetadataCacheTtl());
+    }
+  }
+
+  for (const MetadataCache::Column& found : columns) {
+    meta.emplace_back(meta::ColumnMeta(found.database, found.table));
+    meta.back().Read(found.name, found.dataType, found.remarks,
+                     found.nullable, found.position);
+  }
+
   LOG_DEBUG_MSG("meta size is " << meta.size());
 
   if (meta.empty()) {
-    diag.AddStatusRecord(
-        SqlState::S01000_GENERAL_WARNING,
-        "No columns with name \'" + column.get_value_or("") + "\' found",
-        LogLevel::Type::WARNING_LEVEL);
-    result = SqlResult::AI_SUCCESS_WITH_INFO;
+    std::string warnMsg = "No columns with name \'" + columnPattern
+                          + "\' found in " + databasePattern + "."
+                          + tablePattern;
+    diag.AddStatusRecord(SqlState::S01000_GENERAL_WARNING, warnMsg,
+                         LogLevel::Type::WARNING_LEVEL);
+    return SqlResult::AI_SUCCESS_WITH_INFO;
   }
 
   return result;
@@ -22,8 +22,14 @@
 
 #include "trino/odbc/connection.h"
 #include "trino/odbc/log.h"
+#include "trino/odbc/metrics.h"
+#include "trino/odbc/tracer.h"
+#include "trino/odbc/worker_pool.h"
 #include "ignite/odbc/odbc_error.h"
 
+#include <algorithm>
+#include <limits>
+
 /*#*/
 #include <aws/trino-query/model/Type.h>
 #include <aws/trino-query/model/CancelQueryRequest.h>
@@ -32,35 +38,74 @@ namespace trino {
 namespace odbc {
 namespace query {
 DataQuery::DataQuery(diagnostic::DiagnosableAdapter& diag,
-                     Connection& connection, const std::string& sql)
+                     Connection& connection, const std::string& sql,
+                     bool scrollable, int64_t maxRows,
+                     int32_t queryTimeout)
     : Query(diag, trino::odbc::query::QueryType::DATA),
       connection_(connection),
       sql_(sql),
       resultMetaAvailable_(false),
       resultMeta_(),
       request_(),
-      result_(nullptr),
+      queryId_(),
       cursor_(nullptr),
+      arenaPool_(
+          std::make_shared< PageArenaPool >(connection.GetMemoryGovernor())),
       queryClient_(connection.GetQueryClient()),
+      context_(std::make_shared< DataQueryContext >()),
       hasAsyncFetch(false),
-      rowCounter(0) {
+      rowCounter(0),
+      scrollable_(scrollable),
+      spill_(),
+      rowsetStart_(0),
+      rowsetSize_(0),
+      maxRows_(maxRows),
+      rowsReceived_(0),
+      bytesReceived_(0),
+      executeStart_(),
+      queryTimeout_(queryTimeout),
+      resultCache_(),
+      cacheKey_(),
+      cachedResult_(),
+      cachedPage_(0),
+      cacheEntry_(),
+      sharedQuery_(),
+      sharedReader_(0),
+      sharedPage_(0),
+      trace_(),
+      timer_(0),
+      failure_(FailureKind::NONE) {
   // No-op.
 }
 
 DataQuery::~DataQuery() {
   LOG_DEBUG_MSG("~DataQuery is called");
 
-  if (result_.get())
-    InternalClose();
+  InternalClose();
 }
 
 SqlResult::Type DataQuery::Execute() {
   LOG_DEBUG_MSG("Execute is called");
 
-  if (result_.get())
-    InternalClose();
+  InternalClose();
+
+  // a prepared statement runs the same query again, count from the start
+  rowCounter = 0;
+  rowsReceived_ = 0;
+  bytesReceived_ = 0;
+  failure_ = FailureKind::NONE;
 
   SqlResult::Type retval = MakeRequestExecute();
+  if (retval == SqlResult::AI_ERROR && failure_ == FailureKind::NONE) {
+    failure_ = FailureKind::OTHER;
+  }
+  if (trace_) {
+    trace_->Executed();
+  }
+  if (retval != SqlResult::AI_ERROR) {
+    Metrics::GetInstance().executeLatency.Record(
+        std::chrono::steady_clock::now() - executeStart_);
+  }
 
   LOG_DEBUG_MSG("retval is " << retval);
   return retval;
@@ -69,8 +114,8 @@ SqlResult::Type DataQuery::Execute() {
 SqlResult::Type DataQuery::Cancel() {
   LOG_DEBUG_MSG("Cancel is called");
 
-  if (hasAsyncFetch) {
-    if (!result_) {
+  if (hasAsyncFetch && !cachedResult_ && !sharedQuery_) {
+    if (queryId_.empty()) {
       LOG_ERROR_MSG("no result found");
       diag.AddStatusRecord(SqlState::SHY000_GENERAL_ERROR,
                            "query is not executed");
@@ -78,26 +123,14 @@ SqlResult::Type DataQuery::Cancel() {
     }
 
     // Try to cancel current query
-    client::TrinoQuery::Model::CancelQueryRequest cancel_request; /*#*/
-    cancel_request.SetQueryId(result_->GetQueryId());
-
-    auto outcome = connection_.GetQueryClient()->CancelQuery(cancel_request);
-    std::string message("");
-    if (outcome.IsSuccess()) {
-      message = "Query ID: " + cancel_request.GetQueryId() + " is cancelled."
-                + outcome.GetResult().GetCancellationMessage();
-    } else {
-      message = "Query ID: " + cancel_request.GetQueryId() + " can't cancel."
-                + outcome.GetError().GetMessage();
-      // ValidationException is an exception that the query is finished and
-      // cancel does not work, it should not be counted as error
-      if (outcome.GetError().GetExceptionName() != "ValidationException") {
-        LOG_ERROR_MSG(message.c_str());
-        diag.AddStatusRecord(SqlState::SHY000_GENERAL_ERROR, message);
-        return SqlResult::AI_ERROR;
-      }
+    std::string message;
+    if (!CancelServerQuery(message)) {
+      LOG_ERROR_MSG(message.c_str());
+      diag.AddStatusRecord(SqlState::SHY000_GENERAL_ERROR, message);
+      return SqlResult::AI_ERROR;
     }
     LOG_DEBUG_MSG(message.c_str());
+    hasAsyncFetch = false;  // the query is already cancelled
   }
 
   InternalClose();
@@ -105,6 +138,148 @@ SqlResult::Type DataQuery::Cancel() {
   return SqlResult::AI_SUCCESS;
 }
 
+void DataQuery::ArmTimeout() {
+  if (queryTimeout_ <= 0) {
+    return;
+  }
+
+  // the callback runs on the timer thread and may outlive the query, so it
+  // only holds shared state
+  std::shared_ptr< DataQueryContext > context = context_;
+  std::shared_ptr< client::TrinoQuery::TrinoQueryClient > client = /*#*/
+      queryClient_;
+  std::shared_ptr< MemoryGovernor > governor = arenaPool_->GetMemoryGovernor();
+
+  timer_ = TimerService::GetInstance().Schedule(
+      std::chrono::seconds(queryTimeout_), [context, client, governor]() {
+        LOG_INFO_MSG("Query timeout expired");
+        Expire(context, client, governor);
+      });
+}
+
+void DataQuery::Interrupt() {
+  LOG_INFO_MSG("Interrupting query " << sql_);
+
+  std::shared_ptr< DataQueryContext > context = std::atomic_load(&context_);
+  context->interrupted_ = true;
+  Expire(context, queryClient_, arenaPool_->GetMemoryGovernor());
+}
+
+void DataQuery::Expire(
+    const std::shared_ptr< DataQueryContext >& context,
+    const std::shared_ptr< client::TrinoQuery::TrinoQueryClient >& client, /*#*/
+    const std::shared_ptr< MemoryGovernor >& governor) {
+  std::string queryId;
+  std::shared_ptr< SharedQuery > sharedQuery;
+  {
+    std::lock_guard< std::mutex > locker(context->mutex_);
+    context->timedOut_ = true;
+    queryId = context->queryId_;
+    sharedQuery = context->sharedQuery_;
+    context->cv_.notify_all();
+  }
+  if (governor) {
+    governor->Notify();
+  }
+  if (sharedQuery) {
+    sharedQuery->Wake();
+  }
+
+  if (queryId.empty()) {
+    return;
+  }
+
+  SubmitCancel(client, queryId);
+}
+
+void DataQuery::SubmitCancel(
+    const std::shared_ptr< client::TrinoQuery::TrinoQueryClient >& client, /*#*/
+    const std::string& queryId) {
+  if (!client || queryId.empty()) {
+    return;
+  }
+
+  LOG_DEBUG_MSG("Cancelling query " << queryId);
+  WorkerPool::GetRequestInstance().Submit([client, queryId]() {
+    client::TrinoQuery::Model::CancelQueryRequest request; /*#*/
+    request.SetQueryId(queryId);
+    auto outcome = client->CancelQuery(request);
+    // ValidationException tells the query is finished already
+    if (!outcome.IsSuccess()
+        && outcome.GetError().GetExceptionName() != "ValidationException") {
+      LOG_ERROR_MSG("Query ID: " << queryId << " can't cancel."
+                                 << outcome.GetError().GetMessage());
+    }
+  });
+}
+
+void DataQuery::DisarmTimeout() {
+  if (timer_ != 0) {
+    TimerService::GetInstance().Cancel(timer_);
+    timer_ = 0;
+  }
+}
+
+SqlResult::Type DataQuery::TimeoutExpired() {
+  bool interrupted = context_->interrupted_;
+  if (interrupted) {
+    LOG_INFO_MSG("Query " << sql_ << " is interrupted");
+  } else {
+    LOG_ERROR_MSG("Query timeout of " << queryTimeout_
+                                      << " seconds expired for query "
+                                      << sql_);
+  }
+
+  // the query is cancelled by Expire() unless it ran before the query ID
+  // was known
+  bool cancelled = true;
+  {
+    std::lock_guard< std::mutex > locker(context_->mutex_);
+    cancelled = !context_->queryId_.empty();
+  }
+  if (!cancelled && !queryId_.empty()) {
+    std::string message;
+    CancelServerQuery(message);
+    LOG_DEBUG_MSG(message.c_str());
+  }
+
+  DisarmTimeout();
+  hasAsyncFetch = false;  // no async fetch any more
+  cacheEntry_.reset();
+  failure_ = FailureKind::STOPPED;
+  if (trace_) {
+    trace_->SetError(interrupted ? "Operation canceled"
+                                 : "Query timeout expired");
+  }
+  Metrics::GetInstance().queriesFailed.Add();
+  if (interrupted) {
+    diag.AddStatusRecord(SqlState::SHY008_OPERATION_CANCELED,
+                         "Operation canceled.");
+  } else {
+    diag.AddStatusRecord(SqlState::SHYT00_TIMEOUT_EXPIRED,
+                         "Query timeout expired.");
+  }
+  return SqlResult::AI_ERROR;
+}
+
+bool DataQuery::CancelServerQuery(std::string& message) {
+  client::TrinoQuery::Model::CancelQueryRequest cancel_request; /*#*/
+  cancel_request.SetQueryId(queryId_);
+
+  auto outcome = queryClient_->CancelQuery(cancel_request);
+  if (outcome.IsSuccess()) {
+    message = "Query ID: " + cancel_request.GetQueryId() + " is cancelled."
+              + outcome.GetResult().GetCancellationMessage();
+    return true;
+  }
+
+  message = "Query ID: " + cancel_request.GetQueryId() + " can't cancel."
+            + outcome.GetError().GetMessage();
+  // ValidationException is an exception that the query is finished and
+  // cancel does not work, it should not be counted as error
+  return outcome.GetError().GetExceptionName() == "ValidationException";
+}
+
 const meta::ColumnMetaVector* DataQuery::GetMeta() {
   LOG_DEBUG_MSG("GetMeta is called");
 
@@ -122,96 +297,450 @@ const meta::ColumnMetaVector* DataQuery::GetMeta() {
 }
 
 /**
- * Fetch one page asynchronously. It will be
- * executed in an asynchronous thread.
+ * Fetch one page asynchronously and decode it. It is run on the request
+ * worker pool and only uses what it is given, so it can outlive the query
+ * once the query is closed.
  *
  * @return void.
  */
 void AsyncFetchOnePage(
     const std::shared_ptr< client::TrinoQuery::TrinoQueryClient > client, /*#*/
-    const QueryRequest& request, DataQueryContext& context_) {
+    const QueryRequest request, std::shared_ptr< PageArenaPool > pool,
+    std::shared_ptr< DataQueryContext > context) {
   LOG_DEBUG_MSG("AsyncFetchOnePage is called");
-  client::TrinoQuery::Model::QueryOutcome result; /*#*/
-  result = client->Query(request);
-
-  std::unique_lock< std::mutex > locker(context_.mutex_);
-  context_.cv_.wait(locker, [&]() {
-    // This thread could only continue when context_.queue_ is empty
-    // or the main thread is exiting.
-    return context_.queue_.empty() || context_.isClosing_;
-  });
 
-  if (context_.queue_.empty()) {
+  // Do not pull more data while the result memory budget is exhausted,
+  // unless the main thread already needs this page
+  const std::shared_ptr< MemoryGovernor >& governor =
+      pool->GetMemoryGovernor();
+  if (governor) {
+    Tracer::Span span("wait for memory", "wait");
+    governor->WaitForBudget([&]() {
+      return context->isClosing_.load() || context->consumerWaiting_.load()
+             || context->timedOut_.load();
+    });
+  }
+
+  if (context->isClosing_ || context->timedOut_) {
+    LOG_DEBUG_MSG("Statement is closing, page is not fetched");
+    return;
+  }
+
+  PageOutcome page;
+  {
+    QueryTrace::Clock::time_point start = QueryTrace::Clock::now();
+    client::TrinoQuery::Model::QueryOutcome outcome =
+        client->Query(request); /*#*/
+    if (context->isClosing_) {
+      LOG_DEBUG_MSG("Statement is closed, fetched page is dropped");
+      return;
+    }
+    QueryTrace::Clock::time_point received = QueryTrace::Clock::now();
+    page.fetch = received - start;
+    Tracer::GetInstance().Complete("fetch page", "fetch", start, received);
+
+    if (outcome.IsSuccess()) {
+      const QueryResult& result = outcome.GetResult();
+      page.page = pool->DecodePage(result.GetRows(), context->columnMeta_,
+                                   result.GetNextToken());
+      page.decode = QueryTrace::Clock::now() - received;
+      Metrics::GetInstance().RecordPage(page.fetch,
+                                        page.page->GetArena().GetUsedBytes());
+    } else {
+      auto& error = outcome.GetError();
+      page.error = error.GetExceptionName() + ": " + error.GetMessage();
+    }
+    // the raw outcome is released here, only the decoded page is kept
+  }
+
+  std::unique_lock< std::mutex > locker(context->mutex_);
+  {
+    Tracer::Span span("wait for consumer", "wait");
+    context->cv_.wait(locker, [&]() {
+      // This thread could only continue when context->queue_ is empty
+      // or the main thread is exiting.
+      return context->queue_.empty() || context->isClosing_
+             || context->timedOut_;
+    });
+  }
+
+  if (!context->isClosing_ && !context->timedOut_) {
     LOG_DEBUG_MSG("Result queue is empty");
-    // context_.queue_ hold one element at most
-    context_.queue_.push(result);
-    context_.cv_.notify_one();
+    // context->queue_ hold one element at most
+    context->queue_.push(std::move(page));
+    context->cv_.notify_one();
   }
 }
 
 SqlResult::Type DataQuery::SwitchCursor() {
   LOG_DEBUG_MSG("SwitchCursor is called");
-  std::unique_lock< std::mutex > locker(context_.mutex_);
-  context_.cv_.wait(locker, [&]() { return !context_.queue_.empty(); });
-  client::TrinoQuery::Model::QueryOutcome outcome = context_.queue_.front(); /*#*/
-  context_.queue_.pop();
+
+  std::shared_ptr< const ResultPage > page;
+  SqlResult::Type result = TakeNextPage(page);
+  if (result == SqlResult::AI_ERROR) {
+    cursor_.reset();
+  }
+  if (result != SqlResult::AI_SUCCESS) {
+    return result;
+  }
+
+  // switch to rows in next page, the page of the previous cursor goes back
+  // to the pool once the cursor drops it
+  cursor_.reset(new TrinoCursor(std::move(page), resultMeta_));
+  cursor_->Increment();  // The cursor_ needs to be incremented before using it
+                         // for the first time
+
+  return SqlResult::AI_SUCCESS;
+}
+
+SqlResult::Type DataQuery::TakeNextPage(
+    std::shared_ptr< const ResultPage >& page) {
+  LOG_DEBUG_MSG("TakeNextPage is called");
+
+  if (cachedResult_) {
+    return TakeCachedPage(page);
+  }
+
+  if (sharedQuery_) {
+    return TakeSharedPage(page);
+  }
+
+  // the current page is exhausted, let the fetching thread go even if the
+  // result memory budget is still exhausted
+  context_->consumerWaiting_ = true;
+  if (arenaPool_->GetMemoryGovernor()) {
+    arenaPool_->GetMemoryGovernor()->Notify();
+  }
+
+  QueryTrace::Clock::time_point waitStart;
+  if (trace_ || Tracer::IsEnabled()) {
+    waitStart = QueryTrace::Clock::now();
+  }
+
+  std::unique_lock< std::mutex > locker(context_->mutex_);
+  context_->cv_.wait(locker, [&]() {
+    return !context_->queue_.empty() || context_->timedOut_;
+  });
+  if (trace_ || Tracer::IsEnabled()) {
+    QueryTrace::Clock::time_point waitEnd = QueryTrace::Clock::now();
+    Tracer::GetInstance().Complete("wait for page", "wait", waitStart,
+                                   waitEnd);
+    if (trace_) {
+      trace_->AddWait(waitEnd - waitStart);
+    }
+  }
+  if (context_->timedOut_) {
+    locker.unlock();
+    context_->consumerWaiting_ = false;
+    return TimeoutExpired();
+  }
+  PageOutcome outcome = std::move(context_->queue_.front());
+  context_->queue_.pop();
   locker.unlock();
+  context_->consumerWaiting_ = false;
 
-  if (!outcome.IsSuccess()) {
-    auto& error = outcome.GetError();
-    LOG_ERROR_MSG("ERROR: " << error.GetExceptionName() << ": "
-                            << error.GetMessage() << ", for query " << sql_
+  if (!outcome.page) {
+    LOG_ERROR_MSG("ERROR: " << outcome.error << ", for query " << sql_
                             << ", number of rows fetched: " << rowCounter);
-    cursor_.reset();
     hasAsyncFetch = false;  // no async fetch any more
+    cacheEntry_.reset();
+    if (trace_) {
+      trace_->SetError(outcome.error);
+    }
+    Metrics::GetInstance().queriesFailed.Add();
     return SqlResult::Type::AI_ERROR;
   }
 
-  result_ = std::make_shared< QueryResult >(outcome.GetResult());
-  const Aws::Vector< Row >& rows = outcome.GetResult().GetRows(); /*#*/
-  const Aws::String& token = outcome.GetResult().GetNextToken(); /*#*/
-  if (rows.empty()) {
+  if (trace_) {
+    trace_->AddPage(outcome.page->GetRowCount(),
+                    outcome.page->GetArena().GetUsedBytes(), outcome.fetch,
+                    outcome.decode);
+  }
+
+  if (outcome.page->GetRowCount() == 0) {
     LOG_INFO_MSG(
         "Data fetching is finished, number of rows fetched: " << rowCounter);
+    hasAsyncFetch = false;  // no async fetch any more
+    StoreResult();
     return SqlResult::AI_NO_DATA;
   }
 
-  // switch to rows in next page
-  cursor_.reset(new TrinoCursor(rows, resultMeta_));
-  cursor_->Increment();  // The cursor_ needs to be incremented before using it
-                         // for the first time
+  ContinueFetch(*outcome.page);
+
+  page = std::move(outcome.page);
+  return SqlResult::AI_SUCCESS;
+}
+
+void DataQuery::ContinueFetch(const ResultPage& page) {
+  rowsReceived_ += static_cast< int64_t >(page.GetRowCount());
+  bytesReceived_ += page.GetArena().GetUsedBytes();
 
+  if (cacheEntry_) {
+    cacheEntry_->AddPage(page.GetArena());
+    if (cacheEntry_->GetSize() > resultCache_->GetEntryLimit()) {
+      LOG_DEBUG_MSG("Result is too large to be cached");
+      cacheEntry_.reset();
+    }
+  }
+
+  const std::string& token = page.GetNextToken();
   if (token.empty()) {
+    DisarmTimeout();        // the query is finished on the server
     hasAsyncFetch = false;  // no async fetch any more
     LOG_INFO_MSG(
         "Data fetching is finished, number of rows fetched: " << rowCounter);
+    StoreResult();
+  } else if (maxRows_ > 0 && rowsReceived_ >= maxRows_) {
+    StopAtMaxRows();
+  } else if (sharedQuery_) {
+    hasAsyncFetch = true;  // the shared query fetches the next page
   } else {
-    if (!threads_.empty()) {
-      std::thread& itr = threads_.front();
-      // wait for the last thread to end. The join() should be done before the
-      // thread is popped from the queue. The thread could not be joined after
-      // it is popped from the queue, as it could cause crash.
-      LOG_DEBUG_MSG("Waiting for thread " << itr.get_id() << " to end");
-      if (itr.joinable()) {
-        itr.join();
+    StartAsyncFetch(token);
+    hasAsyncFetch = true;
+  }
+}
+
+void DataQuery::LimitPageSize() {
+  if (maxRows_ <= 0) {
+    return;
+  }
+
+  const config::Configuration& config = connection_.GetConfiguration();
+  int64_t remaining = maxRows_ - rowsReceived_;
+  if (!config.IsMaxRowPerPageSet() || remaining < config.GetMaxRowPerPage()) {
+    // SQL_ATTR_MAX_ROWS is an SQLULEN, the request takes an int
+    int pageRows = static_cast< int >(std::min< int64_t >(
+        remaining, std::numeric_limits< int >::max()));
+    LOG_DEBUG_MSG("Page size is limited to " << pageRows << " rows");
+    request_.SetMaxRows(pageRows);
+  }
+}
+
+void DataQuery::StopAtMaxRows() {
+  DisarmTimeout();
+  hasAsyncFetch = false;  // no async fetch any more
+  cacheEntry_.reset();    // the result is incomplete
+
+  // the rest of the result set is not needed, so the server can stop
+  // producing it
+  std::string message;
+  if (!CancelServerQuery(message)) {
+    LOG_ERROR_MSG(message.c_str());
+  }
+
+  int64_t elapsed = std::chrono::duration_cast< std::chrono::milliseconds >(
+                        std::chrono::steady_clock::now() - executeStart_)
+                        .count();
+  LOG_INFO_MSG("Row limit of " << maxRows_ << " is reached after "
+                               << rowsReceived_ << " rows, " << bytesReceived_
+                               << " bytes and " << elapsed
+                               << " ms, remaining pages are not fetched. "
+                               << message);
+}
+
+SqlResult::Type DataQuery::AcceptPage(
+    std::shared_ptr< const ResultPage > page) {
+  if (!scrollable_) {
+    cursor_.reset(new TrinoCursor(std::move(page), resultMeta_));
+    return SqlResult::AI_SUCCESS;
+  }
+
+  // the page goes back to the pool right after it is spilled, rows past
+  // the row limit are dropped
+  size_t rowLimit = SIZE_MAX;
+  if (maxRows_ > 0) {
+    rowLimit = static_cast< size_t >(maxRows_) - spill_->GetRowCount();
+  }
+
+  if (!spill_->Append(page->GetArena(), rowLimit)) {
+    diag.AddStatusRecord(SqlState::SHY000_GENERAL_ERROR,
+                         "Failed to store fetched rows for scrolling.");
+    return SqlResult::AI_ERROR;
+  }
+
+  if (!cursor_) {
+    cursor_.reset(new TrinoCursor(spill_, resultMeta_));
+  }
+
+  return SqlResult::AI_SUCCESS;
+}
+
+SqlResult::Type DataQuery::SpillUntil(size_t rowCount) {
+  while (spill_->GetRowCount() < rowCount && hasAsyncFetch) {
+    std::shared_ptr< const ResultPage > page;
+    SqlResult::Type result = TakeNextPage(page);
+    if (result == SqlResult::AI_NO_DATA) {
+      break;
+    }
+
+    if (result == SqlResult::AI_SUCCESS) {
+      result = AcceptPage(std::move(page));
+    }
+
+    if (result != SqlResult::AI_SUCCESS) {
+      return result;
+    }
+  }
+
+  return SqlResult::AI_SUCCESS;
+}
+
+SqlResult::Type DataQuery::MoveToRowset(int16_t orientation, int64_t offset,
+                                        SqlUlen rowsetSize) {
+  LOG_DEBUG_MSG("MoveToRowset is called with orientation "
+                << orientation << ", offset " << offset << ", rowset size "
+                << rowsetSize);
+
+  if (!scrollable_) {
+    return Query::MoveToRowset(orientation, offset, rowsetSize);
+  }
+
+  if (!cursor_) {
+    return SqlResult::AI_NO_DATA;
+  }
+
+  const int64_t size = static_cast< int64_t >(rowsetSize);
+  const int64_t current = static_cast< int64_t >(rowsetStart_);
+  const int64_t maxRow = std::numeric_limits< int64_t >::max();
+  const bool beforeStart = rowsetStart_ == 0;
+  const bool afterEnd =
+      !hasAsyncFetch && rowsetStart_ > spill_->GetRowCount();
+
+  // The last row is only known once the whole result set is spilled, so it
+  // is only requested by the orientations that depend on it.
+  SqlResult::Type result = SqlResult::AI_SUCCESS;
+  auto lastRow = [&]() {
+    result = SpillUntil(static_cast< size_t >(maxRow));
+    return static_cast< int64_t >(spill_->GetRowCount());
+  };
+
+  // target row of the new rowset, values below 1 mean before the start
+  int64_t target = 0;
+  bool truncated = false;
+
+  switch (orientation) {
+    case SQL_FETCH_NEXT:
+      target = beforeStart ? 1 : current + static_cast< int64_t >(rowsetSize_);
+      break;
+
+    case SQL_FETCH_PRIOR:
+      if (beforeStart) {
+        target = 0;
+      } else if (afterEnd) {
+        target = std::max< int64_t >(lastRow() - size + 1, 1);
+      } else if (current == 1) {
+        target = 0;
+      } else if (current - size < 1) {
+        target = 1;
+        truncated = true;
+      } else {
+        target = current - size;
       }
-      threads_.pop();
-    } else {
-      LOG_DEBUG_MSG("The threads queue is empty");
+      break;
+
+    case SQL_FETCH_RELATIVE:
+    case SQL_FETCH_ABSOLUTE: {
+      int64_t base = 0;
+      if (orientation == SQL_FETCH_RELATIVE) {
+        if (beforeStart && offset <= 0) {
+          break;
+        }
+        base = beforeStart ? 0 : (afterEnd ? lastRow() + 1 : current);
+      } else if (offset < 0) {
+        base = lastRow() + 1;
+      } else if (offset == 0) {
+        break;
+      }
+
+      target = base + offset;
+      if (target < 1 && -offset <= size) {
+        target = 1;
+        truncated = true;
+      }
+      break;
     }
 
-    request_.SetNextToken(token);
-    std::thread next(AsyncFetchOnePage, queryClient_, std::ref(request_),
-                     std::ref(context_));
-    LOG_DEBUG_MSG("New thread " << next.get_id() << " is started");
-    addThreads(next);
+    case SQL_FETCH_FIRST:
+      target = 1;
+      break;
+
+    case SQL_FETCH_LAST:
+      target = std::max< int64_t >(lastRow() - size + 1, 1);
+      break;
+
+    default:
+      diag.AddStatusRecord(SqlState::SHY106_FETCH_TYPE_OUT_OF_RANGE,
+                           "Fetch orientation is not supported.");
+      return SqlResult::AI_ERROR;
+  }
+
+  if (result == SqlResult::AI_SUCCESS && target >= 1) {
+    result = SpillUntil(static_cast< size_t >(target));
+  }
+
+  if (result != SqlResult::AI_SUCCESS) {
+    return result;
+  }
+
+  rowsetSize_ = rowsetSize;
+
+  if (target < 1) {
+    LOG_DEBUG_MSG("Cursor is positioned before the start of the result set");
+    rowsetStart_ = 0;
+    cursor_->SetPosition(0);
+    return SqlResult::AI_NO_DATA;
+  }
+
+  if (static_cast< size_t >(target) > spill_->GetRowCount()) {
+    LOG_DEBUG_MSG("Cursor is positioned after the end of the result set");
+    rowsetStart_ = spill_->GetRowCount() + 1;
+    cursor_->SetPosition(rowsetStart_);
+    return SqlResult::AI_NO_DATA;
+  }
+
+  rowsetStart_ = static_cast< size_t >(target);
+  cursor_->SetPosition(rowsetStart_ - 1);
+
+  if (truncated) {
+    diag.AddStatusRecord(
+        SqlState::S01S06_FETCH_BEFORE_FIRST_ROWSET,
+        "Attempt to fetch before the result set returned the first rowset.");
+    return SqlResult::AI_SUCCESS_WITH_INFO;
   }
 
   return SqlResult::AI_SUCCESS;
 }
 
+void DataQuery::StartAsyncFetch(const std::string& nextToken) {
+  if (fetch_.valid()) {
+    // the pages are fetched one after another
+    LOG_DEBUG_MSG("Waiting for the previous page fetch to end");
+    fetch_.wait();
+  }
+
+  request_.SetNextToken(nextToken);
+  LimitPageSize();
+
+  std::shared_ptr< std::promise< void > > done =
+      std::make_shared< std::promise< void > >();
+  fetch_ = done->get_future().share();
+
+  std::shared_ptr< client::TrinoQuery::TrinoQueryClient > client = /*#*/
+      queryClient_;
+  QueryRequest request = request_;
+  std::shared_ptr< PageArenaPool > pool = arenaPool_;
+  std::shared_ptr< DataQueryContext > context = context_;
+  WorkerPool::GetRequestInstance().Submit(
+      [client, request, pool, context, done]() {
+        AsyncFetchOnePage(client, request, pool, context);
+        done->set_value();
+      });
+  LOG_DEBUG_MSG("Page fetch is submitted");
+}
+
 SqlResult::Type DataQuery::FetchNextRow(app::ColumnBindingMap& columnBindings) {
   LOG_DEBUG_MSG("FetchNextRow is called");
+  QueryTrace::CallTimer timer(trace_.get());
   if (!cursor_) {
     diag.AddStatusRecord(SqlState::S01000_GENERAL_WARNING,
                          "Cursor does not point to any data.",
@@ -219,6 +748,28 @@ SqlResult::Type DataQuery::FetchNextRow(app::ColumnBindingMap& columnBindings) {
     return SqlResult::AI_NO_DATA;
   }
 
+  if (scrollable_) {
+    // rows of the rowset are read one after another from the spill store
+    size_t next = cursor_->GetPosition() + 1;
+    SqlResult::Type result = SpillUntil(next);
+    if (result != SqlResult::AI_SUCCESS) {
+      return result;
+    }
+
+    if (next > spill_->GetRowCount()) {
+      cursor_->SetPosition(spill_->GetRowCount() + 1);
+      return SqlResult::AI_NO_DATA;
+    }
+
+    cursor_->SetPosition(next);
+    return ReadRow(columnBindings);
+  }
+
+  if (maxRows_ > 0 && rowCounter >= maxRows_) {
+    LOG_INFO_MSG("Exit due to row limit of " << maxRows_ << " is reached.");
+    return SqlResult::AI_NO_DATA;
+  }
+
   if (!cursor_->Increment()) {
     if (hasAsyncFetch) {
       SqlResult::Type result = SwitchCursor();
@@ -236,15 +787,29 @@ SqlResult::Type DataQuery::FetchNextRow(app::ColumnBindingMap& columnBindings) {
     }
   }
 
+  return ReadRow(columnBindings);
+}
+
+SqlResult::Type DataQuery::ReadRow(app::ColumnBindingMap& columnBindings) {
   for (uint32_t i = 1; i < cursor_->GetColumnSize() + 1; ++i) {
     app::ColumnBindingMap::iterator it = columnBindings.find(i);
 
     if (it == columnBindings.end())
       continue;
   
+    QueryTrace::Clock::time_point start;
+    if (trace_) {
+      start = QueryTrace::Clock::now();
+    }
+
     app::ConversionResult::Type convRes =
         cursor_->ReadColumnToBuffer(i, it->second);
 
+    if (trace_) {
+      trace_->AddConversion(static_cast< uint16_t >(i),
+                            QueryTrace::Clock::now() - start);
+    }
+
     SqlResult::Type result = ProcessConversionResult(convRes, 0, i);
 
     if (result == SqlResult::AI_ERROR) {
@@ -254,12 +819,14 @@ SqlResult::Type DataQuery::FetchNextRow(app::ColumnBindingMap& columnBindings) {
   }
 
   rowCounter++;
+  Metrics::GetInstance().rowsConverted.Add();
   return SqlResult::AI_SUCCESS;
 }
 
 SqlResult::Type DataQuery::GetColumn(uint16_t columnIdx,
                                      app::ApplicationDataBuffer& buffer) {
   LOG_DEBUG_MSG("GetColumn is called");
+  QueryTrace::CallTimer timer(trace_.get());
 
   if (!cursor_) {
     diag.AddStatusRecord(SqlState::S01000_GENERAL_WARNING,
@@ -276,9 +843,18 @@ SqlResult::Type DataQuery::GetColumn(uint16_t columnIdx,
     return SqlResult::AI_ERROR;
   }
 
+  QueryTrace::Clock::time_point start;
+  if (trace_) {
+    start = QueryTrace::Clock::now();
+  }
+
   app::ConversionResult::Type convRes =
       cursor_->ReadColumnToBuffer(columnIdx, buffer);
 
+  if (trace_) {
+    trace_->AddConversion(columnIdx, QueryTrace::Clock::now() - start);
+  }
+
   SqlResult::Type result = ProcessConversionResult(convRes, 0, columnIdx);
 
   LOG_DEBUG_MSG("result is " << result);
@@ -297,21 +873,62 @@ SqlResult::Type DataQuery::Close() {
 SqlResult::Type DataQuery::InternalClose() {
   LOG_DEBUG_MSG("InternalClose is called");
 
-  // stop all asynchronous threads
-  context_.isClosing_ = true;
-  while (!threads_.empty()) {
-    std::thread& itr = threads_.front();
-    // wait for the last thread to end. The join() should be done before the
-    // thread is popped from the queue. The thread could not be joined after
-    // it is popped from the queue, as it could cause crash.
-    if (itr.joinable()) {
-      itr.join();
-    }
-    threads_.pop();
+  std::chrono::steady_clock::time_point closeStart =
+      std::chrono::steady_clock::now();
+  bool complete = !hasAsyncFetch;
+
+  DisarmTimeout();
+
+  // the rest of the result set is not going to be read, let the server stop
+  // producing it. This also makes the in-flight page request return early.
+  if (hasAsyncFetch) {
+    SubmitCancel(queryClient_, queryId_);
   }
 
-  result_.reset();
+  // stop all asynchronous threads, including the ones waiting for budget
+  {
+    std::lock_guard< std::mutex > locker(context_->mutex_);
+    context_->isClosing_ = true;
+    context_->cv_.notify_all();
+  }
+  if (arenaPool_->GetMemoryGovernor()) {
+    arenaPool_->GetMemoryGovernor()->Notify();
+  }
+
+  // A page fetch may still be waiting for the server. It only holds the
+  // context it was started with, so it is left to finish on the worker pool
+  // instead of blocking the close for a page round-trip.
+  fetch_ = std::shared_future< void >();
+
+  queryId_.clear();
   cursor_.reset();
+  hasAsyncFetch = false;
+  cachedResult_.reset();
+  cachedPage_ = 0;
+  cacheEntry_.reset();
+  LeaveSharedQuery();
+  spill_.reset();
+  rowsetStart_ = 0;
+  rowsetSize_ = 0;
+
+  // pages left behind by the fetching thread are dropped with the context
+  std::atomic_store(&context_, std::make_shared< DataQueryContext >());
+
+  LOG_DEBUG_MSG("Query is closed in "
+                << std::chrono::duration_cast< std::chrono::microseconds >(
+                       std::chrono::steady_clock::now() - closeStart)
+                       .count()
+                << " us");
+
+  if (trace_) {
+    trace_->Finish(complete, std::chrono::steady_clock::now() - closeStart);
+    trace_->Write(connection_.GetConfiguration().GetQueryTraceFile());
+    trace_.reset();
+  }
+
+  LOG_DEBUG_MSG("Page arenas created: " << arenaPool_->GetCreatedCount()
+                                        << ", reused: "
+                                        << arenaPool_->GetReusedCount());
 
   return SqlResult::AI_SUCCESS;
 }
@@ -336,6 +953,11 @@ int64_t DataQuery::RowNumber() const {
 
     return 0;
   }
+  if (scrollable_) {
+    LOG_DEBUG_MSG("Row number returned: " << cursor_->GetPosition());
+    return static_cast< int64_t >(cursor_->GetPosition());
+  }
+
   LOG_DEBUG_MSG("Row number returned: " << rowCounter);
   return int64_t(rowCounter);
 }
@@ -356,15 +978,132 @@ SqlResult::Type DataQuery::MakeRequestExecute() {
     request_.SetMaxRows(connection_.GetConfiguration().GetMaxRowPerPage());
   }
 
+  executeStart_ = std::chrono::steady_clock::now();
+  Metrics::GetInstance().queriesStarted.Add();
+  if (!connection_.GetConfiguration().GetQueryTraceFile().empty()) {
+    trace_.reset(new QueryTrace(sql_));
+  }
+
+  // the result cache and the shared queries only take queries that read
+  // data, identified by the same key
+  cacheKey_.clear();
+  resultCache_ = connection_.GetResultCache();
+  std::shared_ptr< SharedQueryRegistry > sharedQueries =
+      connection_.GetSharedQueries();
+  if (resultCache_ || sharedQueries) {
+    std::string normalized = ResultCache::NormalizeSql(sql_);
+    if (ResultCache::IsCacheable(normalized)) {
+      cacheKey_ = ResultCache::MakeKey(
+          normalized, connection_.GetResultCacheIdentity());
+    }
+  }
+
+  if (resultCache_ && !cacheKey_.empty()) {
+    cachedResult_ = resultCache_->Get(cacheKey_);
+  }
+
+  if (scrollable_) {
+    spill_ = std::make_shared< SpillStore >();
+    if (!spill_->Open()) {
+      diag.AddStatusRecord(SqlState::SHY000_GENERAL_ERROR,
+                           "Failed to create storage for a scrollable cursor.");
+      spill_.reset();
+      cachedResult_.reset();
+      return SqlResult::AI_ERROR;
+    }
+  }
+
+  if (cachedResult_) {
+    return ExecuteCached();
+  }
+
+  // the client is taken when the query is created, the connection may have
+  // been closed since
+  if (!queryClient_) {
+    diag.AddStatusRecord(SqlState::S08003_NOT_CONNECTED,
+                         "Connection is not open.");
+    InternalClose();
+    return SqlResult::AI_ERROR;
+  }
+
+  LimitPageSize();
+  ArmTimeout();
+
+  // a query stopped by the row limit can not be read to the end by others
+  if (sharedQueries && !cacheKey_.empty() && maxRows_ <= 0) {
+    bool leader = false;
+    sharedQuery_ = sharedQueries->Join(cacheKey_, queryClient_,
+                                       sharedReader_, leader);
+    {
+      std::lock_guard< std::mutex > locker(context_->mutex_);
+      context_->sharedQuery_ = sharedQuery_;
+    }
+
+    if (!leader) {
+      std::shared_ptr< DataQueryContext > context = context_;
+      SharedQuery::Outcome::Type outcome = sharedQuery_->WaitStarted(
+          [context]() { return context->timedOut_.load(); });
+
+      if (outcome == SharedQuery::Outcome::PAGE) {
+        return ExecuteShared();
+      }
+
+      LeaveSharedQuery();
+      if (outcome == SharedQuery::Outcome::STOPPED) {
+        SqlResult::Type result = TimeoutExpired();
+        InternalClose();
+        return result;
+      }
+
+      LOG_DEBUG_MSG("Shared query is abandoned, executing " << sql_);
+    }
+  }
+
+  std::shared_ptr< const ResultPage > page;
   do {
+    QueryTrace::Clock::time_point fetchStart = QueryTrace::Clock::now();
     client::TrinoQuery::Model::QueryOutcome outcome =
-        connection_.GetQueryClient()->Query(request_); /*#*/
+        queryClient_->Query(request_); /*#*/
+    QueryTrace::Clock::time_point received = QueryTrace::Clock::now();
+    Tracer::GetInstance().Complete("fetch page", "fetch", fetchStart,
+                                   received);
+    if (trace_) {
+      trace_->FirstResponse();
+    }
+
+    if (outcome.IsSuccess()) {
+      queryId_ = outcome.GetResult().GetQueryId();
+      if (trace_) {
+        trace_->SetQueryId(queryId_);
+      }
+
+      // once published, the query is cancelled by the timer on expiry
+      std::lock_guard< std::mutex > locker(context_->mutex_);
+      if (!context_->timedOut_) {
+        context_->queryId_ = queryId_;
+      }
+    }
+
+    if (context_->timedOut_) {
+      SqlResult::Type result = TimeoutExpired();
+      InternalClose();
+      return result;
+    }
 
     if (!outcome.IsSuccess()) {
       auto error = outcome.GetError();
       LOG_ERROR_MSG("ERROR: " << error.GetExceptionName() << ": "
                               << error.GetMessage() << " for query " << sql_);
+      if (trace_) {
+        trace_->SetError(error.GetExceptionName() + ": " + error.GetMessage());
+      }
+      Metrics::GetInstance().queriesFailed.Add();
 
+      // the service refuses statements it can not run with a validation
+      // error, other errors leave open whether the statement ran
+      failure_ = error.GetExceptionName() == "ValidationException"
+                     ? FailureKind::REJECTED
+                     : FailureKind::OTHER;
       diag.AddStatusRecord(
           SqlState::SHY000_GENERAL_ERROR,
           "API Failure: Failed to execute query \"" + sql_ + "\"");
@@ -372,74 +1111,250 @@ SqlResult::Type DataQuery::MakeRequestExecute() {
       return SqlResult::AI_ERROR;
     }
 
-    // outcome is successful, update result_
-    result_ = std::make_shared< QueryResult >(outcome.GetResult());
-    if (result_->GetRows().empty()) {
-      if (result_->GetNextToken().empty()) {
+    // outcome is successful, borrow the result rather than copying it
+    const QueryResult& result = outcome.GetResult();
+    queryId_ = result.GetQueryId();
+
+    if (!resultMetaAvailable_) {
+      ReadColumnMetadataVector(result.GetColumnInfo());
+    }
+
+    if (result.GetRows().empty()) {
+      if (trace_) {
+        trace_->AddPage(0, 0, received - fetchStart,
+                        QueryTrace::Clock::duration::zero());
+      }
+      Metrics::GetInstance().RecordPage(received - fetchStart, 0);
+      if (result.GetNextToken().empty()) {
         // result is empty
         LOG_DEBUG_MSG("QueryResult is empty, returning no data");
+        LeaveSharedQuery();
         return SqlResult::AI_NO_DATA;
       }
-      request_.SetNextToken(result_->GetNextToken());
+      request_.SetNextToken(result.GetNextToken());
       continue;
-    } else {
-      break;
     }
-  } while (true);
 
-  cursor_.reset(new TrinoCursor(result_->GetRows(), resultMeta_));
+    LOG_DEBUG_MSG("Result has " << result.GetRows().size() << " rows");
+    page = arenaPool_->DecodePage(result.GetRows(), resultMeta_,
+                                  result.GetNextToken());
+    if (trace_) {
+      trace_->AddPage(page->GetRowCount(), page->GetArena().GetUsedBytes(),
+                      received - fetchStart,
+                      QueryTrace::Clock::now() - received);
+    }
+    Metrics::GetInstance().RecordPage(received - fetchStart,
+                                      page->GetArena().GetUsedBytes());
+  } while (!page);
 
-  if (!result_->GetNextToken().empty()) {
-    LOG_DEBUG_MSG(
-        "Next token is not empty, starting async thread to fetch next page");
-    request_.SetNextToken(result_->GetNextToken());
-    std::thread next(AsyncFetchOnePage, queryClient_, std::ref(request_),
-                     std::ref(context_));
-    addThreads(next);
-    hasAsyncFetch = true;
+  if (resultCache_ && !cacheKey_.empty()) {
+    cacheEntry_ = std::make_shared< ResultCache::Entry >(resultMeta_);
   }
 
-  SqlResult::Type retval = MakeRequestFetch();
-  return retval;
+  context_->columnMeta_ = resultMeta_;
+  if (sharedQuery_) {
+    // from now on the shared query fetches the pages, and it is cancelled
+    // once its last reader leaves rather than by this statement
+    sharedQuery_->Start(request_, resultMeta_, page, queryId_, arenaPool_);
+    {
+      std::lock_guard< std::mutex > locker(context_->mutex_);
+      context_->queryId_.clear();
+    }
+    queryId_.clear();
+    sharedPage_ = 1;
+  }
+  ContinueFetch(*page);
+
+  SqlResult::Type result = AcceptPage(std::move(page));
+  if (result != SqlResult::AI_SUCCESS) {
+    InternalClose();
+    return result;
+  }
+
+  return SqlResult::AI_SUCCESS;
 }
 
-SqlResult::Type DataQuery::MakeRequestFetch() {
-  LOG_DEBUG_MSG("MakeRequestFetch is called");
+SqlResult::Type DataQuery::ExecuteCached() {
+  LOG_INFO_MSG("Result is served from the result cache, hits: "
+               << resultCache_->GetHitCount()
+               << ", misses: " << resultCache_->GetMissCount());
+
+  SetResultsetMeta(cachedResult_->GetMeta());
+  cachedPage_ = 0;
+  hasAsyncFetch = true;
+  if (trace_) {
+    trace_->SetSource("cache");
+  }
+
+  std::shared_ptr< const ResultPage > page;
+  SqlResult::Type result = TakeCachedPage(page);
+  if (result == SqlResult::AI_SUCCESS) {
+    result = AcceptPage(std::move(page));
+  }
+
+  if (result == SqlResult::AI_ERROR) {
+    diag.AddStatusRecord(SqlState::SHY000_GENERAL_ERROR,
+                         "Failed to read cached result of query \"" + sql_
+                             + "\"");
+    InternalClose();
+  }
+
+  return result;
+}
+
+SqlResult::Type DataQuery::TakeCachedPage(
+    std::shared_ptr< const ResultPage >& page) {
+  if (cachedPage_ >= cachedResult_->GetPageCount()
+      || (maxRows_ > 0 && rowsReceived_ >= maxRows_)) {
+    hasAsyncFetch = false;
+    return SqlResult::AI_NO_DATA;
+  }
 
-  if (!result_.get()) {
-    diag.AddStatusRecord(SqlState::SHY010_SEQUENCE_ERROR,
-                         "result_ is a null pointer");
+  // cached pages are decoded into pooled arenas just like fetched ones
+  QueryTrace::Clock::time_point start = QueryTrace::Clock::now();
+  std::unique_ptr< PageArena > arena = arenaPool_->Acquire();
+  if (!cachedResult_->ReadPage(cachedPage_++, *arena)) {
+    LOG_ERROR_MSG("Failed to read page " << cachedPage_
+                                         << " of cached result of query "
+                                         << sql_);
+    arenaPool_->Release(std::move(arena));
+    hasAsyncFetch = false;
     return SqlResult::AI_ERROR;
   }
 
-  const Aws::Vector< ColumnInfo >& columnInfo = result_->GetColumnInfo(); /*#*/
+  rowsReceived_ += static_cast< int64_t >(arena->GetRowCount());
+  bytesReceived_ += arena->GetUsedBytes();
+  if (trace_) {
+    trace_->AddPage(arena->GetRowCount(), arena->GetUsedBytes(),
+                    QueryTrace::Clock::duration::zero(),
+                    QueryTrace::Clock::now() - start);
+  }
+  page = std::make_shared< ResultPage >(std::move(arena), arenaPool_, "",
+                                        arenaPool_->GetMemoryGovernor());
 
-  if (!resultMetaAvailable_) {
-    ReadColumnMetadataVector(columnInfo);
+  hasAsyncFetch = cachedPage_ < cachedResult_->GetPageCount()
+                  && (maxRows_ <= 0 || rowsReceived_ < maxRows_);
+  return SqlResult::AI_SUCCESS;
+}
+
+void DataQuery::StoreResult() {
+  if (!cacheEntry_) {
+    return;
   }
 
-  SqlResult::Type retval = SqlResult::AI_SUCCESS;
+  resultCache_->Put(cacheKey_, std::move(cacheEntry_),
+                    connection_.GetConfiguration().GetResultCacheTtl());
+  cacheEntry_.reset();
 
-  if (result_->GetRows().empty()) {
-    retval = SqlResult::AI_NO_DATA;
-  } else {
-    LOG_DEBUG_MSG("Result has " << result_->GetRows().size() << " rows");
-    cursor_.reset(new TrinoCursor(result_->GetRows(), resultMeta_));
+  LOG_DEBUG_MSG("Result is stored in the result cache, hits: "
+                << resultCache_->GetHitCount()
+                << ", misses: " << resultCache_->GetMissCount());
+}
+
+SqlResult::Type DataQuery::ExecuteShared() {
+  LOG_INFO_MSG("Query is read from an identical query of another statement: "
+               << sql_);
+
+  SetResultsetMeta(sharedQuery_->GetMeta());
+  context_->columnMeta_ = resultMeta_;
+  sharedPage_ = 0;
+  if (trace_) {
+    trace_->SetSource("shared");
+  }
+  if (resultCache_) {
+    cacheEntry_ = std::make_shared< ResultCache::Entry >(resultMeta_);
   }
 
-  LOG_DEBUG_MSG("retval is " << retval);
+  std::shared_ptr< const ResultPage > page;
+  SqlResult::Type result = TakeSharedPage(page);
+  if (result == SqlResult::AI_SUCCESS) {
+    result = AcceptPage(std::move(page));
+  }
 
-  return retval;
+  if (result == SqlResult::AI_ERROR) {
+    diag.AddStatusRecord(
+        SqlState::SHY000_GENERAL_ERROR,
+        "API Failure: Failed to execute query \"" + sql_ + "\"");
+    InternalClose();
+  } else if (result == SqlResult::AI_NO_DATA) {
+    LeaveSharedQuery();
+  }
+
+  return result;
+}
+
+SqlResult::Type DataQuery::TakeSharedPage(
+    std::shared_ptr< const ResultPage >& page) {
+  std::shared_ptr< DataQueryContext > context = context_;
+  std::string error;
+  QueryTrace::Clock::time_point start = QueryTrace::Clock::now();
+  SharedQuery::Outcome::Type outcome = sharedQuery_->GetPage(
+      sharedReader_, sharedPage_, page, error,
+      [context]() { return context->timedOut_.load(); });
+  if (Tracer::IsEnabled()) {
+    Tracer::GetInstance().Complete("wait for shared page", "wait", start,
+                                   QueryTrace::Clock::now());
+  }
+  if (trace_) {
+    // pages of a shared query are fetched and decoded by another statement
+    trace_->AddWait(QueryTrace::Clock::now() - start);
+  }
+
+  switch (outcome) {
+    case SharedQuery::Outcome::PAGE:
+      ++sharedPage_;
+      if (trace_) {
+        trace_->AddPage(page->GetRowCount(), page->GetArena().GetUsedBytes(),
+                        QueryTrace::Clock::duration::zero(),
+                        QueryTrace::Clock::duration::zero());
+      }
+      ContinueFetch(*page);
+      return SqlResult::AI_SUCCESS;
+
+    case SharedQuery::Outcome::STOPPED:
+      return TimeoutExpired();
+
+    case SharedQuery::Outcome::FAILED:
+      LOG_ERROR_MSG("ERROR: " << error << ", for query " << sql_
+                              << ", number of rows fetched: " << rowCounter);
+      if (trace_) {
+        trace_->SetError(error);
+      }
+      Metrics::GetInstance().queriesFailed.Add();
+      hasAsyncFetch = false;
+      cacheEntry_.reset();
+      return SqlResult::AI_ERROR;
+
+    default:
+      LOG_INFO_MSG(
+          "Data fetching is finished, number of rows fetched: " << rowCounter);
+      hasAsyncFetch = false;
+      StoreResult();
+      return SqlResult::AI_NO_DATA;
+  }
+}
+
+void DataQuery::LeaveSharedQuery() {
+  if (sharedQuery_) {
+    sharedQuery_->Detach(sharedReader_);
+    sharedQuery_.reset();
+  }
 }
 
 SqlResult::Type DataQuery::MakeRequestResultsetMeta() {
   LOG_DEBUG_MSG("MakeRequestResultsetMeta is called");
 
+  if (!queryClient_) {
+    diag.AddStatusRecord(SqlState::S08003_NOT_CONNECTED,
+                         "Connection is not open.");
+    return SqlResult::AI_ERROR;
+  }
+
   QueryRequest request;
   request.SetQueryString(sql_);
 
   client::TrinoQuery::Model::QueryOutcome outcome =
-      connection_.GetQueryClient()->Query(request); /*@*/
+      queryClient_->Query(request); /*@*/
 
   if (!outcome.IsSuccess()) {
     auto const error = outcome.GetError();
@@ -452,7 +1367,7 @@ SqlResult::Type DataQuery::MakeRequestResultsetMeta() {
     return SqlResult::AI_ERROR;
   }
   // outcome is successful
-  QueryResult result = outcome.GetResult();
+  const QueryResult& result = outcome.GetResult();
   const Aws::Vector< ColumnInfo >& columnInfo = result.GetColumnInfo();
 
   ReadColumnMetadataVector(columnInfo);
@@ -486,6 +1401,13 @@ SqlResult::Type DataQuery::ProcessConversionResult(
   LOG_DEBUG_MSG("ProcessConversionResult is called with convRes is "
                 << static_cast< int >(convRes));
 
+  if (convRes != app::ConversionResult::Type::AI_SUCCESS
+      && convRes != app::ConversionResult::Type::AI_NO_DATA) {
+    Metrics::GetInstance()
+        .conversionErrors[static_cast< size_t >(convRes)]
+        .Add();
+  }
+
   switch (convRes) {
     case app::ConversionResult::Type::AI_SUCCESS: {
       return SqlResult::AI_SUCCESS;
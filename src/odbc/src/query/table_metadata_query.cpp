@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "trino/odbc/connection.h"
+#include "trino/odbc/fan_out.h"
 #include "trino/odbc/log.h"
 #include "trino/odbc/type_traits.h"
 
@@ -53,8 +54,10 @@ TableMetadataQuery::TableMetadataQuery(
       all_schemas(false),
       all_catalogs(false),
       all_table_types(false),
+      prefetching(false),
       meta(),
-      columnsMeta() {
+      columnsMeta(),
+      interrupted_(false) {
   LOG_DEBUG_MSG("TableMetadataQuery constructor is called");
   using meta::ColumnMeta;
   using meta::Nullability;
@@ -196,6 +199,22 @@ SqlResult::Type TableMetadataQuery::Execute() {
   return result;
 }
 
+SqlResult::Type TableMetadataQuery::Prefetch() {
+  LOG_DEBUG_MSG("Prefetch is called");
+  prefetching = true;
+
+  std::vector< std::string > databaseNames;
+  SqlResult::Type result = getMatchedDatabases("%", databaseNames);
+  if (result == SqlResult::AI_SUCCESS) {
+    result = getTablesWithSearchPattern(boost::none);
+  }
+
+  prefetching = false;
+  meta.clear();
+
+  return result;
+}
+
 SqlResult::Type TableMetadataQuery::Cancel() {
   LOG_DEBUG_MSG("Cancel is called");
 
@@ -208,6 +227,16 @@ SqlResult::Type TableMetadataQuery::Cancel() {
   return SqlResult::AI_SUCCESS;
 }
 
+void TableMetadataQuery::Interrupt() {
+  LOG_INFO_MSG("Interrupting table metadata query");
+
+  std::lock_guard< std::mutex > locker(runningMutex_);
+  interrupted_ = true;
+  for (DataQuery* query : runningQueries_) {
+    query->Interrupt();
+  }
+}
+
 const meta::ColumnMetaVector* TableMetadataQuery::GetMeta() {
   return &columnsMeta;
 }
@@ -523,80 +552,240 @@ SqlResult::Type TableMetadataQuery::getMatchedDatabases(
     const std::string& databasePattern,
     std::vector< std::string >& databaseNames) {
   LOG_DEBUG_MSG("getMatchedDatabases is called");
-  std::string sql = "SHOW DATABASES LIKE \'" + databasePattern + "\'";
-  LOG_DEBUG_MSG("sql is " << sql);
+  std::shared_ptr< MetadataCache > cache = connection.GetMetadataCache();
+  std::string identity;
+  std::vector< std::string > names;
+  if (cache) {
+    identity = connection.GetResultCacheIdentity();
+  }
 
-  dataQuery_ = std::make_shared< DataQuery >(diag, connection, sql);
-  SqlResult::Type result = dataQuery_->Execute();
+  if (cache && !prefetching
+      && cache->GetDatabases(identity, databasePattern, names)) {
+    LOG_DEBUG_MSG("Databases are found in the metadata cache");
+  } else {
+    std::string sql = "SHOW DATABASES LIKE "
+                      + utility::QuoteSqlString(databasePattern)
+                      + " ESCAPE '\\'";
+    LOG_DEBUG_MSG("sql is " << sql);
+
+    dataQuery_ = std::make_shared< DataQuery >(diag, connection, sql);
+    if (!beginDataQuery(*dataQuery_, diag)) {
+      return SqlResult::AI_ERROR;
+    }
+    SqlResult::Type result = dataQuery_->Execute();
+
+    if (result == SqlResult::AI_SUCCESS) {
+      app::ColumnBindingMap columnBindings;
+      SqlLen buflen = STRING_BUFFER_SIZE;
+      // According to Trino, table name could only contain
+      // letters, digits, dashes, periods or underscores. It could
+      // not be a unicode string.
+      char databaseName[STRING_BUFFER_SIZE]{};
+      ApplicationDataBuffer buf(OdbcNativeType::Type::AI_CHAR, &databaseName,
+                                buflen, nullptr);
+      columnBindings[1] = buf;
+
+      while (dataQuery_->FetchNextRow(columnBindings)
+             == SqlResult::AI_SUCCESS) {
+        names.emplace_back(std::string(databaseName));
+        LOG_DEBUG_MSG("databaseName: " << databaseName);
+      }
+    }
+
+    // the names of an interrupted query are partial, they are not cached
+    if (!endDataQuery(*dataQuery_, diag)) {
+      return SqlResult::AI_ERROR;
+    }
+    if (result != SqlResult::AI_SUCCESS && result != SqlResult::AI_NO_DATA) {
+      LOG_ERROR_MSG("Failed to execute sql:" << sql);
+      return result;
+    }
 
-  if (result == SqlResult::AI_NO_DATA) {
+    // no match is cached as well
+    if (cache) {
+      cache->PutDatabases(identity, databasePattern, names,
+                          connection.GetConfiguration().GetMetadataCacheTtl());
+    }
+  }
+
+  if (names.empty()) {
     std::string warnMsg =
         "No database is found with pattern \'" + databasePattern + "\'";
     diag.AddStatusRecord(SqlState::S01000_GENERAL_WARNING, warnMsg,
                          trino::odbc::LogLevel::Type::WARNING_LEVEL);
     return SqlResult::AI_SUCCESS_WITH_INFO;
-  } else if (result != SqlResult::AI_SUCCESS) {
-    LOG_ERROR_MSG("Failed to execute sql:" << sql);
-    return result;
-  }
-
-  app::ColumnBindingMap columnBindings;
-  SqlLen buflen = STRING_BUFFER_SIZE;
-  // According to Trino, table name could only contain
-  // letters, digits, dashes, periods or underscores. It could
-  // not be a unicode string.
-  char databaseName[STRING_BUFFER_SIZE]{};
-  ApplicationDataBuffer buf(OdbcNativeType::Type::AI_CHAR, &databaseName,
-                            buflen, nullptr);
-  columnBindings[1] = buf;
-
-  while (dataQuery_->FetchNextRow(columnBindings) == SqlResult::AI_SUCCESS) {
-    databaseNames.emplace_back(std::string(databaseName));
-    LOG_DEBUG_MSG("databaseName: " << databaseName);
   }
 
+  databaseNames.insert(databaseNames.end(), names.begin(), names.end());
   return SqlResult::AI_SUCCESS;
 }
 
 SqlResult::Type TableMetadataQuery::getMatchedTables(
-    const std::string& databaseName, const std::string& tablePattern,
-    std::vector< std::string >& tableNames) {
+    const std::string& condition, std::vector< MetadataCache::Table >& tables,
+    diagnostic::DiagnosableAdapter& queryDiag) {
   LOG_DEBUG_MSG("getMatchedTables is called");
+  // the server filters the tables of all databases at once, so there is one
+  // round trip instead of one SHOW TABLES per database
   std::string sql =
-      "SHOW TABLES FROM \"" + databaseName + "\" LIKE \'" + tablePattern + "\'";
+      "SELECT table_schema, table_name FROM information_schema.tables WHERE "
+      + condition + " ORDER BY table_schema, table_name";
   LOG_DEBUG_MSG("sql is " << sql);
 
-  dataQuery_ = std::make_shared< DataQuery >(diag, connection, sql);
+  dataQuery_ = std::make_shared< DataQuery >(queryDiag, connection, sql);
+  if (!beginDataQuery(*dataQuery_, queryDiag)) {
+    return SqlResult::AI_ERROR;
+  }
   SqlResult::Type result = dataQuery_->Execute();
 
-  if (result == SqlResult::AI_NO_DATA) {
-    std::string warnMsg = "No table is found with pattern \'" + tablePattern
-                          + "\' from database (" + databaseName + ")";
-    diag.AddStatusRecord(SqlState::S01000_GENERAL_WARNING, warnMsg,
-                         trino::odbc::LogLevel::Type::WARNING_LEVEL);
-    return SqlResult::AI_SUCCESS_WITH_INFO;
-    // DataQuery::Execute() does not return SUCCESS_WITH_INFO
-  } else if (result != SqlResult::AI_SUCCESS) {
+  // DataQuery::Execute() does not return SUCCESS_WITH_INFO
+  if (result == SqlResult::AI_SUCCESS) {
+    app::ColumnBindingMap columnBindings;
+    SqlLen buflen = STRING_BUFFER_SIZE;
+    // According to Trino, database and table names could only contain
+    // letters, digits, dashes, periods or underscores. They could
+    // not be unicode strings.
+    char databaseName[STRING_BUFFER_SIZE]{};
+    ApplicationDataBuffer buf1(OdbcNativeType::Type::AI_CHAR, databaseName,
+                               buflen, nullptr);
+    columnBindings[1] = buf1;
+
+    char tableName[STRING_BUFFER_SIZE]{};
+    ApplicationDataBuffer buf2(OdbcNativeType::Type::AI_CHAR, tableName,
+                               buflen, nullptr);
+    columnBindings[2] = buf2;
+
+    while (dataQuery_->FetchNextRow(columnBindings) == SqlResult::AI_SUCCESS) {
+      MetadataCache::Table found;
+      found.database = databaseName;
+      found.name = tableName;
+      tables.push_back(std::move(found));
+    }
+  }
+
+  if (!endDataQuery(*dataQuery_, queryDiag)) {
+    return SqlResult::AI_ERROR;
+  }
+  if (result != SqlResult::AI_SUCCESS && result != SqlResult::AI_NO_DATA) {
     LOG_ERROR_MSG("Failed to execute sql:" << sql);
     return result;
   }
 
-  app::ColumnBindingMap columnBindings;
-  SqlLen buflen = STRING_BUFFER_SIZE;
-  // According to Trino, table name could only contain
-  // letters, digits, dashes, periods or underscores. It could
-  // not be a unicode string.
-  char tableName[STRING_BUFFER_SIZE]{};
-  ApplicationDataBuffer buf(OdbcNativeType::Type::AI_CHAR, &tableName, buflen,
-                            nullptr);
-  columnBindings[1] = buf;
+  LOG_DEBUG_MSG("tables size is " << tables.size());
+  return SqlResult::AI_SUCCESS;
+}
 
-  while (dataQuery_->FetchNextRow(columnBindings) == SqlResult::AI_SUCCESS) {
-    tableNames.emplace_back(std::string(tableName));
-    LOG_DEBUG_MSG("tableName: " << tableName);
+SqlResult::Type TableMetadataQuery::getTablesPerDatabase(
+    const std::string& databasePattern, const std::string& tablePattern,
+    std::vector< MetadataCache::Table >& tables) {
+  LOG_DEBUG_MSG("getTablesPerDatabase is called");
+  std::vector< std::string > databaseNames;
+  SqlResult::Type result = getMatchedDatabases(databasePattern, databaseNames);
+  if (result != SqlResult::AI_SUCCESS) {
+    return result;
   }
 
-  return SqlResult::AI_SUCCESS;
+  /** Outcome of the query of one database. */
+  struct DatabaseTables {
+    /** Table names. */
+    std::vector< std::string > names;
+
+    /** Error message, empty on success. */
+    std::string error;
+  };
+
+  std::vector< DatabaseTables > found(databaseNames.size());
+  FanOut fanOut(connection.GetConfiguration().GetMetadataConcurrency());
+  std::vector< std::string > failures;
+  failures = fanOut.Run(databaseNames.size(), [&](size_t idx) {
+    // every query has its own diagnostics, they are merged in database order
+    diagnostic::DiagnosableAdapter queryDiag(&connection);
+    std::string sql = "SHOW TABLES FROM \"" + databaseNames[idx] + "\" LIKE "
+                      + utility::QuoteSqlString(tablePattern) + " ESCAPE '\\'";
+    LOG_DEBUG_MSG("sql is " << sql);
+
+    DataQuery query(queryDiag, connection, sql);
+    if (!beginDataQuery(query, queryDiag)) {
+      return;
+    }
+    SqlResult::Type queryResult = query.Execute();
+    if (queryResult == SqlResult::AI_SUCCESS) {
+      app::ColumnBindingMap columnBindings;
+      SqlLen buflen = STRING_BUFFER_SIZE;
+      char tableName[STRING_BUFFER_SIZE]{};
+      ApplicationDataBuffer buf(OdbcNativeType::Type::AI_CHAR, tableName,
+                                buflen, nullptr);
+      columnBindings[1] = buf;
+
+      while (query.FetchNextRow(columnBindings) == SqlResult::AI_SUCCESS) {
+        found[idx].names.emplace_back(tableName);
+      }
+    }
+
+    if (!endDataQuery(query, queryDiag)) {
+      return;
+    }
+    if (queryResult != SqlResult::AI_SUCCESS
+        && queryResult != SqlResult::AI_NO_DATA) {
+      const diagnostic::DiagnosticRecordStorage& records =
+          queryDiag.GetDiagnosticRecords();
+      found[idx].error = records.GetStatusRecordsNumber() > 0
+                             ? records.GetStatusRecord(1).GetMessageText()
+                             : "Failed to execute sql: " + sql;
+    }
+  });
+
+  // the partial outcome of a failed task is dropped
+  for (size_t i = 0; i < failures.size(); ++i) {
+    if (!failures[i].empty()) {
+      found[i].error = failures[i];
+    }
+  }
+
+  // the tables of the interrupted databases are missing
+  if (interrupted_) {
+    diag.AddStatusRecord(SqlState::SHY008_OPERATION_CANCELED,
+                         "Operation canceled.");
+    return SqlResult::AI_ERROR;
+  }
+
+  result = SqlResult::AI_SUCCESS;
+  for (size_t i = 0; i < databaseNames.size(); ++i) {
+    if (!found[i].error.empty()) {
+      // the tables of the other databases are still returned
+      std::string warnMsg = "Failed to get the tables of database ("
+                            + databaseNames[i] + "): " + found[i].error;
+      diag.AddStatusRecord(SqlState::S01000_GENERAL_WARNING, warnMsg,
+                           trino::odbc::LogLevel::Type::WARNING_LEVEL);
+      result = SqlResult::AI_SUCCESS_WITH_INFO;
+      continue;
+    }
+
+    for (const std::string& name : found[i].names) {
+      MetadataCache::Table table;
+      table.database = databaseNames[i];
+      table.name = name;
+      tables.push_back(std::move(table));
+    }
+  }
+
+  LOG_DEBUG_MSG("tables size is " << tables.size());
+  return result;
+}
+
+void TableMetadataQuery::addTables(
+    const std::vector< MetadataCache::Table >& tables) {
+  using meta::TableMeta;
+
+  meta.reserve(meta.size() + tables.size());
+  for (const MetadataCache::Table& found : tables) {
+    if (DATABASE_AS_SCHEMA) {
+      meta.emplace_back(TableMeta(std::string(""), found.database, found.name,
+                                  std::string("TABLE")));
+    } else {
+      meta.emplace_back(TableMeta(found.database, std::string(""), found.name,
+                                  std::string("TABLE")));
+    }
+  }
 }
 
 SqlResult::Type TableMetadataQuery::getAllDatabases() {
@@ -637,88 +826,47 @@ SqlResult::Type TableMetadataQuery::getTablesWithIdentifier(
     const std::string& databaseIdentifier) {
   LOG_DEBUG_MSG("getTablesWithIdentifier is called, databaseIdentifier is "
                 << databaseIdentifier);
-
-  std::vector< std::string > databaseNames;
-  SqlResult::Type result = getMatchedDatabases("%", databaseNames);
-
-  if (result != SqlResult::AI_SUCCESS) {
-    LOG_DEBUG_MSG(
-        "getTablesWithIdentifier early exiting with result: " << result);
-    return result;
+  std::shared_ptr< MetadataCache > cache = connection.GetMetadataCache();
+  std::string identity;
+  std::vector< MetadataCache::Table > tables;
+  if (cache) {
+    identity = connection.GetResultCacheIdentity();
   }
 
-  // get all database names, then do filtering based on database name identifier
-  int numDatabases = databaseNames.size();
-  bool match = false;
-  Aws::String databaseUpper =
-      Aws::Utils::StringUtils::ToUpper(databaseIdentifier.data()); /*#*/
-
-  std::string databaseName("");
-  for (int i = 0; i < numDatabases; i++) {
-    databaseName = databaseNames.at(i);
-    Aws::String dbNameUpper =
-        Aws::Utils::StringUtils::ToUpper(databaseName.data()); /*#*/
-    match = (databaseUpper == dbNameUpper);
-
-    if (match) {
-      break;
+  if (cache
+      && cache->GetTablesByName(identity, databaseIdentifier, table.get(),
+                                tables)) {
+    LOG_DEBUG_MSG("Tables are found in the metadata cache");
+  } else {
+    // identifiers are case-insensitive, so the names are compared by the
+    // server in lower case
+    SqlResult::Type result = getMatchedTables(
+        "lower(table_schema) = lower("
+            + utility::QuoteSqlString(databaseIdentifier)
+            + ") AND lower(table_name) = lower("
+            + utility::QuoteSqlString(table.get()) + ")",
+        tables, diag);
+    if (result != SqlResult::AI_SUCCESS) {
+      LOG_DEBUG_MSG(
+          "getTablesWithIdentifier early exiting with result: " << result);
+      return result;
     }
-  }
 
-  // no matched database
-  if (!match) {
-    std::string warnMsg = "No matched database for " + databaseIdentifier;
-    diag.AddStatusRecord(SqlState::S01000_GENERAL_WARNING, warnMsg,
-                         trino::odbc::LogLevel::Type::WARNING_LEVEL);
-    return SqlResult::AI_SUCCESS_WITH_INFO;
-  }
-
-  // retrieve tables using database name
-  std::vector< std::string > tableNames;
-  SqlResult::Type res = getMatchedTables(databaseName, "%", tableNames);
-
-  if (res != SqlResult::AI_SUCCESS && res != SqlResult::AI_SUCCESS_WITH_INFO) {
-    LOG_DEBUG_MSG("getTablesWithIdentifier early exiting with result: " << res);
-    return res;
-  }
-
-  // get all database names, then do filtering based on database name
-  // identifier
-  int numTables = tableNames.size();
-  LOG_DEBUG_MSG("numTables is " << numTables << " for database "
-                                << databaseName);
-  for (int j = 0; j < numTables; j++) {
-    using meta::TableMeta;
-
-    // Check exact match for table name case-insensitive identifier
-    std::string foundTableName = tableNames.at(j);
-    Aws::String tableUpper =
-        Aws::Utils::StringUtils::ToUpper(table.get().data()); /*#*/
-    Aws::String tbNameUpper =
-        Aws::Utils::StringUtils::ToUpper(foundTableName.data()); /*#*/
-    match = (tableUpper == tbNameUpper);
-
-    if (match) {
-      if (DATABASE_AS_SCHEMA) {
-        meta.emplace_back(TableMeta(std::string(""), databaseName,
-                                    std::string(foundTableName),
-                                    std::string("TABLE")));
-      } else {
-        meta.emplace_back(TableMeta(databaseName, std::string(""),
-                                    std::string(foundTableName),
-                                    std::string("TABLE")));
-      }
-      LOG_DEBUG_MSG("Found matched table for " << databaseName << "."
-                                               << table.get());
+    // no match is cached as well
+    if (cache) {
+      cache->PutTablesByName(
+          identity, databaseIdentifier, table.get(), tables,
+          connection.GetConfiguration().GetMetadataCacheTtl());
     }
   }
 
+  addTables(tables);
   LOG_DEBUG_MSG("meta size is " << meta.size());
 
   if (meta.empty()) {
     std::string warnMsg =
         "Empty result set is returned as we could not find tables with "
-        + databaseName + "." + table.get();
+        + databaseIdentifier + "." + table.get();
     diag.AddStatusRecord(SqlState::S01000_GENERAL_WARNING, warnMsg,
                          trino::odbc::LogLevel::Type::WARNING_LEVEL);
     return SqlResult::AI_SUCCESS_WITH_INFO;
@@ -730,70 +878,93 @@ SqlResult::Type TableMetadataQuery::getTablesWithIdentifier(
 SqlResult::Type TableMetadataQuery::getTablesWithSearchPattern(
     const boost::optional< std::string >& databasePattern) {
   LOG_DEBUG_MSG("getTablesWithSearchPattern is called");
-  std::vector< std::string > databaseNames;
-  SqlResult::Type result =
-      getMatchedDatabases(databasePattern.get_value_or("%"), databaseNames);
-
-  LOG_DEBUG_MSG("databasePattern is " << databasePattern.get_value_or("%")
-                                      << ", databaseNames size is "
-                                      << databaseNames.size());
-  if (result != SqlResult::AI_SUCCESS) {
-    LOG_DEBUG_MSG(
-        "getTablesWithSearchPattern early exiting with result: " << result);
-    return result;
+  std::string databaseFilter = databasePattern.get_value_or("%");
+  std::string tableFilter = table.get_value_or("%");
+  LOG_DEBUG_MSG("databasePattern is " << databaseFilter
+                                      << ", tablePattern is " << tableFilter);
+
+  std::shared_ptr< MetadataCache > cache = connection.GetMetadataCache();
+  std::string identity;
+  std::vector< MetadataCache::Table > tables;
+  if (cache) {
+    identity = connection.GetResultCacheIdentity();
   }
 
-  int numDatabases = databaseNames.size();
-
-  for (int i = 0; i < numDatabases; i++) {
-    std::string databaseName = databaseNames.at(i);
-
-    // retrieve tables using database name
-    std::vector< std::string > tableNames;
-    SqlResult::Type res =
-        getMatchedTables(databaseName, table.get_value_or("%"), tableNames);
+  SqlResult::Type result = SqlResult::AI_SUCCESS;
+  if (cache && !prefetching
+      && cache->GetTables(identity, databaseFilter, tableFilter, tables)) {
+    LOG_DEBUG_MSG("Tables are found in the metadata cache");
+  } else {
+    diagnostic::DiagnosableAdapter catalogDiag(&connection);
+    result = getMatchedTables(
+        "table_schema LIKE " + utility::QuoteSqlString(databaseFilter)
+            + " ESCAPE '\\' AND table_name LIKE "
+            + utility::QuoteSqlString(tableFilter) + " ESCAPE '\\'",
+        tables, catalogDiag);
+    if (result != SqlResult::AI_SUCCESS) {
+      LOG_WARNING_MSG(
+          "information_schema.tables could not be read, falling back to SHOW "
+          "TABLES per database");
+      tables.clear();
+      result = getTablesPerDatabase(databaseFilter, tableFilter, tables);
+    }
 
-    if (res != SqlResult::AI_SUCCESS
-        && res != SqlResult::AI_SUCCESS_WITH_INFO) {
-      LOG_DEBUG_MSG("getMatchedTables returns " << res << " for database "
-                                                << databaseName);
-      return res;
+    if (result != SqlResult::AI_SUCCESS
+        && result != SqlResult::AI_SUCCESS_WITH_INFO) {
+      LOG_DEBUG_MSG(
+          "getTablesWithSearchPattern early exiting with result: " << result);
+      return result;
     }
 
-    int numTables = tableNames.size();
-    LOG_DEBUG_MSG("tableNames size is " << numTables << " for database "
-                                        << databaseName);
-    for (int j = 0; j < numTables; j++) {
-      using meta::TableMeta;
-
-      std::string foundTableName = tableNames.at(j);
-      if (DATABASE_AS_SCHEMA) {
-        meta.emplace_back(TableMeta(std::string(""), databaseName,
-                                    std::string(foundTableName),
-                                    std::string("TABLE")));
-      } else {
-        meta.emplace_back(TableMeta(databaseName, std::string(""),
-                                    std::string(foundTableName),
-                                    std::string("TABLE")));
-      }
-      LOG_DEBUG_MSG("Found matched table for " << databaseName << "."
-                                               << foundTableName);
+    // no match is cached as well, partial results are not
+    if (cache && result == SqlResult::AI_SUCCESS) {
+      cache->PutTables(identity, databaseFilter, tableFilter, tables,
+                       connection.GetConfiguration().GetMetadataCacheTtl());
     }
   }
 
+  addTables(tables);
   LOG_DEBUG_MSG("meta size is " << meta.size());
 
   if (meta.empty()) {
     std::string warnMsg =
         "Empty result set is returned as we could not find tables for database "
         "pattern "
-        + databasePattern.get_value_or("%");
+        + databaseFilter;
     diag.AddStatusRecord(SqlState::S01000_GENERAL_WARNING, warnMsg,
                          trino::odbc::LogLevel::Type::WARNING_LEVEL);
     return SqlResult::AI_SUCCESS_WITH_INFO;
   }
 
-  return SqlResult::AI_SUCCESS;
+  return result;
+}
+
+bool TableMetadataQuery::beginDataQuery(
+    DataQuery& query, diagnostic::DiagnosableAdapter& queryDiag) {
+  std::lock_guard< std::mutex > locker(runningMutex_);
+  if (interrupted_) {
+    queryDiag.AddStatusRecord(SqlState::SHY008_OPERATION_CANCELED,
+                              "Operation canceled.");
+    return false;
+  }
+
+  runningQueries_.insert(&query);
+  return true;
+}
+
+bool TableMetadataQuery::endDataQuery(
+    DataQuery& query, diagnostic::DiagnosableAdapter& queryDiag) {
+  std::lock_guard< std::mutex > locker(runningMutex_);
+  runningQueries_.erase(&query);
+
+  // an interruption during Execute() may not reach the server query, the
+  // flag is what tells
+  if (interrupted_) {
+    queryDiag.AddStatusRecord(SqlState::SHY008_OPERATION_CANCELED,
+                              "Operation canceled.");
+    return false;
+  }
+  return true;
 }
 
 std::string TableMetadataQuery::dequote(const std::string& s) {
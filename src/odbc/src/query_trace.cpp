@@ -0,0 +1,250 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "trino/odbc/query_trace.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+#include "trino/odbc/log.h"
+
+namespace {
+/**
+ * Convert a duration to whole microseconds.
+ *
+ * @param d Duration.
+ * @return Microseconds.
+ */
+int64_t Micros(trino::odbc::QueryTrace::Clock::duration d) {
+  return std::chrono::duration_cast< std::chrono::microseconds >(d).count();
+}
+
+/**
+ * Write a string as a quoted JSON string.
+ *
+ * @param out Stream.
+ * @param value String, expected to be UTF-8.
+ */
+void WriteJsonString(std::ostream& out, const std::string& value) {
+  out << '"';
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      case '\n':
+        out << "\\n";
+        break;
+      case '\r':
+        out << "\\r";
+        break;
+      case '\t':
+        out << "\\t";
+        break;
+      default:
+        if (static_cast< unsigned char >(c) < 0x20) {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x",
+                        static_cast< unsigned int >(c));
+          out << escaped;
+        } else {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+}
+
+/** Serializes writes of all statements to the trace files. */
+std::mutex traceFileMutex;
+}  // namespace
+
+namespace trino {
+namespace odbc {
+const size_t QueryTrace::MAX_LISTED_PAGES = 1000;
+
+QueryTrace::QueryTrace(const std::string& sql)
+    : sql_(sql),
+      queryId_(),
+      source_("server"),
+      error_(),
+      started_(std::chrono::system_clock::now()),
+      start_(Clock::now()),
+      firstResponse_(Clock::duration::zero()),
+      execute_(Clock::duration::zero()),
+      total_(Clock::duration::zero()),
+      close_(Clock::duration::zero()),
+      pages_(),
+      pageCount_(0),
+      rows_(0),
+      bytes_(0),
+      fetch_(Clock::duration::zero()),
+      decode_(Clock::duration::zero()),
+      wait_(Clock::duration::zero()),
+      conversion_(),
+      fetchCalls_(0),
+      fetchCallTime_(Clock::duration::zero()),
+      complete_(false) {
+  // No-op.
+}
+
+void QueryTrace::SetQueryId(const std::string& queryId) {
+  queryId_ = queryId;
+}
+
+void QueryTrace::SetSource(const std::string& source) {
+  source_ = source;
+}
+
+void QueryTrace::FirstResponse() {
+  if (firstResponse_ == Clock::duration::zero()) {
+    firstResponse_ = Clock::now() - start_;
+  }
+}
+
+void QueryTrace::Executed() {
+  execute_ = Clock::now() - start_;
+}
+
+void QueryTrace::AddPage(size_t rows, uint64_t bytes, Clock::duration fetch,
+                         Clock::duration decode) {
+  ++pageCount_;
+  rows_ += rows;
+  bytes_ += bytes;
+  fetch_ += fetch;
+  decode_ += decode;
+
+  if (pages_.size() < MAX_LISTED_PAGES) {
+    Page page;
+    page.rows = rows;
+    page.fetch = fetch;
+    page.decode = decode;
+    pages_.push_back(page);
+  }
+}
+
+void QueryTrace::AddWait(Clock::duration wait) {
+  wait_ += wait;
+}
+
+void QueryTrace::AddConversion(uint16_t columnIdx, Clock::duration time) {
+  if (columnIdx == 0) {
+    return;
+  }
+  if (conversion_.size() < columnIdx) {
+    conversion_.resize(columnIdx, Clock::duration::zero());
+  }
+  conversion_[columnIdx - 1] += time;
+}
+
+void QueryTrace::AddFetchCall(Clock::duration time) {
+  ++fetchCalls_;
+  fetchCallTime_ += time;
+}
+
+void QueryTrace::SetError(const std::string& error) {
+  error_ = error;
+}
+
+void QueryTrace::Finish(bool complete, Clock::duration close) {
+  complete_ = complete;
+  close_ = close;
+  total_ = Clock::now() - start_;
+}
+
+std::string QueryTrace::ToJson() const {
+  // whatever is neither driver work nor closing is the application's time
+  Clock::duration application = total_ - execute_ - fetchCallTime_ - close_;
+  if (application < Clock::duration::zero()) {
+    application = Clock::duration::zero();
+  }
+
+  std::ostringstream out;
+  out << "{\"startMs\":"
+      << std::chrono::duration_cast< std::chrono::milliseconds >(
+             started_.time_since_epoch())
+             .count();
+  out << ",\"queryId\":";
+  WriteJsonString(out, queryId_);
+  out << ",\"source\":";
+  WriteJsonString(out, source_);
+  out << ",\"status\":\""
+      << (!error_.empty() ? "failed" : (complete_ ? "complete" : "closed"))
+      << "\"";
+  if (!error_.empty()) {
+    out << ",\"error\":";
+    WriteJsonString(out, error_);
+  }
+  out << ",\"sql\":";
+  WriteJsonString(out, sql_);
+  out << ",\"rows\":" << rows_ << ",\"bytes\":" << bytes_
+      << ",\"pageCount\":" << pageCount_
+      << ",\"firstResponseUs\":" << Micros(firstResponse_)
+      << ",\"executeUs\":" << Micros(execute_)
+      << ",\"fetchUs\":" << Micros(fetch_)
+      << ",\"decodeUs\":" << Micros(decode_)
+      << ",\"waitUs\":" << Micros(wait_) << ",\"conversionUs\":[";
+  for (size_t i = 0; i < conversion_.size(); ++i) {
+    out << (i > 0 ? "," : "") << Micros(conversion_[i]);
+  }
+  out << "],\"fetchCalls\":" << fetchCalls_
+      << ",\"driverFetchUs\":" << Micros(fetchCallTime_)
+      << ",\"applicationUs\":" << Micros(application)
+      << ",\"closeUs\":" << Micros(close_)
+      << ",\"totalUs\":" << Micros(total_) << ",\"pages\":[";
+  for (size_t i = 0; i < pages_.size(); ++i) {
+    out << (i > 0 ? "," : "") << "{\"rows\":" << pages_[i].rows
+        << ",\"fetchUs\":" << Micros(pages_[i].fetch)
+        << ",\"decodeUs\":" << Micros(pages_[i].decode) << "}";
+  }
+  out << "]}";
+
+  return out.str();
+}
+
+bool QueryTrace::Write(const std::string& path) const {
+  std::string record = ToJson();
+  record += '\n';
+
+  // records of concurrent statements must not interleave
+  std::lock_guard< std::mutex > lock(traceFileMutex);
+  std::ofstream file(path, std::ios::out | std::ios::app | std::ios::binary);
+  if (!file.is_open()) {
+    LOG_ERROR_MSG("Failed to open query trace file " << path);
+    return false;
+  }
+
+  file.write(record.data(), record.size());
+  file.flush();
+  if (!file) {
+    LOG_ERROR_MSG("Failed to write to query trace file " << path);
+    return false;
+  }
+
+  return true;
+}
+}  // namespace odbc
+}  // namespace trino
@@ -0,0 +1,446 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "trino/odbc/result_cache.h"
+
+#ifdef _WIN32
+#include "trino/odbc/system/odbc_constants.h"
+#else
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+
+#include "trino/odbc/log.h"
+#include "trino/odbc/metrics.h"
+#include "trino/odbc/spill_store.h"
+
+namespace {
+/** Share of the cache one entry may take at most. */
+const uint64_t ENTRY_LIMIT_DIVISOR = 4;
+
+/** Leading keywords of the queries that only read data. */
+const char* const READ_KEYWORDS[] = {"select", "with", "values", "show",
+                                     "describe"};
+
+/**
+ * Create a new file in the directory.
+ *
+ * @param dir Directory.
+ * @param path Path of the created file.
+ * @return Open file or nullptr on failure.
+ */
+std::FILE* CreateCacheFile(const std::string& dir, std::string& path) {
+#ifdef _WIN32
+  char name[MAX_PATH + 1];
+  if (GetTempFileNameA(dir.c_str(), "trc", 0, name) == 0) {
+    return nullptr;
+  }
+
+  path = name;
+  return fopen(name, "wb");
+#else
+  std::string pattern = dir + "/trino-odbc-cache-XXXXXX";
+  std::vector< char > name(pattern.begin(), pattern.end());
+  name.push_back('\0');
+
+  int fd = mkstemp(name.data());
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  path = name.data();
+  std::FILE* file = fdopen(fd, "wb");
+  if (!file) {
+    close(fd);
+    std::remove(path.c_str());
+  }
+  return file;
+#endif
+}
+}  // namespace
+
+namespace trino {
+namespace odbc {
+ResultCache::Entry::Entry(const meta::ColumnMetaVector& meta)
+    : meta_(meta), pages_(), data_(), size_(0), path_() {
+  // No-op.
+}
+
+ResultCache::Entry::~Entry() {
+  if (!path_.empty()) {
+    std::remove(path_.c_str());
+  }
+}
+
+void ResultCache::Entry::AddPage(const PageArena& arena) {
+  std::vector< char > chunk;
+  if (SpillStore::EncodeChunk(arena, SIZE_MAX, chunk) == 0) {
+    return;
+  }
+
+  Page page;
+  page.offset = data_.size();
+  page.size = chunk.size();
+  pages_.push_back(page);
+
+  data_.insert(data_.end(), chunk.begin(), chunk.end());
+  size_ += page.size;
+}
+
+bool ResultCache::Entry::ReadPage(size_t pageIdx, PageArena& arena) const {
+  if (pageIdx >= pages_.size()) {
+    return false;
+  }
+
+  const Page& page = pages_[pageIdx];
+  if (path_.empty()) {
+    return SpillStore::DecodeChunk(data_.data() + page.offset,
+                                   static_cast< size_t >(page.size), arena);
+  }
+
+  std::FILE* file = std::fopen(path_.c_str(), "rb");
+  if (!file) {
+    LOG_ERROR_MSG("Failed to open result cache file " << path_);
+    return false;
+  }
+
+  std::vector< char > chunk(static_cast< size_t >(page.size));
+  bool read = std::fseek(file, static_cast< long >(page.offset), SEEK_SET) == 0
+              && std::fread(chunk.data(), 1, chunk.size(), file)
+                     == chunk.size();
+  std::fclose(file);
+
+  if (!read) {
+    LOG_ERROR_MSG("Failed to read " << page.size
+                                    << " bytes from result cache file "
+                                    << path_);
+    return false;
+  }
+
+  return SpillStore::DecodeChunk(chunk.data(), chunk.size(), arena);
+}
+
+std::shared_ptr< const ResultCache::Entry > ResultCache::Entry::Spill(
+    const std::string& dir) const {
+  std::shared_ptr< Entry > spilled = std::make_shared< Entry >(meta_);
+
+  std::FILE* file = CreateCacheFile(dir, spilled->path_);
+  if (!file) {
+    LOG_ERROR_MSG("Failed to create result cache file in " << dir);
+    return nullptr;
+  }
+
+  bool written =
+      std::fwrite(data_.data(), 1, data_.size(), file) == data_.size();
+  if (std::fclose(file) != 0 || !written) {
+    // the destructor of the new entry removes the file
+    LOG_ERROR_MSG("Failed to write " << data_.size()
+                                     << " bytes to result cache file "
+                                     << spilled->path_);
+    return nullptr;
+  }
+
+  spilled->pages_ = pages_;
+  spilled->size_ = size_;
+  return spilled;
+}
+
+ResultCache::ResultCache()
+    : limit_(0),
+      dir_(),
+      memoryUsage_(0),
+      diskUsage_(0),
+      hits_(0),
+      misses_(0),
+      stores_(0),
+      evictions_(0),
+      slots_(),
+      index_(),
+      mutex_() {
+  // No-op.
+}
+
+ResultCache::~ResultCache() {
+  Clear();
+}
+
+void ResultCache::Reserve(uint64_t limit, const std::string& dir) {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  limit_ = std::max(limit_, limit);
+  if (dir_.empty()) {
+    dir_ = dir;
+  }
+
+  LOG_DEBUG_MSG("Result cache limit is " << limit_ << " bytes, directory is '"
+                                         << dir_ << "'");
+}
+
+uint64_t ResultCache::GetEntryLimit() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  return limit_ / ENTRY_LIMIT_DIVISOR;
+}
+
+std::shared_ptr< const ResultCache::Entry > ResultCache::Get(
+    const std::string& key) {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++misses_;
+    Metrics::GetInstance().resultCacheMisses.Add();
+    return nullptr;
+  }
+
+  if (it->second->expiry <= std::chrono::steady_clock::now()) {
+    LOG_DEBUG_MSG("Cached result is expired");
+    EraseLocked(it->second);
+    ++misses_;
+    Metrics::GetInstance().resultCacheMisses.Add();
+    return nullptr;
+  }
+
+  ++hits_;
+  Metrics::GetInstance().resultCacheHits.Add();
+  slots_.splice(slots_.begin(), slots_, it->second);
+
+  return slots_.front().entry;
+}
+
+void ResultCache::Put(const std::string& key,
+                      std::shared_ptr< const Entry > entry, int32_t ttl) {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  if (entry->GetSize() > limit_ / ENTRY_LIMIT_DIVISOR) {
+    LOG_DEBUG_MSG("Result of " << entry->GetSize()
+                               << " bytes is too large to be cached");
+    return;
+  }
+
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    // stored by another statement while this one was fetching
+    EraseLocked(it->second);
+  }
+
+  Slot slot;
+  slot.key = key;
+  slot.entry = std::move(entry);
+  slot.expiry = std::chrono::steady_clock::now() + std::chrono::seconds(ttl);
+
+  memoryUsage_ += slot.entry->GetSize();
+  slots_.push_front(std::move(slot));
+  index_[key] = slots_.begin();
+  ++stores_;
+
+  EvictLocked();
+}
+
+void ResultCache::Clear() {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  index_.clear();
+  slots_.clear();
+  memoryUsage_ = 0;
+  diskUsage_ = 0;
+}
+
+size_t ResultCache::GetSize() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  return slots_.size();
+}
+
+uint64_t ResultCache::GetMemoryUsage() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  return memoryUsage_;
+}
+
+uint64_t ResultCache::GetDiskUsage() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  return diskUsage_;
+}
+
+int64_t ResultCache::GetHitCount() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  return hits_;
+}
+
+int64_t ResultCache::GetMissCount() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  return misses_;
+}
+
+int64_t ResultCache::GetStoreCount() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  return stores_;
+}
+
+int64_t ResultCache::GetEvictionCount() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  return evictions_;
+}
+
+void ResultCache::EraseLocked(std::list< Slot >::iterator slot) {
+  if (slot->entry->IsOnDisk()) {
+    diskUsage_ -= slot->entry->GetSize();
+  } else {
+    memoryUsage_ -= slot->entry->GetSize();
+  }
+
+  index_.erase(slot->key);
+  slots_.erase(slot);
+}
+
+void ResultCache::EvictLocked() {
+  auto it = slots_.end();
+  while (memoryUsage_ > limit_ && it != slots_.begin()) {
+    --it;
+    if (it->entry->IsOnDisk()) {
+      continue;
+    }
+
+    std::shared_ptr< const Entry > spilled;
+    if (!dir_.empty()) {
+      spilled = it->entry->Spill(dir_);
+    }
+
+    if (spilled) {
+      LOG_DEBUG_MSG("Moving cached result of " << spilled->GetSize()
+                                               << " bytes to " << dir_);
+      memoryUsage_ -= spilled->GetSize();
+      diskUsage_ += spilled->GetSize();
+      it->entry = std::move(spilled);
+    } else {
+      LOG_DEBUG_MSG("Evicting cached result of " << it->entry->GetSize()
+                                                 << " bytes");
+      auto evicted = it++;
+      EraseLocked(evicted);
+      ++evictions_;
+    }
+  }
+
+  it = slots_.end();
+  while (diskUsage_ > limit_ && it != slots_.begin()) {
+    --it;
+    if (!it->entry->IsOnDisk()) {
+      continue;
+    }
+
+    LOG_DEBUG_MSG("Evicting cached result of " << it->entry->GetSize()
+                                               << " bytes from " << dir_);
+    auto evicted = it++;
+    EraseLocked(evicted);
+    ++evictions_;
+  }
+}
+
+std::string ResultCache::NormalizeSql(const std::string& sql) {
+  std::string normalized;
+  normalized.reserve(sql.size());
+
+  bool blank = false;
+  size_t i = 0;
+  while (i < sql.size()) {
+    char c = sql[i];
+
+    if (c == '-' && i + 1 < sql.size() && sql[i + 1] == '-') {
+      i = sql.find('\n', i);
+      i = i == std::string::npos ? sql.size() : i;
+      blank = true;
+      continue;
+    }
+
+    if (c == '/' && i + 1 < sql.size() && sql[i + 1] == '*') {
+      i = sql.find("*/", i + 2);
+      i = i == std::string::npos ? sql.size() : i + 2;
+      blank = true;
+      continue;
+    }
+
+    if (std::isspace(static_cast< unsigned char >(c))) {
+      ++i;
+      blank = true;
+      continue;
+    }
+
+    if (blank && !normalized.empty()) {
+      normalized.push_back(' ');
+    }
+    blank = false;
+
+    if (c == '\'' || c == '"') {
+      // quoted text is kept as is, doubled quotes included
+      size_t end = sql.find(c, i + 1);
+      while (end != std::string::npos && end + 1 < sql.size()
+             && sql[end + 1] == c) {
+        end = sql.find(c, end + 2);
+      }
+      end = end == std::string::npos ? sql.size() : end + 1;
+      normalized.append(sql, i, end - i);
+      i = end;
+      continue;
+    }
+
+    normalized.push_back(c);
+    ++i;
+  }
+
+  return normalized;
+}
+
+bool ResultCache::IsCacheable(const std::string& sql) {
+  size_t end = 0;
+  while (end < sql.size()
+         && std::isalpha(static_cast< unsigned char >(sql[end]))) {
+    ++end;
+  }
+
+  std::string keyword = sql.substr(0, end);
+  std::transform(keyword.begin(), keyword.end(), keyword.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+
+  for (const char* read : READ_KEYWORDS) {
+    if (keyword == read) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::string ResultCache::MakeKey(const std::string& sql,
+                                 const std::string& identity) {
+  // the separator does not occur in the identity fields
+  return identity + '\0' + sql;
+}
+}  // namespace odbc
+}  // namespace trino
@@ -0,0 +1,328 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "trino/odbc/shared_query.h"
+
+#include <algorithm>
+
+#include "trino/odbc/log.h"
+#include "trino/odbc/metrics.h"
+#include "trino/odbc/tracer.h"
+#include "trino/odbc/worker_pool.h"
+
+/*#*/
+#include <aws/trino-query/model/CancelQueryRequest.h>
+#include <aws/trino-query/model/QueryResult.h>
+
+namespace trino {
+namespace odbc {
+SharedQuery::SharedQuery(
+    std::shared_ptr< client::TrinoQuery::TrinoQueryClient > client) /*#*/
+    : client_(std::move(client)),
+      request_(),
+      pool_(),
+      meta_(),
+      queryId_(),
+      nextToken_(),
+      pages_(),
+      readers_(),
+      nextReader_(0),
+      started_(false),
+      abandoned_(false),
+      finished_(false),
+      fetching_(false),
+      joinable_(true),
+      error_(),
+      mutex_(),
+      cv_() {
+  // No-op.
+}
+
+bool SharedQuery::Attach(size_t& reader) {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  if (!joinable_ || abandoned_) {
+    return false;
+  }
+
+  reader = nextReader_++;
+  readers_[reader] = 0;
+
+  return true;
+}
+
+void SharedQuery::Detach(size_t reader) {
+  std::string queryId;
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+
+    readers_.erase(reader);
+    if (!started_ && reader == 0) {
+      LOG_DEBUG_MSG("Shared query is abandoned before it started");
+      abandoned_ = true;
+      finished_ = true;
+    } else if (started_ && readers_.empty() && !finished_) {
+      // nobody is going to read the rest of the result set
+      finished_ = true;
+      queryId = queryId_;
+    }
+
+    if (readers_.empty()) {
+      joinable_ = false;
+    }
+
+    TrimLocked();
+    cv_.notify_all();
+  }
+
+  if (queryId.empty()) {
+    return;
+  }
+
+  LOG_DEBUG_MSG("Cancelling shared query " << queryId);
+  std::shared_ptr< client::TrinoQuery::TrinoQueryClient > client = /*#*/
+      client_;
+  WorkerPool::GetRequestInstance().Submit([client, queryId]() {
+    client::TrinoQuery::Model::CancelQueryRequest request; /*#*/
+    request.SetQueryId(queryId);
+    client->CancelQuery(request);
+  });
+}
+
+void SharedQuery::Start(
+    const client::TrinoQuery::Model::QueryRequest& request, /*#*/
+    const meta::ColumnMetaVector& meta,
+    std::shared_ptr< const ResultPage > first, const std::string& queryId,
+    std::shared_ptr< PageArenaPool > pool) {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  request_ = request;
+  meta_ = meta;
+  pool_ = std::move(pool);
+  queryId_ = queryId;
+  nextToken_ = first->GetNextToken();
+  pages_.push_back(std::move(first));
+  started_ = true;
+  finished_ = nextToken_.empty();
+
+  // the first reader already holds the first page
+  readers_[0] = 1;
+  if (!finished_) {
+    FetchLocked();
+  }
+
+  TrimLocked();
+  cv_.notify_all();
+}
+
+SharedQuery::Outcome::Type SharedQuery::WaitStarted(
+    const std::function< bool() >& stop) {
+  std::unique_lock< std::mutex > lock(mutex_);
+
+  cv_.wait(lock, [&]() { return started_ || abandoned_ || stop(); });
+
+  if (started_) {
+    return Outcome::PAGE;
+  }
+
+  return abandoned_ ? Outcome::ABANDONED : Outcome::STOPPED;
+}
+
+SharedQuery::Outcome::Type SharedQuery::GetPage(
+    size_t reader, size_t pageIdx, std::shared_ptr< const ResultPage >& page,
+    std::string& error, const std::function< bool() >& stop) {
+  std::unique_lock< std::mutex > lock(mutex_);
+
+  cv_.wait(lock, [&]() {
+    return pageIdx < pages_.size() || finished_ || stop();
+  });
+
+  if (pageIdx < pages_.size()) {
+    page = pages_[pageIdx];
+    readers_[reader] = pageIdx + 1;
+    TrimLocked();
+
+    // keep one page ahead of the fastest reader
+    if (pageIdx + 1 == pages_.size() && !finished_ && !fetching_) {
+      FetchLocked();
+    }
+
+    return Outcome::PAGE;
+  }
+
+  if (!finished_) {
+    return Outcome::STOPPED;
+  }
+
+  if (!error_.empty()) {
+    error = error_;
+    return Outcome::FAILED;
+  }
+
+  return Outcome::END;
+}
+
+void SharedQuery::Wake() {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  cv_.notify_all();
+}
+
+size_t SharedQuery::GetReaderCount() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  return readers_.size();
+}
+
+void SharedQuery::FetchLocked() {
+  fetching_ = true;
+  request_.SetNextToken(nextToken_);
+
+  // the task keeps the query alive until the page arrives
+  std::shared_ptr< SharedQuery > self = shared_from_this();
+  client::TrinoQuery::Model::QueryRequest request = request_; /*#*/
+  WorkerPool::GetRequestInstance().Submit(
+      [self, request]() { self->Fetch(request); });
+}
+
+void SharedQuery::Fetch(
+    client::TrinoQuery::Model::QueryRequest request) { /*#*/
+  std::shared_ptr< const ResultPage > page;
+  std::string token;
+  std::string error;
+
+  while (true) {
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    client::TrinoQuery::Model::QueryOutcome outcome = /*#*/
+        client_->Query(request);
+    std::chrono::steady_clock::time_point received =
+        std::chrono::steady_clock::now();
+    std::chrono::steady_clock::duration fetch = received - start;
+    Tracer::GetInstance().Complete("fetch page", "fetch", start, received);
+    if (!outcome.IsSuccess()) {
+      auto& err = outcome.GetError();
+      error = err.GetExceptionName() + ": " + err.GetMessage();
+      break;
+    }
+
+    const client::TrinoQuery::Model::QueryResult& result = /*#*/
+        outcome.GetResult();
+    token = result.GetNextToken();
+    if (!result.GetRows().empty()) {
+      page = pool_->DecodePage(result.GetRows(), meta_, token);
+      Metrics::GetInstance().RecordPage(fetch, page->GetArena().GetUsedBytes());
+      break;
+    }
+    Metrics::GetInstance().RecordPage(fetch, 0);
+
+    std::lock_guard< std::mutex > lock(mutex_);
+    if (token.empty() || finished_) {
+      break;
+    }
+    request.SetNextToken(token);
+  }
+
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  fetching_ = false;
+  if (finished_) {
+    LOG_DEBUG_MSG("Shared query is finished, fetched page is dropped");
+  } else if (!error.empty()) {
+    LOG_ERROR_MSG("ERROR: " << error << " for shared query " << queryId_);
+    error_ = error;
+    finished_ = true;
+  } else {
+    if (page) {
+      pages_.push_back(std::move(page));
+    }
+
+    nextToken_ = token;
+    finished_ = token.empty();
+    if (pages_.size() > MAX_RETAINED_PAGES) {
+      joinable_ = false;
+    }
+    TrimLocked();
+  }
+
+  cv_.notify_all();
+}
+
+void SharedQuery::TrimLocked() {
+  // late readers start from the first page, so it is kept while they may
+  // still attach
+  if (joinable_) {
+    return;
+  }
+
+  size_t next = pages_.size();
+  for (const auto& reader : readers_) {
+    next = std::min(next, reader.second);
+  }
+
+  for (size_t i = 0; i < next; ++i) {
+    pages_[i].reset();
+  }
+}
+
+SharedQueryRegistry::SharedQueryRegistry() : queries_(), merged_(0), mutex_() {
+  // No-op.
+}
+
+std::shared_ptr< SharedQuery > SharedQueryRegistry::Join(
+    const std::string& key,
+    std::shared_ptr< client::TrinoQuery::TrinoQueryClient > client, /*#*/
+    size_t& reader, bool& leader) {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  for (auto it = queries_.begin(); it != queries_.end();) {
+    if (it->second.expired()) {
+      it = queries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  auto it = queries_.find(key);
+  if (it != queries_.end()) {
+    std::shared_ptr< SharedQuery > query = it->second.lock();
+    if (query && query->Attach(reader)) {
+      ++merged_;
+      leader = false;
+      return query;
+    }
+  }
+
+  std::shared_ptr< SharedQuery > query =
+      std::make_shared< SharedQuery >(std::move(client));
+  query->Attach(reader);
+  queries_[key] = query;
+  leader = true;
+
+  return query;
+}
+
+int64_t SharedQueryRegistry::GetMergedCount() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  return merged_;
+}
+}  // namespace odbc
+}  // namespace trino
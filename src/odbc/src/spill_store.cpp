@@ -0,0 +1,343 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "trino/odbc/spill_store.h"
+
+#ifdef _WIN32
+#include <io.h>
+
+#include "trino/odbc/system/odbc_constants.h"
+#else
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "trino/odbc/log.h"
+
+namespace {
+/** Size of the chunk header: row count and column count. */
+const size_t CHUNK_HEADER_SIZE = 2 * sizeof(uint32_t);
+
+/** Chunks start at offsets aligned to this value. */
+const size_t CHUNK_ALIGNMENT = 8;
+}  // namespace
+
+namespace trino {
+namespace odbc {
+SpillStore::SpillStore()
+    : file_(nullptr),
+      mapping_(nullptr),
+      mapped_(nullptr),
+      mappedSize_(0),
+      fileSize_(0),
+      rowCount_(0),
+      chunks_(),
+      chunkBuffer_() {
+  // No-op.
+}
+
+SpillStore::~SpillStore() {
+  Close();
+}
+
+bool SpillStore::Open() {
+  LOG_DEBUG_MSG("Open is called");
+  Close();
+
+#ifdef _WIN32
+  char dir[MAX_PATH + 1];
+  char path[MAX_PATH + 1];
+  if (GetTempPathA(sizeof(dir), dir) == 0
+      || GetTempFileNameA(dir, "trs", 0, path) == 0) {
+    LOG_ERROR_MSG("Failed to create spill file name, error "
+                  << GetLastError());
+    return false;
+  }
+
+  // "T" keeps the file in the cache, "D" deletes it once it is closed
+  file_ = fopen(path, "w+bTD");
+  if (!file_) {
+    LOG_ERROR_MSG("Failed to open spill file " << path);
+    return false;
+  }
+#else
+  const char* tmpDir = std::getenv("TMPDIR");
+  std::string path = std::string(tmpDir && *tmpDir ? tmpDir : "/tmp")
+                     + "/trino-odbc-spill-XXXXXX";
+
+  std::vector< char > name(path.begin(), path.end());
+  name.push_back('\0');
+
+  int fd = mkstemp(name.data());
+  if (fd < 0) {
+    LOG_ERROR_MSG("Failed to create spill file " << path);
+    return false;
+  }
+
+  // the file goes away with the last descriptor
+  unlink(name.data());
+
+  file_ = fdopen(fd, "w+b");
+  if (!file_) {
+    LOG_ERROR_MSG("Failed to open spill file " << name.data());
+    close(fd);
+    return false;
+  }
+#endif
+
+  LOG_DEBUG_MSG("Spill file is created");
+  return true;
+}
+
+void SpillStore::Close() {
+  Unmap();
+
+  if (file_) {
+    LOG_DEBUG_MSG("Closing spill file holding " << rowCount_ << " rows in "
+                                                << fileSize_ << " bytes");
+    std::fclose(file_);
+    file_ = nullptr;
+  }
+
+  fileSize_ = 0;
+  rowCount_ = 0;
+  chunks_.clear();
+}
+
+bool SpillStore::Append(const PageArena& arena, size_t rowLimit) {
+  if (!file_) {
+    LOG_ERROR_MSG("Spill file is not open");
+    return false;
+  }
+
+  uint32_t rows =
+      static_cast< uint32_t >(EncodeChunk(arena, rowLimit, chunkBuffer_));
+  if (rows == 0) {
+    return true;
+  }
+
+  if (std::fwrite(chunkBuffer_.data(), 1, chunkBuffer_.size(), file_)
+      != chunkBuffer_.size()) {
+    LOG_ERROR_MSG("Failed to write " << chunkBuffer_.size()
+                                     << " bytes to spill file");
+    return false;
+  }
+
+  Chunk chunk;
+  chunk.firstRow = rowCount_;
+  chunk.rowCount = rows;
+  chunk.columnCount = static_cast< uint32_t >(arena.GetColumnCount());
+  chunk.offset = fileSize_;
+  chunk.size = chunkBuffer_.size();
+  chunks_.push_back(chunk);
+
+  fileSize_ += chunk.size;
+  rowCount_ += rows;
+
+  LOG_DEBUG_MSG("Spilled " << rows << " rows, " << rowCount_
+                           << " rows in total");
+  return true;
+}
+
+bool SpillStore::GetCell(size_t rowIdx, size_t columnIdx, PageCell& cell,
+                         const char*& value) {
+  if (rowIdx >= rowCount_) {
+    return false;
+  }
+
+  std::vector< Chunk >::const_iterator chunk = std::upper_bound(
+      chunks_.begin(), chunks_.end(), rowIdx,
+      [](size_t row, const Chunk& c) { return row < c.firstRow; });
+  --chunk;
+
+  if (columnIdx >= chunk->columnCount
+      || !EnsureMapped(chunk->offset + chunk->size)) {
+    return false;
+  }
+
+  const char* cells = mapped_ + chunk->offset + CHUNK_HEADER_SIZE;
+  size_t cellIdx = columnIdx * chunk->rowCount + (rowIdx - chunk->firstRow);
+  std::memcpy(&cell, cells + cellIdx * sizeof(PageCell), sizeof(PageCell));
+
+  const char* data =
+      cells + static_cast< size_t >(chunk->rowCount) * chunk->columnCount
+                  * sizeof(PageCell);
+  value = data + cell.offset;
+
+  return true;
+}
+
+size_t SpillStore::EncodeChunk(const PageArena& arena, size_t rowLimit,
+                               std::vector< char >& chunk) {
+  uint32_t rows =
+      static_cast< uint32_t >(std::min(arena.GetRowCount(), rowLimit));
+  uint32_t columns = static_cast< uint32_t >(arena.GetColumnCount());
+  chunk.clear();
+  if (rows == 0) {
+    return 0;
+  }
+
+  // the cell table is filled in place once the values are laid out
+  size_t cellCount = static_cast< size_t >(rows) * columns;
+  size_t cellsSize = cellCount * sizeof(PageCell);
+  chunk.resize(CHUNK_HEADER_SIZE + cellsSize);
+
+  uint32_t header[2] = {rows, columns};
+  std::memcpy(chunk.data(), header, CHUNK_HEADER_SIZE);
+
+  size_t dataStart = chunk.size();
+  for (uint32_t column = 0; column < columns; ++column) {
+    for (uint32_t row = 0; row < rows; ++row) {
+      PageCell cell;
+      const PageCell* source = arena.GetCell(row, column);
+
+      cell.offset = static_cast< uint32_t >(chunk.size() - dataStart);
+      if (source) {
+        cell.kind = source->kind;
+        cell.length = source->length;
+
+        const char* value = arena.GetValue(*source);
+        chunk.insert(chunk.end(), value, value + source->length);
+      } else {
+        cell.kind = PageCell::Kind::NULL_VALUE;
+        cell.length = 0;
+      }
+      chunk.push_back('\0');
+
+      size_t cellIdx = static_cast< size_t >(column) * rows + row;
+      std::memcpy(chunk.data() + CHUNK_HEADER_SIZE + cellIdx * sizeof(PageCell),
+                  &cell, sizeof(PageCell));
+    }
+  }
+
+  size_t padding =
+      (CHUNK_ALIGNMENT - chunk.size() % CHUNK_ALIGNMENT) % CHUNK_ALIGNMENT;
+  chunk.insert(chunk.end(), padding, '\0');
+
+  return rows;
+}
+
+bool SpillStore::DecodeChunk(const char* data, size_t size,
+                             PageArena& arena) {
+  arena.Reset();
+  if (size < CHUNK_HEADER_SIZE) {
+    return false;
+  }
+
+  uint32_t header[2];
+  std::memcpy(header, data, CHUNK_HEADER_SIZE);
+  size_t rows = header[0];
+  size_t columns = header[1];
+
+  size_t cellsSize = rows * columns * sizeof(PageCell);
+  if (size < CHUNK_HEADER_SIZE + cellsSize) {
+    return false;
+  }
+
+  const char* cells = data + CHUNK_HEADER_SIZE;
+  const char* values = cells + cellsSize;
+  size_t valuesSize = size - CHUNK_HEADER_SIZE - cellsSize;
+
+  for (size_t row = 0; row < rows; ++row) {
+    arena.BeginRow();
+    for (size_t column = 0; column < columns; ++column) {
+      PageCell cell;
+      std::memcpy(&cell, cells + (column * rows + row) * sizeof(PageCell),
+                  sizeof(PageCell));
+      if (static_cast< size_t >(cell.offset) + cell.length >= valuesSize) {
+        return false;
+      }
+      arena.AddCell(cell.kind, values + cell.offset, cell.length);
+    }
+  }
+
+  return true;
+}
+
+bool SpillStore::EnsureMapped(uint64_t size) {
+  if (size <= mappedSize_) {
+    return true;
+  }
+
+  // map everything written so far, so appends do not remap on every read
+  Unmap();
+  if (std::fflush(file_) != 0) {
+    LOG_ERROR_MSG("Failed to flush spill file");
+    return false;
+  }
+
+#ifdef _WIN32
+  HANDLE handle = reinterpret_cast< HANDLE >(_get_osfhandle(_fileno(file_)));
+  HANDLE mapping = CreateFileMappingA(
+      handle, NULL, PAGE_READONLY, static_cast< DWORD >(fileSize_ >> 32),
+      static_cast< DWORD >(fileSize_ & 0xFFFFFFFF), NULL);
+  if (!mapping) {
+    LOG_ERROR_MSG("Failed to map spill file, error " << GetLastError());
+    return false;
+  }
+
+  void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0,
+                             static_cast< SIZE_T >(fileSize_));
+  if (!data) {
+    LOG_ERROR_MSG("Failed to map spill file, error " << GetLastError());
+    CloseHandle(mapping);
+    return false;
+  }
+
+  mapping_ = mapping;
+#else
+  void* data = mmap(nullptr, static_cast< size_t >(fileSize_), PROT_READ,
+                    MAP_SHARED, fileno(file_), 0);
+  if (data == MAP_FAILED) {
+    LOG_ERROR_MSG("Failed to map spill file of " << fileSize_ << " bytes");
+    return false;
+  }
+#endif
+
+  mapped_ = static_cast< char* >(data);
+  mappedSize_ = fileSize_;
+
+  return size <= mappedSize_;
+}
+
+void SpillStore::Unmap() {
+  if (!mapped_) {
+    return;
+  }
+
+#ifdef _WIN32
+  UnmapViewOfFile(mapped_);
+  CloseHandle(reinterpret_cast< HANDLE >(mapping_));
+  mapping_ = nullptr;
+#else
+  munmap(mapped_, static_cast< size_t >(mappedSize_));
+#endif
+
+  mapped_ = nullptr;
+  mappedSize_ = 0;
+}
+}  // namespace odbc
+}  // namespace trino
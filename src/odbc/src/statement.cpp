@@ -20,6 +20,7 @@
 
 #include "trino/odbc/statement.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <limits>
 
@@ -40,17 +41,48 @@
 #include "trino/odbc/query/type_info_query.h"
 #include "trino/odbc/system/odbc_constants.h"
 #include "trino/odbc/utility.h"
+#include "trino/odbc/worker_pool.h"
+
+namespace {
+/**
+ * Records of the statement function the worker thread runs asynchronously,
+ * null on other threads.
+ */
+thread_local trino::odbc::diagnostic::DiagnosticRecordStorage* asyncRecords =
+    nullptr;
+
+/** Statement of the function the worker thread runs asynchronously. */
+thread_local const trino::odbc::Statement* asyncStatement = nullptr;
+}  // namespace
 
 namespace trino {
 namespace odbc {
+const size_t Statement::MAX_BATCH_ROWS;
+const size_t Statement::MAX_BATCH_QUERY_LENGTH;
+
 Statement::Statement(Connection& parent)
     : connection(parent),
       columnBindings(),
+      paramBindings(),
+      preparedSql(),
       currentQuery(),
+      queryMutex(),
+      interrupted(false),
       rowsFetched(0),
       rowStatuses(0),
       columnBindOffset(0),
-      rowArraySize(1) {
+      rowArraySize(1),
+      paramSetSize(1),
+      paramsProcessed(0),
+      paramStatuses(0),
+      cursorType(SQL_CURSOR_FORWARD_ONLY),
+      maxRows(0),
+      queryTimeout(0),
+      asyncEnable(SQL_ASYNC_ENABLE_OFF),
+      asyncOperation(),
+      asyncCallback(nullptr),
+      asyncCallbackContext(nullptr),
+      executing(false) {
   // Create and initialize implicit descriptors. Here we created the 4 implicit
   // descriptors. But besides implicit ARD, they are not in use because there is
   // no clear document about how to set and use them. This could be done in
@@ -83,6 +115,8 @@ Statement::Statement(Connection& parent)
 }
 
 Statement::~Statement() {
+  // the worker refers to the statement until the function is done
+  WaitAsyncOperation();
 }
 
 void Statement::RestoreDescriptor(DescType type) {
@@ -201,6 +235,81 @@ void Statement::SetDescriptorFields(uint16_t columnIdx, int16_t targetType,
   record.octetLengthPtr = strLengthOrIndicator;
 }
 
+void Statement::BindParameter(uint16_t paramIdx, int16_t ioType,
+                              int16_t bufferType, int16_t paramSqlType,
+                              SqlUlen columnSize, int16_t decDigits,
+                              void* buffer, SqlLen bufferLen, SqlLen* resLen) {
+  IGNITE_ODBC_API_CALL(InternalBindParameter(paramIdx, ioType, bufferType,
+                                             paramSqlType, columnSize,
+                                             decDigits, buffer, bufferLen,
+                                             resLen));
+}
+
+SqlResult::Type Statement::InternalBindParameter(
+    uint16_t paramIdx, int16_t ioType, int16_t bufferType,
+    int16_t paramSqlType, SqlUlen columnSize, int16_t decDigits, void* buffer,
+    SqlLen bufferLen, SqlLen* resLen) {
+  LOG_DEBUG_MSG("InternalBindParameter is called with paramIdx "
+                << paramIdx << ", ioType " << ioType << ", bufferType "
+                << bufferType << ", paramSqlType " << paramSqlType
+                << ", columnSize " << columnSize << ", decDigits "
+                << decDigits << ", bufferLen " << bufferLen);
+  using namespace type_traits;
+
+  if (paramIdx == 0) {
+    AddStatusRecord(SqlState::S07009_INVALID_DESCRIPTOR_INDEX,
+                    "The value specified for the argument ParameterNumber "
+                    "was less than 1.");
+
+    return SqlResult::AI_ERROR;
+  }
+
+  if (ioType != SQL_PARAM_INPUT) {
+    AddStatusRecord(SqlState::SHY105_INVALID_PARAMETER_TYPE,
+                    "Only input parameters are supported.");
+
+    return SqlResult::AI_ERROR;
+  }
+
+  OdbcNativeType::Type driverType = ToDriverType(bufferType);
+
+  if (driverType == OdbcNativeType::AI_UNSUPPORTED) {
+    AddStatusRecord(SqlState::SHY003_INVALID_APPLICATION_BUFFER_TYPE,
+                    "The argument ValueType was not a valid data type.");
+
+    return SqlResult::AI_ERROR;
+  }
+
+  if (!buffer && !resLen) {
+    AddStatusRecord(SqlState::SHY009_INVALID_USE_OF_NULL_POINTER,
+                    "ParameterValuePtr and StrLen_or_IndPtr are both null.");
+
+    return SqlResult::AI_ERROR;
+  }
+
+  app::ApplicationDataBuffer dataBuffer(driverType, buffer, bufferLen, resLen);
+  paramBindings[paramIdx] =
+      app::Parameter(dataBuffer, paramSqlType, columnSize, decDigits);
+
+  return SqlResult::AI_SUCCESS;
+}
+
+void Statement::GetParametersNumber(uint16_t& paramNum) {
+  IGNITE_ODBC_API_CALL(InternalGetParametersNumber(paramNum));
+}
+
+SqlResult::Type Statement::InternalGetParametersNumber(uint16_t& paramNum) {
+  if (!currentQuery.get()) {
+    AddStatusRecord(SqlState::SHY010_SEQUENCE_ERROR, "Query is not prepared.");
+
+    return SqlResult::AI_ERROR;
+  }
+
+  paramNum = app::Parameter::CountMarkers(preparedSql);
+
+  return SqlResult::AI_SUCCESS;
+}
+
 void Statement::SafeBindColumn(uint16_t columnIdx,
                                const app::ApplicationDataBuffer& buffer) {
   columnBindings[columnIdx] = buffer;
@@ -267,11 +376,40 @@ SqlResult::Type Statement::InternalSetAttribute(int attr, void* value,
     }
 
     case SQL_ATTR_CURSOR_TYPE: {
-      SqlUlen cursorType = reinterpret_cast< SqlUlen >(value);
+      SqlUlen type = reinterpret_cast< SqlUlen >(value);
 
-      if (cursorType != SQL_CURSOR_FORWARD_ONLY) {
-        AddStatusRecord(SqlState::SHYC00_OPTIONAL_FEATURE_NOT_IMPLEMENTED,
-                        "Only forward cursors are currently supported");
+      if (type == SQL_CURSOR_FORWARD_ONLY || type == SQL_CURSOR_STATIC) {
+        cursorType = type;
+        break;
+      }
+
+      if (type != SQL_CURSOR_KEYSET_DRIVEN && type != SQL_CURSOR_DYNAMIC) {
+        AddStatusRecord(SqlState::SHY024_INVALID_ATTRIBUTE_VALUE,
+                        "Invalid argument value");
+
+        return SqlResult::AI_ERROR;
+      }
+
+      // result sets are read-only snapshots, so a static cursor is the
+      // closest match
+      cursorType = SQL_CURSOR_STATIC;
+      AddStatusRecord(SqlState::S01S02_OPTION_VALUE_CHANGED,
+                      "Cursor type changed to SQL_CURSOR_STATIC",
+                      trino::odbc::LogLevel::Type::WARNING_LEVEL);
+
+      return SqlResult::AI_SUCCESS_WITH_INFO;
+    }
+
+    case SQL_ATTR_CURSOR_SCROLLABLE: {
+      SqlUlen scrollable = reinterpret_cast< SqlUlen >(value);
+
+      if (scrollable == SQL_SCROLLABLE) {
+        cursorType = SQL_CURSOR_STATIC;
+      } else if (scrollable == SQL_NONSCROLLABLE) {
+        cursorType = SQL_CURSOR_FORWARD_ONLY;
+      } else {
+        AddStatusRecord(SqlState::SHY024_INVALID_ATTRIBUTE_VALUE,
+                        "Invalid argument value");
 
         return SqlResult::AI_ERROR;
       }
@@ -279,6 +417,64 @@ SqlResult::Type Statement::InternalSetAttribute(int attr, void* value,
       break;
     }
 
+    case SQL_ATTR_MAX_ROWS: {
+      maxRows = reinterpret_cast< SqlUlen >(value);
+
+      LOG_DEBUG_MSG("maxRows: " << maxRows);
+
+      break;
+    }
+
+    case SQL_ATTR_QUERY_TIMEOUT: {
+      SqlUlen timeout = reinterpret_cast< SqlUlen >(value);
+
+      if (timeout > static_cast< SqlUlen >(INT32_MAX)) {
+        queryTimeout = static_cast< SqlUlen >(INT32_MAX);
+        AddStatusRecord(SqlState::S01S02_OPTION_VALUE_CHANGED,
+                        "Query timeout is changed to the maximum value",
+                        trino::odbc::LogLevel::Type::WARNING_LEVEL);
+
+        return SqlResult::AI_SUCCESS_WITH_INFO;
+      }
+
+      queryTimeout = timeout;
+
+      LOG_DEBUG_MSG("queryTimeout: " << queryTimeout);
+
+      break;
+    }
+
+    case SQL_ATTR_ASYNC_ENABLE: {
+      SqlUlen enable = reinterpret_cast< SqlUlen >(value);
+
+      if (enable != SQL_ASYNC_ENABLE_ON && enable != SQL_ASYNC_ENABLE_OFF) {
+        AddStatusRecord(SqlState::SHY024_INVALID_ATTRIBUTE_VALUE,
+                        "Invalid argument value");
+
+        return SqlResult::AI_ERROR;
+      }
+
+      asyncEnable = enable;
+
+      LOG_DEBUG_MSG("asyncEnable: " << asyncEnable);
+
+      break;
+    }
+
+#ifdef SQL_ATTR_ASYNC_STMT_PCALLBACK
+    case SQL_ATTR_ASYNC_STMT_PCALLBACK: {
+      asyncCallback = reinterpret_cast< AsyncNotificationCallback >(value);
+
+      break;
+    }
+
+    case SQL_ATTR_ASYNC_STMT_PCONTEXT: {
+      asyncCallbackContext = value;
+
+      break;
+    }
+#endif  // SQL_ATTR_ASYNC_STMT_PCALLBACK
+
     case SQL_ATTR_METADATA_ID: {
       SqlUlen id = reinterpret_cast< SqlUlen >(value);
 
@@ -289,8 +485,7 @@ SqlResult::Type Statement::InternalSetAttribute(int attr, void* value,
         return SqlResult::AI_ERROR;
       }
 
-      connection.SetAttribute(SQL_ATTR_METADATA_ID,
-                              reinterpret_cast< SQLPOINTER >(id), 0);
+      connection.SetMetadataID(id == SQL_TRUE);
 
       break;
     }
@@ -322,6 +517,35 @@ SqlResult::Type Statement::InternalSetAttribute(int attr, void* value,
       break;
     }
 
+    case SQL_ATTR_PARAMSET_SIZE: {
+      SqlUlen val = reinterpret_cast< SqlUlen >(value);
+
+      LOG_DEBUG_MSG("SQL_ATTR_PARAMSET_SIZE: " << val);
+
+      if (val == 0) {
+        AddStatusRecord(SqlState::SHY024_INVALID_ATTRIBUTE_VALUE,
+                        "Parameter set size cannot be 0.");
+
+        return SqlResult::AI_ERROR;
+      }
+
+      paramSetSize = val;
+
+      break;
+    }
+
+    case SQL_ATTR_PARAM_STATUS_PTR: {
+      paramStatuses = reinterpret_cast< SQLUSMALLINT* >(value);
+
+      break;
+    }
+
+    case SQL_ATTR_PARAMS_PROCESSED_PTR: {
+      paramsProcessed = reinterpret_cast< SQLULEN* >(value);
+
+      break;
+    }
+
     case SQL_ATTR_APP_ROW_DESC: {
       Descriptor* desc = reinterpret_cast< Descriptor* >(value);
       if (desc) {
@@ -506,7 +730,8 @@ SqlResult::Type Statement::InternalGetAttribute(int attr, void* buf, SQLINTEGER,
     case SQL_ATTR_CURSOR_SCROLLABLE: {
       SqlUlen* val = reinterpret_cast< SqlUlen* >(buf);
 
-      *val = SQL_NONSCROLLABLE;
+      *val = cursorType == SQL_CURSOR_STATIC ? SQL_SCROLLABLE
+                                             : SQL_NONSCROLLABLE;
 
       break;
     }
@@ -522,11 +747,59 @@ SqlResult::Type Statement::InternalGetAttribute(int attr, void* buf, SQLINTEGER,
     case SQL_ATTR_CURSOR_TYPE: {
       SqlUlen* val = reinterpret_cast< SqlUlen* >(buf);
 
-      *val = SQL_CURSOR_FORWARD_ONLY;
+      *val = cursorType;
+
+      break;
+    }
+
+    case SQL_ATTR_MAX_ROWS: {
+      SqlUlen* val = reinterpret_cast< SqlUlen* >(buf);
+
+      *val = maxRows;
+
+      break;
+    }
+
+    case SQL_ATTR_QUERY_TIMEOUT: {
+      SqlUlen* val = reinterpret_cast< SqlUlen* >(buf);
+
+      *val = queryTimeout;
+
+      break;
+    }
+
+    case SQL_ATTR_ASYNC_ENABLE: {
+      SqlUlen* val = reinterpret_cast< SqlUlen* >(buf);
+
+      *val = asyncEnable;
+
+      break;
+    }
+
+#ifdef SQL_ATTR_ASYNC_STMT_PCALLBACK
+    case SQL_ATTR_ASYNC_STMT_PCALLBACK: {
+      SQLPOINTER* val = reinterpret_cast< SQLPOINTER* >(buf);
+
+      *val = reinterpret_cast< SQLPOINTER >(asyncCallback);
+
+      if (valueLen)
+        *valueLen = SQL_IS_POINTER;
 
       break;
     }
 
+    case SQL_ATTR_ASYNC_STMT_PCONTEXT: {
+      SQLPOINTER* val = reinterpret_cast< SQLPOINTER* >(buf);
+
+      *val = asyncCallbackContext;
+
+      if (valueLen)
+        *valueLen = SQL_IS_POINTER;
+
+      break;
+    }
+#endif  // SQL_ATTR_ASYNC_STMT_PCALLBACK
+
     case SQL_ATTR_ENABLE_AUTO_IPD: {
       SqlUlen* val = reinterpret_cast< SqlUlen* >(buf);
 
@@ -622,6 +895,36 @@ SqlResult::Type Statement::InternalGetAttribute(int attr, void* buf, SQLINTEGER,
       break;
     }
 
+    case SQL_ATTR_PARAMSET_SIZE: {
+      SqlUlen* val = reinterpret_cast< SqlUlen* >(buf);
+
+      *val = paramSetSize;
+
+      break;
+    }
+
+    case SQL_ATTR_PARAM_STATUS_PTR: {
+      SQLUSMALLINT** val = reinterpret_cast< SQLUSMALLINT** >(buf);
+
+      *val = paramStatuses;
+
+      if (valueLen)
+        *valueLen = SQL_IS_POINTER;
+
+      break;
+    }
+
+    case SQL_ATTR_PARAMS_PROCESSED_PTR: {
+      SQLULEN** val = reinterpret_cast< SQLULEN** >(buf);
+
+      *val = paramsProcessed;
+
+      if (valueLen)
+        *valueLen = SQL_IS_POINTER;
+
+      break;
+    }
+
     case SQL_ATTR_ROW_BIND_OFFSET_PTR: {
       SqlUlen** val = reinterpret_cast< SqlUlen** >(buf);
 
@@ -704,16 +1007,36 @@ SqlResult::Type Statement::ProcessInternalCommand(const std::string& query) {
 }
 
 SqlResult::Type Statement::InternalPrepareSqlQuery(const std::string& query) {
+  SetCurrentQuery(new query::DataQuery(*this, connection, query,
+                                       cursorType == SQL_CURSOR_STATIC,
+                                       static_cast< int64_t >(maxRows),
+                                       static_cast< int32_t >(queryTimeout)),
+                  query);
+
+  return SqlResult::AI_SUCCESS;
+}
+
+void Statement::SetCurrentQuery(Query* query, const std::string& sql) {
+  std::lock_guard< std::mutex > lock(queryMutex);
+
   if (currentQuery.get())
     currentQuery->Close();
 
-  currentQuery.reset(new query::DataQuery(*this, connection, query));
+  currentQuery.reset(query);
+  preparedSql = sql;
+}
 
-  return SqlResult::AI_SUCCESS;
+void Statement::InterruptCurrentQuery() {
+  std::lock_guard< std::mutex > lock(queryMutex);
+
+  interrupted = true;
+  if (currentQuery.get())
+    currentQuery->Interrupt();
 }
 
 void Statement::ExecuteSqlQuery(const std::string& query) {
-  IGNITE_ODBC_API_CALL(InternalExecuteSqlQuery(query));
+  AsyncApiCall(SQL_API_SQLEXECDIRECT,
+               [this, query]() { return InternalExecuteSqlQuery(query); });
 }
 
 SqlResult::Type Statement::InternalExecuteSqlQuery(const std::string& query) {
@@ -727,7 +1050,8 @@ SqlResult::Type Statement::InternalExecuteSqlQuery(const std::string& query) {
 }
 
 void Statement::ExecuteSqlQuery() {
-  IGNITE_ODBC_API_CALL(InternalExecuteSqlQuery());
+  AsyncApiCall(SQL_API_SQLEXECUTE,
+               [this]() { return InternalExecuteSqlQuery(); });
 }
 
 SqlResult::Type Statement::InternalExecuteSqlQuery() {
@@ -738,7 +1062,10 @@ SqlResult::Type Statement::InternalExecuteSqlQuery() {
     return SqlResult::AI_ERROR;
   }
 
-  SqlResult::Type retval = currentQuery->Execute();
+  uint16_t paramNum = app::Parameter::CountMarkers(preparedSql);
+  SqlResult::Type retval = paramNum > 0
+                               ? InternalExecuteWithParameters(paramNum)
+                               : currentQuery->Execute();
   // For SQLExecute() when the query result is empty according to Microsoft
   // document it should be SUCCESS. SQL_NO_DATA is only used for DML statements.
   // The DataQuery::Execute() needs to keep AI_NO_DATA as it is needed by
@@ -750,7 +1077,303 @@ SqlResult::Type Statement::InternalExecuteSqlQuery() {
   return retval;
 }
 
+bool Statement::InterruptSqlQuery() {
+  // the handle lock is also held by calls that can not be interrupted, so
+  // it does not tell whether a query runs
+  if (!executing) {
+    return false;
+  }
+
+  LOG_INFO_MSG("Interrupting function running on another thread");
+  InterruptCurrentQuery();
+
+  return true;
+}
+
+SqlResult::Type Statement::InternalExecuteWithParameters(uint16_t paramNum) {
+  LOG_DEBUG_MSG("InternalExecuteWithParameters is called with paramNum "
+                << paramNum);
+
+  if (paramSetSize > 1)
+    return InternalExecuteParameterArray(paramNum);
+
+  std::vector< std::string > literals;
+  SqlResult::Type result = GetParameterLiterals(0, paramNum, literals);
+  if (result != SqlResult::AI_SUCCESS)
+    return result;
+
+  // requests carry no prepared statements of the session, so a PREPARE would
+  // not outlive its own request. EXECUTE IMMEDIATE sends the query text
+  // unchanged with the values as its arguments in a single request instead.
+  std::string query = app::Parameter::ExecuteImmediate(preparedSql, literals);
+
+  // the prepared query stays the one with markers, so SQLExecute can run it
+  // again with other values
+  std::string sql = preparedSql;
+  SetCurrentQuery(new query::DataQuery(*this, connection, query,
+                                       cursorType == SQL_CURSOR_STATIC,
+                                       static_cast< int64_t >(maxRows),
+                                       static_cast< int32_t >(queryTimeout)),
+                  sql);
+
+  return currentQuery->Execute();
+}
+
+SqlResult::Type Statement::InternalExecuteParameterArray(uint16_t paramNum) {
+  LOG_DEBUG_MSG("InternalExecuteParameterArray is called with paramSetSize "
+                << paramSetSize);
+
+  if (paramsProcessed)
+    *paramsProcessed = 0;
+
+  if (paramStatuses) {
+    for (SqlUlen i = 0; i < paramSetSize; ++i)
+      paramStatuses[i] = SQL_PARAM_UNUSED;
+  }
+
+  {
+    std::lock_guard< std::mutex > lock(queryMutex);
+    interrupted = false;
+  }
+
+  // the query timeout applies to the whole SQLExecute, not to every query
+  std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::now()
+      + std::chrono::seconds(static_cast< int64_t >(queryTimeout));
+
+  // once interrupted or timed out no query runs any more, the parameter sets
+  // left stay SQL_PARAM_UNUSED
+  bool stopped = false;
+  SqlUlen failed = 0;
+  auto setStatus = [this, &failed](SqlUlen row, SqlResult::Type result) {
+    if (result == SqlResult::AI_ERROR)
+      ++failed;
+
+    if (paramStatuses)
+      paramStatuses[row] = result == SqlResult::AI_ERROR ? SQL_PARAM_ERROR
+                                                         : SQL_PARAM_SUCCESS;
+    if (paramsProcessed)
+      *paramsProcessed = row + 1;
+  };
+
+  std::vector< std::string > literals;
+  std::vector< size_t > markers = app::Parameter::FindMarkers(preparedSql);
+  size_t rowStart = 0;
+
+  if (app::Parameter::FindValuesRow(preparedSql, rowStart)
+      && markers.front() > rowStart) {
+    // INSERT ... VALUES (?, ?): append the rows of a batch to one statement.
+    // A batch the server rejected inserted nothing, its rows are inserted
+    // one by one then to tell the failing rows from the others. Any other
+    // failure, like a timeout, may come after the rows were written, so
+    // they are not sent again.
+    std::string head = preparedSql.substr(0, rowStart);
+    std::vector< std::string > batch;
+    size_t batchLength = 0;
+    std::vector< SqlUlen > batchRows;
+
+    auto flush = [&]() {
+      if (batchRows.empty() || stopped
+          || (stopped = IsParameterArrayStopped(deadline)))
+        return;
+
+      LOG_DEBUG_MSG("Inserting a batch of " << batchRows.size() << " rows");
+      std::string query = head;
+      for (size_t i = 0; i < batch.size(); ++i)
+        query += (i == 0 ? "" : ", ") + batch[i];
+
+      bool rejected = false;
+      SqlResult::Type result =
+          RunParameterArrayQuery(query, deadline, rejected, stopped);
+      if (result == SqlResult::AI_ERROR && rejected && batchRows.size() > 1) {
+        LOG_WARNING_MSG("Batch insert was rejected, inserting its "
+                        << batchRows.size() << " rows one by one");
+        for (size_t i = 0; i < batchRows.size(); ++i) {
+          if (stopped || (stopped = IsParameterArrayStopped(deadline)))
+            return;
+
+          setStatus(batchRows[i], RunParameterArrayQuery(
+                                      head + batch[i], deadline, rejected,
+                                      stopped));
+        }
+      } else {
+        for (SqlUlen row : batchRows)
+          setStatus(row, result);
+      }
+
+      batch.clear();
+      batchLength = 0;
+      batchRows.clear();
+    };
+
+    for (SqlUlen row = 0; row < paramSetSize && !stopped; ++row) {
+      if (GetParameterLiterals(row, paramNum, literals)
+          == SqlResult::AI_ERROR) {
+        flush();
+        if (stopped)
+          break;
+
+        setStatus(row, SqlResult::AI_ERROR);
+        continue;
+      }
+
+      std::string values = app::Parameter::InlineLiterals(
+          preparedSql, markers, literals, rowStart);
+      batchLength += values.size() + 2;
+      batch.push_back(std::move(values));
+      batchRows.push_back(row);
+
+      if (batchRows.size() >= MAX_BATCH_ROWS
+          || head.size() + batchLength >= MAX_BATCH_QUERY_LENGTH)
+        flush();
+    }
+    flush();
+  } else {
+    // any other statement runs once per parameter set. Each query replaces
+    // the previous one, so only the result of the last parameter set stays
+    // open for the application to fetch.
+    for (SqlUlen row = 0; row < paramSetSize; ++row) {
+      SqlResult::Type result = GetParameterLiterals(row, paramNum, literals);
+      if (result != SqlResult::AI_ERROR) {
+        if ((stopped = IsParameterArrayStopped(deadline)))
+          break;
+
+        bool rejected = false;
+        result = RunParameterArrayQuery(
+            app::Parameter::ExecuteImmediate(preparedSql, literals), deadline,
+            rejected, stopped);
+      }
+      setStatus(row, result);
+
+      if (stopped)
+        break;
+    }
+  }
+
+  LOG_DEBUG_MSG(failed << " of " << paramSetSize << " parameter sets failed");
+
+  if (stopped || failed == paramSetSize)
+    return SqlResult::AI_ERROR;
+
+  return failed > 0 ? SqlResult::AI_SUCCESS_WITH_INFO : SqlResult::AI_SUCCESS;
+}
+
+SqlResult::Type Statement::GetParameterLiterals(
+    SqlUlen rowIdx, uint16_t paramNum, std::vector< std::string >& literals) {
+  literals.resize(paramNum);
+
+  for (uint16_t i = 1; i <= paramNum; ++i) {
+    app::ParameterBindingMap::const_iterator it = paramBindings.find(i);
+    if (it == paramBindings.end()) {
+      AddStatusRecord(SqlState::S07002_COUNT_FIELD_INCORRECT,
+                      "Parameter " + std::to_string(i) + " is not bound.");
+
+      return SqlResult::AI_ERROR;
+    }
+
+    if (it->second.IsDataAtExec(rowIdx)) {
+      AddStatusRecord(SqlState::SHYC00_OPTIONAL_FEATURE_NOT_IMPLEMENTED,
+                      "Data at execution parameters are not supported.");
+
+      return SqlResult::AI_ERROR;
+    }
+
+    if (!it->second.GetLiteral(literals[i - 1], rowIdx)) {
+      AddStatusRecord(SqlState::S07006_RESTRICTION_VIOLATION,
+                      "SQL type of parameter " + std::to_string(i)
+                          + " is not supported.");
+
+      return SqlResult::AI_ERROR;
+    }
+  }
+
+  return SqlResult::AI_SUCCESS;
+}
+
+SqlResult::Type Statement::RunParameterArrayQuery(
+    const std::string& query,
+    const std::chrono::steady_clock::time_point& deadline, bool& rejected,
+    bool& stopped) {
+  LOG_DEBUG_MSG("RunParameterArrayQuery is called for query " << query);
+
+  int32_t timeout = 0;
+  if (queryTimeout > 0) {
+    // the seconds left of the timeout, rounded up
+    int64_t left = std::chrono::duration_cast< std::chrono::milliseconds >(
+                       deadline - std::chrono::steady_clock::now())
+                       .count();
+    timeout = static_cast< int32_t >(std::max< int64_t >(left + 999, 1000)
+                                     / 1000);
+  }
+
+  // the prepared query stays the one with markers, so SQLExecute can run the
+  // parameter array again
+  std::string sql = preparedSql;
+  query::DataQuery* dataQuery =
+      new query::DataQuery(*this, connection, query,
+                           cursorType == SQL_CURSOR_STATIC,
+                           static_cast< int64_t >(maxRows), timeout);
+  SetCurrentQuery(dataQuery, sql);
+
+  SqlResult::Type result = dataQuery->Execute();
+  rejected = dataQuery->GetFailure() == query::FailureKind::REJECTED;
+
+  // an interrupt that came before the query started is caught here
+  {
+    std::lock_guard< std::mutex > lock(queryMutex);
+    stopped = interrupted
+              || dataQuery->GetFailure() == query::FailureKind::STOPPED;
+  }
+
+  if (stopped && result != SqlResult::AI_ERROR)
+    AddStatusRecord(SqlState::SHY008_OPERATION_CANCELED,
+                    "Operation canceled.");
+
+  return result == SqlResult::AI_NO_DATA ? SqlResult::AI_SUCCESS : result;
+}
+
+bool Statement::IsParameterArrayStopped(
+    const std::chrono::steady_clock::time_point& deadline) {
+  {
+    std::lock_guard< std::mutex > lock(queryMutex);
+    if (interrupted) {
+      AddStatusRecord(SqlState::SHY008_OPERATION_CANCELED,
+                      "Operation canceled.");
+
+      return true;
+    }
+  }
+
+  if (queryTimeout > 0 && std::chrono::steady_clock::now() >= deadline) {
+    AddStatusRecord(SqlState::SHYT00_TIMEOUT_EXPIRED,
+                    "Query timeout expired.");
+
+    return true;
+  }
+
+  return false;
+}
+
 void Statement::CancelSqlQuery() {
+  std::lock_guard< std::recursive_mutex > cancelLock(handleMutex);
+
+  if (asyncOperation) {
+    // the diagnostic records belong to the running function, the result is
+    // reported when the application polls it again
+    {
+      std::lock_guard< std::mutex > lock(asyncOperation->mutex);
+      LOG_INFO_MSG("Cancelling function " << asyncOperation->function
+                                          << " running asynchronously");
+      asyncOperation->cancelled = true;
+    }
+
+    InterruptCurrentQuery();
+
+    diagnosticRecords.SetHeaderRecord(SqlResult::AI_SUCCESS);
+
+    return;
+  }
+
   IGNITE_ODBC_API_CALL(InternalCancelSqlQuery());
 }
 
@@ -779,11 +1402,8 @@ SqlResult::Type Statement::InternalExecuteGetColumnsMetaQuery(
     const boost::optional< std::string >& schema,
     const boost::optional< std::string >& table,
     const boost::optional< std::string >& column) {
-  if (currentQuery.get())
-    currentQuery->Close();
-
-  currentQuery.reset(new query::ColumnMetadataQuery(*this, connection, catalog,
-                                                    schema, table, column));
+  SetCurrentQuery(new query::ColumnMetadataQuery(*this, connection, catalog,
+                                                 schema, table, column));
 
   return currentQuery->Execute();
 }
@@ -803,11 +1423,8 @@ SqlResult::Type Statement::InternalExecuteGetTablesMetaQuery(
     const boost::optional< std::string >& table,
     const boost::optional< std::string >& tableType) {
   LOG_DEBUG_MSG("InternalExecuteGetTablesMetaQuery is called");
-  if (currentQuery.get())
-    currentQuery->Close();
-
-  currentQuery.reset(new query::TableMetadataQuery(*this, connection, catalog,
-                                                   schema, table, tableType));
+  SetCurrentQuery(new query::TableMetadataQuery(*this, connection, catalog,
+                                                schema, table, tableType));
 
   return currentQuery->Execute();
 }
@@ -817,10 +1434,7 @@ void Statement::ExecuteGetForeignKeysQuery() {
 }
 
 SqlResult::Type Statement::InternalExecuteGetForeignKeysQuery() {
-  if (currentQuery.get())
-    currentQuery->Close();
-
-  currentQuery.reset(new query::ForeignKeysQuery(*this));
+  SetCurrentQuery(new query::ForeignKeysQuery(*this));
 
   return currentQuery->Execute();
 }
@@ -830,10 +1444,7 @@ void Statement::ExecuteGetPrimaryKeysQuery() {
 }
 
 SqlResult::Type Statement::InternalExecuteGetPrimaryKeysQuery() {
-  if (currentQuery.get())
-    currentQuery->Close();
-
-  currentQuery.reset(new query::PrimaryKeysQuery(*this));
+  SetCurrentQuery(new query::PrimaryKeysQuery(*this));
 
   return currentQuery->Execute();
 }
@@ -843,10 +1454,7 @@ void Statement::ExecuteSpecialColumnsQuery() {
 }
 
 SqlResult::Type Statement::InternalExecuteSpecialColumnsQuery() {
-  if (currentQuery.get())
-    currentQuery->Close();
-
-  currentQuery.reset(new query::SpecialColumnsQuery(*this));
+  SetCurrentQuery(new query::SpecialColumnsQuery(*this));
 
   return currentQuery->Execute();
 }
@@ -856,10 +1464,7 @@ void Statement::ExecuteStatisticsQuery() {
 }
 
 SqlResult::Type Statement::InternalExecuteStatisticsQuery() {
-  if (currentQuery.get())
-    currentQuery->Close();
-
-  currentQuery.reset(
+  SetCurrentQuery(
       new query::StatisticsQuery(*this, connection.GetEnvODBCVer()));
 
   return currentQuery->Execute();
@@ -870,10 +1475,7 @@ void Statement::ExecuteProcedureColumnsQuery() {
 }
 
 SqlResult::Type Statement::InternalExecuteProcedureColumnsQuery() {
-  if (currentQuery.get())
-    currentQuery->Close();
-
-  currentQuery.reset(new query::ProcedureColumnsQuery(*this));
+  SetCurrentQuery(new query::ProcedureColumnsQuery(*this));
 
   return currentQuery->Execute();
 }
@@ -883,10 +1485,7 @@ void Statement::ExecuteProceduresQuery() {
 }
 
 SqlResult::Type Statement::InternalExecuteProceduresQuery() {
-  if (currentQuery.get())
-    currentQuery->Close();
-
-  currentQuery.reset(new query::ProceduresQuery(*this));
+  SetCurrentQuery(new query::ProceduresQuery(*this));
 
   return currentQuery->Execute();
 }
@@ -896,10 +1495,7 @@ void Statement::ExecuteColumnPrivilegesQuery() {
 }
 
 SqlResult::Type Statement::InternalExecuteColumnPrivilegesQuery() {
-  if (currentQuery.get())
-    currentQuery->Close();
-
-  currentQuery.reset(new query::ColumnPrivilegesQuery(*this));
+  SetCurrentQuery(new query::ColumnPrivilegesQuery(*this));
 
   return currentQuery->Execute();
 }
@@ -909,10 +1505,7 @@ void Statement::ExecuteTablePrivilegesQuery() {
 }
 
 SqlResult::Type Statement::InternalExecuteTablePrivilegesQuery() {
-  if (currentQuery.get())
-    currentQuery->Close();
-
-  currentQuery.reset(new query::TablePrivilegesQuery(*this));
+  SetCurrentQuery(new query::TablePrivilegesQuery(*this));
 
   return currentQuery->Execute();
 }
@@ -934,10 +1527,7 @@ SqlResult::Type Statement::InternalExecuteGetTypeInfoQuery(int16_t sqlType) {
     return SqlResult::AI_ERROR;
   }
 
-  if (currentQuery.get())
-    currentQuery->Close();
-
-  currentQuery.reset(new query::TypeInfoQuery(*this, sqlType));
+  SetCurrentQuery(new query::TypeInfoQuery(*this, sqlType));
 
   return currentQuery->Execute();
 }
@@ -965,6 +1555,12 @@ SqlResult::Type Statement::InternalFreeResources(int16_t option) {
       break;
     }
 
+    case SQL_RESET_PARAMS: {
+      paramBindings.clear();
+
+      break;
+    }
+
     default: {
       AddStatusRecord(
           SqlState::SHY092_OPTION_TYPE_OUT_OF_RANGE,
@@ -995,31 +1591,61 @@ SqlResult::Type Statement::InternalClose() {
 }
 
 void Statement::FetchScroll(int16_t orientation, int64_t offset) {
-  IGNITE_ODBC_API_CALL(InternalFetchScroll(orientation, offset));
+  AsyncApiCall(SQL_API_SQLFETCHSCROLL, [this, orientation, offset]() {
+    return InternalFetchScroll(orientation, offset);
+  });
 }
 
 SqlResult::Type Statement::InternalFetchScroll(int16_t orientation,
                                                int64_t offset) {
   LOG_DEBUG_MSG("InternalFetchScroll is called with orientation "
-                << orientation);
-  UNREFERENCED_PARAMETER(offset);
+                << orientation << ", offset " << offset);
 
-  if (orientation != SQL_FETCH_NEXT) {
-    AddStatusRecord(SqlState::SHYC00_OPTIONAL_FEATURE_NOT_IMPLEMENTED,
-                    "Only SQL_FETCH_NEXT FetchOrientation type is supported");
+  if (!currentQuery.get() || !currentQuery->IsScrollable()) {
+    if (orientation != SQL_FETCH_NEXT) {
+      AddStatusRecord(SqlState::SHYC00_OPTIONAL_FEATURE_NOT_IMPLEMENTED,
+                      "Only SQL_FETCH_NEXT FetchOrientation type is supported");
 
-    return SqlResult::AI_ERROR;
+      return SqlResult::AI_ERROR;
+    }
+
+    return FetchRowset();
   }
 
-  return InternalFetchRow();
+  SqlResult::Type moveRes =
+      currentQuery->MoveToRowset(orientation, offset, rowArraySize);
+
+  if (moveRes == SqlResult::AI_NO_DATA || moveRes == SqlResult::AI_ERROR) {
+    if (rowsFetched)
+      *rowsFetched = 0;
+
+    return moveRes;
+  }
+
+  SqlResult::Type result = FetchRowset();
+
+  if (result == SqlResult::AI_SUCCESS
+      && moveRes == SqlResult::AI_SUCCESS_WITH_INFO)
+    return SqlResult::AI_SUCCESS_WITH_INFO;
+
+  return result;
 }
 
 void Statement::FetchRow() {
-  IGNITE_ODBC_API_CALL(InternalFetchRow());
+  AsyncApiCall(SQL_API_SQLFETCH, [this]() { return InternalFetchRow(); });
 }
 
 SqlResult::Type Statement::InternalFetchRow() {
   LOG_DEBUG_MSG("InternalFetchRow is called");
+
+  // scrollable cursors keep track of the rowset start
+  if (currentQuery.get() && currentQuery->IsScrollable())
+    return InternalFetchScroll(SQL_FETCH_NEXT, 0);
+
+  return FetchRowset();
+}
+
+SqlResult::Type Statement::FetchRowset() {
   if (rowsFetched)
     *rowsFetched = 0;
 
@@ -1067,6 +1693,149 @@ SqlResult::Type Statement::InternalFetchRow() {
   return errors == 0 ? SqlResult::AI_NO_DATA : SqlResult::AI_ERROR;
 }
 
+void Statement::AsyncApiCall(
+    uint16_t function, const std::function< SqlResult::Type() >& operation) {
+  // the worker runs the operation without the handle lock, so the
+  // application can poll and cancel while it runs
+  std::lock_guard< std::recursive_mutex > handleLock(handleMutex);
+
+  if (asyncOperation) {
+    diagnosticRecords.SetHeaderRecord(PollAsyncOperation(function));
+    return;
+  }
+
+  diagnosticRecords.Reset();
+
+  if (asyncEnable != SQL_ASYNC_ENABLE_ON) {
+    SqlResult::Type result = SqlResult::AI_ERROR;
+    executing = true;
+    try {
+      result = operation();
+    } catch (...) {
+      executing = false;
+      throw;
+    }
+    executing = false;
+
+    diagnosticRecords.SetHeaderRecord(result);
+    return;
+  }
+
+  LOG_DEBUG_MSG("Starting function " << function << " asynchronously");
+
+  std::shared_ptr< AsyncOperation > async = std::make_shared< AsyncOperation >();
+  async->function = function;
+  async->result = SqlResult::AI_ERROR;
+  async->done = false;
+  async->cancelled = false;
+  async->start = std::chrono::steady_clock::now();
+  asyncOperation = async;
+
+  AsyncNotificationCallback callback = asyncCallback;
+  SQLPOINTER callbackContext = asyncCallbackContext;
+
+  WorkerPool::GetInstance().Submit(
+      [this, async, operation, callback, callbackContext]() {
+        // the worker writes the records of the function only, the handle
+        // lock is not held
+        asyncRecords = &async->records;
+        asyncStatement = this;
+
+        SqlResult::Type result = SqlResult::AI_ERROR;
+        try {
+          result = operation();
+        } catch (const std::exception& e) {
+          AddStatusRecord(SqlState::SHY000_GENERAL_ERROR, e.what());
+        } catch (...) {
+          AddStatusRecord(SqlState::SHY000_GENERAL_ERROR,
+                          "Unknown error in asynchronous function.");
+        }
+
+        asyncRecords = nullptr;
+        asyncStatement = nullptr;
+
+        {
+          std::lock_guard< std::mutex > lock(async->mutex);
+          async->result = result;
+          async->done = true;
+          async->cv.notify_all();
+        }
+
+        // the statement may be gone from here on
+        if (callback) {
+          callback(callbackContext, 1);
+        }
+      });
+
+  diagnosticRecords.SetHeaderRecord(SqlResult::AI_STILL_EXECUTING);
+}
+
+SqlResult::Type Statement::PollAsyncOperation(uint16_t function) {
+  std::shared_ptr< AsyncOperation > async = asyncOperation;
+  {
+    std::lock_guard< std::mutex > lock(async->mutex);
+    if (async->function != function) {
+      // the driver manager reports HY010 for this case, the diagnostic
+      // records belong to the running function
+      LOG_ERROR_MSG("Function " << function << " is called while function "
+                                << async->function
+                                << " is running asynchronously");
+      return SqlResult::AI_ERROR;
+    }
+
+    if (!async->done) {
+      return SqlResult::AI_STILL_EXECUTING;
+    }
+  }
+
+  asyncOperation.reset();
+
+  LOG_DEBUG_MSG("Function "
+                << function << " finished asynchronously in "
+                << std::chrono::duration_cast< std::chrono::milliseconds >(
+                       std::chrono::steady_clock::now() - async->start)
+                       .count()
+                << " ms with result " << async->result);
+
+  diagnosticRecords.Reset();
+
+  if (async->cancelled) {
+    // also stops fetching pages the function may have started
+    if (currentQuery.get())
+      currentQuery->Close();
+
+    AddStatusRecord(SqlState::SHY008_OPERATION_CANCELED,
+                    "Operation canceled.");
+
+    return SqlResult::AI_ERROR;
+  }
+
+  // the worker is done with the records
+  for (int32_t i = 1; i <= async->records.GetStatusRecordsNumber(); ++i) {
+    diagnosticRecords.AddStatusRecord(async->records.GetStatusRecord(i));
+  }
+
+  return async->result;
+}
+
+void Statement::AddStatusRecord(const diagnostic::DiagnosticRecord& rec) {
+  if (asyncStatement == this) {
+    asyncRecords->AddStatusRecord(rec);
+    return;
+  }
+
+  diagnosticRecords.AddStatusRecord(rec);
+}
+
+void Statement::WaitAsyncOperation() {
+  if (!asyncOperation) {
+    return;
+  }
+
+  std::unique_lock< std::mutex > lock(asyncOperation->mutex);
+  asyncOperation->cv.wait(lock, [&]() { return asyncOperation->done; });
+}
+
 const meta::ColumnMetaVector* Statement::GetMeta() {
   LOG_DEBUG_MSG("GetMeta is called");
   if (!currentQuery.get()) {
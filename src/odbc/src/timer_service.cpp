@@ -0,0 +1,161 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "trino/odbc/timer_service.h"
+
+#include <algorithm>
+
+#include "trino/odbc/log.h"
+
+namespace trino {
+namespace odbc {
+TimerService& TimerService::GetInstance() {
+  static TimerService instance;
+  return instance;
+}
+
+TimerService::TimerService(std::chrono::milliseconds tick, size_t slotCount)
+    : tick_(tick.count() > 0 ? tick : std::chrono::milliseconds(1)),
+      slots_(slotCount > 0 ? slotCount : 1),
+      index_(),
+      start_(std::chrono::steady_clock::now()),
+      currentTick_(0),
+      lastId_(0),
+      stopping_(false) {
+  // No-op.
+}
+
+TimerService::~TimerService() {
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    stopping_ = true;
+    cv_.notify_all();
+  }
+
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+TimerService::TimerId TimerService::Schedule(std::chrono::milliseconds delay,
+                                             Callback callback) {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  // round up, so a timer never expires early
+  uint64_t ticks = delay.count() > 0
+                       ? static_cast< uint64_t >(
+                             (delay.count() + tick_.count() - 1) / tick_.count())
+                       : 1;
+  uint64_t elapsed = static_cast< uint64_t >(
+      std::chrono::duration_cast< std::chrono::milliseconds >(
+          std::chrono::steady_clock::now() - start_)
+          .count()
+      / tick_.count());
+
+  Timer timer;
+  timer.expiry = std::max(elapsed, currentTick_) + ticks;
+  timer.callback = std::move(callback);
+
+  TimerId id = ++lastId_;
+  size_t slot = static_cast< size_t >(timer.expiry % slots_.size());
+  slots_[slot].emplace(id, std::move(timer));
+  index_.emplace(id, slot);
+
+  if (!thread_.joinable()) {
+    LOG_DEBUG_MSG("Starting timer thread");
+    thread_ = std::thread(&TimerService::Run, this);
+  } else if (index_.size() == 1) {
+    // the thread sleeps without a deadline while no timer is pending
+    cv_.notify_one();
+  }
+
+  return id;
+}
+
+bool TimerService::Cancel(TimerId id) {
+  std::lock_guard< std::mutex > lock(mutex_);
+
+  auto it = index_.find(id);
+  if (it == index_.end()) {
+    return false;
+  }
+
+  slots_[it->second].erase(id);
+  index_.erase(it);
+
+  return true;
+}
+
+size_t TimerService::GetPendingCount() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+  return index_.size();
+}
+
+void TimerService::Run() {
+  std::vector< Callback > expired;
+
+  std::unique_lock< std::mutex > lock(mutex_);
+  while (!stopping_) {
+    if (index_.empty()) {
+      cv_.wait(lock, [&]() { return stopping_ || !index_.empty(); });
+      continue;
+    }
+
+    cv_.wait_until(lock, start_ + tick_ * (currentTick_ + 1));
+    if (stopping_) {
+      break;
+    }
+
+    uint64_t now = static_cast< uint64_t >(
+        (std::chrono::steady_clock::now() - start_) / tick_);
+
+    // catch up with all ticks passed since the last wake up, a full turn of
+    // the wheel visits every slot
+    uint64_t last = std::min(now, currentTick_ + slots_.size());
+    for (uint64_t tick = currentTick_ + 1; tick <= last; ++tick) {
+      size_t slot = static_cast< size_t >(tick % slots_.size());
+      auto& timers = slots_[slot];
+      for (auto it = timers.begin(); it != timers.end();) {
+        if (it->second.expiry <= now) {
+          expired.push_back(std::move(it->second.callback));
+          index_.erase(it->first);
+          it = timers.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+    currentTick_ = std::max(currentTick_, now);
+
+    if (expired.empty()) {
+      continue;
+    }
+
+    // callbacks may arm or cancel timers
+    lock.unlock();
+    for (Callback& callback : expired) {
+      callback();
+    }
+    expired.clear();
+    lock.lock();
+  }
+}
+}  // namespace odbc
+}  // namespace trino
@@ -19,6 +19,8 @@
  */
 
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <time.h>
 #include "trino/odbc/trino_column.h"
@@ -45,6 +47,17 @@ TrinoColumn::TrinoColumn(
 
 ConversionResult::Type TrinoColumn::ReadToBuffer(const Datum& datum, ApplicationDataBuffer& dataBuf) const {
   LOG_DEBUG_MSG("ReadToBuffer is called");
+
+  std::string value;
+  PageCell::Kind::Type kind = DecodeDatum(datum, value);
+
+  return ReadToBuffer(kind, value.c_str(), value.size(), dataBuf);
+}
+
+ConversionResult::Type TrinoColumn::ReadToBuffer(
+    PageCell::Kind::Type kind, const char* value, size_t length,
+    ApplicationDataBuffer& dataBuf) const {
+  LOG_DEBUG_MSG("ReadToBuffer is called with kind " << kind);
   const boost::optional< client::TrinoQuery::Model::ColumnInfo >& columnInfo =
       columnMeta_.GetColumnInfo(); /*@*/
 
@@ -53,40 +66,82 @@ ConversionResult::Type TrinoColumn::ReadToBuffer(const Datum& datum, Application
     return ConversionResult::Type::AI_FAILURE;
   }
 
-  ConversionResult::Type retval = ParseDatum(datum, dataBuf);
-
-  return retval;
+  return PutValue(kind, value, length, dataBuf);
 }
 
-ConversionResult::Type TrinoColumn::ParseDatum(
-    const Datum& datum, ApplicationDataBuffer& dataBuf) const {
-  LOG_DEBUG_MSG("ParseDatum is called");
+PageCell::Kind::Type TrinoColumn::DecodeDatum(const Datum& datum,
+                                              std::string& value) const {
+  LOG_DEBUG_MSG("DecodeDatum is called");
 
-  ConversionResult::Type retval = ConversionResult::Type::AI_FAILURE;
+  value.clear();
   if (datum.ScalarValueHasBeenSet()) {
-    retval = ParseScalarType(datum, dataBuf);
+    value = datum.GetScalarValue();
+    return PageCell::Kind::SCALAR;
   } else if (datum.TimeSeriesValueHasBeenSet()) {
-    retval = ParseTimeSeriesType(datum, dataBuf);
+    FormatTimeSeriesType(datum, value);
+    return PageCell::Kind::TEXT;
   } else if (datum.ArrayValueHasBeenSet()) {
-    retval = ParseArrayType(datum, dataBuf);
+    FormatArrayType(datum, value);
+    return PageCell::Kind::TEXT;
   } else if (datum.RowValueHasBeenSet()) {
-    retval = ParseRowType(datum, dataBuf);
+    if (!FormatRowType(datum, value)) {
+      return PageCell::Kind::NO_DATA;
+    }
+    return PageCell::Kind::TEXT;
   } else if (datum.NullValueHasBeenSet()) {
-    dataBuf.PutString("-");
-    retval = ConversionResult::Type::AI_SUCCESS;
-  } else {
-    LOG_ERROR_MSG("Unsupported data type");
+    return PageCell::Kind::NULL_VALUE;
+  }
+
+  LOG_ERROR_MSG("Unsupported data type");
+  return PageCell::Kind::UNSUPPORTED;
+}
+
+ConversionResult::Type TrinoColumn::PutValue(
+    PageCell::Kind::Type kind, const char* value, size_t length,
+    ApplicationDataBuffer& dataBuf) const {
+  LOG_DEBUG_MSG("PutValue is called");
+
+  ConversionResult::Type retval = ConversionResult::Type::AI_FAILURE;
+  switch (kind) {
+    case PageCell::Kind::SCALAR:
+      retval = ParseScalarType(value, length, dataBuf);
+      break;
+    case PageCell::Kind::TEXT: {
+      retval = dataBuf.PutString(value, length);
+      LOG_DEBUG_MSG("convRes is " << static_cast< int >(retval));
+      break;
+    }
+    case PageCell::Kind::NULL_VALUE:
+      dataBuf.PutString("-");
+      retval = ConversionResult::Type::AI_SUCCESS;
+      break;
+    case PageCell::Kind::NO_DATA:
+      LOG_DEBUG_MSG("No data is set for the row");
+      retval = ConversionResult::Type::AI_NO_DATA;
+      break;
+    default:
+      break;
   }
 
   return retval;
 }
 
+void TrinoColumn::AppendElement(const Datum& datum, std::string& result) const {
+  char buf[BUFFER_SIZE]{};
+  SqlLen resLen;
+  ApplicationDataBuffer tmpBuf(OdbcNativeType::Type::AI_CHAR,
+                               static_cast< void* >(buf), BUFFER_SIZE,
+                               &resLen);
+  std::string value;
+  PageCell::Kind::Type kind = DecodeDatum(datum, value);
+  PutValue(kind, value.c_str(), value.size(), tmpBuf);
+  result += buf;
+}
+
 ConversionResult::Type TrinoColumn::ParseScalarType(
-    const client::TrinoQuery::Model::Datum& datum,
-    ApplicationDataBuffer& dataBuf) const { /*@*/
+    const char* value, size_t length, ApplicationDataBuffer& dataBuf) const {
   LOG_DEBUG_MSG("ParseScalarType is called");
 
-  Aws::String value = datum.GetScalarValue(); /*@*/
   LOG_DEBUG_MSG("value is " << value << ", scalar type is "
                             << static_cast< int >(columnMeta_.GetScalarType()));
 
@@ -94,7 +149,7 @@ ConversionResult::Type TrinoColumn::ParseScalarType(
 
   switch (columnMeta_.GetScalarType()) {
     case ScalarType::VARCHAR:
-      convRes = dataBuf.PutString(value);
+      convRes = dataBuf.PutString(value, length);
       break;
     case ScalarType::DOUBLE:
       // There could be a precision problem for stod as double can not be
@@ -102,16 +157,17 @@ ConversionResult::Type TrinoColumn::ParseScalarType(
       // double value 35.2 in string, std::stod("35.2") could
       // return 35.200000000000003 on Windows. These rounding errors are a
       // common issue in floating-point arithmetic and can not be avoided.
-      convRes = dataBuf.PutDouble(std::stod(value));
+      convRes = dataBuf.PutDouble(std::strtod(value, nullptr));
       break;
     case ScalarType::BOOLEAN:
-      convRes = dataBuf.PutInt8(value == "true" ? 1 : 0);
+      convRes = dataBuf.PutInt8(std::strcmp(value, "true") == 0 ? 1 : 0);
       break;
     case ScalarType::INTEGER:
-      convRes = dataBuf.PutInt32(utility::StringToInt(value));
+      convRes = dataBuf.PutInt32(
+          static_cast< int32_t >(std::strtol(value, nullptr, 10)));
       break;
     case ScalarType::BIGINT:
-      convRes = dataBuf.PutInt64(utility::StringToLong(value));
+      convRes = dataBuf.PutInt64(std::strtoll(value, nullptr, 10));
       break;
     case ScalarType::NOT_SET:
     case ScalarType::UNKNOWN:
@@ -121,7 +177,7 @@ ConversionResult::Type TrinoColumn::ParseScalarType(
       tm tmTime;
       memset(&tmTime, 0, sizeof(tm));
       int32_t fractionNs;
-      std::sscanf(value.c_str(), "%4d-%2d-%2d %2d:%2d:%2d.%9d", &tmTime.tm_year,
+      std::sscanf(value, "%4d-%2d-%2d %2d:%2d:%2d.%9d", &tmTime.tm_year,
                   &tmTime.tm_mon, &tmTime.tm_mday, &tmTime.tm_hour,
                   &tmTime.tm_min, &tmTime.tm_sec, &fractionNs);
       tmTime.tm_year -= 1900;
@@ -145,7 +201,7 @@ ConversionResult::Type TrinoColumn::ParseScalarType(
       tm tmTime;
       memset(&tmTime, 0, sizeof(tm));
       int32_t fractionNs;
-      std::sscanf(value.c_str(), "%4d-%2d-%2d", &tmTime.tm_year, &tmTime.tm_mon,
+      std::sscanf(value, "%4d-%2d-%2d", &tmTime.tm_year, &tmTime.tm_mon,
                   &tmTime.tm_mday);
       tmTime.tm_year -= 1900;
       tmTime.tm_mon--;
@@ -163,7 +219,7 @@ ConversionResult::Type TrinoColumn::ParseScalarType(
       uint32_t minute;
       uint32_t second;
       int32_t fractionNs;
-      std::sscanf(value.c_str(), "%2d:%2d:%2d.%9d", &hour, &minute, &second,
+      std::sscanf(value, "%2d:%2d:%2d.%9d", &hour, &minute, &second,
                   &fractionNs);
       int32_t secondValue = (hour * 60 + minute) * 60 + second;
       convRes = dataBuf.PutTime(Time(secondValue, fractionNs));
@@ -171,13 +227,13 @@ ConversionResult::Type TrinoColumn::ParseScalarType(
     }
     case ScalarType::INTERVAL_YEAR_TO_MONTH: {
       int32_t year, month;
-      std::sscanf(value.c_str(), "%d-%d", &year, &month);
+      std::sscanf(value, "%d-%d", &year, &month);
       convRes = dataBuf.PutInterval(IntervalYearMonth(year, month));
       break;
     }
     case ScalarType::INTERVAL_DAY_TO_SECOND: {
       int32_t day, hour, minute, second, fraction;
-      std::sscanf(value.c_str(), "%d %2d:%2d:%2d.%9d", &day, &hour, &minute,
+      std::sscanf(value, "%d %2d:%2d:%2d.%9d", &day, &hour, &minute,
                   &second, &fraction);
       convRes = dataBuf.PutInterval(
           IntervalDaySecond(day, hour, minute, second, fraction));
@@ -191,14 +247,14 @@ ConversionResult::Type TrinoColumn::ParseScalarType(
   return convRes;
 }
 
-ConversionResult::Type TrinoColumn::ParseTimeSeriesType(
-    const Datum& datum, ApplicationDataBuffer& dataBuf) const {
-  LOG_DEBUG_MSG("ParseTimeSeriesType is called");
+void TrinoColumn::FormatTimeSeriesType(const Datum& datum,
+                                       std::string& result) const {
+  LOG_DEBUG_MSG("FormatTimeSeriesType is called");
 
   const Aws::Vector< TimeSeriesDataPoint >& valueVec =
       datum.GetTimeSeriesValue(); /*@*/
 
-  std::string result = "[";
+  result = "[";
   for (const auto& itr : valueVec) {
     result += "{time: ";
     if (itr.TimeHasBeenSet()) {
@@ -207,13 +263,7 @@ ConversionResult::Type TrinoColumn::ParseTimeSeriesType(
     result += ", value: ";
 
     if (itr.ValueHasBeenSet()) {
-      char buf[BUFFER_SIZE]{};
-      SqlLen resLen;
-      ApplicationDataBuffer tmpBuf(OdbcNativeType::Type::AI_CHAR,
-                                   static_cast< void* >(buf), BUFFER_SIZE,
-                                   &resLen);
-      ParseDatum(itr.GetValue(), tmpBuf);
-      result += buf;
+      AppendElement(itr.GetValue(), result);
     }
 
     result += "},";
@@ -222,66 +272,42 @@ ConversionResult::Type TrinoColumn::ParseTimeSeriesType(
     result.pop_back();
   }
   result += "]";
-
-  ConversionResult::Type convRes = dataBuf.PutString(result);
-
-  LOG_DEBUG_MSG("convRes is " << static_cast< int >(convRes));
-  return convRes;
 }
 
-ConversionResult::Type TrinoColumn::ParseArrayType(
-    const Datum& datum, ApplicationDataBuffer& dataBuf) const {
-  LOG_DEBUG_MSG("ParseArrayType is called");
+void TrinoColumn::FormatArrayType(const Datum& datum,
+                                  std::string& result) const {
+  LOG_DEBUG_MSG("FormatArrayType is called");
 
   const Aws::Vector< Datum >& valueVec = datum.GetArrayValue(); /*@*/
 
-  std::string result("");
   if (valueVec.empty()) {
     result = "-";
   } else {
     result = "[";
     for (const auto& itr : valueVec) {
-      char buf[BUFFER_SIZE]{};
-      SqlLen resLen;
-      ApplicationDataBuffer tmpBuf(OdbcNativeType::Type::AI_CHAR,
-                                   static_cast< void* >(buf), BUFFER_SIZE,
-                                   &resLen);
-      ParseDatum(itr, tmpBuf);
-      result += buf;
+      AppendElement(itr, result);
 
       result += ",";
     }
     result.pop_back();
     result += "]";
   }
-
-  ConversionResult::Type convRes = dataBuf.PutString(result);
-
-  LOG_DEBUG_MSG("convRes is " << static_cast< int >(convRes));
-  return convRes;
 }
 
-ConversionResult::Type TrinoColumn::ParseRowType(
-    const Datum& datum, ApplicationDataBuffer& dataBuf) const {
-  LOG_DEBUG_MSG("ParseRowType is called");
+bool TrinoColumn::FormatRowType(const Datum& datum, std::string& result) const {
+  LOG_DEBUG_MSG("FormatRowType is called");
 
   const Row& row = datum.GetRowValue();
 
   if (!row.DataHasBeenSet()) {
     LOG_DEBUG_MSG("No data is set for the row");
-    return ConversionResult::Type::AI_NO_DATA;
+    return false;
   }
 
   const Aws::Vector< Datum >& valueVec = row.GetData(); /*@*/
-  std::string result = "(";
+  result = "(";
   for (const auto& itr : valueVec) {
-    char buf[BUFFER_SIZE]{};
-    SqlLen resLen;
-    ApplicationDataBuffer tmpBuf(OdbcNativeType::Type::AI_CHAR,
-                                 static_cast< void* >(buf), BUFFER_SIZE,
-                                 &resLen);
-    ParseDatum(itr, tmpBuf);
-    result += buf;
+    AppendElement(itr, result);
 
     result += ",";
   }
@@ -290,10 +316,7 @@ ConversionResult::Type TrinoColumn::ParseRowType(
   }
   result += ")";
 
-  ConversionResult::Type convRes = dataBuf.PutString(result);
-
-  LOG_DEBUG_MSG("convRes is " << static_cast< int >(convRes));
-  return convRes;
+  return true;
 }
 }  // namespace odbc
 }  // namespace trino
@@ -23,11 +23,19 @@
 namespace trino {
 namespace odbc {
 
-TrinoCursor::TrinoCursor(
-    const Aws::Vector< Row > rowVec,
-    const meta::ColumnMetaVector& columnMetadataVec) /*@*/
-    : rowVec_(rowVec),
-      iterator_(rowVec_.begin()),
+TrinoCursor::TrinoCursor(std::shared_ptr< const ResultPage > page,
+                         const meta::ColumnMetaVector& columnMetadataVec)
+    : page_(std::move(page)),
+      spill_(),
+      columnMetadataVec_(columnMetadataVec),
+      curPos_(0) {
+  // No-op.
+}
+
+TrinoCursor::TrinoCursor(std::shared_ptr< SpillStore > spill,
+                         const meta::ColumnMetaVector& columnMetadataVec)
+    : page_(),
+      spill_(std::move(spill)),
       columnMetadataVec_(columnMetadataVec),
       curPos_(0) {
   // No-op.
@@ -37,19 +45,20 @@ TrinoCursor::~TrinoCursor() {
   // No-op.
 }
 
-// After Increment, the "curPos_"th iterator is being handled
+// After Increment, the "curPos_"th row is being handled
 bool TrinoCursor::Increment() {
   LOG_DEBUG_MSG("Increment is called");
 
-  if (curPos_ > 0) {
-    ++iterator_;
-  }
   curPos_++;
-  return curPos_ <= rowVec_.size();
+  return HasData();
 }
 
 bool TrinoCursor::HasData() const {
-  return curPos_ <= rowVec_.size();
+  if (spill_) {
+    return curPos_ >= 1 && curPos_ <= spill_->GetRowCount();
+  }
+
+  return page_ && curPos_ <= page_->GetRowCount();
 }
 
 app::ConversionResult::Type TrinoCursor::ReadColumnToBuffer(
@@ -61,8 +70,32 @@ app::ConversionResult::Type TrinoCursor::ReadColumnToBuffer(
   }
 
   TrinoColumn& column = GetColumn(columnIdx);
-  const Datum& datum = iterator_->GetData()[columnIdx-1];
-  return column.ReadToBuffer(datum, dataBuf);
+
+  if (spill_) {
+    PageCell spilled;
+    const char* value = nullptr;
+    if (!HasData()
+        || !spill_->GetCell(curPos_ - 1, columnIdx - 1, spilled, value)) {
+      LOG_ERROR_MSG("No data for column " << columnIdx << " at row "
+                                          << curPos_);
+      return app::ConversionResult::Type::AI_FAILURE;
+    }
+
+    return column.ReadToBuffer(spilled.kind, value, spilled.length, dataBuf);
+  }
+
+  // Before the first Increment the cursor reads the first row
+  size_t rowIdx = curPos_ > 0 ? curPos_ - 1 : 0;
+  const PageCell* cell =
+      HasData() ? page_->GetArena().GetCell(rowIdx, columnIdx - 1) : nullptr;
+  if (!cell) {
+    LOG_ERROR_MSG("No data for column " << columnIdx << " at row " << curPos_);
+    return app::ConversionResult::Type::AI_FAILURE;
+  }
+
+  // the value is read in place from the arena
+  return column.ReadToBuffer(cell->kind, page_->GetArena().GetValue(*cell),
+                             cell->length, dataBuf);
 }
 
 bool TrinoCursor::EnsureColumnDiscovered(uint32_t columnIdx) {
@@ -0,0 +1,264 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "trino/odbc/tracer.h"
+
+#ifdef _WIN32
+#include "trino/odbc/system/odbc_constants.h"
+#else
+#include <unistd.h>
+#endif
+
+#include "trino/odbc/log.h"
+
+namespace {
+/** Largest number of events written at once. */
+const size_t BATCH_SIZE = 1024;
+
+/** Time the writer sleeps before looking for events again. */
+const std::chrono::milliseconds WRITER_IDLE(10);
+
+/** Source of the thread identifiers. */
+std::atomic< uint32_t > nextThreadId(1);
+
+/**
+ * Get identifier of the calling thread. Identifiers are small numbers
+ * handed out in the order threads record their first event, which keeps
+ * them readable in the trace viewer on every platform.
+ *
+ * @return Thread identifier.
+ */
+uint32_t GetThreadId() {
+  static thread_local uint32_t id = 0;
+  if (id == 0) {
+    id = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+  }
+  return id;
+}
+
+/**
+ * Get identifier of the process.
+ *
+ * @return Process identifier.
+ */
+uint64_t GetProcessId() {
+#ifdef _WIN32
+  return static_cast< uint64_t >(GetCurrentProcessId());
+#else
+  return static_cast< uint64_t >(getpid());
+#endif
+}
+
+/**
+ * Format a duration as microseconds with a fraction, the unit of the trace
+ * event timestamps.
+ *
+ * @param duration Duration.
+ * @return Formatted duration.
+ */
+std::string FormatMicros(std::chrono::steady_clock::duration duration) {
+  int64_t nanos =
+      std::chrono::duration_cast< std::chrono::nanoseconds >(duration).count();
+  if (nanos < 0) {
+    nanos = 0;
+  }
+
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%lld.%03d",
+                static_cast< long long >(nanos / 1000),
+                static_cast< int >(nanos % 1000));
+  return buffer;
+}
+}  // namespace
+
+namespace trino {
+namespace odbc {
+const size_t Tracer::QUEUE_CAPACITY;
+std::atomic< bool > Tracer::enabled(false);
+
+Tracer& Tracer::GetInstance() {
+  // never destroyed, the tasks of the static worker pools may still end
+  // spans while the pools are destroyed at exit
+  static Tracer* instance = new Tracer();
+  return *instance;
+}
+
+Tracer::Tracer()
+    : queue_(QUEUE_CAPACITY),
+      file_(nullptr),
+      path_(),
+      origin_(Clock::now()),
+      pid_(GetProcessId()),
+      first_(true),
+      dropped_(0),
+      writerRunning_(false),
+      stopping_(false) {
+  // No-op.
+}
+
+Tracer::~Tracer() {
+  Stop();
+}
+
+bool Tracer::Start(const std::string& path) {
+  std::lock_guard< std::mutex > control(controlMutex_);
+  if (file_) {
+    if (path != path_) {
+      LOG_WARNING_MSG("Trace events are already written to "
+                      << path_ << ", " << path << " is not used");
+    }
+    return path == path_;
+  }
+
+  file_ = std::fopen(path.c_str(), "wb");
+  if (!file_) {
+    LOG_ERROR_MSG("Failed to open trace event file " << path);
+    return false;
+  }
+
+  path_ = path;
+  first_ = true;
+  std::fputs("[\n", file_);
+
+  LOG_INFO_MSG("Writing trace events to " << path);
+  enabled.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+void Tracer::Stop() {
+  enabled.store(false, std::memory_order_relaxed);
+
+  std::lock_guard< std::mutex > control(controlMutex_);
+  StopWriter();
+  if (file_) {
+    std::fclose(file_);
+    file_ = nullptr;
+    path_.clear();
+  }
+}
+
+void Tracer::Complete(const char* name, const char* category,
+                      Clock::time_point start, Clock::time_point end) {
+  if (!IsEnabled()) {
+    return;
+  }
+
+  std::string event;
+  event.reserve(128);
+  event.append("{\"name\":\"")
+      .append(name)
+      .append("\",\"cat\":\"")
+      .append(category)
+      .append("\",\"ph\":\"X\",\"ts\":")
+      .append(FormatMicros(start - origin_))
+      .append(",\"dur\":")
+      .append(FormatMicros(end - start))
+      .append(",\"pid\":")
+      .append(std::to_string(pid_))
+      .append(",\"tid\":")
+      .append(std::to_string(GetThreadId()))
+      .append(1, '}');
+
+  if (!writerRunning_.load(std::memory_order_acquire)) {
+    StartWriter();
+  }
+
+  // the writer is never waited for, it catches up within its idle time
+  if (!queue_.TryPush(event)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void Tracer::Flush() {
+  std::lock_guard< std::mutex > control(controlMutex_);
+  StopWriter();
+}
+
+void Tracer::StopWriter() {
+  if (!writer_.joinable()) {
+    return;
+  }
+
+  {
+    std::lock_guard< std::mutex > lock(writerMutex_);
+    stopping_ = true;
+  }
+  writerCv_.notify_all();
+
+  // the writer drains the queue before it exits
+  writer_.join();
+  writerRunning_ = false;
+}
+
+void Tracer::StartWriter() {
+  std::lock_guard< std::mutex > control(controlMutex_);
+  if (writer_.joinable() || !file_) {
+    return;
+  }
+
+  stopping_ = false;
+  writer_ = std::thread(&Tracer::RunWriter, this);
+  writerRunning_ = true;
+}
+
+void Tracer::RunWriter() {
+  std::string batch;
+  std::string event;
+  int64_t reportedDrops = dropped_.load(std::memory_order_relaxed);
+
+  for (;;) {
+    batch.clear();
+    for (size_t count = 0; count < BATCH_SIZE && queue_.TryPop(event);
+         ++count) {
+      batch.append(first_ ? "" : ",\n").append(event);
+      first_ = false;
+    }
+
+    if (!batch.empty()) {
+      std::fwrite(batch.data(), 1, batch.size(), file_);
+      continue;
+    }
+
+    if (queue_.GetPopped() != queue_.GetPushed()) {
+      // a span claimed a position but has not stored the event yet
+      std::this_thread::yield();
+      continue;
+    }
+
+    std::fflush(file_);
+
+    int64_t drops = dropped_.load(std::memory_order_relaxed);
+    if (drops != reportedDrops) {
+      LOG_WARNING_MSG(drops - reportedDrops
+                      << " trace events were dropped, the queue was full");
+      reportedDrops = drops;
+    }
+
+    std::unique_lock< std::mutex > lock(writerMutex_);
+    if (stopping_) {
+      break;
+    }
+
+    // spans never wake the writer up, so recording stays a queue push
+    writerCv_.wait_for(lock, WRITER_IDLE, [this]() { return stopping_; });
+  }
+}
+}  // namespace odbc
+}  // namespace trino
@@ -350,6 +350,21 @@ std::string Trim(const std::string& s) {
   return Ltrim(Rtrim(s));
 }
 
+std::string QuoteSqlString(const std::string& value) {
+  std::string literal;
+  literal.reserve(value.size() + 2);
+
+  literal.push_back('\'');
+  for (char c : value) {
+    if (c == '\'')
+      literal.push_back('\'');
+    literal.push_back(c);
+  }
+  literal.push_back('\'');
+
+  return literal;
+}
+
 int UpdateRegexExpression(int index, int start, const std::string& pattern,
                           const std::string& str, std::string& converted) {
   LOG_DEBUG_MSG("UpdateRegexExpression is called with index is "
@@ -0,0 +1,144 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "trino/odbc/worker_pool.h"
+
+#include <exception>
+#include <limits>
+
+#include "trino/odbc/log.h"
+#include "trino/odbc/metrics.h"
+
+namespace {
+/**
+ * Thread limit of the driver-wide pool. Tasks mostly wait for the server,
+ * so the limit is well above the number of cores.
+ */
+const size_t DEFAULT_MAX_THREADS = 64;
+}  // namespace
+
+namespace trino {
+namespace odbc {
+WorkerPool& WorkerPool::GetInstance() {
+  static WorkerPool instance(DEFAULT_MAX_THREADS);
+  return instance;
+}
+
+WorkerPool& WorkerPool::GetRequestInstance() {
+  static WorkerPool instance(std::numeric_limits< size_t >::max());
+  return instance;
+}
+
+WorkerPool::WorkerPool(size_t maxThreads)
+    : maxThreads_(maxThreads > 0 ? maxThreads : 1),
+      tasks_(),
+      idle_(0),
+      running_(0),
+      stopping_(false) {
+  // No-op.
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    stopping_ = true;
+    cv_.notify_all();
+  }
+
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkerPool::Submit(Task task) {
+  std::lock_guard< std::mutex > lock(mutex_);
+  tasks_.push_back(std::move(task));
+
+  if (idle_ >= tasks_.size()) {
+    cv_.notify_one();
+  } else if (threads_.size() < maxThreads_) {
+    LOG_DEBUG_MSG("Starting worker thread " << threads_.size() + 1);
+    threads_.emplace_back(&WorkerPool::Run, this);
+    Metrics::GetInstance().workerThreads.Add(1);
+  } else {
+    LOG_DEBUG_MSG("All " << maxThreads_ << " worker threads are busy, "
+                         << tasks_.size() << " tasks are queued");
+  }
+}
+
+size_t WorkerPool::GetThreadCount() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+  return threads_.size();
+}
+
+size_t WorkerPool::GetQueuedCount() const {
+  std::lock_guard< std::mutex > lock(mutex_);
+  return tasks_.size();
+}
+
+void WorkerPool::Drain() {
+  std::unique_lock< std::mutex > lock(mutex_);
+  drained_.wait(lock, [&]() { return tasks_.empty() && running_ == 0; });
+}
+
+void WorkerPool::Run() {
+  Metrics& metrics = Metrics::GetInstance();
+  std::unique_lock< std::mutex > lock(mutex_);
+  while (true) {
+    if (tasks_.empty()) {
+      if (stopping_) {
+        break;
+      }
+
+      ++idle_;
+      cv_.wait(lock, [&]() { return stopping_ || !tasks_.empty(); });
+      --idle_;
+      continue;
+    }
+
+    Task task = std::move(tasks_.front());
+    tasks_.pop_front();
+    ++running_;
+
+    lock.unlock();
+    metrics.workersBusy.Add(1);
+    // an escaping exception would end the process on a worker thread
+    try {
+      task();
+    } catch (const std::exception& e) {
+      LOG_ERROR_MSG("Worker task failed: " << e.what());
+    } catch (...) {
+      LOG_ERROR_MSG("Worker task failed with an unknown error");
+    }
+    // the task and what it holds are released before the pool is drained
+    task = Task();
+    metrics.workersBusy.Add(-1);
+    lock.lock();
+
+    --running_;
+    if (tasks_.empty() && running_ == 0) {
+      drained_.notify_all();
+    }
+  }
+
+  metrics.workerThreads.Add(-1);
+}
+}  // namespace odbc
+}  // namespace trino
@@ -215,6 +215,15 @@ BOOST_AUTO_TEST_CASE(StatementAttributeCursorScrollable) {
 
   ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
   BOOST_REQUIRE_EQUAL(scrollable, SQL_NONSCROLLABLE);
+
+  ret = SQLSetStmtAttr(stmt, SQL_ATTR_CURSOR_SCROLLABLE,
+                       reinterpret_cast< SQLPOINTER >(SQL_SCROLLABLE), 0);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+
+  SQLULEN cursorType = -1;
+  ret = SQLGetStmtAttr(stmt, SQL_ATTR_CURSOR_TYPE, &cursorType, 0, 0);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+  BOOST_REQUIRE_EQUAL(cursorType, SQL_CURSOR_STATIC);
 }
 
 BOOST_AUTO_TEST_CASE(StatementAttributeCursorSensitivity) {
@@ -239,6 +248,24 @@ BOOST_AUTO_TEST_CASE(StatementAttributeAutoIPD) {
   BOOST_REQUIRE_EQUAL(autoIPD, SQL_FALSE);
 }
 
+BOOST_AUTO_TEST_CASE(StatementAttributeAsyncEnable) {
+  ConnectToTS();
+
+  SQLULEN enable = -1;
+  SQLRETURN ret = SQLGetStmtAttr(stmt, SQL_ATTR_ASYNC_ENABLE, &enable, 0, 0);
+
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+  BOOST_REQUIRE_EQUAL(enable, SQL_ASYNC_ENABLE_OFF);
+
+  ret = SQLSetStmtAttr(stmt, SQL_ATTR_ASYNC_ENABLE,
+                       reinterpret_cast< SQLPOINTER >(SQL_ASYNC_ENABLE_ON), 0);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+
+  ret = SQLGetStmtAttr(stmt, SQL_ATTR_ASYNC_ENABLE, &enable, 0, 0);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+  BOOST_REQUIRE_EQUAL(enable, SQL_ASYNC_ENABLE_ON);
+}
+
 BOOST_AUTO_TEST_CASE(StatementAttributeConcurrency) {
   ConnectToTS();
 
@@ -279,14 +306,21 @@ BOOST_AUTO_TEST_CASE(StatementAttributeCursorType) {
                        0);
   ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
 
-  // Attempt to set to unsupported value
   ret = SQLSetStmtAttr(stmt, SQL_ATTR_CURSOR_TYPE,
                        reinterpret_cast< SQLPOINTER >(SQL_CURSOR_STATIC), 0);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
 
-  BOOST_REQUIRE_EQUAL(ret, SQL_ERROR);
-  CheckSQLStatementDiagnosticError("HYC00");
-  BOOST_REQUIRE_EQUAL("HYC00: Only forward cursors are currently supported",
-                      GetOdbcErrorMessage(SQL_HANDLE_STMT, stmt));
+  // Keyset-driven cursors are substituted with static ones
+  ret = SQLSetStmtAttr(
+      stmt, SQL_ATTR_CURSOR_TYPE,
+      reinterpret_cast< SQLPOINTER >(SQL_CURSOR_KEYSET_DRIVEN), 0);
+
+  BOOST_REQUIRE_EQUAL(ret, SQL_SUCCESS_WITH_INFO);
+  CheckSQLStatementDiagnosticError("01S02");
+
+  ret = SQLGetStmtAttr(stmt, SQL_ATTR_CURSOR_TYPE, &cursorType, 0, 0);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+  BOOST_REQUIRE_EQUAL(cursorType, SQL_CURSOR_STATIC);
 }
 
 BOOST_AUTO_TEST_CASE(StatementAttributeRowArraySize) {
@@ -1064,12 +1098,9 @@ BOOST_AUTO_TEST_CASE(StatementOptionNotSupported) {
   // These unsupported options are blocked by driver manager
   CHECK_GET_OPTION_NOTSUPPORTED(SQL_GET_BOOKMARK);
   CHECK_GET_OPTION_NOTSUPPORTED(SQL_ROW_NUMBER);
-  CHECK_GET_OPTION_NOTSUPPORTED(SQL_ASYNC_ENABLE);
   CHECK_GET_OPTION_NOTSUPPORTED(SQL_KEYSET_SIZE);
   CHECK_GET_OPTION_NOTSUPPORTED(SQL_MAX_LENGTH);
-  CHECK_GET_OPTION_NOTSUPPORTED(SQL_MAX_ROWS);
   CHECK_GET_OPTION_NOTSUPPORTED(SQL_NOSCAN);
-  CHECK_GET_OPTION_NOTSUPPORTED(SQL_QUERY_TIMEOUT);
   CHECK_GET_OPTION_NOTSUPPORTED(SQL_SIMULATE_CURSOR);
   CHECK_GET_OPTION_NOTSUPPORTED(SQL_USE_BOOKMARKS);
 }
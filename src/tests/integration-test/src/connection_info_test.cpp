@@ -232,4 +232,31 @@ BOOST_AUTO_TEST_CASE(TestConnectionInfoSupportedInfo) {
 #endif  // SQL_QUOTED_IDENTIFIER_CASE
 }
 
+BOOST_AUTO_TEST_CASE(TestConnectionInfoSetInfoIsPerConnection) {
+  char buffer[4096];
+  short reslen = 0;
+
+  Configuration cfg;
+  ConnectionInfo first(cfg);
+  ConnectionInfo second(cfg);
+
+  BOOST_REQUIRE(first.SetInfo(SQL_USER_NAME, "alice")
+                == SqlResult::AI_SUCCESS);
+
+  // only string values can be set
+  BOOST_CHECK(first.SetInfo(SQL_TXN_CAPABLE, "1") == SqlResult::AI_ERROR);
+
+  BOOST_REQUIRE(first.GetInfo(SQL_USER_NAME, buffer, sizeof(buffer), &reslen)
+                == SqlResult::AI_SUCCESS);
+  BOOST_CHECK_EQUAL(static_cast< short >(5 * sizeof(SQLWCHAR)), reslen);
+
+  // the other connection still reports the shared value
+  BOOST_REQUIRE(second.GetInfo(SQL_USER_NAME, buffer, sizeof(buffer), &reslen)
+                == SqlResult::AI_SUCCESS);
+  BOOST_CHECK_EQUAL(0, reslen);
+
+  BOOST_CHECK(first.GetInfo(-1, buffer, sizeof(buffer), &reslen)
+              == SqlResult::AI_ERROR);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -295,6 +295,127 @@ BOOST_AUTO_TEST_CASE(TestSQLSetPos) {
                       GetOdbcErrorMessage(SQL_HANDLE_STMT, stmt));
 }
 
+BOOST_AUTO_TEST_CASE(TestMaxRows) {
+  ConnectToTS();
+
+  SQLRETURN ret = SQLSetStmtAttr(stmt, SQL_ATTR_MAX_ROWS,
+                                 reinterpret_cast< SQLPOINTER >(3), 0);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+
+  SQLULEN maxRows = 0;
+  ret = SQLGetStmtAttr(stmt, SQL_ATTR_MAX_ROWS, &maxRows, 0, 0);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+  BOOST_CHECK_EQUAL(3, maxRows);
+
+  std::vector< SQLWCHAR > request =
+      MakeSqlBuffer("SELECT * FROM UNNEST(SEQUENCE(1, 10)) AS t(x)");
+
+  ret = SQLExecDirect(stmt, request.data(), SQL_NTS);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+
+  SQLBIGINT value = 0;
+  SQLLEN ind = 0;
+  ret = SQLBindCol(stmt, 1, SQL_C_SBIGINT, &value, sizeof(value), &ind);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+
+  for (SQLBIGINT i = 1; i <= 3; ++i) {
+    ret = SQLFetch(stmt);
+    ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+    BOOST_CHECK_EQUAL(i, value);
+  }
+
+  ret = SQLFetch(stmt);
+  BOOST_CHECK_EQUAL(SQL_NO_DATA, ret);
+}
+
+BOOST_AUTO_TEST_CASE(TestAsyncExecution) {
+  ConnectToTS();
+
+  SQLRETURN ret =
+      SQLSetStmtAttr(stmt, SQL_ATTR_ASYNC_ENABLE,
+                     reinterpret_cast< SQLPOINTER >(SQL_ASYNC_ENABLE_ON), 0);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+
+  std::vector< SQLWCHAR > request =
+      MakeSqlBuffer("SELECT * FROM UNNEST(SEQUENCE(1, 10)) AS t(x)");
+
+  // the first call only starts the query
+  ret = SQLExecDirect(stmt, request.data(), SQL_NTS);
+  BOOST_CHECK_EQUAL(SQL_STILL_EXECUTING, ret);
+  while (ret == SQL_STILL_EXECUTING) {
+    ret = SQLExecDirect(stmt, request.data(), SQL_NTS);
+  }
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+
+  SQLBIGINT value = 0;
+  SQLLEN ind = 0;
+  ret = SQLBindCol(stmt, 1, SQL_C_SBIGINT, &value, sizeof(value), &ind);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+
+  for (SQLBIGINT i = 1; i <= 10; ++i) {
+    do {
+      ret = SQLFetch(stmt);
+    } while (ret == SQL_STILL_EXECUTING);
+    ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+    BOOST_CHECK_EQUAL(i, value);
+  }
+
+  do {
+    ret = SQLFetch(stmt);
+  } while (ret == SQL_STILL_EXECUTING);
+  BOOST_CHECK_EQUAL(SQL_NO_DATA, ret);
+}
+
+BOOST_AUTO_TEST_CASE(TestSQLFetchScrollStaticCursor) {
+  ConnectToTS();
+
+  SQLRETURN ret = SQLSetStmtAttr(
+      stmt, SQL_ATTR_CURSOR_TYPE,
+      reinterpret_cast< SQLPOINTER >(SQL_CURSOR_STATIC), 0);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+
+  std::vector< SQLWCHAR > request =
+      MakeSqlBuffer("SELECT * FROM UNNEST(SEQUENCE(1, 10)) AS t(x)");
+
+  ret = SQLExecDirect(stmt, request.data(), SQL_NTS);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+
+  SQLBIGINT value = 0;
+  SQLLEN ind = 0;
+  ret = SQLBindCol(stmt, 1, SQL_C_SBIGINT, &value, sizeof(value), &ind);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+
+  ret = SQLFetchScroll(stmt, SQL_FETCH_LAST, 0);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+  BOOST_CHECK_EQUAL(10, value);
+
+  ret = SQLFetchScroll(stmt, SQL_FETCH_PRIOR, 0);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+  BOOST_CHECK_EQUAL(9, value);
+
+  ret = SQLFetchScroll(stmt, SQL_FETCH_ABSOLUTE, 3);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+  BOOST_CHECK_EQUAL(3, value);
+
+  ret = SQLFetchScroll(stmt, SQL_FETCH_RELATIVE, -2);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+  BOOST_CHECK_EQUAL(1, value);
+
+  ret = SQLFetchScroll(stmt, SQL_FETCH_PRIOR, 0);
+  BOOST_CHECK_EQUAL(SQL_NO_DATA, ret);
+
+  ret = SQLFetch(stmt);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+  BOOST_CHECK_EQUAL(1, value);
+
+  ret = SQLFetchScroll(stmt, SQL_FETCH_ABSOLUTE, 11);
+  BOOST_CHECK_EQUAL(SQL_NO_DATA, ret);
+
+  ret = SQLFetchScroll(stmt, SQL_FETCH_ABSOLUTE, -10);
+  ODBC_FAIL_ON_ERROR(ret, SQL_HANDLE_STMT, stmt);
+  BOOST_CHECK_EQUAL(1, value);
+}
+
 BOOST_AUTO_TEST_CASE(TestSQLSetDescRec) {
   ConnectToTS();
 
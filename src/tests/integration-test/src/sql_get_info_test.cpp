@@ -168,13 +168,13 @@ BOOST_AUTO_TEST_CASE(TestValues) {
   CheckStrInfo(SQL_PROCEDURE_TERM, "");
   CheckStrInfo(SQL_PROCEDURES, "N");
   CheckStrInfo(SQL_ROW_UPDATES, "N");
-  CheckStrInfo(SQL_SEARCH_PATTERN_ESCAPE, "");
+  CheckStrInfo(SQL_SEARCH_PATTERN_ESCAPE, "\\");
   CheckStrInfo(SQL_SERVER_NAME, "AWS Trino");
   std::string expectedUserName =
       ignite::odbc::common::GetEnv("AWS_ACCESS_KEY_ID");
   CheckStrInfo(SQL_USER_NAME, expectedUserName);
 
-  CheckIntInfo(SQL_ASYNC_MODE, SQL_AM_NONE);
+  CheckIntInfo(SQL_ASYNC_MODE, SQL_AM_STATEMENT);
   CheckIntInfo(SQL_BATCH_ROW_COUNT, 0);
   CheckIntInfo(SQL_BATCH_SUPPORT, 0);
   CheckIntInfo(SQL_BOOKMARK_PERSISTENCE, 0);
@@ -209,11 +209,10 @@ BOOST_AUTO_TEST_CASE(TestValues) {
                                                  | SQL_SDF_CURRENT_TIMESTAMP);
   CheckIntInfo(SQL_SQL92_VALUE_EXPRESSIONS, SQL_SVE_CASE | SQL_SVE_CAST);
   CheckIntInfo(SQL_STATIC_CURSOR_ATTRIBUTES1,
-               SQL_CA1_NEXT | SQL_CA1_ABSOLUTE | SQL_CA1_RELATIVE
-                   | SQL_CA1_BOOKMARK | SQL_CA1_LOCK_NO_CHANGE
-                   | SQL_CA1_POS_POSITION | SQL_CA1_POS_REFRESH);
+               SQL_CA1_NEXT | SQL_CA1_ABSOLUTE | SQL_CA1_RELATIVE);
   CheckIntInfo(SQL_STATIC_CURSOR_ATTRIBUTES2,
-               SQL_CA2_READ_ONLY_CONCURRENCY | SQL_CA2_CRC_EXACT);
+               SQL_CA2_READ_ONLY_CONCURRENCY | SQL_CA2_MAX_ROWS_SELECT
+                   | SQL_CA2_CRC_EXACT);
   CheckIntInfo(SQL_PARAM_ARRAY_ROW_COUNTS, SQL_PARC_BATCH);
   CheckIntInfo(SQL_PARAM_ARRAY_SELECTS, SQL_PAS_NO_BATCH);
   CheckIntInfo(SQL_SCROLL_OPTIONS, SQL_SO_FORWARD_ONLY | SQL_SO_STATIC);
@@ -246,7 +245,8 @@ BOOST_AUTO_TEST_CASE(TestValues) {
   CheckIntInfo(SQL_DYNAMIC_CURSOR_ATTRIBUTES2, 0);
   CheckIntInfo(SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES1, SQL_CA1_NEXT);
   CheckIntInfo(SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES2,
-               SQL_CA2_READ_ONLY_CONCURRENCY | SQL_CA2_CRC_EXACT);
+               SQL_CA2_READ_ONLY_CONCURRENCY | SQL_CA2_MAX_ROWS_SELECT
+                   | SQL_CA2_CRC_EXACT);
   CheckIntInfo(SQL_INDEX_KEYWORDS, SQL_IK_NONE);
   CheckIntInfo(SQL_INFO_SCHEMA_VIEWS, 0);
   CheckIntInfo(SQL_INSERT_STATEMENT, 0);
@@ -346,7 +346,7 @@ BOOST_AUTO_TEST_CASE(TestValues) {
   CheckIntInfo(SQL_FETCH_DIRECTION,
                SQL_FD_FETCH_NEXT | SQL_FD_FETCH_FIRST | SQL_FD_FETCH_LAST
                    | SQL_FD_FETCH_PRIOR | SQL_FD_FETCH_ABSOLUTE
-                   | SQL_FD_FETCH_RELATIVE | SQL_FD_FETCH_BOOKMARK);
+                   | SQL_FD_FETCH_RELATIVE);
 
   CheckShortInfo(SQL_MAX_CONCURRENT_ACTIVITIES, 0);
   CheckShortInfo(SQL_QUOTED_IDENTIFIER_CASE, SQL_IC_SENSITIVE);
@@ -21,6 +21,7 @@
 #include <aws/core/Aws.h>
 #include <aws/core/auth/AWSCredentials.h>
 #include <aws/trino-query/TrinoQueryClient.h>
+#include <aws/trino-query/model/CancelQueryRequest.h>
 #include <aws/trino-query/model/QueryRequest.h>
 
 namespace trino {
@@ -60,6 +61,15 @@ class MockTrinoQueryClient
   virtual Aws::TrinoQuery::Model::QueryOutcome Query(
       const Aws::TrinoQuery::Model::QueryRequest &request) const;
 
+  /**
+   * Cancel a query.
+   *
+   * @param request Cancel request.
+   * @return Operation outcome.
+   */
+  virtual Aws::TrinoQuery::Model::CancelQueryOutcome CancelQuery(
+      const Aws::TrinoQuery::Model::CancelQueryRequest &request) const;
+
  private:
   Aws::Auth::AWSCredentials credentials_;
   Aws::Client::ClientConfiguration clientConfiguration_;
@@ -21,8 +21,14 @@
 #include <aws/core/Aws.h>
 #include <aws/core/auth/AWSCredentials.h>
 #include <aws/trino-query/TrinoQueryClient.h>
+#include <aws/trino-query/model/CancelQueryRequest.h>
 #include <aws/trino-query/model/QueryRequest.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
 namespace trino {
 namespace odbc {
 /**
@@ -92,11 +98,68 @@ class MockTrinoService {
   Aws::TrinoQuery::Model::QueryOutcome HandleQueryReq(
       const Aws::TrinoQuery::Model::QueryRequest& request);
 
+  /**
+   * Handle cancel request from query client
+   *
+   * @param request Cancel request
+   */
+  Aws::TrinoQuery::Model::CancelQueryOutcome HandleCancelQueryReq(
+      const Aws::TrinoQuery::Model::CancelQueryRequest& request);
+
+  /**
+   * Get number of cancel requests received
+   *
+   * @return Number of cancel requests
+   */
+  int GetCancelCount();
+
+  /**
+   * Get number of INSERT statements into the insert mock table that
+   * succeeded
+   *
+   * @return Number of INSERT statements
+   */
+  int GetInsertCount();
+
+  /**
+   * Get number of rows inserted into the insert mock table
+   *
+   * @return Number of rows
+   */
+  int64_t GetInsertedRows();
+
+  /**
+   * Get number of page requests of the latency mock table
+   *
+   * @return Number of page requests
+   */
+  int GetLatencyRequestCount();
+
+  /** Time the slow mock table takes to return a page after the first one */
+  static const std::chrono::milliseconds SLOW_PAGE_DELAY;
+
+  /**
+   * Time an insert of the slow value takes, longer than the shortest query
+   * timeout
+   */
+  static const std::chrono::milliseconds SLOW_INSERT_DELAY;
+
+  /** Time the latency mock table takes to return every page */
+  static const std::chrono::milliseconds LATENCY_PAGE_DELAY;
+
+  /** Number of pages of the latency mock table, 3 rows each */
+  static const int LATENCY_PAGE_COUNT;
+
  private:
   /**
    * Constructor.
    */
-  MockTrinoService() {
+  MockTrinoService()
+      : cancelCount_(0),
+        cancelled_(false),
+        insertCount_(0),
+        insertedRows_(0),
+        latencyRequestCount_(0) {
   }
 
   void SetupResultForMockTable(
@@ -106,8 +169,19 @@ class MockTrinoService {
   static MockTrinoService* instance_;
   std::map< Aws::String, Aws::String >
       credMap_;  // credentials configured by user
-  static int token;
+  static std::atomic< int > token;
   static int errorToken;
+
+  std::mutex cancelMutex_;  // guards the cancel state
+  std::condition_variable cancelCv_;  // wakes up slow page requests
+  int cancelCount_;  // number of cancel requests received
+  bool cancelled_;  // the slow query is cancelled
+
+  std::mutex insertMutex_;  // guards the insert counters
+  int insertCount_;  // number of INSERT statements that succeeded
+  int64_t insertedRows_;  // number of rows inserted
+
+  std::atomic< int > latencyRequestCount_;  // page requests of latency table
 };
 }  // namespace odbc
 }  // namespace trino
@@ -0,0 +1,114 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <trino/odbc/fan_out.h>
+
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace trino::odbc;
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE(FanOutTestSuite)
+
+BOOST_AUTO_TEST_CASE(TestResultsKeepTaskOrder) {
+  WorkerPool pool(8);
+  FanOut fanOut(4, pool);
+
+  std::vector< size_t > results(100, 0);
+  fanOut.Run(results.size(), [&](size_t idx) {
+    // later tasks finish first
+    std::this_thread::sleep_for(std::chrono::microseconds(100 - idx));
+    results[idx] = idx * idx;
+  });
+
+  for (size_t i = 0; i < results.size(); ++i) {
+    BOOST_CHECK_EQUAL(i * i, results[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestRunningTasksAreBounded) {
+  WorkerPool pool(8);
+  FanOut fanOut(3, pool);
+
+  std::atomic< int > running(0);
+  std::atomic< int > peak(0);
+  fanOut.Run(30, [&](size_t) {
+    int now = ++running;
+    int seen = peak.load();
+    while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    --running;
+  });
+
+  BOOST_CHECK_LE(peak.load(), 3);
+  BOOST_CHECK_GT(peak.load(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(TestRunsWhenPoolIsBusy) {
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool release = false;
+
+  WorkerPool pool(1);
+  pool.Submit([&]() {
+    std::unique_lock< std::mutex > lock(mutex);
+    cv.wait(lock, [&]() { return release; });
+  });
+
+  // the only worker is blocked, the caller runs every task itself
+  FanOut fanOut(4, pool);
+  std::atomic< int > done(0);
+  fanOut.Run(10, [&](size_t) { ++done; });
+  BOOST_CHECK_EQUAL(10, done.load());
+
+  std::lock_guard< std::mutex > lock(mutex);
+  release = true;
+  cv.notify_all();
+}
+
+BOOST_AUTO_TEST_CASE(TestThrowingTaskIsReported) {
+  WorkerPool pool(8);
+  FanOut fanOut(4, pool);
+
+  std::atomic< int > done(0);
+  std::vector< std::string > errors = fanOut.Run(20, [&](size_t idx) {
+    if (idx % 5 == 0) {
+      throw std::runtime_error("task failed");
+    }
+    ++done;
+  });
+
+  // the other tasks still run and the run waits for all of them
+  BOOST_CHECK_EQUAL(16, done.load());
+  BOOST_REQUIRE_EQUAL(20, errors.size());
+  for (size_t i = 0; i < errors.size(); ++i) {
+    BOOST_CHECK_EQUAL(i % 5 == 0 ? "task failed" : "", errors[i]);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
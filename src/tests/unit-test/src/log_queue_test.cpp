@@ -0,0 +1,112 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <trino/odbc/log_queue.h>
+
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace trino::odbc;
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE(LogQueueTestSuite)
+
+BOOST_AUTO_TEST_CASE(TestCapacityIsRounded) {
+  LogQueue queue(5);
+  BOOST_CHECK_EQUAL(8, queue.GetCapacity());
+}
+
+BOOST_AUTO_TEST_CASE(TestMessagesKeepOrder) {
+  LogQueue queue(4);
+  for (int i = 0; i < 3; ++i) {
+    std::string message = "message " + std::to_string(i);
+    BOOST_REQUIRE(queue.TryPush(message));
+  }
+
+  std::string message;
+  for (int i = 0; i < 3; ++i) {
+    BOOST_REQUIRE(queue.TryPop(message));
+    BOOST_CHECK_EQUAL("message " + std::to_string(i), message);
+  }
+  BOOST_CHECK(!queue.TryPop(message));
+}
+
+BOOST_AUTO_TEST_CASE(TestFullQueueRejects) {
+  LogQueue queue(2);
+  std::string first = "first";
+  std::string second = "second";
+  std::string third = "third";
+  BOOST_REQUIRE(queue.TryPush(first));
+  BOOST_REQUIRE(queue.TryPush(second));
+
+  // a rejected message stays with the caller
+  BOOST_CHECK(!queue.TryPush(third));
+  BOOST_CHECK_EQUAL("third", third);
+
+  std::string message;
+  BOOST_REQUIRE(queue.TryPop(message));
+  BOOST_CHECK_EQUAL("first", message);
+  BOOST_CHECK(queue.TryPush(third));
+  BOOST_CHECK_EQUAL(3, queue.GetPushed());
+  BOOST_CHECK_EQUAL(1, queue.GetPopped());
+}
+
+BOOST_AUTO_TEST_CASE(TestManyWriters) {
+  const int writers = 4;
+  const int messagesPerWriter = 10000;
+  LogQueue queue(64);
+
+  std::vector< std::thread > threads;
+  for (int w = 0; w < writers; ++w) {
+    threads.emplace_back([&queue, w]() {
+      for (int i = 0; i < messagesPerWriter; ++i) {
+        std::string message = std::to_string(w) + ":" + std::to_string(i);
+        while (!queue.TryPush(message)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // messages of one writer come out in the order they were written
+  std::vector< int > next(writers, 0);
+  int popped = 0;
+  std::string message;
+  while (popped < writers * messagesPerWriter) {
+    if (!queue.TryPop(message)) {
+      std::this_thread::yield();
+      continue;
+    }
+    size_t colon = message.find(':');
+    int w = std::stoi(message.substr(0, colon));
+    BOOST_REQUIRE_EQUAL(next[w], std::stoi(message.substr(colon + 1)));
+    ++next[w];
+    ++popped;
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK(!queue.TryPop(message));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
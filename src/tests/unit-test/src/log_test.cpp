@@ -458,6 +458,22 @@ BOOST_AUTO_TEST_CASE(TestLogSetInvalidLogPath) {
     setLoggerVars(logger, origLogPath, origLogLevel);
 }
 
+BOOST_AUTO_TEST_CASE(TestLogLevelEnabledCheck) {
+  std::shared_ptr< Logger > logger = Logger::GetLoggerInstance();
+  LogLevel::Type origLogLevel = logger->GetLogLevel();
+
+  logger->SetLogLevel(LogLevel::Type::WARNING_LEVEL);
+  BOOST_CHECK(Logger::IsLevelEnabled(LogLevel::Type::ERROR_LEVEL));
+  BOOST_CHECK(Logger::IsLevelEnabled(LogLevel::Type::WARNING_LEVEL));
+  BOOST_CHECK(!Logger::IsLevelEnabled(LogLevel::Type::INFO_LEVEL));
+  BOOST_CHECK(!Logger::IsLevelEnabled(LogLevel::Type::DEBUG_LEVEL));
+
+  logger->SetLogLevel(LogLevel::Type::OFF);
+  BOOST_CHECK(!Logger::IsLevelEnabled(LogLevel::Type::ERROR_LEVEL));
+
+  logger->SetLogLevel(origLogLevel);
+}
+
 BOOST_AUTO_TEST_CASE(TestAWSLogLevelParseMixedCases) {
   using trino::odbc::Connection;
 
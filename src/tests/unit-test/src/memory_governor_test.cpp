@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <trino/odbc/memory_governor.h>
+#include <trino/odbc/page_arena.h>
+
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace trino::odbc;
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE(MemoryGovernorTestSuite)
+
+BOOST_AUTO_TEST_CASE(TestReserveChargesAncestors) {
+  std::shared_ptr< MemoryGovernor > root =
+      std::make_shared< MemoryGovernor >(0);
+  MemoryGovernor child(100, root);
+
+  child.Reserve(60);
+  BOOST_CHECK_EQUAL(60, child.GetUsage());
+  BOOST_CHECK_EQUAL(60, root->GetUsage());
+  BOOST_CHECK(!child.IsOverBudget());
+
+  child.Reserve(40);
+  BOOST_CHECK(child.IsOverBudget());
+  BOOST_CHECK(!root->IsOverBudget());
+
+  child.Release(100);
+  BOOST_CHECK_EQUAL(0, child.GetUsage());
+  BOOST_CHECK_EQUAL(0, root->GetUsage());
+  BOOST_CHECK_EQUAL(100, root->GetPeakUsage());
+}
+
+BOOST_AUTO_TEST_CASE(TestRootLimitAppliesToChildren) {
+  std::shared_ptr< MemoryGovernor > root =
+      std::make_shared< MemoryGovernor >(100);
+  MemoryGovernor first(0, root);
+  MemoryGovernor second(0, root);
+
+  first.Reserve(100);
+  BOOST_CHECK(second.IsOverBudget());
+
+  root->SetLimit(0);
+  BOOST_CHECK(!second.IsOverBudget());
+
+  first.Release(100);
+}
+
+BOOST_AUTO_TEST_CASE(TestWaitForBudgetBlocksUntilRelease) {
+  std::shared_ptr< MemoryGovernor > root =
+      std::make_shared< MemoryGovernor >(100);
+  root->Reserve(100);
+
+  std::atomic< bool > done(false);
+  std::thread waiter([&]() {
+    root->WaitForBudget([]() { return false; });
+    done = true;
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  BOOST_CHECK(!done);
+
+  root->Release(50);
+  waiter.join();
+
+  BOOST_CHECK(done);
+  BOOST_CHECK_EQUAL(1, root->GetThrottledCount());
+  root->Release(50);
+}
+
+BOOST_AUTO_TEST_CASE(TestWaitForBudgetProceedsOnPredicate) {
+  std::shared_ptr< MemoryGovernor > root =
+      std::make_shared< MemoryGovernor >(100);
+  root->Reserve(100);
+
+  std::atomic< bool > proceed(false);
+  std::thread waiter(
+      [&]() { root->WaitForBudget([&]() { return proceed.load(); }); });
+
+  proceed = true;
+  root->Notify();
+  waiter.join();
+
+  BOOST_CHECK_EQUAL(100, root->GetUsage());
+  root->Release(100);
+}
+
+BOOST_AUTO_TEST_CASE(TestResultPageIsCharged) {
+  std::shared_ptr< MemoryGovernor > governor =
+      std::make_shared< MemoryGovernor >(0);
+  std::shared_ptr< PageArenaPool > pool =
+      std::make_shared< PageArenaPool >(governor);
+
+  std::unique_ptr< PageArena > arena = pool->Acquire();
+  std::string value("value");
+  arena->BeginRow();
+  arena->AddCell(PageCell::Kind::SCALAR, value.data(), value.size());
+  int64_t reserved = static_cast< int64_t >(arena->GetReservedBytes());
+
+  std::shared_ptr< const ResultPage > page = std::make_shared< ResultPage >(
+      std::move(arena), pool, "", pool->GetMemoryGovernor());
+  BOOST_CHECK_EQUAL(reserved, governor->GetUsage());
+
+  page.reset();
+  BOOST_CHECK_EQUAL(0, governor->GetUsage());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
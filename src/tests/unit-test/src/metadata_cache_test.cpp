@@ -0,0 +1,272 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <trino/odbc/metadata_cache.h>
+
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace trino::odbc;
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE(MetadataCacheTestSuite)
+
+BOOST_AUTO_TEST_CASE(TestMetadataCacheHitAndExpiry) {
+  MetadataCache cache;
+  std::vector< std::string > names;
+  std::vector< MetadataCache::Table > tables;
+
+  BOOST_CHECK(!cache.GetDatabases("alice", "%", names));
+
+  cache.PutDatabases("alice", "%", {"db1", "db2"}, 60);
+  cache.PutTables("alice", "db1", "%", {{"db1", "t1"}}, 60);
+  cache.PutTables("alice", "db2", "%", {{"db2", "t2"}}, 0);
+
+  BOOST_REQUIRE(cache.GetDatabases("alice", "%", names));
+  BOOST_CHECK(names == std::vector< std::string >({"db1", "db2"}));
+  BOOST_REQUIRE(cache.GetTables("alice", "db1", "%", tables));
+  BOOST_REQUIRE_EQUAL(1, tables.size());
+  BOOST_CHECK_EQUAL("db1", tables[0].database);
+  BOOST_CHECK_EQUAL("t1", tables[0].name);
+
+  // entries are separate per pattern, database and identity
+  BOOST_CHECK(!cache.GetDatabases("alice", "db%", names));
+  BOOST_CHECK(!cache.GetDatabases("bob", "%", names));
+  BOOST_CHECK(!cache.GetTables("alice", "db2", "%", tables));
+
+  BOOST_CHECK_EQUAL(2, cache.GetSize());
+  BOOST_CHECK_EQUAL(2, cache.GetHitCount());
+  BOOST_CHECK_EQUAL(4, cache.GetMissCount());
+}
+
+BOOST_AUTO_TEST_CASE(TestMetadataCacheKeepsMissingObjects) {
+  MetadataCache cache;
+  std::vector< MetadataCache::Table > tables = {{"db1", "stale"}};
+  std::vector< MetadataCache::Column > columns;
+
+  cache.PutTables("alice", "db1", "missing%", {}, 60);
+  cache.PutColumns("alice", "db1", "empty", {}, 60);
+
+  BOOST_REQUIRE(cache.GetTables("alice", "db1", "missing%", tables));
+  BOOST_CHECK(tables.empty());
+  BOOST_REQUIRE(cache.GetColumns("alice", "db1", "empty", columns));
+  BOOST_CHECK(columns.empty());
+}
+
+BOOST_AUTO_TEST_CASE(TestMetadataCacheColumns) {
+  MetadataCache cache;
+
+  MetadataCache::Column time;
+  time.name = "time";
+  time.dataType = "timestamp";
+  time.remarks = "TIMESTAMP";
+
+  MetadataCache::Column value;
+  value.name = "measure_value::double";
+  value.dataType = "double";
+  value.remarks = "MEASURE_VALUE";
+
+  cache.PutColumns("alice", "db1", "t1", {time, value}, 60);
+
+  std::vector< MetadataCache::Column > columns;
+  BOOST_REQUIRE(cache.GetColumns("alice", "db1", "t1", columns));
+  BOOST_REQUIRE_EQUAL(2, columns.size());
+  BOOST_CHECK_EQUAL("time", columns[0].name);
+  BOOST_CHECK_EQUAL("timestamp", columns[0].dataType);
+  BOOST_CHECK_EQUAL("TIMESTAMP", columns[0].remarks);
+  BOOST_CHECK_EQUAL("measure_value::double", columns[1].name);
+  BOOST_CHECK_EQUAL("double", columns[1].dataType);
+  BOOST_CHECK_EQUAL("MEASURE_VALUE", columns[1].remarks);
+}
+
+BOOST_AUTO_TEST_CASE(TestMetadataCacheColumnListing) {
+  MetadataCache cache;
+
+  MetadataCache::Column first;
+  first.database = "db1";
+  first.table = "t1";
+  first.name = "time";
+  first.dataType = "timestamp";
+  first.position = 1;
+
+  MetadataCache::Column second;
+  second.database = "db2";
+  second.table = "t2";
+  second.name = "region";
+  second.dataType = "varchar";
+  second.remarks = "dimension";
+  second.nullable = true;
+  second.position = 4;
+
+  cache.PutColumnListing("alice", "db%", "t%", "%", {first, second}, 60);
+
+  std::vector< MetadataCache::Column > columns;
+  BOOST_CHECK(!cache.GetColumnListing("alice", "db%", "t%", "r%", columns));
+  BOOST_CHECK(!cache.GetColumns("alice", "db%", "t%", columns));
+
+  BOOST_REQUIRE(cache.GetColumnListing("alice", "db%", "t%", "%", columns));
+  BOOST_REQUIRE_EQUAL(2, columns.size());
+  BOOST_CHECK_EQUAL("db1", columns[0].database);
+  BOOST_CHECK_EQUAL("t1", columns[0].table);
+  BOOST_CHECK_EQUAL("time", columns[0].name);
+  BOOST_CHECK(!columns[0].nullable);
+  BOOST_CHECK_EQUAL(1, columns[0].position);
+  BOOST_CHECK_EQUAL("db2", columns[1].database);
+  BOOST_CHECK_EQUAL("t2", columns[1].table);
+  BOOST_CHECK_EQUAL("dimension", columns[1].remarks);
+  BOOST_CHECK(columns[1].nullable);
+  BOOST_CHECK_EQUAL(4, columns[1].position);
+}
+
+BOOST_AUTO_TEST_CASE(TestMetadataCacheTablesByName) {
+  MetadataCache cache;
+  std::vector< MetadataCache::Table > tables;
+
+  cache.PutTablesByName("alice", "DB1", "T1", {{"db1", "t1"}}, 60);
+
+  // identifiers and patterns do not share entries
+  BOOST_CHECK(!cache.GetTables("alice", "DB1", "T1", tables));
+  BOOST_REQUIRE(cache.GetTablesByName("alice", "DB1", "T1", tables));
+  BOOST_REQUIRE_EQUAL(1, tables.size());
+  BOOST_CHECK_EQUAL("db1", tables[0].database);
+  BOOST_CHECK_EQUAL("t1", tables[0].name);
+}
+
+BOOST_AUTO_TEST_CASE(TestMetadataCacheInvalidate) {
+  MetadataCache cache;
+  std::vector< std::string > names;
+  std::vector< MetadataCache::Table > tables;
+
+  cache.PutDatabases("alice", "%", {"db1"}, 60);
+  cache.PutTables("alice", "db1", "%", {{"db1", "t1"}}, 60);
+  cache.PutDatabases("bob", "%", {"db1"}, 60);
+
+  cache.Invalidate("alice");
+
+  BOOST_CHECK_EQUAL(1, cache.GetSize());
+  BOOST_CHECK(!cache.GetDatabases("alice", "%", names));
+  BOOST_CHECK(!cache.GetTables("alice", "db1", "%", tables));
+  BOOST_CHECK(cache.GetDatabases("bob", "%", names));
+}
+
+BOOST_AUTO_TEST_CASE(TestMetadataCacheWaitsForLoad) {
+  MetadataCache cache;
+  std::vector< std::string > names;
+  std::vector< MetadataCache::Table > tables;
+
+  cache.BeginDatabasesLoad("alice", "%");
+  cache.BeginTablesLoad("alice", "%", "%");
+
+  std::thread loader([&cache]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    cache.PutDatabases("alice", "%", {"db1"}, 60);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    cache.EndLoads("alice");
+  });
+
+  // the lookups attach to the loads instead of missing right away
+  BOOST_REQUIRE(cache.GetDatabases("alice", "%", names));
+  BOOST_CHECK(names == std::vector< std::string >({"db1"}));
+  BOOST_CHECK(!cache.GetTables("alice", "%", "%", tables));
+  loader.join();
+
+  // other entries never wait
+  BOOST_CHECK(!cache.GetDatabases("bob", "%", names));
+  BOOST_CHECK_EQUAL(1, cache.GetHitCount());
+  BOOST_CHECK_EQUAL(2, cache.GetMissCount());
+}
+
+BOOST_AUTO_TEST_CASE(TestMetadataCacheSnapshot) {
+  std::string path = std::string(DEFAULT_LOG_PATH) + "/"
+                     + MetadataCache::MakeSnapshotName("dsn", "alice");
+  std::vector< std::string > names;
+  std::vector< MetadataCache::Table > tables;
+
+  {
+    MetadataCache cache;
+    cache.PutDatabases("alice", "%", {"db1", "db2"}, 60);
+    cache.PutTables("alice", "db1", "%", {{"db1", "t1"}}, 60);
+    cache.PutTables("alice", "db2", "%", {{"db2", "t2"}}, 0);
+    cache.PutDatabases("bob", "%", {"db3"}, 60);
+    BOOST_REQUIRE(cache.Save("alice", path));
+  }
+
+  // a later process finds the live entries of the identity
+  MetadataCache cache;
+  BOOST_CHECK_EQUAL(2, cache.Load("alice", path));
+  BOOST_REQUIRE(cache.GetDatabases("alice", "%", names));
+  BOOST_CHECK(names == std::vector< std::string >({"db1", "db2"}));
+  BOOST_REQUIRE(cache.GetTables("alice", "db1", "%", tables));
+  BOOST_REQUIRE_EQUAL(1, tables.size());
+  BOOST_CHECK_EQUAL("t1", tables[0].name);
+  BOOST_CHECK(!cache.GetTables("alice", "db2", "%", tables));
+  BOOST_CHECK(!cache.GetDatabases("bob", "%", names));
+
+  // entries already in the cache are kept
+  cache.PutDatabases("alice", "%", {"db4"}, 60);
+  BOOST_CHECK_EQUAL(0, cache.Load("alice", path));
+  BOOST_REQUIRE(cache.GetDatabases("alice", "%", names));
+  BOOST_CHECK(names == std::vector< std::string >({"db4"}));
+
+  std::remove(path.c_str());
+  BOOST_CHECK_EQUAL(0, cache.Load("alice", path));
+}
+
+BOOST_AUTO_TEST_CASE(TestMetadataCacheSnapshotRejectsOtherFormats) {
+  std::string path = std::string(DEFAULT_LOG_PATH) + "/"
+                     + MetadataCache::MakeSnapshotName("dsn", "bob");
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "TMCS\x02\x00\x00\x00";
+  }
+
+  MetadataCache cache;
+  BOOST_CHECK_EQUAL(0, cache.Load("bob", path));
+  BOOST_CHECK_EQUAL(0, cache.GetSize());
+
+  std::remove(path.c_str());
+  BOOST_CHECK_NE(MetadataCache::MakeSnapshotName("dsn", "alice"),
+                 MetadataCache::MakeSnapshotName("dsn", "bob"));
+}
+
+BOOST_AUTO_TEST_CASE(TestMetadataCacheEvictsLeastRecentlyUsed) {
+  MetadataCache cache;
+  std::vector< std::string > names;
+
+  for (size_t i = 0; i < MetadataCache::MAX_ENTRIES; ++i) {
+    cache.PutDatabases("alice", "db" + std::to_string(i), {"db"}, 60);
+  }
+
+  // touch the oldest entry so the second oldest goes first
+  BOOST_CHECK(cache.GetDatabases("alice", "db0", names));
+  cache.PutDatabases("alice", "extra", {"db"}, 60);
+
+  BOOST_CHECK_EQUAL(MetadataCache::MAX_ENTRIES, cache.GetSize());
+  BOOST_CHECK(cache.GetDatabases("alice", "db0", names));
+  BOOST_CHECK(!cache.GetDatabases("alice", "db1", names));
+  BOOST_CHECK(cache.GetDatabases("alice", "extra", names));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,135 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <trino/odbc/metrics.h>
+
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace trino::odbc;
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE(MetricsTestSuite)
+
+BOOST_AUTO_TEST_CASE(TestCounterFromManyThreads) {
+  Metrics metrics;
+
+  std::vector< std::thread > threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < 10000; ++j) {
+        metrics.rowsConverted.Add();
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL(40000, metrics.rowsConverted.Get());
+}
+
+BOOST_AUTO_TEST_CASE(TestHistogramBuckets) {
+  Metrics::Histogram histogram;
+
+  histogram.Record(std::chrono::microseconds(0));
+  histogram.Record(std::chrono::microseconds(1));
+  histogram.Record(std::chrono::microseconds(3));
+  histogram.Record(std::chrono::microseconds(4));
+  histogram.Record(std::chrono::microseconds(5));
+  histogram.Record(std::chrono::hours(1));
+
+  BOOST_CHECK_EQUAL(2, histogram.GetBucket(0));
+  BOOST_CHECK_EQUAL(0, histogram.GetBucket(1));
+  BOOST_CHECK_EQUAL(2, histogram.GetBucket(2));
+  BOOST_CHECK_EQUAL(1, histogram.GetBucket(3));
+  BOOST_CHECK_EQUAL(1, histogram.GetBucket(Metrics::Histogram::BUCKET_COUNT));
+  BOOST_CHECK_EQUAL(6, histogram.GetCount());
+  BOOST_CHECK_EQUAL(3600000013ULL, histogram.GetSumMicros());
+}
+
+BOOST_AUTO_TEST_CASE(TestPrometheusText) {
+  Metrics metrics;
+
+  metrics.queriesStarted.Add(3);
+  metrics.RecordPage(std::chrono::milliseconds(3), 1024);
+  metrics.conversionErrors[static_cast< size_t >(
+                               app::ConversionResult::Type::AI_FAILURE)]
+      .Add();
+  metrics.workersBusy.Add(2);
+
+  std::string text = metrics.ToPrometheusText();
+
+  BOOST_CHECK(text.find("# TYPE trino_odbc_queries_started_total counter\n"
+                        "trino_odbc_queries_started_total 3\n")
+              != std::string::npos);
+  BOOST_CHECK(text.find("trino_odbc_pages_fetched_total 1\n")
+              != std::string::npos);
+  BOOST_CHECK(text.find("trino_odbc_received_bytes_total 1024\n")
+              != std::string::npos);
+  BOOST_CHECK(
+      text.find("trino_odbc_conversion_errors_total{result=\"failure\"} 1\n")
+      != std::string::npos);
+  BOOST_CHECK(text.find("conversion_errors_total{result=\"no_data\"}")
+              == std::string::npos);
+  BOOST_CHECK(text.find("trino_odbc_worker_threads_busy 2\n")
+              != std::string::npos);
+
+  // 3 ms falls into the 4.096 ms bucket, the buckets are cumulative
+  BOOST_CHECK(text.find("# TYPE trino_odbc_page_fetch_seconds histogram\n")
+              != std::string::npos);
+  BOOST_CHECK(text.find("trino_odbc_page_fetch_seconds_bucket"
+                        "{le=\"0.002048\"} 0\n")
+              != std::string::npos);
+  BOOST_CHECK(text.find("trino_odbc_page_fetch_seconds_bucket"
+                        "{le=\"0.004096\"} 1\n")
+              != std::string::npos);
+  BOOST_CHECK(text.find("trino_odbc_page_fetch_seconds_bucket"
+                        "{le=\"+Inf\"} 1\n")
+              != std::string::npos);
+  BOOST_CHECK(text.find("trino_odbc_page_fetch_seconds_sum 0.003\n")
+              != std::string::npos);
+  BOOST_CHECK(text.find("trino_odbc_page_fetch_seconds_count 1\n")
+              != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(TestWriteFile) {
+  Metrics metrics;
+  metrics.queriesFailed.Add();
+
+  std::string path = "trino_odbc_metrics_test.prom";
+  BOOST_REQUIRE(metrics.WriteFile(path));
+
+  std::ifstream file(path);
+  std::stringstream content;
+  content << file.rdbuf();
+  file.close();
+  std::remove(path.c_str());
+
+  BOOST_CHECK_EQUAL(metrics.ToPrometheusText(), content.str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -43,5 +43,10 @@ Aws::TrinoQuery::Model::QueryOutcome MockTrinoQueryClient::Query(
   return MockTrinoService::GetInstance()->HandleQueryReq(request);
 }
 
+Aws::TrinoQuery::Model::CancelQueryOutcome MockTrinoQueryClient::CancelQuery(
+    const Aws::TrinoQuery::Model::CancelQueryRequest &request) const {
+  return MockTrinoService::GetInstance()->HandleCancelQueryReq(request);
+}
+
 }  // namespace odbc
 }  // namespace trino
@@ -30,8 +30,12 @@ namespace odbc {
 
 std::mutex MockTrinoService::mutex_;
 MockTrinoService* MockTrinoService::instance_ = nullptr;
-int MockTrinoService::token = 0;
+std::atomic< int > MockTrinoService::token(0);
 int MockTrinoService::errorToken = 0;
+const std::chrono::milliseconds MockTrinoService::SLOW_PAGE_DELAY(5000);
+const std::chrono::milliseconds MockTrinoService::SLOW_INSERT_DELAY(1500);
+const std::chrono::milliseconds MockTrinoService::LATENCY_PAGE_DELAY(20);
+const int MockTrinoService::LATENCY_PAGE_COUNT = 5;
 
 void MockTrinoService::CreateMockTrinoService() {
   if (!instance_) {
@@ -162,6 +166,97 @@ Aws::TrinoQuery::Model::QueryOutcome MockTrinoService::HandleQueryReq(
 
       return Aws::TrinoQuery::Model::QueryOutcome(error);
     }
+  } else if (request.GetQueryString()
+             == "select measure, time from mockDB.mockTableSlow") {
+    Aws::TrinoQuery::Model::QueryResult result;
+    SetupResultForMockTable(result);
+    result.SetQueryId("mockTableSlow");
+    result.SetNextToken("1");
+
+    if (request.GetNextToken().empty()) {
+      std::lock_guard< std::mutex > lock(cancelMutex_);
+      cancelled_ = false;
+      return Aws::TrinoQuery::Model::QueryOutcome(result);
+    }
+
+    // pages after the first one take long unless the query is cancelled
+    std::unique_lock< std::mutex > lock(cancelMutex_);
+    if (cancelCv_.wait_for(lock, SLOW_PAGE_DELAY,
+                           [&]() { return cancelled_; })) {
+      Aws::TrinoQuery::TrinoQueryError error(
+          Aws::Client::AWSError< Aws::Client::CoreErrors >(
+              Aws::Client::CoreErrors::REQUEST_CANCELLED, false));
+
+      return Aws::TrinoQuery::Model::QueryOutcome(error);
+    }
+    return Aws::TrinoQuery::Model::QueryOutcome(result);
+  } else if (request.GetQueryString()
+             == "select measure, time from mockDB.mockTableLatency") {
+    // every page takes a fixed time, like a round trip to a real server
+    ++latencyRequestCount_;
+    std::this_thread::sleep_for(LATENCY_PAGE_DELAY);
+
+    Aws::TrinoQuery::Model::QueryResult result;
+    SetupResultForMockTable(result);
+
+    int page = request.GetNextToken().empty()
+                   ? 0
+                   : std::stoi(request.GetNextToken().c_str());
+    if (page + 1 < LATENCY_PAGE_COUNT) {
+      result.SetNextToken(std::to_string(page + 1));
+    }
+    return Aws::TrinoQuery::Model::QueryOutcome(result);
+  } else if (request.GetQueryString().find("INSERT INTO mockDB.mockInsert")
+             == 0) {
+    // the whole statement is rejected if any of its rows holds the bad value
+    const Aws::String& query = request.GetQueryString();
+    if (query.find("'bad'") != Aws::String::npos) {
+      Aws::TrinoQuery::TrinoQueryError error(
+          Aws::Client::AWSError< Aws::Client::CoreErrors >(
+              Aws::Client::CoreErrors::VALIDATION, "ValidationException",
+              "Bad value", false));
+
+      return Aws::TrinoQuery::Model::QueryOutcome(error);
+    }
+
+    // a statement with the slow value is written after the client gave up
+    if (query.find("'slow'") != Aws::String::npos) {
+      std::this_thread::sleep_for(SLOW_INSERT_DELAY);
+    }
+
+    int rows = 1;
+    for (size_t pos = query.find("), ("); pos != Aws::String::npos;
+         pos = query.find("), (", pos + 4)) {
+      ++rows;
+    }
+
+    {
+      std::lock_guard< std::mutex > lock(insertMutex_);
+      ++insertCount_;
+      insertedRows_ += rows;
+    }
+
+    Aws::TrinoQuery::Model::QueryResult result;
+    Aws::TrinoQuery::Model::ColumnInfo column;
+    column.SetName("rows");
+    Aws::TrinoQuery::Model::Type bigintType;
+    bigintType.SetScalarType(Aws::TrinoQuery::Model::ScalarType::BIGINT);
+    column.SetType(bigintType);
+    result.AddColumnInfo(column);
+
+    Aws::TrinoQuery::Model::Datum datum;
+    datum.SetScalarValue(std::to_string(rows).c_str());
+    Aws::TrinoQuery::Model::Row row;
+    row.AddData(datum);
+    result.AddRows(row);
+    return Aws::TrinoQuery::Model::QueryOutcome(result);
+  } else if (request.GetQueryString()
+             == "EXECUTE IMMEDIATE 'select measure, time from "
+                "mockDB.mockTable where measure = ?' USING 'cpu_usage'") {
+    // the parameterized query with its value as an argument
+    Aws::TrinoQuery::Model::QueryResult result;
+    SetupResultForMockTable(result);
+    return Aws::TrinoQuery::Model::QueryOutcome(result);
   } else {
     Aws::TrinoQuery::TrinoQueryError error(
         Aws::Client::AWSError< Aws::Client::CoreErrors >(
@@ -170,5 +265,38 @@ Aws::TrinoQuery::Model::QueryOutcome MockTrinoService::HandleQueryReq(
     return Aws::TrinoQuery::Model::QueryOutcome(error);
   }
 }
+
+Aws::TrinoQuery::Model::CancelQueryOutcome
+MockTrinoService::HandleCancelQueryReq(
+    const Aws::TrinoQuery::Model::CancelQueryRequest& request) {
+  std::lock_guard< std::mutex > lock(cancelMutex_);
+  ++cancelCount_;
+  if (request.GetQueryId() == "mockTableSlow") {
+    cancelled_ = true;
+    cancelCv_.notify_all();
+  }
+
+  return Aws::TrinoQuery::Model::CancelQueryOutcome(
+      Aws::TrinoQuery::Model::CancelQueryResult());
+}
+
+int MockTrinoService::GetCancelCount() {
+  std::lock_guard< std::mutex > lock(cancelMutex_);
+  return cancelCount_;
+}
+
+int MockTrinoService::GetInsertCount() {
+  std::lock_guard< std::mutex > lock(insertMutex_);
+  return insertCount_;
+}
+
+int64_t MockTrinoService::GetInsertedRows() {
+  std::lock_guard< std::mutex > lock(insertMutex_);
+  return insertedRows_;
+}
+
+int MockTrinoService::GetLatencyRequestCount() {
+  return latencyRequestCount_;
+}
 }  // namespace odbc
 }  // namespace trino
@@ -0,0 +1,143 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <trino/odbc/page_arena.h>
+
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <string>
+
+using namespace trino::odbc;
+using namespace boost::unit_test;
+
+namespace {
+void FillArena(PageArena& arena, size_t rows, const std::string& value) {
+  for (size_t i = 0; i < rows; ++i) {
+    arena.BeginRow();
+    arena.AddCell(PageCell::Kind::SCALAR, value.data(), value.size());
+    arena.AddCell(PageCell::Kind::NULL_VALUE, nullptr, 0);
+  }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(PageArenaTestSuite)
+
+BOOST_AUTO_TEST_CASE(TestPageArenaCells) {
+  PageArena arena;
+  FillArena(arena, 3, "value");
+
+  BOOST_CHECK_EQUAL(3, arena.GetRowCount());
+  BOOST_CHECK_EQUAL(2, arena.GetColumnCount());
+
+  const PageCell* cell = arena.GetCell(2, 0);
+  BOOST_REQUIRE(cell != nullptr);
+  BOOST_CHECK_EQUAL(PageCell::Kind::SCALAR, cell->kind);
+  BOOST_CHECK_EQUAL(5, cell->length);
+  BOOST_CHECK_EQUAL(0, std::strcmp("value", arena.GetValue(*cell)));
+
+  cell = arena.GetCell(1, 1);
+  BOOST_REQUIRE(cell != nullptr);
+  BOOST_CHECK_EQUAL(PageCell::Kind::NULL_VALUE, cell->kind);
+  BOOST_CHECK_EQUAL(0, cell->length);
+
+  BOOST_CHECK(arena.GetCell(3, 0) == nullptr);
+  BOOST_CHECK(arena.GetCell(0, 2) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(TestPageArenaResetKeepsCapacity) {
+  PageArena arena;
+  FillArena(arena, 1000, "some longer value that is not inlined");
+
+  size_t reserved = arena.GetReservedBytes();
+  BOOST_CHECK(arena.GetUsedBytes() > 0);
+
+  arena.Reset();
+  BOOST_CHECK_EQUAL(0, arena.GetRowCount());
+  BOOST_CHECK_EQUAL(0, arena.GetUsedBytes());
+  BOOST_CHECK_EQUAL(reserved, arena.GetReservedBytes());
+
+  // A page of the same shape fits into the retained capacity
+  FillArena(arena, 1000, "some longer value that is not inlined");
+  BOOST_CHECK_EQUAL(reserved, arena.GetReservedBytes());
+}
+
+BOOST_AUTO_TEST_CASE(TestPageArenaPoolRecycles) {
+  PageArenaPool pool(nullptr, 1);
+
+  std::unique_ptr< PageArena > first = pool.Acquire();
+  FillArena(*first, 10, "value");
+  PageArena* firstPtr = first.get();
+  pool.Release(std::move(first));
+
+  std::unique_ptr< PageArena > second = pool.Acquire();
+  BOOST_CHECK_EQUAL(firstPtr, second.get());
+  BOOST_CHECK_EQUAL(0, second->GetRowCount());
+
+  // Pool is empty now, a new arena is created
+  std::unique_ptr< PageArena > third = pool.Acquire();
+  BOOST_CHECK(third.get() != second.get());
+
+  // Only one idle arena is kept
+  pool.Release(std::move(second));
+  pool.Release(std::move(third));
+
+  BOOST_CHECK_EQUAL(2, pool.GetCreatedCount());
+  BOOST_CHECK_EQUAL(1, pool.GetReusedCount());
+}
+
+BOOST_AUTO_TEST_CASE(TestResultPageReturnsArena) {
+  std::shared_ptr< PageArenaPool > pool = std::make_shared< PageArenaPool >();
+
+  std::unique_ptr< PageArena > arena = pool->Acquire();
+  FillArena(*arena, 10, "value");
+  PageArena* arenaPtr = arena.get();
+
+  std::shared_ptr< const ResultPage > page =
+      std::make_shared< ResultPage >(std::move(arena), pool, "token");
+  std::shared_ptr< const ResultPage > borrowed = page;
+
+  BOOST_CHECK_EQUAL(10, borrowed->GetRowCount());
+  BOOST_CHECK_EQUAL("token", borrowed->GetNextToken());
+
+  // The arena is returned only when the last reference is dropped
+  page.reset();
+  BOOST_CHECK_EQUAL(arenaPtr, &borrowed->GetArena());
+  borrowed.reset();
+
+  std::unique_ptr< PageArena > recycled = pool->Acquire();
+  BOOST_CHECK_EQUAL(arenaPtr, recycled.get());
+  BOOST_CHECK_EQUAL(0, recycled->GetRowCount());
+}
+
+BOOST_AUTO_TEST_CASE(TestResultPageOutlivesPool) {
+  std::shared_ptr< PageArenaPool > pool = std::make_shared< PageArenaPool >();
+
+  std::unique_ptr< PageArena > arena = pool->Acquire();
+  FillArena(*arena, 1, "value");
+
+  std::shared_ptr< const ResultPage > page =
+      std::make_shared< ResultPage >(std::move(arena), pool, "");
+  pool.reset();
+
+  BOOST_CHECK_EQUAL(1, page->GetRowCount());
+  page.reset();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
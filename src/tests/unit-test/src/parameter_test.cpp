@@ -0,0 +1,119 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <trino/odbc/app/parameter.h>
+#include <trino/odbc/system/odbc_constants.h>
+
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <vector>
+
+using namespace trino::odbc;
+using namespace trino::odbc::app;
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE(ParameterTestSuite)
+
+BOOST_AUTO_TEST_CASE(TestParameterFindMarkers) {
+  std::string sql =
+      "SELECT '?', \"a?\" FROM t -- where ?\n"
+      "WHERE a = ? /* and ? */ AND b = 'it''s' AND c = ?";
+
+  std::vector< size_t > markers = Parameter::FindMarkers(sql);
+  BOOST_REQUIRE_EQUAL(2, markers.size());
+  BOOST_CHECK_EQUAL('?', sql[markers[0]]);
+  BOOST_CHECK_EQUAL(sql.size() - 1, markers[1]);
+  BOOST_CHECK_EQUAL(2, Parameter::CountMarkers(sql));
+  BOOST_CHECK_EQUAL(0, Parameter::CountMarkers("SELECT 1"));
+}
+
+BOOST_AUTO_TEST_CASE(TestParameterInlineLiterals) {
+  std::string sql = "SELECT '?' FROM t WHERE a = ? AND b IN (?, 1)";
+  std::vector< size_t > markers = Parameter::FindMarkers(sql);
+
+  BOOST_CHECK_EQUAL(
+      "SELECT '?' FROM t WHERE a = 'it''s' AND b IN (NULL, 1)",
+      Parameter::InlineLiterals(sql, markers, {"'it''s'", "NULL"}));
+
+  // only the text from the given position is returned
+  size_t from = sql.find("(?");
+  BOOST_CHECK_EQUAL("(2, 1)",
+                    Parameter::InlineLiterals(sql, {markers[1]}, {"2"}, from));
+}
+
+BOOST_AUTO_TEST_CASE(TestParameterExecuteImmediate) {
+  // the query is quoted as it is, markers included
+  BOOST_CHECK_EQUAL(
+      "EXECUTE IMMEDIATE 'SELECT ''?'' FROM t WHERE a = ? AND b IN (?, 1)' "
+      "USING 'it''s', NULL",
+      Parameter::ExecuteImmediate(
+          "SELECT '?' FROM t WHERE a = ? AND b IN (?, 1)",
+          {"'it''s'", "NULL"}));
+
+  BOOST_CHECK_EQUAL("EXECUTE IMMEDIATE 'SELECT 1'",
+                    Parameter::ExecuteImmediate("SELECT 1", {}));
+}
+
+BOOST_AUTO_TEST_CASE(TestParameterFindValuesRow) {
+  size_t rowStart = 0;
+
+  std::string sql = "INSERT INTO t (a, b) VALUES (?, lower(?))  ";
+  BOOST_REQUIRE(Parameter::FindValuesRow(sql, rowStart));
+  BOOST_CHECK_EQUAL(sql.find("(?"), rowStart);
+
+  BOOST_CHECK(Parameter::FindValuesRow(
+      " insert into t values /* row */ (?, 'values (x)') -- end", rowStart));
+
+  // several rows, other clauses or other statements cannot be extended
+  BOOST_CHECK(!Parameter::FindValuesRow("INSERT INTO t VALUES (?), (?)",
+                                        rowStart));
+  BOOST_CHECK(!Parameter::FindValuesRow(
+      "INSERT INTO t SELECT * FROM (VALUES (?)) v", rowStart));
+  BOOST_CHECK(
+      !Parameter::FindValuesRow("SELECT * FROM (VALUES (?)) v", rowStart));
+  BOOST_CHECK(!Parameter::FindValuesRow("INSERT INTO t VALUES (?", rowStart));
+}
+
+BOOST_AUTO_TEST_CASE(TestParameterLiteralOfArrayElement) {
+  SQLINTEGER ids[3] = {1, 2, 3};
+  ApplicationDataBuffer idBuffer(type_traits::OdbcNativeType::AI_SIGNED_LONG,
+                                 ids, 0, nullptr);
+  Parameter id(idBuffer, SQL_INTEGER, 0, 0);
+
+  char names[3][8] = {"a", "it's", ""};
+  SqlLen nameLens[3] = {SQL_NTS, SQL_NTS, SQL_NULL_DATA};
+  ApplicationDataBuffer nameBuffer(type_traits::OdbcNativeType::AI_CHAR,
+                                   names, sizeof(names[0]), nameLens);
+  Parameter name(nameBuffer, SQL_VARCHAR, 8, 0);
+
+  std::string literal;
+  BOOST_REQUIRE(id.GetLiteral(literal, 2));
+  BOOST_CHECK_EQUAL("3", literal);
+
+  BOOST_REQUIRE(name.GetLiteral(literal, 0));
+  BOOST_CHECK_EQUAL("'a'", literal);
+  BOOST_REQUIRE(name.GetLiteral(literal, 1));
+  BOOST_CHECK_EQUAL("'it''s'", literal);
+  BOOST_REQUIRE(name.GetLiteral(literal, 2));
+  BOOST_CHECK_EQUAL("NULL", literal);
+  BOOST_CHECK(!name.IsDataAtExec(1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,105 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <trino/odbc/query_trace.h>
+
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace trino::odbc;
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE(QueryTraceTestSuite)
+
+BOOST_AUTO_TEST_CASE(TestRecordHoldsPhases) {
+  QueryTrace trace("select \"a\"\nfrom t");
+  trace.SetQueryId("20261018_000000_00001_abcde");
+  trace.FirstResponse();
+  trace.AddPage(10, 100, std::chrono::milliseconds(5),
+                std::chrono::milliseconds(2));
+  trace.AddPage(5, 50, std::chrono::milliseconds(3),
+                std::chrono::milliseconds(1));
+  trace.Executed();
+  trace.AddWait(std::chrono::milliseconds(4));
+  trace.AddConversion(2, std::chrono::microseconds(7));
+  trace.AddFetchCall(std::chrono::milliseconds(1));
+  trace.Finish(true, std::chrono::milliseconds(1));
+
+  std::string record = trace.ToJson();
+  BOOST_CHECK_EQUAL('{', record.front());
+  BOOST_CHECK_EQUAL('}', record.back());
+  BOOST_CHECK_EQUAL(std::string::npos, record.find('\n'));
+
+  BOOST_CHECK_NE(std::string::npos,
+                 record.find("\"queryId\":\"20261018_000000_00001_abcde\""));
+  BOOST_CHECK_NE(std::string::npos, record.find("\"status\":\"complete\""));
+  BOOST_CHECK_NE(std::string::npos,
+                 record.find("\"sql\":\"select \\\"a\\\"\\nfrom t\""));
+  BOOST_CHECK_NE(std::string::npos, record.find("\"rows\":15"));
+  BOOST_CHECK_NE(std::string::npos, record.find("\"bytes\":150"));
+  BOOST_CHECK_NE(std::string::npos, record.find("\"pageCount\":2"));
+  BOOST_CHECK_NE(std::string::npos, record.find("\"fetchUs\":8000"));
+  BOOST_CHECK_NE(std::string::npos, record.find("\"decodeUs\":3000"));
+  BOOST_CHECK_NE(std::string::npos, record.find("\"waitUs\":4000"));
+  BOOST_CHECK_NE(std::string::npos, record.find("\"conversionUs\":[0,7]"));
+  BOOST_CHECK_NE(std::string::npos, record.find("\"fetchCalls\":1"));
+  BOOST_CHECK_NE(std::string::npos,
+                 record.find("\"pages\":[{\"rows\":10,\"fetchUs\":5000,"
+                             "\"decodeUs\":2000},{\"rows\":5"));
+}
+
+BOOST_AUTO_TEST_CASE(TestFailedQuery) {
+  QueryTrace trace("select 1");
+  trace.SetError("QueryFailed: line 1:1");
+  trace.Finish(true, std::chrono::milliseconds(0));
+
+  std::string record = trace.ToJson();
+  BOOST_CHECK_NE(std::string::npos, record.find("\"status\":\"failed\""));
+  BOOST_CHECK_NE(std::string::npos,
+                 record.find("\"error\":\"QueryFailed: line 1:1\""));
+}
+
+BOOST_AUTO_TEST_CASE(TestRecordsAreAppended) {
+  std::string path = "query_trace_test.jsonl";
+  std::remove(path.c_str());
+
+  QueryTrace first("select 1");
+  first.Finish(false, std::chrono::milliseconds(0));
+  BOOST_REQUIRE(first.Write(path));
+
+  QueryTrace second("select 2");
+  second.Finish(true, std::chrono::milliseconds(0));
+  BOOST_REQUIRE(second.Write(path));
+
+  std::ifstream file(path);
+  std::string line;
+  BOOST_REQUIRE(std::getline(file, line));
+  BOOST_CHECK_NE(std::string::npos, line.find("\"status\":\"closed\""));
+  BOOST_REQUIRE(std::getline(file, line));
+  BOOST_CHECK_NE(std::string::npos, line.find("\"sql\":\"select 2\""));
+  BOOST_CHECK(!std::getline(file, line));
+
+  file.close();
+  std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,164 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <trino/odbc/log.h>
+#include <trino/odbc/result_cache.h>
+
+#include <boost/test/unit_test.hpp>
+#include <string>
+
+using namespace trino::odbc;
+using namespace boost::unit_test;
+
+namespace {
+std::shared_ptr< ResultCache::Entry > MakeEntry(size_t pages, size_t rows) {
+  std::shared_ptr< ResultCache::Entry > entry =
+      std::make_shared< ResultCache::Entry >(meta::ColumnMetaVector());
+
+  for (size_t page = 0; page < pages; ++page) {
+    PageArena arena;
+    for (size_t i = page * rows; i < (page + 1) * rows; ++i) {
+      std::string value = std::to_string(i);
+      arena.BeginRow();
+      arena.AddCell(PageCell::Kind::SCALAR, value.data(), value.size());
+      arena.AddCell(PageCell::Kind::NULL_VALUE, nullptr, 0);
+    }
+    entry->AddPage(arena);
+  }
+
+  return entry;
+}
+
+void CheckPage(const ResultCache::Entry& entry, size_t page, size_t rows) {
+  PageArena arena;
+  BOOST_REQUIRE(entry.ReadPage(page, arena));
+  BOOST_REQUIRE_EQUAL(rows, arena.GetRowCount());
+  BOOST_REQUIRE_EQUAL(2, arena.GetColumnCount());
+
+  for (size_t row = 0; row < rows; ++row) {
+    const PageCell* cell = arena.GetCell(row, 0);
+    BOOST_REQUIRE(cell);
+    BOOST_CHECK_EQUAL(PageCell::Kind::SCALAR, cell->kind);
+    BOOST_CHECK_EQUAL(std::to_string(page * rows + row),
+                      arena.GetValue(*cell));
+    BOOST_CHECK_EQUAL(PageCell::Kind::NULL_VALUE,
+                      arena.GetCell(row, 1)->kind);
+  }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(ResultCacheTestSuite)
+
+BOOST_AUTO_TEST_CASE(TestResultCacheNormalizeSql) {
+  BOOST_CHECK_EQUAL(
+      "SELECT a, b FROM t WHERE c = 'x  -- y' AND d = \"e  f\"",
+      ResultCache::NormalizeSql(
+          "  SELECT a,\n\tb -- columns\nFROM t /* table */ WHERE c = "
+          "'x  -- y' AND d = \"e  f\"\n"));
+  BOOST_CHECK_EQUAL("SELECT 'it''s  here'",
+                    ResultCache::NormalizeSql("SELECT   'it''s  here'"));
+  BOOST_CHECK_EQUAL("SELECT 1", ResultCache::NormalizeSql("SELECT 1 -- end"));
+
+  BOOST_CHECK(ResultCache::IsCacheable("select 1"));
+  BOOST_CHECK(ResultCache::IsCacheable("WITH t AS (SELECT 1) SELECT * FROM t"));
+  BOOST_CHECK(ResultCache::IsCacheable("SHOW CATALOGS"));
+  BOOST_CHECK(!ResultCache::IsCacheable("INSERT INTO t VALUES (1)"));
+  BOOST_CHECK(!ResultCache::IsCacheable("selectx"));
+  BOOST_CHECK(!ResultCache::IsCacheable(""));
+
+  BOOST_CHECK(ResultCache::MakeKey("SELECT 1", "user1")
+              != ResultCache::MakeKey("SELECT 1", "user2"));
+}
+
+BOOST_AUTO_TEST_CASE(TestResultCacheHitAndExpiry) {
+  ResultCache cache;
+  cache.Reserve(1024 * 1024, "");
+
+  cache.Put("live", MakeEntry(3, 10), 60);
+  cache.Put("expired", MakeEntry(1, 10), 0);
+  BOOST_CHECK_EQUAL(2, cache.GetStoreCount());
+
+  std::shared_ptr< const ResultCache::Entry > entry = cache.Get("live");
+  BOOST_REQUIRE(entry);
+  BOOST_REQUIRE_EQUAL(3, entry->GetPageCount());
+  for (size_t page = 0; page < 3; ++page) {
+    CheckPage(*entry, page, 10);
+  }
+
+  BOOST_CHECK(!cache.Get("expired"));
+  BOOST_CHECK(!cache.Get("missing"));
+  BOOST_CHECK_EQUAL(1, cache.GetSize());
+  BOOST_CHECK_EQUAL(1, cache.GetHitCount());
+  BOOST_CHECK_EQUAL(2, cache.GetMissCount());
+}
+
+BOOST_AUTO_TEST_CASE(TestResultCacheEvictsLeastRecentlyUsed) {
+  uint64_t entrySize = MakeEntry(1, 100)->GetSize();
+
+  // four entries fit, the limit of one entry is a quarter of the cache
+  ResultCache cache;
+  cache.Reserve(entrySize * 4, "");
+
+  for (int i = 0; i < 4; ++i) {
+    cache.Put("q" + std::to_string(i), MakeEntry(1, 100), 60);
+  }
+  BOOST_CHECK(cache.Get("q0"));
+
+  cache.Put("q4", MakeEntry(1, 100), 60);
+  BOOST_CHECK_EQUAL(4, cache.GetSize());
+  BOOST_CHECK_EQUAL(1, cache.GetEvictionCount());
+  BOOST_CHECK(cache.GetMemoryUsage() <= entrySize * 4);
+  BOOST_CHECK(cache.Get("q0"));
+  BOOST_CHECK(!cache.Get("q1"));
+
+  // too large for the cache, not stored at all
+  cache.Put("large", MakeEntry(2, 100), 60);
+  BOOST_CHECK(!cache.Get("large"));
+  BOOST_CHECK_EQUAL(5, cache.GetStoreCount());
+}
+
+BOOST_AUTO_TEST_CASE(TestResultCacheSpillsToDirectory) {
+  uint64_t entrySize = MakeEntry(2, 50)->GetSize();
+
+  ResultCache cache;
+  cache.Reserve(entrySize * 4, DEFAULT_LOG_PATH);
+
+  for (int i = 0; i < 6; ++i) {
+    cache.Put("q" + std::to_string(i), MakeEntry(2, 50), 60);
+  }
+
+  // the oldest entries moved to files instead of being dropped
+  BOOST_CHECK_EQUAL(6, cache.GetSize());
+  BOOST_CHECK_EQUAL(0, cache.GetEvictionCount());
+  BOOST_CHECK_EQUAL(entrySize * 4, cache.GetMemoryUsage());
+  BOOST_CHECK_EQUAL(entrySize * 2, cache.GetDiskUsage());
+
+  std::shared_ptr< const ResultCache::Entry > entry = cache.Get("q0");
+  BOOST_REQUIRE(entry);
+  BOOST_CHECK(entry->IsOnDisk());
+  CheckPage(*entry, 0, 50);
+  CheckPage(*entry, 1, 50);
+
+  cache.Clear();
+  BOOST_CHECK_EQUAL(0, cache.GetDiskUsage());
+  CheckPage(*entry, 1, 50);  // the file lives as long as the entry
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,98 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <trino/odbc/spill_store.h>
+
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <string>
+
+using namespace trino::odbc;
+using namespace boost::unit_test;
+
+namespace {
+void FillArena(PageArena& arena, size_t firstRow, size_t rows) {
+  for (size_t i = firstRow; i < firstRow + rows; ++i) {
+    std::string value = std::to_string(i);
+    arena.BeginRow();
+    arena.AddCell(PageCell::Kind::SCALAR, value.data(), value.size());
+    arena.AddCell(PageCell::Kind::NULL_VALUE, nullptr, 0);
+  }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(SpillStoreTestSuite)
+
+BOOST_AUTO_TEST_CASE(TestSpillStoreReadsAcrossChunks) {
+  SpillStore store;
+  BOOST_REQUIRE(store.Open());
+
+  for (size_t page = 0; page < 3; ++page) {
+    PageArena arena;
+    FillArena(arena, page * 100, 100);
+    BOOST_REQUIRE(store.Append(arena));
+  }
+
+  BOOST_CHECK_EQUAL(300, store.GetRowCount());
+  BOOST_CHECK(store.GetFileSize() > 0);
+
+  PageCell cell;
+  const char* value = nullptr;
+  for (size_t row : {0, 99, 100, 250, 299}) {
+    BOOST_REQUIRE(store.GetCell(row, 0, cell, value));
+    BOOST_CHECK_EQUAL(PageCell::Kind::SCALAR, cell.kind);
+    BOOST_CHECK_EQUAL(std::to_string(row), std::string(value, cell.length));
+
+    BOOST_REQUIRE(store.GetCell(row, 1, cell, value));
+    BOOST_CHECK_EQUAL(PageCell::Kind::NULL_VALUE, cell.kind);
+  }
+
+  BOOST_CHECK(!store.GetCell(300, 0, cell, value));
+  BOOST_CHECK(!store.GetCell(0, 2, cell, value));
+}
+
+BOOST_AUTO_TEST_CASE(TestSpillStoreAppendAfterRead) {
+  SpillStore store;
+  BOOST_REQUIRE(store.Open());
+
+  PageArena arena;
+  FillArena(arena, 0, 10);
+  BOOST_REQUIRE(store.Append(arena));
+
+  PageCell cell;
+  const char* value = nullptr;
+  BOOST_REQUIRE(store.GetCell(9, 0, cell, value));
+  BOOST_CHECK_EQUAL(0, std::strcmp("9", value));
+
+  // the mapping grows with the file
+  arena.Reset();
+  FillArena(arena, 10, 10);
+  BOOST_REQUIRE(store.Append(arena));
+
+  BOOST_REQUIRE(store.GetCell(15, 0, cell, value));
+  BOOST_CHECK_EQUAL(0, std::strcmp("15", value));
+  BOOST_REQUIRE(store.GetCell(3, 0, cell, value));
+  BOOST_CHECK_EQUAL(0, std::strcmp("3", value));
+
+  store.Close();
+  BOOST_CHECK_EQUAL(0, store.GetRowCount());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,97 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <trino/odbc/timer_service.h>
+
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace trino::odbc;
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE(TimerServiceTestSuite)
+
+BOOST_AUTO_TEST_CASE(TestTimerExpires) {
+  TimerService service(std::chrono::milliseconds(10), 8);
+
+  std::atomic< int > fired(0);
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  std::atomic< int64_t > elapsed(0);
+
+  // the delay spans several turns of the wheel
+  service.Schedule(std::chrono::milliseconds(200), [&]() {
+    elapsed = std::chrono::duration_cast< std::chrono::milliseconds >(
+                  std::chrono::steady_clock::now() - start)
+                  .count();
+    ++fired;
+  });
+  service.Schedule(std::chrono::milliseconds(20), [&]() { ++fired; });
+  BOOST_CHECK_EQUAL(2, service.GetPendingCount());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  BOOST_CHECK_EQUAL(2, fired.load());
+  BOOST_CHECK_GE(elapsed.load(), 200);
+  BOOST_CHECK_EQUAL(0, service.GetPendingCount());
+}
+
+BOOST_AUTO_TEST_CASE(TestCancelledTimerDoesNotFire) {
+  TimerService service(std::chrono::milliseconds(10), 8);
+
+  std::atomic< bool > fired(false);
+  TimerService::TimerId id =
+      service.Schedule(std::chrono::milliseconds(50), [&]() { fired = true; });
+
+  BOOST_CHECK(service.Cancel(id));
+  BOOST_CHECK(!service.Cancel(id));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  BOOST_CHECK(!fired);
+}
+
+BOOST_AUTO_TEST_CASE(TestScheduleAndCancelCost) {
+  TimerService service(std::chrono::milliseconds(100), 512);
+
+  const int count = 100000;
+  std::vector< TimerService::TimerId > ids;
+  ids.reserve(count);
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (int i = 0; i < count; ++i) {
+    ids.push_back(service.Schedule(std::chrono::seconds(30 + i % 600), []() {}));
+  }
+  for (TimerService::TimerId id : ids) {
+    service.Cancel(id);
+  }
+  int64_t elapsed = std::chrono::duration_cast< std::chrono::nanoseconds >(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+
+  BOOST_TEST_MESSAGE("Arming and cancelling a timer takes "
+                     << elapsed / count << " ns");
+  BOOST_CHECK_EQUAL(0, service.GetPendingCount());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,119 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <trino/odbc/tracer.h>
+
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace trino::odbc;
+using namespace boost::unit_test;
+
+namespace {
+/**
+ * Read a whole file.
+ *
+ * @param path File path.
+ * @return File content.
+ */
+std::string ReadFile(const std::string& path) {
+  std::ifstream file(path);
+  std::stringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+/**
+ * Count occurrences of a string.
+ *
+ * @param text Text to search.
+ * @param part String to count.
+ * @return Number of occurrences.
+ */
+size_t Count(const std::string& text, const std::string& part) {
+  size_t count = 0;
+  for (size_t pos = text.find(part); pos != std::string::npos;
+       pos = text.find(part, pos + part.size())) {
+    ++count;
+  }
+  return count;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TracerTestSuite)
+
+BOOST_AUTO_TEST_CASE(TestCompleteEvents) {
+  std::string path = "trino_odbc_tracer_test.json";
+  Tracer tracer;
+  BOOST_REQUIRE(tracer.Start(path));
+  BOOST_CHECK(Tracer::IsEnabled());
+
+  Tracer::Clock::time_point start = Tracer::Clock::now();
+  tracer.Complete("SQLFetch", "odbc", start,
+                  start + std::chrono::microseconds(1500));
+  std::thread([&]() {
+    tracer.Complete("fetch page", "fetch", start, start);
+  }).join();
+
+  tracer.Stop();
+  BOOST_CHECK(!Tracer::IsEnabled());
+
+  std::string content = ReadFile(path);
+  std::remove(path.c_str());
+
+  // the array format allows leaving out the closing bracket
+  BOOST_CHECK_EQUAL(0, content.find("[\n{\"name\":\"SQLFetch\","
+                                    "\"cat\":\"odbc\",\"ph\":\"X\",\"ts\":"));
+  BOOST_CHECK(content.find(",\"dur\":1500.000,") != std::string::npos);
+  BOOST_CHECK(content.find("},\n{\"name\":\"fetch page\",\"cat\":\"fetch\",")
+              != std::string::npos);
+  BOOST_CHECK_EQUAL(2, Count(content, "\"ph\":\"X\""));
+  BOOST_CHECK_EQUAL(content.size() - 1, content.rfind('}'));
+
+  // every thread has its own identifier
+  size_t first = content.find("\"tid\":");
+  size_t second = content.find("\"tid\":", first + 1);
+  BOOST_REQUIRE(second != std::string::npos);
+  BOOST_CHECK(content.substr(first, content.find('}', first) - first)
+              != content.substr(second, content.find('}', second) - second));
+}
+
+BOOST_AUTO_TEST_CASE(TestNothingRecordedWhenStopped) {
+  std::string path = "trino_odbc_tracer_test.json";
+  Tracer tracer;
+  BOOST_REQUIRE(tracer.Start(path));
+  tracer.Stop();
+
+  Tracer::Clock::time_point start = Tracer::Clock::now();
+  tracer.Complete("SQLFetch", "odbc", start, start);
+  tracer.Flush();
+
+  std::string content = ReadFile(path);
+  std::remove(path.c_str());
+
+  BOOST_CHECK_EQUAL("[\n", content);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -212,4 +212,335 @@ BOOST_AUTO_TEST_CASE(TestParsingMaxConnections) {
       "default value. [key='MaxConnections', value='-1000']");
 }
 
+BOOST_AUTO_TEST_CASE(TestParsingResultMemoryLimit) {
+  trino::odbc::config::Configuration cfg;
+
+  ConnectionStringParser parser(cfg);
+
+  diagnostic::DiagnosticRecordStorage diag;
+
+  std::string connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "ResultMemoryLimit=256;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 0);
+  BOOST_CHECK_EQUAL(cfg.GetResultMemoryLimit(), 256);
+
+  connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "ResultMemoryLimit=-1;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 1);
+  BOOST_CHECK_EQUAL(
+      diag.GetStatusRecord(1).GetMessageText(),
+      "Result Memory Limit attribute value contains unexpected characters. "
+      "Using default value. [key='ResultMemoryLimit', value='-1']");
+
+  connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "ResultMemoryLimit=3000000000;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 2);
+  BOOST_CHECK_EQUAL(
+      diag.GetStatusRecord(2).GetMessageText(),
+      "Result Memory Limit attribute value is out of range. Using default "
+      "value. [key='ResultMemoryLimit', value='3000000000']");
+}
+
+BOOST_AUTO_TEST_CASE(TestParsingResultCache) {
+  trino::odbc::config::Configuration cfg;
+
+  ConnectionStringParser parser(cfg);
+
+  diagnostic::DiagnosticRecordStorage diag;
+
+  BOOST_CHECK_EQUAL(cfg.GetResultCacheTtl(), 0);
+  BOOST_CHECK_EQUAL(cfg.GetResultCacheSize(), 64);
+
+  std::string connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "ResultCacheTtl=30;"
+      "ResultCacheSize=128;"
+      "ResultCacheDir=.;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 0);
+  BOOST_CHECK_EQUAL(cfg.GetResultCacheTtl(), 30);
+  BOOST_CHECK_EQUAL(cfg.GetResultCacheSize(), 128);
+  BOOST_CHECK_EQUAL(cfg.GetResultCacheDir(), ".");
+
+  connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "ResultCacheTtl=-1;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 1);
+  BOOST_CHECK_EQUAL(
+      diag.GetStatusRecord(1).GetMessageText(),
+      "Result Cache TTL attribute value contains unexpected characters. "
+      "Using default value. [key='ResultCacheTtl', value='-1']");
+  BOOST_CHECK_EQUAL(cfg.GetResultCacheTtl(), 30);
+}
+
+BOOST_AUTO_TEST_CASE(TestParsingQuerySharing) {
+  trino::odbc::config::Configuration cfg;
+
+  ConnectionStringParser parser(cfg);
+
+  diagnostic::DiagnosticRecordStorage diag;
+
+  BOOST_CHECK(!cfg.GetQuerySharing());
+
+  std::string connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "QuerySharing=true;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 0);
+  BOOST_CHECK(cfg.GetQuerySharing());
+
+  connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "QuerySharing=maybe;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 1);
+  BOOST_CHECK_EQUAL(
+      diag.GetStatusRecord(1).GetMessageText(),
+      "Query Sharing attribute value is not a boolean. "
+      "Using default value. [key='QuerySharing', value='maybe']");
+  BOOST_CHECK(cfg.GetQuerySharing());
+}
+
+BOOST_AUTO_TEST_CASE(TestParsingLogFileSize) {
+  trino::odbc::config::Configuration cfg;
+
+  ConnectionStringParser parser(cfg);
+
+  diagnostic::DiagnosticRecordStorage diag;
+
+  BOOST_CHECK_EQUAL(cfg.GetLogFileSize(), 0);
+  BOOST_CHECK(!cfg.GetLogDropOnOverflow());
+
+  std::string connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "LogFileSize=50;"
+      "LogDropOnOverflow=true;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 0);
+  BOOST_CHECK_EQUAL(cfg.GetLogFileSize(), 50);
+  BOOST_CHECK(cfg.GetLogDropOnOverflow());
+
+  connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "LogFileSize=-1;"
+      "LogDropOnOverflow=false;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 1);
+  BOOST_CHECK_EQUAL(
+      diag.GetStatusRecord(1).GetMessageText(),
+      "Log File Size attribute value contains unexpected characters. "
+      "Using default value. [key='LogFileSize', value='-1']");
+  BOOST_CHECK_EQUAL(cfg.GetLogFileSize(), 50);
+  BOOST_CHECK(!cfg.GetLogDropOnOverflow());
+}
+
+BOOST_AUTO_TEST_CASE(TestParsingMetadataCacheTtl) {
+  trino::odbc::config::Configuration cfg;
+
+  ConnectionStringParser parser(cfg);
+
+  diagnostic::DiagnosticRecordStorage diag;
+
+  BOOST_CHECK_EQUAL(cfg.GetMetadataCacheTtl(), 0);
+
+  std::string connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "MetadataCacheTtl=300;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 0);
+  BOOST_CHECK_EQUAL(cfg.GetMetadataCacheTtl(), 300);
+
+  connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "MetadataCacheTtl=5m;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 1);
+  BOOST_CHECK_EQUAL(
+      diag.GetStatusRecord(1).GetMessageText(),
+      "Metadata Cache TTL attribute value contains unexpected characters. "
+      "Using default value. [key='MetadataCacheTtl', value='5m']");
+  BOOST_CHECK_EQUAL(cfg.GetMetadataCacheTtl(), 300);
+}
+
+BOOST_AUTO_TEST_CASE(TestParsingMetadataConcurrency) {
+  trino::odbc::config::Configuration cfg;
+
+  ConnectionStringParser parser(cfg);
+
+  diagnostic::DiagnosticRecordStorage diag;
+
+  BOOST_CHECK_EQUAL(cfg.GetMetadataConcurrency(), 16);
+
+  std::string connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "MetadataConcurrency=4;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 0);
+  BOOST_CHECK_EQUAL(cfg.GetMetadataConcurrency(), 4);
+
+  connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "MetadataConcurrency=-1;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 1);
+  BOOST_CHECK_EQUAL(cfg.GetMetadataConcurrency(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(TestParsingMetadataSnapshotDir) {
+  trino::odbc::config::Configuration cfg;
+
+  ConnectionStringParser parser(cfg);
+
+  diagnostic::DiagnosticRecordStorage diag;
+
+  BOOST_CHECK_EQUAL(cfg.GetMetadataSnapshotDir(), "");
+
+  std::string connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "MetadataSnapshotDir=.;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 0);
+  BOOST_CHECK_EQUAL(cfg.GetMetadataSnapshotDir(), ".");
+}
+
+BOOST_AUTO_TEST_CASE(TestParsingMetadataPrefetch) {
+  trino::odbc::config::Configuration cfg;
+
+  ConnectionStringParser parser(cfg);
+
+  diagnostic::DiagnosticRecordStorage diag;
+
+  BOOST_CHECK(!cfg.GetMetadataPrefetch());
+
+  std::string connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "MetadataPrefetch=true;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 0);
+  BOOST_CHECK(cfg.GetMetadataPrefetch());
+
+  connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "MetadataPrefetch=maybe;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 1);
+  BOOST_CHECK_EQUAL(
+      diag.GetStatusRecord(1).GetMessageText(),
+      "Metadata Prefetch attribute value is not a boolean. "
+      "Using default value. [key='MetadataPrefetch', value='maybe']");
+  BOOST_CHECK(cfg.GetMetadataPrefetch());
+}
+
+BOOST_AUTO_TEST_CASE(TestParsingQueryTraceFile) {
+  trino::odbc::config::Configuration cfg;
+
+  ConnectionStringParser parser(cfg);
+
+  diagnostic::DiagnosticRecordStorage diag;
+
+  BOOST_CHECK_EQUAL(cfg.GetQueryTraceFile(), "");
+
+  std::string connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "QueryTraceFile=/tmp/trino_odbc_trace.jsonl;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 0);
+  BOOST_CHECK_EQUAL(cfg.GetQueryTraceFile(), "/tmp/trino_odbc_trace.jsonl");
+}
+
+BOOST_AUTO_TEST_CASE(TestParsingMetricsFile) {
+  trino::odbc::config::Configuration cfg;
+
+  ConnectionStringParser parser(cfg);
+
+  diagnostic::DiagnosticRecordStorage diag;
+
+  BOOST_CHECK_EQUAL(cfg.GetMetricsFile(), "");
+  BOOST_CHECK_EQUAL(cfg.GetMetricsInterval(), 60);
+
+  std::string connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "MetricsFile=/tmp/trino_odbc.prom;"
+      "MetricsInterval=15;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 0);
+  BOOST_CHECK_EQUAL(cfg.GetMetricsFile(), "/tmp/trino_odbc.prom");
+  BOOST_CHECK_EQUAL(cfg.GetMetricsInterval(), 15);
+
+  connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "MetricsInterval=-5;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 1);
+  BOOST_CHECK_EQUAL(
+      diag.GetStatusRecord(1).GetMessageText(),
+      "Metrics Interval attribute value contains unexpected characters. "
+      "Using default value. [key='MetricsInterval', value='-5']");
+  BOOST_CHECK_EQUAL(cfg.GetMetricsInterval(), 15);
+}
+
+BOOST_AUTO_TEST_CASE(TestParsingTraceEventFile) {
+  trino::odbc::config::Configuration cfg;
+
+  ConnectionStringParser parser(cfg);
+
+  diagnostic::DiagnosticRecordStorage diag;
+
+  BOOST_CHECK_EQUAL(cfg.GetTraceEventFile(), "");
+
+  std::string connectionString =
+      "driver={Amazon Trino ODBC Driver};"
+      "TraceEventFile=/tmp/trino_odbc_trace.json;";
+
+  BOOST_CHECK_NO_THROW(parser.ParseConnectionString(connectionString, &diag));
+
+  BOOST_CHECK(diag.GetStatusRecordsNumber() == 0);
+  BOOST_CHECK_EQUAL(cfg.GetTraceEventFile(), "/tmp/trino_odbc_trace.json");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
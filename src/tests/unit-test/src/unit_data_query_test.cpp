@@ -14,7 +14,14 @@
  *
  */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <odbc_unit_test_suite.h>
 #include "trino/odbc/log.h"
@@ -26,6 +33,7 @@
 
 using trino::odbc::AuthType;
 using trino::odbc::MockConnection;
+using trino::odbc::MockStatement;
 using trino::odbc::MockTrinoService;
 using trino::odbc::OdbcUnitTestSuite;
 using trino::odbc::Statement;
@@ -175,4 +183,658 @@ BOOST_AUTO_TEST_CASE(TestDataQuery10RowWithError) {
   BOOST_CHECK_EQUAL(GetReturnCode(), SQL_NO_DATA);
 }
 
+BOOST_AUTO_TEST_CASE(TestDataQueryCloseCancelsQuery) {
+  // Closing the cursor while the next page is still being fetched must not
+  // wait for the page, and the query must be cancelled on the server.
+  Connect();
+
+  std::string sql = "select measure, time from mockDB.mockTableSlow";
+  stmt->ExecuteSqlQuery(sql);
+  BOOST_CHECK(IsSuccessful());
+
+  stmt->FetchRow();
+  BOOST_CHECK(IsSuccessful());
+
+  int cancelCount = MockTrinoService::GetInstance()->GetCancelCount();
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  stmt->FreeResources(SQL_CLOSE);
+  std::chrono::milliseconds elapsed =
+      std::chrono::duration_cast< std::chrono::milliseconds >(
+          std::chrono::steady_clock::now() - start);
+  BOOST_CHECK(IsSuccessful());
+
+  BOOST_TEST_MESSAGE("Close latency: " << elapsed.count() << " ms");
+  BOOST_CHECK_LT(elapsed.count(),
+                 MockTrinoService::SLOW_PAGE_DELAY.count() / 10);
+  BOOST_CHECK_EQUAL(cancelCount + 1,
+                    MockTrinoService::GetInstance()->GetCancelCount());
+
+  // the statement can run the query again right away
+  stmt->ExecuteSqlQuery(sql);
+  BOOST_CHECK(IsSuccessful());
+}
+
+BOOST_AUTO_TEST_CASE(TestDataQueryMaxRowsExecuteTwice) {
+  // The row limit applies to every execution of a prepared query
+  Connect();
+
+  stmt->SetAttribute(SQL_ATTR_MAX_ROWS, reinterpret_cast< SQLPOINTER >(2), 0);
+  stmt->PrepareSqlQuery("select measure, time from mockDB.mockTable");
+  BOOST_CHECK(IsSuccessful());
+
+  for (int i = 0; i < 2; ++i) {
+    stmt->ExecuteSqlQuery();
+    BOOST_CHECK(IsSuccessful());
+
+    for (int row = 0; row < 2; ++row) {
+      stmt->FetchRow();
+      BOOST_CHECK(IsSuccessful());
+    }
+    stmt->FetchRow();
+    BOOST_CHECK_EQUAL(GetReturnCode(), SQL_NO_DATA);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestDataQueryWithParameters) {
+  // A parameterized query is executed with EXECUTE IMMEDIATE, the bound
+  // values are its arguments.
+  Connect();
+
+  std::string sql =
+      "select measure, time from mockDB.mockTable where measure = ?";
+  stmt->PrepareSqlQuery(sql);
+  BOOST_CHECK(IsSuccessful());
+
+  uint16_t paramNum = 0;
+  stmt->GetParametersNumber(paramNum);
+  BOOST_CHECK_EQUAL(1, paramNum);
+
+  // executing without a bound parameter fails
+  stmt->ExecuteSqlQuery();
+  BOOST_CHECK_EQUAL("07002", GetSqlState());
+
+  char value[] = "cpu_usage";
+  SQLLEN valueLen = SQL_NTS;
+  stmt->BindParameter(1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR,
+                      sizeof(value), 0, value, sizeof(value), &valueLen);
+  BOOST_CHECK(IsSuccessful());
+
+  for (int i = 0; i < 3; ++i) {
+    stmt->ExecuteSqlQuery();
+    BOOST_CHECK(IsSuccessful());
+
+    for (int row = 0; row < 3; ++row) {
+      stmt->FetchRow();
+      BOOST_CHECK(IsSuccessful());
+    }
+    stmt->FetchRow();
+    BOOST_CHECK_EQUAL(GetReturnCode(), SQL_NO_DATA);
+  }
+
+  // the value is read again on every execution, the mock knows no other
+  std::strcpy(value, "mem_usage");
+  stmt->ExecuteSqlQuery();
+  BOOST_CHECK(!IsSuccessful());
+
+  stmt->FreeResources(SQL_RESET_PARAMS);
+  stmt->ExecuteSqlQuery();
+  BOOST_CHECK_EQUAL("07002", GetSqlState());
+}
+
+BOOST_AUTO_TEST_CASE(TestDataQueryParameterArrayInsert) {
+  // Rows of a parameter array are inserted in batches; the rows of a failing
+  // batch are inserted one by one, so only the failing row fails.
+  Connect();
+
+  const SQLULEN rows = 2 * Statement::MAX_BATCH_ROWS + 500;
+  const SQLULEN badRow = Statement::MAX_BATCH_ROWS + 500;
+  const SQLLEN valueSize = 16;
+
+  std::vector< char > measures(rows * valueSize);
+  std::vector< SQLLEN > measureLens(rows, SQL_NTS);
+  std::vector< SQLINTEGER > ids(rows);
+  for (SQLULEN i = 0; i < rows; ++i) {
+    std::string measure = i == badRow ? "bad" : "m" + std::to_string(i);
+    measure.copy(&measures[i * valueSize], measure.size());
+    ids[i] = static_cast< SQLINTEGER >(i);
+  }
+  std::vector< SQLUSMALLINT > statuses(rows);
+  SQLULEN processed = 0;
+
+  stmt->PrepareSqlQuery(
+      "INSERT INTO mockDB.mockInsert (measure, id) VALUES (?, ?)");
+  stmt->BindParameter(1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, valueSize,
+                      0, measures.data(), valueSize, measureLens.data());
+  stmt->BindParameter(2, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0,
+                      ids.data(), 0, nullptr);
+  stmt->SetAttribute(SQL_ATTR_PARAMSET_SIZE,
+                     reinterpret_cast< SQLPOINTER >(rows), 0);
+  stmt->SetAttribute(SQL_ATTR_PARAM_STATUS_PTR, statuses.data(), 0);
+  stmt->SetAttribute(SQL_ATTR_PARAMS_PROCESSED_PTR, &processed, 0);
+  BOOST_CHECK(IsSuccessful());
+
+  int insertCount = MockTrinoService::GetInstance()->GetInsertCount();
+  int64_t insertedRows = MockTrinoService::GetInstance()->GetInsertedRows();
+
+  stmt->ExecuteSqlQuery();
+  BOOST_CHECK_EQUAL(SQL_SUCCESS_WITH_INFO, GetReturnCode());
+  BOOST_CHECK_EQUAL(rows, processed);
+
+  for (SQLULEN i = 0; i < rows; ++i) {
+    BOOST_REQUIRE_EQUAL(i == badRow ? SQL_PARAM_ERROR : SQL_PARAM_SUCCESS,
+                        statuses[i]);
+  }
+
+  // two batches and the rows of the failed batch but the bad one
+  BOOST_CHECK_EQUAL(
+      insertCount + 2 + static_cast< int >(Statement::MAX_BATCH_ROWS - 1),
+      MockTrinoService::GetInstance()->GetInsertCount());
+  BOOST_CHECK_EQUAL(insertedRows + static_cast< int64_t >(rows - 1),
+                    MockTrinoService::GetInstance()->GetInsertedRows());
+}
+
+BOOST_AUTO_TEST_CASE(TestDataQueryParameterArrayInsertTimeout) {
+  // A batch that timed out may have been written, so its rows are not
+  // inserted again one by one.
+  Connect();
+
+  const SQLULEN rows = 3;
+  char measures[rows][16] = {"m0", "slow", "m2"};
+  SQLLEN measureLens[rows] = {SQL_NTS, SQL_NTS, SQL_NTS};
+  SQLUSMALLINT statuses[rows] = {};
+
+  stmt->SetAttribute(SQL_ATTR_QUERY_TIMEOUT, reinterpret_cast< void* >(1), 0);
+  stmt->PrepareSqlQuery("INSERT INTO mockDB.mockInsert (measure) VALUES (?)");
+  stmt->BindParameter(1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 16, 0,
+                      measures, 16, measureLens);
+  stmt->SetAttribute(SQL_ATTR_PARAMSET_SIZE,
+                     reinterpret_cast< SQLPOINTER >(rows), 0);
+  stmt->SetAttribute(SQL_ATTR_PARAM_STATUS_PTR, statuses, 0);
+  BOOST_CHECK(IsSuccessful());
+
+  int insertCount = MockTrinoService::GetInstance()->GetInsertCount();
+
+  stmt->ExecuteSqlQuery();
+  BOOST_CHECK_EQUAL(SQL_ERROR, GetReturnCode());
+  BOOST_CHECK_EQUAL("HYT00", GetSqlState());
+  for (SQLULEN i = 0; i < rows; ++i) {
+    BOOST_CHECK_EQUAL(SQL_PARAM_ERROR, statuses[i]);
+  }
+
+  // the mock answers the batch only after the timeout, it is the only insert
+  BOOST_CHECK_EQUAL(insertCount + 1,
+                    MockTrinoService::GetInstance()->GetInsertCount());
+}
+
+BOOST_AUTO_TEST_CASE(TestDataQueryParameterArrayInsertTimeoutStops) {
+  // The query timeout covers the whole parameter array: once a batch timed
+  // out the next one is not sent and its rows stay unused.
+  Connect();
+
+  const SQLULEN rows = Statement::MAX_BATCH_ROWS + 10;
+  const SQLLEN valueSize = 16;
+
+  std::vector< char > measures(rows * valueSize);
+  std::vector< SQLLEN > measureLens(rows, SQL_NTS);
+  for (SQLULEN i = 0; i < rows; ++i) {
+    std::string measure = i == 0 ? "slow" : "m" + std::to_string(i);
+    measure.copy(&measures[i * valueSize], measure.size());
+  }
+  std::vector< SQLUSMALLINT > statuses(rows);
+  SQLULEN processed = 0;
+
+  stmt->SetAttribute(SQL_ATTR_QUERY_TIMEOUT, reinterpret_cast< void* >(1), 0);
+  stmt->PrepareSqlQuery("INSERT INTO mockDB.mockInsert (measure) VALUES (?)");
+  stmt->BindParameter(1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, valueSize,
+                      0, measures.data(), valueSize, measureLens.data());
+  stmt->SetAttribute(SQL_ATTR_PARAMSET_SIZE,
+                     reinterpret_cast< SQLPOINTER >(rows), 0);
+  stmt->SetAttribute(SQL_ATTR_PARAM_STATUS_PTR, statuses.data(), 0);
+  stmt->SetAttribute(SQL_ATTR_PARAMS_PROCESSED_PTR, &processed, 0);
+  BOOST_CHECK(IsSuccessful());
+
+  int insertCount = MockTrinoService::GetInstance()->GetInsertCount();
+
+  stmt->ExecuteSqlQuery();
+  BOOST_CHECK_EQUAL(SQL_ERROR, GetReturnCode());
+  BOOST_CHECK_EQUAL("HYT00", GetSqlState());
+  BOOST_CHECK_EQUAL(Statement::MAX_BATCH_ROWS, processed);
+
+  for (SQLULEN i = 0; i < rows; ++i) {
+    BOOST_REQUIRE_EQUAL(i < Statement::MAX_BATCH_ROWS ? SQL_PARAM_ERROR
+                                                      : SQL_PARAM_UNUSED,
+                        statuses[i]);
+  }
+
+  BOOST_CHECK_EQUAL(insertCount + 1,
+                    MockTrinoService::GetInstance()->GetInsertCount());
+}
+
+BOOST_AUTO_TEST_CASE(TestDataQueryParameterArraySelect) {
+  // Statements other than single row inserts run once per parameter set,
+  // the result of the last set is the one fetched.
+  Connect();
+
+  const SQLULEN rows = 3;
+  char measures[rows][16] = {"cpu_usage", "other", "cpu_usage"};
+  SQLLEN measureLens[rows] = {SQL_NTS, SQL_NTS, SQL_NTS};
+  SQLUSMALLINT statuses[rows] = {};
+  SQLULEN processed = 0;
+
+  stmt->PrepareSqlQuery(
+      "select measure, time from mockDB.mockTable where measure = ?");
+  stmt->BindParameter(1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 16, 0,
+                      measures, 16, measureLens);
+  stmt->SetAttribute(SQL_ATTR_PARAMSET_SIZE,
+                     reinterpret_cast< SQLPOINTER >(rows), 0);
+  stmt->SetAttribute(SQL_ATTR_PARAM_STATUS_PTR, statuses, 0);
+  stmt->SetAttribute(SQL_ATTR_PARAMS_PROCESSED_PTR, &processed, 0);
+
+  stmt->ExecuteSqlQuery();
+  BOOST_CHECK_EQUAL(SQL_SUCCESS_WITH_INFO, GetReturnCode());
+  BOOST_CHECK_EQUAL(rows, processed);
+  BOOST_CHECK_EQUAL(SQL_PARAM_SUCCESS, statuses[0]);
+  BOOST_CHECK_EQUAL(SQL_PARAM_ERROR, statuses[1]);
+  BOOST_CHECK_EQUAL(SQL_PARAM_SUCCESS, statuses[2]);
+
+  for (int row = 0; row < 3; ++row) {
+    stmt->FetchRow();
+    BOOST_CHECK(IsSuccessful());
+  }
+  stmt->FetchRow();
+  BOOST_CHECK_EQUAL(GetReturnCode(), SQL_NO_DATA);
+}
+
+BOOST_AUTO_TEST_CASE(TestDataQueryParameterArrayInsertThroughput) {
+  // Measures rows per second of parameter array inserts and checks the rows
+  // go in as few statements as the batch limits allow.
+  Connect();
+
+  const SQLLEN valueSize = 16;
+
+  for (SQLULEN rows : {1000, 10000, 100000}) {
+    std::vector< char > measures(rows * valueSize);
+    std::vector< SQLLEN > measureLens(rows, SQL_NTS);
+    std::vector< double > values(rows);
+    for (SQLULEN i = 0; i < rows; ++i) {
+      std::string measure = "m" + std::to_string(i);
+      measure.copy(&measures[i * valueSize], measure.size());
+      values[i] = i * 0.5;
+    }
+    std::vector< SQLUSMALLINT > statuses(rows);
+
+    stmt->PrepareSqlQuery(
+        "INSERT INTO mockDB.mockInsert (measure, value) VALUES (?, ?)");
+    stmt->BindParameter(1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR,
+                        valueSize, 0, measures.data(), valueSize,
+                        measureLens.data());
+    stmt->BindParameter(2, SQL_PARAM_INPUT, SQL_C_DOUBLE, SQL_DOUBLE, 0, 0,
+                        values.data(), 0, nullptr);
+    stmt->SetAttribute(SQL_ATTR_PARAMSET_SIZE,
+                       reinterpret_cast< SQLPOINTER >(rows), 0);
+    stmt->SetAttribute(SQL_ATTR_PARAM_STATUS_PTR, statuses.data(), 0);
+
+    int insertCount = MockTrinoService::GetInstance()->GetInsertCount();
+
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    stmt->ExecuteSqlQuery();
+    std::chrono::microseconds elapsed =
+        std::chrono::duration_cast< std::chrono::microseconds >(
+            std::chrono::steady_clock::now() - start);
+    BOOST_CHECK_EQUAL(SQL_SUCCESS, GetReturnCode());
+
+    BOOST_TEST_MESSAGE("Inserted " << rows << " rows in "
+                                   << elapsed.count() / 1000 << " ms, "
+                                   << rows * 1000000 / (elapsed.count() + 1)
+                                   << " rows/s");
+    int batches = static_cast< int >((rows + Statement::MAX_BATCH_ROWS - 1)
+                                     / Statement::MAX_BATCH_ROWS);
+    BOOST_CHECK_EQUAL(insertCount + batches,
+                      MockTrinoService::GetInstance()->GetInsertCount());
+    BOOST_CHECK(std::count(statuses.begin(), statuses.end(),
+                           SQL_PARAM_SUCCESS)
+                == static_cast< std::ptrdiff_t >(rows));
+
+    stmt->FreeResources(SQL_RESET_PARAMS);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestDataQueryTimeout) {
+  // The query timeout expires while the second page is being fetched
+  Connect();
+
+  stmt->SetAttribute(SQL_ATTR_QUERY_TIMEOUT, reinterpret_cast< void* >(1), 0);
+  BOOST_CHECK(IsSuccessful());
+
+  std::string sql = "select measure, time from mockDB.mockTableSlow";
+  stmt->ExecuteSqlQuery(sql);
+  BOOST_CHECK(IsSuccessful());
+
+  // rows of the first page
+  for (int i = 0; i < 3; i++) {
+    stmt->FetchRow();
+    BOOST_CHECK(IsSuccessful());
+  }
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  stmt->FetchRow();
+  std::chrono::milliseconds elapsed =
+      std::chrono::duration_cast< std::chrono::milliseconds >(
+          std::chrono::steady_clock::now() - start);
+
+  BOOST_CHECK_EQUAL(GetReturnCode(), SQL_ERROR);
+  BOOST_CHECK_LT(elapsed.count(), MockTrinoService::SLOW_PAGE_DELAY.count());
+}
+
+BOOST_AUTO_TEST_CASE(TestDataQueryAsyncExecution) {
+  // Execute and fetch return SQL_STILL_EXECUTING until the work is done on
+  // a worker, cancelling interrupts the function waiting for a slow page
+  Connect();
+
+  stmt->SetAttribute(SQL_ATTR_ASYNC_ENABLE,
+                     reinterpret_cast< void* >(SQL_ASYNC_ENABLE_ON), 0);
+  BOOST_CHECK(IsSuccessful());
+
+  std::string sql = "select measure, time from mockDB.mockTableSlow";
+  stmt->ExecuteSqlQuery(sql);
+  BOOST_CHECK_EQUAL(GetReturnCode(), SQL_STILL_EXECUTING);
+  while (GetReturnCode() == SQL_STILL_EXECUTING) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    stmt->ExecuteSqlQuery(sql);
+  }
+  BOOST_CHECK(IsSuccessful());
+
+  // rows of the first page
+  for (int i = 0; i < 3; i++) {
+    do {
+      stmt->FetchRow();
+    } while (GetReturnCode() == SQL_STILL_EXECUTING);
+    BOOST_CHECK(IsSuccessful());
+  }
+
+  // the second page is held back until the query is cancelled
+  stmt->FetchRow();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  stmt->FetchRow();
+  BOOST_CHECK_EQUAL(GetReturnCode(), SQL_STILL_EXECUTING);
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  stmt->CancelSqlQuery();
+  BOOST_CHECK(IsSuccessful());
+
+  do {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    stmt->FetchRow();
+  } while (GetReturnCode() == SQL_STILL_EXECUTING);
+  std::chrono::milliseconds elapsed =
+      std::chrono::duration_cast< std::chrono::milliseconds >(
+          std::chrono::steady_clock::now() - start);
+
+  BOOST_CHECK_EQUAL(GetReturnCode(), SQL_ERROR);
+  BOOST_CHECK_EQUAL(GetSqlState(), "HY008");
+  BOOST_CHECK_LT(elapsed.count(),
+                 MockTrinoService::SLOW_PAGE_DELAY.count() / 10);
+
+  // the statement is usable again, also in synchronous mode
+  stmt->SetAttribute(SQL_ATTR_ASYNC_ENABLE,
+                     reinterpret_cast< void* >(SQL_ASYNC_ENABLE_OFF), 0);
+  stmt->ExecuteSqlQuery(sql);
+  BOOST_CHECK(IsSuccessful());
+}
+
+BOOST_AUTO_TEST_CASE(TestCancelFromAnotherThread) {
+  // SQLCancel from another thread interrupts a synchronous fetch waiting for
+  // a slow page instead of waiting for it to finish
+  Connect();
+
+  std::string sql = "select measure, time from mockDB.mockTableSlow";
+  stmt->ExecuteSqlQuery(sql);
+  BOOST_CHECK(IsSuccessful());
+
+  // rows of the first page
+  for (int i = 0; i < 3; i++) {
+    stmt->FetchRow();
+    BOOST_CHECK(IsSuccessful());
+  }
+
+  std::atomic< bool > interrupted(false);
+  std::thread canceller([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    interrupted = stmt->InterruptSqlQuery();
+  });
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  stmt->FetchRow();
+  std::chrono::milliseconds elapsed =
+      std::chrono::duration_cast< std::chrono::milliseconds >(
+          std::chrono::steady_clock::now() - start);
+  canceller.join();
+
+  BOOST_CHECK(interrupted);
+  BOOST_CHECK_EQUAL(GetReturnCode(), SQL_ERROR);
+  BOOST_CHECK_EQUAL(GetSqlState(), "HY008");
+  BOOST_CHECK_LT(elapsed.count(),
+                 MockTrinoService::SLOW_PAGE_DELAY.count() / 2);
+
+  // nothing runs on the statement any more
+  BOOST_CHECK(!stmt->InterruptSqlQuery());
+}
+
+BOOST_AUTO_TEST_CASE(TestConcurrentStatementsStress) {
+  // statements of one connection execute and fetch on their own threads
+  Connect();
+
+  const int threadCount = 8;
+  const int rounds = 20;
+  const int rowsPerRound = 300;
+  std::atomic< int > failures(0);
+  std::atomic< int > rows(0);
+
+  std::vector< std::thread > threads;
+  for (int i = 0; i < threadCount; i++) {
+    threads.emplace_back([&]() {
+      std::unique_ptr< MockStatement > statement(dbc->CreateStatement());
+      for (int round = 0; round < rounds; round++) {
+        statement->ExecuteSqlQuery(
+            "select measure, time from mockDB.mockTable10000");
+        if (!statement->GetDiagnosticRecords().IsSuccessful()) {
+          ++failures;
+          continue;
+        }
+
+        for (int row = 0; row < rowsPerRound; row++) {
+          statement->FetchRow();
+          if (statement->GetDiagnosticRecords().IsSuccessful()) {
+            ++rows;
+          } else {
+            ++failures;
+          }
+        }
+
+        // the attribute is stored on the connection, shared by all threads
+        statement->SetAttribute(
+            SQL_ATTR_METADATA_ID,
+            reinterpret_cast< void* >(round % 2 ? SQL_TRUE : SQL_FALSE), 0);
+        if (!statement->GetDiagnosticRecords().IsSuccessful()) {
+          ++failures;
+        }
+      }
+    });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL(0, failures.load());
+  BOOST_CHECK_EQUAL(threadCount * rounds * rowsPerRound, rows.load());
+}
+
+BOOST_AUTO_TEST_CASE(TestConcurrentStatementsScale) {
+  // statements of one connection overlap their round trips, so several of
+  // them take about as long as one
+  Connect();
+
+  std::atomic< int > rows(0);
+  auto run = [&](int count) {
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+
+    std::vector< std::thread > threads;
+    for (int i = 0; i < count; i++) {
+      threads.emplace_back([&]() {
+        std::unique_ptr< MockStatement > statement(dbc->CreateStatement());
+        statement->ExecuteSqlQuery(
+            "select measure, time from mockDB.mockTableLatency");
+
+        while (statement->GetDiagnosticRecords().IsSuccessful()) {
+          statement->FetchRow();
+          if (statement->GetDiagnosticRecords().IsSuccessful()) {
+            ++rows;
+          }
+        }
+      });
+    }
+
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    return std::chrono::duration_cast< std::chrono::milliseconds >(
+        std::chrono::steady_clock::now() - start);
+  };
+
+  const int threadCount = 8;
+  std::chrono::milliseconds single = run(1);
+  std::chrono::milliseconds parallel = run(threadCount);
+
+  BOOST_TEST_MESSAGE("1 statement: " << single.count() << " ms, "
+                                     << threadCount << " statements: "
+                                     << parallel.count() << " ms");
+
+  int pageRows = MockTrinoService::LATENCY_PAGE_COUNT * 3;
+  BOOST_CHECK_EQUAL((threadCount + 1) * pageRows, rows.load());
+  // serialized statements would take threadCount times as long
+  BOOST_CHECK_LT(parallel.count(), single.count() * threadCount / 2);
+}
+
+BOOST_AUTO_TEST_CASE(TestDataQueryResultCache) {
+  // a repeated query is answered from the result cache without requests
+  Configuration cfg;
+  cfg.SetAuthType(AuthType::Type::IAM);
+  cfg.SetAccessKeyId("AwsTSUnitTestKeyId");
+  cfg.SetSecretKey("AwsTSUnitTestSecretKey");
+  cfg.SetResultCacheTtl(60);
+  getLogOptions(cfg);
+  dbc->Establish(cfg);
+
+  auto fetchAll = [&](const std::string& sql) {
+    stmt->ExecuteSqlQuery(sql);
+    BOOST_REQUIRE(IsSuccessful());
+
+    int rows = 0;
+    while (true) {
+      stmt->FetchRow();
+      if (!IsSuccessful()) {
+        break;
+      }
+      ++rows;
+    }
+    BOOST_CHECK_EQUAL(GetReturnCode(), SQL_NO_DATA);
+    stmt->Close();
+    return rows;
+  };
+
+  int requests = MockTrinoService::GetInstance()->GetLatencyRequestCount();
+  int pageRows = MockTrinoService::LATENCY_PAGE_COUNT * 3;
+
+  BOOST_CHECK_EQUAL(
+      pageRows, fetchAll("select measure, time from mockDB.mockTableLatency"));
+  BOOST_CHECK_EQUAL(
+      requests + MockTrinoService::LATENCY_PAGE_COUNT,
+      MockTrinoService::GetInstance()->GetLatencyRequestCount());
+
+  // formatting differences do not matter
+  BOOST_CHECK_EQUAL(pageRows,
+                    fetchAll("select measure,  time\n  from "
+                             "mockDB.mockTableLatency -- refresh"));
+  BOOST_CHECK_EQUAL(
+      requests + MockTrinoService::LATENCY_PAGE_COUNT,
+      MockTrinoService::GetInstance()->GetLatencyRequestCount());
+
+  SQLULEN hits = 0;
+  SQLULEN misses = 0;
+  dbc->GetAttribute(SQL_ATTR_TRINO_RESULT_CACHE_HITS, &hits, 0, nullptr);
+  dbc->GetAttribute(SQL_ATTR_TRINO_RESULT_CACHE_MISSES, &misses, 0, nullptr);
+  BOOST_CHECK_EQUAL(1, hits);
+  BOOST_CHECK_EQUAL(1, misses);
+
+  // the row limit applies to cached results as well
+  stmt->SetAttribute(SQL_ATTR_MAX_ROWS, reinterpret_cast< SQLPOINTER >(4), 0);
+  BOOST_CHECK_EQUAL(
+      4, fetchAll("select measure, time from mockDB.mockTableLatency"));
+}
+
+BOOST_AUTO_TEST_CASE(TestDataQuerySharing) {
+  // identical queries running at the same time are sent to the server once
+  Configuration cfg;
+  cfg.SetAuthType(AuthType::Type::IAM);
+  cfg.SetAccessKeyId("AwsTSUnitTestKeyId");
+  cfg.SetSecretKey("AwsTSUnitTestSecretKey");
+  cfg.SetQuerySharing(true);
+  getLogOptions(cfg);
+  dbc->Establish(cfg);
+
+  const int threadCount = 8;
+  int requests = MockTrinoService::GetInstance()->GetLatencyRequestCount();
+
+  std::atomic< int > rows(0);
+  std::atomic< int > failures(0);
+  std::vector< std::thread > threads;
+  for (int i = 0; i < threadCount; i++) {
+    threads.emplace_back([&]() {
+      std::unique_ptr< MockStatement > statement(dbc->CreateStatement());
+      statement->ExecuteSqlQuery(
+          "select measure, time from mockDB.mockTableLatency");
+      if (!statement->GetDiagnosticRecords().IsSuccessful()) {
+        ++failures;
+        return;
+      }
+
+      while (true) {
+        statement->FetchRow();
+        if (!statement->GetDiagnosticRecords().IsSuccessful()) {
+          break;
+        }
+        ++rows;
+      }
+      if (statement->GetDiagnosticRecords().GetReturnCode() != SQL_NO_DATA) {
+        ++failures;
+      }
+    });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  int pageRows = MockTrinoService::LATENCY_PAGE_COUNT * 3;
+  BOOST_CHECK_EQUAL(0, failures.load());
+  BOOST_CHECK_EQUAL(threadCount * pageRows, rows.load());
+
+  // statements starting after the first page was read by all others may
+  // run their own query, but most of them share one
+  int sent =
+      MockTrinoService::GetInstance()->GetLatencyRequestCount() - requests;
+  BOOST_TEST_MESSAGE(threadCount << " statements sent " << sent
+                                 << " requests");
+  BOOST_CHECK_LT(sent, threadCount * MockTrinoService::LATENCY_PAGE_COUNT / 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -40,6 +40,12 @@ BOOST_AUTO_TEST_CASE(TestUtilityRemoveSurroundingSpaces) {
   BOOST_REQUIRE(expectedOutStr == realOutStr);
 }
 
+BOOST_AUTO_TEST_CASE(TestUtilityQuoteSqlString) {
+  BOOST_CHECK_EQUAL("''", QuoteSqlString(""));
+  BOOST_CHECK_EQUAL("'my\\_table%'", QuoteSqlString("my\\_table%"));
+  BOOST_CHECK_EQUAL("'it''s'", QuoteSqlString("it's"));
+}
+
 BOOST_AUTO_TEST_CASE(TestUtilityCopyStringToBuffer) {
   SQLWCHAR buffer[1024];
   std::wstring wstr(L"你好 - Some data. And some more data here.");
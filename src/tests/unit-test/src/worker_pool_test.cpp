@@ -0,0 +1,131 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Modifications Copyright Amazon.com, Inc. or its affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <trino/odbc/worker_pool.h>
+
+#include <atomic>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using namespace trino::odbc;
+using namespace boost::unit_test;
+
+BOOST_AUTO_TEST_SUITE(WorkerPoolTestSuite)
+
+BOOST_AUTO_TEST_CASE(TestTasksRun) {
+  std::atomic< int > done(0);
+  {
+    WorkerPool pool(4);
+    for (int i = 0; i < 100; ++i) {
+      pool.Submit([&]() { ++done; });
+    }
+
+    BOOST_CHECK_LE(pool.GetThreadCount(), 4);
+  }
+
+  // the destructor runs the queued tasks
+  BOOST_CHECK_EQUAL(100, done.load());
+}
+
+BOOST_AUTO_TEST_CASE(TestIdleThreadIsReused) {
+  WorkerPool pool(4);
+
+  for (int i = 0; i < 10; ++i) {
+    std::atomic< bool > done(false);
+    pool.Submit([&]() { done = true; });
+    while (!done) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // let the thread go back to waiting
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+
+  BOOST_CHECK_EQUAL(1, pool.GetThreadCount());
+}
+
+BOOST_AUTO_TEST_CASE(TestTasksQueueAtThreadLimit) {
+  WorkerPool pool(2);
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool release = false;
+  std::atomic< int > started(0);
+
+  for (int i = 0; i < 3; ++i) {
+    pool.Submit([&]() {
+      ++started;
+      std::unique_lock< std::mutex > lock(mutex);
+      cv.wait(lock, [&]() { return release; });
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  BOOST_CHECK_EQUAL(2, pool.GetThreadCount());
+  BOOST_CHECK_EQUAL(2, started.load());
+  BOOST_CHECK_EQUAL(1, pool.GetQueuedCount());
+
+  {
+    std::lock_guard< std::mutex > lock(mutex);
+    release = true;
+    cv.notify_all();
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  BOOST_CHECK_EQUAL(3, started.load());
+  BOOST_CHECK_EQUAL(0, pool.GetQueuedCount());
+}
+
+BOOST_AUTO_TEST_CASE(TestDrainWaitsForTasks) {
+  WorkerPool pool(2);
+  std::atomic< int > done(0);
+
+  for (int i = 0; i < 10; ++i) {
+    pool.Submit([&]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      ++done;
+    });
+  }
+
+  pool.Drain();
+  BOOST_CHECK_EQUAL(10, done.load());
+  BOOST_CHECK_EQUAL(0, pool.GetQueuedCount());
+
+  // an idle pool is drained already
+  pool.Drain();
+}
+
+BOOST_AUTO_TEST_CASE(TestThrowingTaskIsDropped) {
+  WorkerPool pool(1);
+  std::atomic< bool > done(false);
+
+  pool.Submit([]() { throw std::runtime_error("task failed"); });
+  pool.Submit([&]() { done = true; });
+  pool.Drain();
+
+  // the thread survives the exception and runs the next task
+  BOOST_CHECK(done);
+  BOOST_CHECK_EQUAL(1, pool.GetThreadCount());
+}
+
+BOOST_AUTO_TEST_SUITE_END()